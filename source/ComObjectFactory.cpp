@@ -0,0 +1,63 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "ComObjectFactory.h"
+#include "Utilities.h"
+
+using namespace System;
+using namespace System::Reflection;
+
+namespace SlimDX
+{
+	generic<typename T>
+	void ComObjectFactory<T>::Initialize()
+	{
+		m_NativeInterface = Utilities::ConvertNativeGuid( Utilities::GetNativeGuidForType( T::typeid ) );
+
+		// the thunk is looked up on T itself; a type without its own thunk cannot be created this way
+		array<Type^>^ parameters = gcnew array<Type^> { IntPtr::typeid, ComObject::typeid };
+		MethodInfo^ thunk = T::typeid->GetMethod( "FromPointerReflectionThunk", BindingFlags::Static | BindingFlags::NonPublic, nullptr, parameters, nullptr );
+		if( thunk != nullptr && thunk->ReturnType == T::typeid )
+			m_Creator = safe_cast<Creator^>( Delegate::CreateDelegate( Creator::typeid, thunk ) );
+	}
+
+	generic<typename T>
+	Guid ComObjectFactory<T>::NativeInterface::get()
+	{
+		return m_NativeInterface;
+	}
+
+	generic<typename T>
+	T ComObjectFactory<T>::FromPointer( IUnknown* pointer, ComObject^ owner )
+	{
+		if( m_Creator == nullptr )
+		{
+			if( pointer != 0 )
+				pointer->Release();
+
+			throw gcnew NotSupportedException( String::Format( "Objects of type {0} cannot be created from a native pointer.", T::typeid->FullName ) );
+		}
+
+		return m_Creator( IntPtr( pointer ), owner );
+	}
+}
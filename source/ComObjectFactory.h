@@ -0,0 +1,59 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "ComObject.h"
+
+namespace SlimDX
+{
+	// Creates wrappers from native pointers in generic methods that only know the wrapper type, such as
+	// Resource::FromSwapChain<T>. The internal FromPointerReflectionThunk of each type is bound to a delegate
+	// once, when the type is first used, and its native interface is looked up at the same time; after that a
+	// wrapper costs one delegate call instead of a reflection invoke with a boxed argument array.
+	generic<typename T> where T : ComObject
+	ref class ComObjectFactory abstract sealed
+	{
+	private:
+		delegate T Creator( System::IntPtr pointer, ComObject^ owner );
+
+		static Creator^ m_Creator;
+		static System::Guid m_NativeInterface;
+
+		static void Initialize();
+
+		static ComObjectFactory()
+		{
+			Initialize();
+		}
+
+	internal:
+		// The IID of the native interface wrapped by T.
+		static property System::Guid NativeInterface
+		{
+			System::Guid get();
+		}
+
+		// Takes ownership of one reference to the pointer, like the FromPointer method of T. Returns the existing
+		// wrapper if the pointer is already in the object table, and null if the pointer is null.
+		static T FromPointer( IUnknown* pointer, ComObject^ owner );
+	};
+}
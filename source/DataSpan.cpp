@@ -0,0 +1,101 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "DataSpan.h"
+#include "Utilities.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+	generic<typename T>
+	DataSpan<T>::DataSpan( char* pointer, int count, bool canRead, bool canWrite )
+	: m_Pointer( pointer ), m_Count( count ), m_CanRead( canRead ), m_CanWrite( canWrite )
+	{
+	}
+
+	generic<typename T>
+	T DataSpan<T>::default::get( int index )
+	{
+		if( !m_CanRead )
+			throw gcnew NotSupportedException();
+		if( static_cast<unsigned int>( index ) >= static_cast<unsigned int>( m_Count ) )
+			throw gcnew ArgumentOutOfRangeException( "index" );
+
+		T result;
+		memcpy( &result, m_Pointer + static_cast<size_t>( index ) * sizeof(T), sizeof(T) );
+		return result;
+	}
+
+	generic<typename T>
+	void DataSpan<T>::default::set( int index, T value )
+	{
+		if( !m_CanWrite )
+			throw gcnew NotSupportedException();
+		if( static_cast<unsigned int>( index ) >= static_cast<unsigned int>( m_Count ) )
+			throw gcnew ArgumentOutOfRangeException( "index" );
+
+		memcpy( m_Pointer + static_cast<size_t>( index ) * sizeof(T), &value, sizeof(T) );
+	}
+
+	generic<typename T>
+	void DataSpan<T>::CopyFrom( array<T>^ source, int sourceIndex, int index, int count )
+	{
+		if( !m_CanWrite )
+			throw gcnew NotSupportedException();
+
+		Utilities::CheckArrayBounds( source, sourceIndex, count );
+		if( index < 0 || index > m_Count - count )
+			throw gcnew ArgumentOutOfRangeException( "index" );
+		if( count == 0 )
+			return;
+
+		pin_ptr<T> pinnedSource = &source[sourceIndex];
+		memcpy( m_Pointer + static_cast<size_t>( index ) * sizeof(T), pinnedSource, static_cast<size_t>( count ) * sizeof(T) );
+	}
+
+	generic<typename T>
+	void DataSpan<T>::CopyTo( int index, array<T>^ destination, int destinationIndex, int count )
+	{
+		if( !m_CanRead )
+			throw gcnew NotSupportedException();
+
+		Utilities::CheckArrayBounds( destination, destinationIndex, count );
+		if( index < 0 || index > m_Count - count )
+			throw gcnew ArgumentOutOfRangeException( "index" );
+		if( count == 0 )
+			return;
+
+		pin_ptr<T> pinnedDestination = &destination[destinationIndex];
+		memcpy( pinnedDestination, m_Pointer + static_cast<size_t>( index ) * sizeof(T), static_cast<size_t>( count ) * sizeof(T) );
+	}
+
+	generic<typename T>
+	void DataSpan<T>::Fill( T value )
+	{
+		if( !m_CanWrite )
+			throw gcnew NotSupportedException();
+
+		for( int i = 0; i < m_Count; i++ )
+			memcpy( m_Pointer + static_cast<size_t>( i ) * sizeof(T), &value, sizeof(T) );
+	}
+}
@@ -0,0 +1,116 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+	/// <summary>
+	/// A typed view over a range of a <see cref="SlimDX::DataStream"/>. The range is bounds checked once, when the view
+	/// is created, so elements can then be read and written without per-element position updates.
+	/// </summary>
+	/// <typeparam name="T">The type of the elements in the view.</typeparam>
+	/// <remarks>
+	/// The view does not keep the stream alive; it must not be used after the stream has been disposed.
+	/// </remarks>
+	/// <unmanaged>None</unmanaged>
+	generic<typename T> where T : value class
+	public value class DataSpan
+	{
+	private:
+		char* m_Pointer;
+		int m_Count;
+		bool m_CanRead;
+		bool m_CanWrite;
+
+	internal:
+		DataSpan( char* pointer, int count, bool canRead, bool canWrite );
+
+	public:
+		/// <summary>
+		/// Gets the number of elements in the view.
+		/// </summary>
+		property int Count
+		{
+			int get() { return m_Count; }
+		}
+
+		/// <summary>
+		/// Gets a value indicating whether the elements of the view can be read.
+		/// </summary>
+		property bool CanRead
+		{
+			bool get() { return m_CanRead; }
+		}
+
+		/// <summary>
+		/// Gets a value indicating whether the elements of the view can be written.
+		/// </summary>
+		property bool CanWrite
+		{
+			bool get() { return m_CanWrite; }
+		}
+
+		/// <summary>
+		/// Gets a pointer to the first element of the view.
+		/// </summary>
+		property System::IntPtr DataPointer
+		{
+			System::IntPtr get() { return System::IntPtr( m_Pointer ); }
+		}
+
+		/// <summary>
+		/// Gets or sets the element at the specified index.
+		/// </summary>
+		/// <param name="index">The index of the element.</param>
+		/// <exception cref="System::ArgumentOutOfRangeException"><paramref name="index" /> is outside the view.</exception>
+		/// <exception cref="System::NotSupportedException">The underlying stream does not support the operation.</exception>
+		property T default[int]
+		{
+			T get( int index );
+			void set( int index, T value );
+		}
+
+		/// <summary>
+		/// Copies elements from an array into the view.
+		/// </summary>
+		/// <param name="source">The array to copy from.</param>
+		/// <param name="sourceIndex">The index in <paramref name="source"/> of the first element to copy.</param>
+		/// <param name="index">The index in the view at which to start writing.</param>
+		/// <param name="count">The number of elements to copy.</param>
+		void CopyFrom( array<T>^ source, int sourceIndex, int index, int count );
+
+		/// <summary>
+		/// Copies elements from the view into an array.
+		/// </summary>
+		/// <param name="index">The index in the view of the first element to copy.</param>
+		/// <param name="destination">The array to copy to.</param>
+		/// <param name="destinationIndex">The index in <paramref name="destination"/> at which to start writing.</param>
+		/// <param name="count">The number of elements to copy.</param>
+		void CopyTo( int index, array<T>^ destination, int destinationIndex, int count );
+
+		/// <summary>
+		/// Sets every element of the view to the same value.
+		/// </summary>
+		/// <param name="value">The value to store.</param>
+		void Fill( T value );
+	};
+}
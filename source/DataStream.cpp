@@ -21,6 +21,7 @@
 * THE SOFTWARE.
 */
 #include "DataStream.h"
+#include "StreamingCopy.h"
 #include "Utilities.h"
 #include "InternalHelpers.h"
 
@@ -137,6 +138,122 @@ namespace SlimDX
 		m_CanWrite = canWrite;
 	}
 
+	DataStream::DataStream( void* view, Int64 sizeInBytes, FileAccess access )
+	{
+		m_Buffer = static_cast<char*>( view );
+		m_Size = sizeInBytes;
+		m_IsMapped = true;
+
+		m_CanRead = ( access & FileAccess::Read ) == FileAccess::Read;
+		m_CanWrite = ( access & FileAccess::Write ) == FileAccess::Write;
+	}
+
+	DataStream^ DataStream::FromFile( String^ path, FileAccess access, FileAccessPattern pattern )
+	{
+		if( path == nullptr )
+			throw gcnew ArgumentNullException( "path" );
+		if( access != FileAccess::Read && access != FileAccess::Write && access != FileAccess::ReadWrite )
+			throw gcnew ArgumentOutOfRangeException( "access" );
+
+		bool writable = ( access & FileAccess::Write ) == FileAccess::Write;
+		DWORD flags = FILE_ATTRIBUTE_NORMAL;
+		if( pattern == FileAccessPattern::Sequential )
+			flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+		else if( pattern == FileAccessPattern::RandomAccess )
+			flags |= FILE_FLAG_RANDOM_ACCESS;
+
+		// a writable view needs read access to the file as well, whether or not the stream allows reading
+		pin_ptr<const wchar_t> pinnedPath = PtrToStringChars( path );
+		HANDLE file = CreateFileW( pinnedPath, writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+			FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL );
+		if( file == INVALID_HANDLE_VALUE )
+			throw Marshal::GetExceptionForHR( HRESULT_FROM_WIN32( GetLastError() ) );
+
+		LARGE_INTEGER size;
+		if( !GetFileSizeEx( file, &size ) )
+		{
+			DWORD error = GetLastError();
+			CloseHandle( file );
+			throw Marshal::GetExceptionForHR( HRESULT_FROM_WIN32( error ) );
+		}
+
+		if( size.QuadPart == 0 )
+		{
+			CloseHandle( file );
+			throw gcnew IOException( String::Format( "The file '{0}' is empty and cannot be mapped.", path ) );
+		}
+
+		// the view keeps the mapping, and the mapping keeps the file, open until it is unmapped
+		HANDLE mapping = CreateFileMappingW( file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL );
+		DWORD error = GetLastError();
+		CloseHandle( file );
+		if( mapping == NULL )
+			throw Marshal::GetExceptionForHR( HRESULT_FROM_WIN32( error ) );
+
+		void* view = MapViewOfFile( mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0 );
+		error = GetLastError();
+		CloseHandle( mapping );
+		if( view == NULL )
+			throw Marshal::GetExceptionForHR( HRESULT_FROM_WIN32( error ) );
+
+		return gcnew DataStream( view, size.QuadPart, access );
+	}
+
+	DataStream::DataStream( Int64 initialCapacity, bool canRead )
+	{
+		m_IsGrowable = true;
+		m_CanRead = canRead;
+		m_CanWrite = true;
+
+		Reserve( std::max( initialCapacity, MinimumGrowableCapacity ) );
+	}
+
+	DataStream^ DataStream::CreateGrowable( Int64 initialCapacity, bool canRead )
+	{
+		if( initialCapacity < 0 )
+			throw gcnew ArgumentOutOfRangeException( "initialCapacity" );
+
+		return gcnew DataStream( initialCapacity, canRead );
+	}
+
+	void DataStream::Reserve( Int64 capacity )
+	{
+		// Manual Allocation: released in Destruct
+		char* buffer = static_cast<char*>( _aligned_malloc( static_cast<size_t>( capacity ), GrowableAlignment ) );
+		if( buffer == 0 )
+			throw gcnew OutOfMemoryException();
+
+		if( m_Buffer != 0 )
+		{
+			memcpy( buffer, m_Buffer, static_cast<size_t>( m_Size ) );
+			_aligned_free( m_Buffer );
+			GC::RemoveMemoryPressure( m_Capacity );
+		}
+
+		GC::AddMemoryPressure( capacity );
+		m_Buffer = buffer;
+		m_Capacity = capacity;
+	}
+
+	bool DataStream::Grow( Int64 size )
+	{
+		if( !m_IsGrowable )
+			return false;
+
+		if( size > m_Capacity )
+		{
+			if( m_HasViews )
+				throw gcnew InvalidOperationException( "The stream cannot grow after a pointer or span into its buffer has been taken, since growing moves the buffer." );
+
+			// geometric growth keeps a sequence of appends linear overall
+			Int64 capacity = std::max( size, m_Capacity * 2 );
+			Reserve( ( capacity + GrowableAlignment - 1 ) & ~static_cast<Int64>( GrowableAlignment - 1 ) );
+		}
+
+		m_Size = size;
+		return true;
+	}
+
 	DataStream::~DataStream()
 	{
 		Destruct();
@@ -156,6 +273,19 @@ namespace SlimDX
 			GC::RemoveMemoryPressure( m_Size );
 			m_OwnsBuffer = false;
 		}
+
+		if( m_IsGrowable && m_Buffer != 0 )
+		{
+			_aligned_free( m_Buffer );
+			GC::RemoveMemoryPressure( m_Capacity );
+			m_IsGrowable = false;
+		}
+
+		if( m_IsMapped )
+		{
+			UnmapViewOfFile( m_Buffer );
+			m_IsMapped = false;
+		}
 		
 		if( m_GCHandle.IsAllocated )
 		{
@@ -175,6 +305,14 @@ namespace SlimDX
 		return m_Buffer + m_Position;
 	}
 
+	IntPtr DataStream::DataPointer::get()
+	{
+		if( m_IsGrowable )
+			m_HasViews = true;
+
+		return IntPtr( m_Buffer );
+	}
+
 	Int64 DataStream::RemainingLength::get()
 	{
 		return m_Size - m_Position;
@@ -222,7 +360,7 @@ namespace SlimDX
 			throw gcnew NotSupportedException();
 
 		Int64 elementSize = static_cast<Int64>( sizeof(T) );
-		if( m_Position + elementSize > m_Size )
+		if( m_Position + elementSize > m_Size && !Grow( m_Position + elementSize ) )
 			throw gcnew EndOfStreamException();
 
 		memcpy( m_Buffer + m_Position, &value, static_cast<size_t>( elementSize ) );
@@ -243,7 +381,7 @@ namespace SlimDX
 		Utilities::CheckArrayBounds( data, offset, count );
 
 		Int64 elementSize = static_cast<Int64>( sizeof(T) );
-		if( (m_Position + count * elementSize) > m_Size )
+		if( (m_Position + count * elementSize) > m_Size && !Grow( m_Position + count * elementSize ) )
 			throw gcnew EndOfStreamException();
 
 		pin_ptr<T> pinnedData = &data[offset];
@@ -260,13 +398,63 @@ namespace SlimDX
 			throw gcnew ArgumentNullException( "source" );
 		if( count < 0 )
 			throw gcnew ArgumentOutOfRangeException( "count" );
-		if( m_Position + count > m_Size )
+		if( m_Position + count > m_Size && !Grow( m_Position + count ) )
 			throw gcnew EndOfStreamException();
 
 		memcpy( m_Buffer + m_Position, source.ToPointer(), static_cast<size_t>( count ) );
 		m_Position += count;
 	}
 
+	generic<typename T> where T : value class
+	void DataStream::WriteRangeStreaming( array<T>^ data, int offset, int count )
+	{
+		if( !m_CanWrite )
+			throw gcnew NotSupportedException();
+		
+		Utilities::CheckArrayBounds( data, offset, count );
+
+		Int64 elementSize = static_cast<Int64>( sizeof(T) );
+		if( (m_Position + count * elementSize) > m_Size && !Grow( m_Position + count * elementSize ) )
+			throw gcnew EndOfStreamException();
+
+		pin_ptr<T> pinnedData = &data[offset];
+		StreamingCopy( m_Buffer + m_Position, pinnedData, static_cast<size_t>( elementSize ) * count );
+		m_Position += elementSize * count;
+	}
+
+	void DataStream::WriteRangeStreaming( IntPtr source, Int64 count )
+	{
+		if( !m_CanWrite )
+			throw gcnew NotSupportedException();
+		
+		if( source == IntPtr::Zero )
+			throw gcnew ArgumentNullException( "source" );
+		if( count < 0 )
+			throw gcnew ArgumentOutOfRangeException( "count" );
+		if( m_Position + count > m_Size && !Grow( m_Position + count ) )
+			throw gcnew EndOfStreamException();
+
+		StreamingCopy( m_Buffer + m_Position, source.ToPointer(), static_cast<size_t>( count ) );
+		m_Position += count;
+	}
+
+	generic<typename T> where T : value class
+	DataSpan<T> DataStream::AsSpan( int count )
+	{
+		if( count < 0 )
+			throw gcnew ArgumentOutOfRangeException( "count" );
+
+		Int64 elementSize = static_cast<Int64>( sizeof(T) );
+		if( m_Position + count * elementSize > m_Size && !Grow( m_Position + count * elementSize ) )
+			throw gcnew EndOfStreamException();
+
+		DataSpan<T> result( m_Buffer + m_Position, count, m_CanRead, m_CanWrite );
+		m_Position += count * elementSize;
+		if( m_IsGrowable )
+			m_HasViews = true;
+		return result;
+	}
+
 	void DataStream::Fill(Byte value)
 	{
 		if( !m_CanWrite )
@@ -335,13 +523,33 @@ namespace SlimDX
 	
 	void DataStream::Flush()
 	{
+		if( m_IsMapped && m_CanWrite )
+		{
+			if( !FlushViewOfFile( m_Buffer, 0 ) )
+				throw Marshal::GetExceptionForHR( HRESULT_FROM_WIN32( GetLastError() ) );
+			return;
+		}
+
+		// the contents of a growable stream already live in its buffer
+		if( m_IsGrowable )
+			return;
+
 		throw gcnew NotSupportedException("DataStream objects cannot be flushed.");
 	}
 
 	void DataStream::SetLength( Int64 value )
 	{
-		SLIMDX_UNREFERENCED_PARAMETER(value);
-		throw gcnew NotSupportedException("DataStream objects cannot be resized.");
+		if( !m_IsGrowable )
+			throw gcnew NotSupportedException("Only growable DataStream objects can be resized.");
+		if( value < 0 )
+			throw gcnew ArgumentOutOfRangeException( "value" );
+
+		Int64 oldSize = m_Size;
+		Grow( value );
+		if( value > oldSize )
+			memset( m_Buffer + oldSize, 0, static_cast<size_t>( value - oldSize ) );
+		if( m_Position > value )
+			m_Position = value;
 	}
 
 	Int64 DataStream::Position::get()
@@ -358,4 +566,9 @@ namespace SlimDX
 	{
 		return m_Size;
 	}
+
+	Int64 DataStream::Capacity::get()
+	{
+		return m_IsGrowable ? m_Capacity : m_Size;
+	}
 }
@@ -21,6 +21,9 @@
 */
 #pragma once
 
+#include "DataSpan.h"
+#include "Enums.h"
+
 #ifdef XMLDOCS
 using System::InvalidOperationException;
 using System::ArgumentException;
@@ -41,15 +44,28 @@ namespace SlimDX
 	private:
 		char* m_Buffer;
 		bool m_OwnsBuffer;
+		bool m_IsMapped;
+		bool m_IsGrowable;
+		bool m_HasViews;
 		
 		System::Int64 m_Size;
 		System::Int64 m_Position;
+		System::Int64 m_Capacity;
 		
 		initonly bool m_CanRead;
 		initonly bool m_CanWrite;
 
 		System::Runtime::InteropServices::GCHandle m_GCHandle;
 
+		DataStream( void* view, System::Int64 sizeInBytes, System::IO::FileAccess access );
+		DataStream( System::Int64 initialCapacity, bool canRead );
+
+		literal int GrowableAlignment = 64;
+		literal System::Int64 MinimumGrowableCapacity = 256;
+
+		void Reserve( System::Int64 capacity );
+		bool Grow( System::Int64 size );
+
 	internal:
 		DataStream( void* buffer, System::Int64 sizeInBytes, bool canRead, bool canWrite, bool makeCopy );
 		DataStream( const void *buffer, System::Int64 sizeInBytes, bool canRead, bool makeCopy );
@@ -59,6 +75,7 @@ namespace SlimDX
 			char* get();
 		}
 
+		// Valid until the next write that grows a growable stream; hold it only for the duration of a call.
 		property char* PositionPointer
 		{
 			char* get();
@@ -101,6 +118,55 @@ namespace SlimDX
 		/// <param name="canWrite"><c>true</c> if writing to the buffer should be allowed; otherwise, <c>false</c>.</param>
 		DataStream( System::Array^ userBuffer, bool canRead, bool canWrite );
 		
+		/// <summary>
+		/// Creates a stream backed by a read-only memory-mapped view of a file.
+		/// </summary>
+		/// <param name="path">The path of the file to map.</param>
+		/// <returns>A stream over the contents of the file. Disposing the stream unmaps the file.</returns>
+		/// <exception cref="ArgumentNullException"><paramref name="path" /> is a null reference.</exception>
+		/// <exception cref="System::IO::IOException">The file could not be opened or mapped, or is empty.</exception>
+		static DataStream^ FromFile( System::String^ path ) { return FromFile( path, System::IO::FileAccess::Read, FileAccessPattern::Normal ); }
+
+		/// <summary>
+		/// Creates a stream backed by a memory-mapped view of a file.
+		/// </summary>
+		/// <param name="path">The path of the file to map.</param>
+		/// <param name="access">The access to the file. Writes through a writable stream go directly to the file.</param>
+		/// <returns>A stream over the contents of the file. Disposing the stream unmaps the file.</returns>
+		/// <exception cref="ArgumentNullException"><paramref name="path" /> is a null reference.</exception>
+		/// <exception cref="System::IO::IOException">The file could not be opened or mapped, or is empty.</exception>
+		static DataStream^ FromFile( System::String^ path, System::IO::FileAccess access ) { return FromFile( path, access, FileAccessPattern::Normal ); }
+
+		/// <summary>
+		/// Creates a stream backed by a memory-mapped view of a file.
+		/// </summary>
+		/// <remarks>
+		/// The file is opened with read sharing, so read-only mappings of the same file from several streams or processes share
+		/// their physical pages. The stream holds no copy of the data; pages are brought in on first access.
+		/// </remarks>
+		/// <param name="path">The path of the file to map.</param>
+		/// <param name="access">The access to the file. Writes through a writable stream go directly to the file.</param>
+		/// <param name="pattern">A hint describing how the contents will be accessed.</param>
+		/// <returns>A stream over the contents of the file. Disposing the stream unmaps the file.</returns>
+		/// <exception cref="ArgumentNullException"><paramref name="path" /> is a null reference.</exception>
+		/// <exception cref="System::IO::IOException">The file could not be opened or mapped, or is empty.</exception>
+		static DataStream^ FromFile( System::String^ path, System::IO::FileAccess access, FileAccessPattern pattern );
+
+		/// <summary>
+		/// Creates an empty stream that grows as data is written past its end, like a <see cref="System::IO::MemoryStream"/>
+		/// whose buffer lives in aligned unmanaged memory and can be handed to the device without a copy.
+		/// </summary>
+		/// <remarks>
+		/// The capacity at least doubles whenever it is exceeded. Growing moves the buffer, so once <see cref="DataPointer"/> or
+		/// <see cref="AsSpan"/> has been used the stream stops growing, and a write past its capacity throws
+		/// <see cref="System::InvalidOperationException"/>. Pass an initial capacity large enough for the data if views are needed.
+		/// </remarks>
+		/// <param name="initialCapacity">The number of bytes to allocate up front.</param>
+		/// <param name="canRead"><c>true</c> if reading from the buffer should be allowed; otherwise, <c>false</c>.</param>
+		/// <returns>A writable stream with a length of zero.</returns>
+		/// <exception cref="ArgumentOutOfRangeException"><paramref name="initialCapacity" /> is negative.</exception>
+		static DataStream^ CreateGrowable( System::Int64 initialCapacity, bool canRead );
+
 		/// <summary>
 		/// Releases all resources used by the <see cref="DataStream"/>.
 		/// </summary>
@@ -177,6 +243,57 @@ namespace SlimDX
 		/// <exception cref="ArgumentOutOfRangeException"><paramref name="count" /> is negative.</exception>
 		void WriteRange( System::IntPtr source, System::Int64 count );
 
+		/// <summary>
+		/// Writes an array of values to the current stream with non-temporal stores, and advances the current position
+		/// within this stream by the number of bytes written.
+		/// </summary>
+		/// <remarks>
+		/// Non-temporal stores bypass the processor caches. They are much faster than <see cref="WriteRange"/> when the
+		/// stream wraps write-combined memory, such as a dynamic buffer mapped with <c>WriteDiscard</c>, but slower for
+		/// ordinary memory that is read back soon afterwards.
+		/// </remarks>
+		/// <typeparam name="T">The type of the values to be written to the stream.</typeparam>
+		/// <param name="data">An array of values to be written to the stream.</param>
+		/// <param name="offset">The zero-based offset in data at which to begin copying values to the current stream.</param>
+		/// <param name="count">The number of values to be written to the current stream. If this is zero,
+		/// all of the contents <paramref name="data" /> will be written.</param>
+		/// <exception cref="NotSupportedException">This stream does not support writing.</exception>
+		/// <exception cref="ArgumentNullException"><paramref name="data" /> is a null reference.</exception>
+		/// <exception cref="ArgumentOutOfRangeException"><paramref name="offset" /> or <paramref name="count" /> is negative.</exception>
+		/// <exception cref="ArgumentException">The sum of <paramref name="offset" /> and <paramref name="count" /> is greater than the buffer length.</exception>
+		/// <exception cref="EndOfStreamException">There is not enough space remaining in the stream.</exception>
+		generic<typename T> where T : value class
+		void WriteRangeStreaming( array<T>^ data, int offset, int count );
+
+		/// <summary>
+		/// Writes a range of bytes to the current stream with non-temporal stores, and advances the current position
+		/// within this stream by the number of bytes written.
+		/// </summary>
+		/// <param name="source">A pointer to the location to start copying from.</param>
+		/// <param name="count">The number of bytes to copy from source to the current stream.</param>
+		/// <exception cref="NotSupportedException">This stream does not support writing.</exception>
+		/// <exception cref="ArgumentNullException"><paramref name="source" /> is a zero pointer.</exception>
+		/// <exception cref="ArgumentOutOfRangeException"><paramref name="count" /> is negative.</exception>
+		/// <exception cref="EndOfStreamException">There is not enough space remaining in the stream.</exception>
+		void WriteRangeStreaming( System::IntPtr source, System::Int64 count );
+
+		/// <summary>
+		/// Returns a typed view of the next elements of the stream, and advances the current position past them.
+		/// </summary>
+		/// <remarks>
+		/// The bounds are checked once for the whole range, so filling a view is cheaper than a <see cref="Write"/> call per element.
+		/// Consecutive calls return consecutive ranges of the stream.
+		/// </remarks>
+		/// <typeparam name="T">The type of the elements in the view.</typeparam>
+		/// <param name="count">The number of elements in the view.</param>
+		/// <returns>A view of the elements, with the read and write access of the stream.</returns>
+		/// <remarks>A growable stream stops growing once a view has been taken, since growing would move the memory under the view.</remarks>
+		/// <exception cref="ArgumentOutOfRangeException"><paramref name="count" /> is negative.</exception>
+		/// <exception cref="EndOfStreamException">There are fewer than <paramref name="count" /> elements remaining in the stream.</exception>
+		/// <exception cref="InvalidOperationException">The stream would have to grow after a view or pointer into it was taken.</exception>
+		generic<typename T> where T : value class
+		DataSpan<T> AsSpan( int count );
+
 		void Fill(System::Byte value);
 
 		/// <summary>
@@ -234,16 +351,18 @@ namespace SlimDX
 		array<T>^ ReadRange( int count );
 
 		/// <summary>
-		/// Not supported.
+		/// Writes modified pages of a writable memory-mapped stream back to its file. Does nothing for a growable stream.
+		/// Not supported by other streams.
 		/// </summary>
-		/// <exception cref="NotSupportedException">Always thrown.</exception>
+		/// <exception cref="NotSupportedException">The stream is neither a writable view of a file nor growable.</exception>
 		virtual void Flush() override;
 
 		/// <summary>
-		/// Not supported.
+		/// Sets the length of a growable stream. New bytes are zeroed, and the position is moved back if it lies past the new end.
 		/// </summary>
-		/// <param name="value">Always ignored.</param>
-		/// <exception cref="NotSupportedException">Always thrown.</exception>
+		/// <param name="value">The new length, in bytes.</param>
+		/// <exception cref="NotSupportedException">The stream is not growable.</exception>
+		/// <exception cref="ArgumentOutOfRangeException"><paramref name="value" /> is negative.</exception>
 		virtual void SetLength( System::Int64 value ) override;
 
 		/// <summary>Gets a value indicating whether the current stream supports reading.</summary>
@@ -274,6 +393,13 @@ namespace SlimDX
 			virtual System::Int64 get() override;
 		}
 
+		/// <summary>Gets the number of bytes the stream can hold before it has to grow.</summary>
+		/// <value>The capacity of a growable stream; otherwise, the length of the stream.</value>
+		property System::Int64 Capacity
+		{
+			System::Int64 get();
+		}
+
 		/// <summary>Gets or sets the position within the current stream.</summary>
 		/// <value>The current position within the stream.</value>
 		/// <seealso cref="Stream">Stream Class</seealso>
@@ -285,9 +411,10 @@ namespace SlimDX
 
 		/// <summary>Gets the internal pointer to the current stream's backing store.</summary>
 		/// <value>An IntPtr to the buffer being used as a backing store.</value>
+		/// <remarks>A growable stream stops growing once its pointer has been taken.</remarks>
 		property System::IntPtr DataPointer
 		{
-			System::IntPtr get() { return System::IntPtr( m_Buffer ); }
+			System::IntPtr get();
 		}
 	};
 }
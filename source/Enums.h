@@ -27,6 +27,27 @@ namespace SlimDX
 	//       adding new enumerations or renaming existing ones, please make sure
 	//       the ordering is maintained.
 	
+	/// <summary>
+	/// Describes how the contents of a memory-mapped file are expected to be accessed, allowing the system to tune read-ahead and caching.
+	/// </summary>
+	public enum class FileAccessPattern : System::Int32
+	{
+		/// <summary>
+		/// No particular access pattern is expected.
+		/// </summary>
+		Normal = 0,
+
+		/// <summary>
+		/// The file is mostly read from beginning to end.
+		/// </summary>
+		Sequential = 1,
+
+		/// <summary>
+		/// The file is accessed at scattered offsets.
+		/// </summary>
+		RandomAccess = 2,
+	};
+
 	/// <summary>
 	/// Specifies possible performance profiling options.
 	/// </summary>
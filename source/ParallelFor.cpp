@@ -0,0 +1,62 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "ParallelFor.h"
+
+using namespace System;
+using namespace System::Threading::Tasks;
+
+namespace SlimDX
+{
+	ref class ParallelForThunk
+	{
+	private:
+		ParallelForBody m_Body;
+		void* m_Context;
+
+	public:
+		ParallelForThunk( ParallelForBody body, void* context )
+		: m_Body( body ), m_Context( context )
+		{
+		}
+
+		void Invoke( int index )
+		{
+			m_Body( m_Context, index );
+		}
+	};
+
+	void ParallelFor( int count, int minimumParallelCount, ParallelForBody body, void* context )
+	{
+		if( count < minimumParallelCount || Environment::ProcessorCount == 1 )
+		{
+			for( int index = 0; index < count; ++index )
+				body( context, index );
+
+			return;
+		}
+
+		ParallelForThunk^ thunk = gcnew ParallelForThunk( body, context );
+		Parallel::For( 0, count, gcnew Action<int>( thunk, &ParallelForThunk::Invoke ) );
+	}
+}
@@ -0,0 +1,356 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "RingDataStream.h"
+#include "Utilities.h"
+#include "InternalHelpers.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Threading;
+
+namespace SlimDX
+{
+	RingDataStream::RingDataStream( Int64 capacity )
+	{
+		if( capacity < 1 )
+			throw gcnew ArgumentOutOfRangeException( "capacity" );
+
+		// Manual Allocation: released in Destruct
+		m_Buffer = static_cast<char*>( _aligned_malloc( static_cast<size_t>( capacity ), 64 ) );
+		if( m_Buffer == 0 )
+			throw gcnew OutOfMemoryException();
+
+		GC::AddMemoryPressure( capacity );
+		m_Capacity = capacity;
+		m_Lock = gcnew Object();
+	}
+
+	RingDataStream::~RingDataStream()
+	{
+		Destruct();
+		GC::SuppressFinalize( this );
+	}
+
+	RingDataStream::!RingDataStream()
+	{
+		Destruct();
+	}
+
+	void RingDataStream::Destruct()
+	{
+		// the constructor may have thrown before the lock was created, and then there is nothing to free
+		if( m_Lock == nullptr )
+			return;
+
+		Monitor::Enter( m_Lock );
+		m_Disposed = true;
+		if( m_CopiesInFlight == 0 )
+			FreeBuffer();
+
+		Monitor::PulseAll( m_Lock );
+		Monitor::Exit( m_Lock );
+	}
+
+	void RingDataStream::FreeBuffer()
+	{
+		if( m_Buffer != 0 )
+		{
+			_aligned_free( m_Buffer );
+			GC::RemoveMemoryPressure( m_Capacity );
+			m_Buffer = 0;
+		}
+	}
+
+	void RingDataStream::CheckDisposed()
+	{
+		if( m_Disposed )
+			throw gcnew ObjectDisposedException( "RingDataStream" );
+	}
+
+	// Called under the lock once a copy that was started under it has finished.
+	void RingDataStream::EndCopy()
+	{
+		if( --m_CopiesInFlight == 0 && m_Disposed )
+			FreeBuffer();
+	}
+
+	void RingDataStream::CopyIn( Int64 total, const char* source, Int64 count )
+	{
+		Int64 start = total % m_Capacity;
+		Int64 first = std::min( count, m_Capacity - start );
+		memcpy( m_Buffer + start, source, static_cast<size_t>( first ) );
+		memcpy( m_Buffer, source + first, static_cast<size_t>( count - first ) );
+	}
+
+	void RingDataStream::CopyOut( Int64 total, char* destination, Int64 count )
+	{
+		Int64 start = total % m_Capacity;
+		Int64 first = std::min( count, m_Capacity - start );
+		memcpy( destination, m_Buffer + start, static_cast<size_t>( first ) );
+		memcpy( destination + first, m_Buffer, static_cast<size_t>( count - first ) );
+	}
+
+	// Only the writer advances m_WriteTotal and only the reader advances m_ReadTotal, so each side can copy
+	// outside the lock: the region it works on cannot be touched by the other side until the cursor is published.
+	void RingDataStream::WriteCore( const char* source, Int64 count )
+	{
+		while( count > 0 )
+		{
+			Int64 total;
+			Int64 chunk;
+
+			Monitor::Enter( m_Lock );
+			try
+			{
+				CheckDisposed();
+				if( m_WritingCompleted )
+					throw gcnew InvalidOperationException( "Writing has been completed." );
+
+				while( !m_Disposed && m_WriteTotal - m_ReadTotal == m_Capacity )
+					Monitor::Wait( m_Lock );
+
+				CheckDisposed();
+				total = m_WriteTotal;
+				chunk = std::min( count, m_Capacity - ( m_WriteTotal - m_ReadTotal ) );
+				m_CopiesInFlight++;
+			}
+			finally
+			{
+				Monitor::Exit( m_Lock );
+			}
+
+			CopyIn( total, source, chunk );
+			source += chunk;
+			count -= chunk;
+
+			Monitor::Enter( m_Lock );
+			m_WriteTotal += chunk;
+			EndCopy();
+			Monitor::PulseAll( m_Lock );
+			Monitor::Exit( m_Lock );
+		}
+	}
+
+	Int64 RingDataStream::ReadCore( char* destination, Int64 count, bool wait )
+	{
+		if( count == 0 )
+			return 0;
+
+		Int64 total;
+		Int64 chunk;
+
+		Monitor::Enter( m_Lock );
+		try
+		{
+			while( wait && !m_Disposed && m_WriteTotal == m_ReadTotal && !m_WritingCompleted )
+				Monitor::Wait( m_Lock );
+
+			CheckDisposed();
+			total = m_ReadTotal;
+			chunk = std::min( count, m_WriteTotal - m_ReadTotal );
+			if( chunk > 0 )
+				m_CopiesInFlight++;
+		}
+		finally
+		{
+			Monitor::Exit( m_Lock );
+		}
+
+		if( chunk == 0 )
+			return 0;
+
+		CopyOut( total, destination, chunk );
+
+		Monitor::Enter( m_Lock );
+		m_ReadTotal += chunk;
+		EndCopy();
+		Monitor::PulseAll( m_Lock );
+		Monitor::Exit( m_Lock );
+		return chunk;
+	}
+
+	void RingDataStream::CompleteWriting()
+	{
+		CheckDisposed();
+
+		Monitor::Enter( m_Lock );
+		m_WritingCompleted = true;
+		Monitor::PulseAll( m_Lock );
+		Monitor::Exit( m_Lock );
+	}
+
+	void RingDataStream::Write( array<Byte>^ buffer, int offset, int count )
+	{
+		CheckDisposed();
+		Utilities::CheckArrayBounds( buffer, offset, count );
+		if( count == 0 )
+			return;
+
+		pin_ptr<Byte> pinnedBuffer = &buffer[offset];
+		WriteCore( reinterpret_cast<const char*>( pinnedBuffer ), count );
+	}
+
+	void RingDataStream::WriteRange( IntPtr source, Int64 count )
+	{
+		CheckDisposed();
+		if( source == IntPtr::Zero )
+			throw gcnew ArgumentNullException( "source" );
+		if( count < 0 )
+			throw gcnew ArgumentOutOfRangeException( "count" );
+
+		WriteCore( static_cast<const char*>( source.ToPointer() ), count );
+	}
+
+	bool RingDataStream::TryWrite( IntPtr source, Int64 count )
+	{
+		CheckDisposed();
+		if( source == IntPtr::Zero )
+			throw gcnew ArgumentNullException( "source" );
+		if( count < 0 )
+			throw gcnew ArgumentOutOfRangeException( "count" );
+
+		Int64 total;
+
+		Monitor::Enter( m_Lock );
+		try
+		{
+			CheckDisposed();
+			if( m_WritingCompleted )
+				throw gcnew InvalidOperationException( "Writing has been completed." );
+			if( m_Capacity - ( m_WriteTotal - m_ReadTotal ) < count )
+				return false;
+
+			total = m_WriteTotal;
+			m_CopiesInFlight++;
+		}
+		finally
+		{
+			Monitor::Exit( m_Lock );
+		}
+
+		CopyIn( total, static_cast<const char*>( source.ToPointer() ), count );
+
+		Monitor::Enter( m_Lock );
+		m_WriteTotal += count;
+		EndCopy();
+		Monitor::PulseAll( m_Lock );
+		Monitor::Exit( m_Lock );
+		return true;
+	}
+
+	int RingDataStream::Read( array<Byte>^ buffer, int offset, int count )
+	{
+		CheckDisposed();
+		Utilities::CheckArrayBounds( buffer, offset, count );
+		if( count == 0 )
+			return 0;
+
+		pin_ptr<Byte> pinnedBuffer = &buffer[offset];
+		return static_cast<int>( ReadCore( reinterpret_cast<char*>( pinnedBuffer ), count, true ) );
+	}
+
+	Int64 RingDataStream::ReadRange( IntPtr destination, Int64 count )
+	{
+		CheckDisposed();
+		if( destination == IntPtr::Zero )
+			throw gcnew ArgumentNullException( "destination" );
+		if( count < 0 )
+			throw gcnew ArgumentOutOfRangeException( "count" );
+
+		return ReadCore( static_cast<char*>( destination.ToPointer() ), count, true );
+	}
+
+	Int64 RingDataStream::TryRead( IntPtr destination, Int64 count )
+	{
+		CheckDisposed();
+		if( destination == IntPtr::Zero )
+			throw gcnew ArgumentNullException( "destination" );
+		if( count < 0 )
+			throw gcnew ArgumentOutOfRangeException( "count" );
+
+		return ReadCore( static_cast<char*>( destination.ToPointer() ), count, false );
+	}
+
+	void RingDataStream::Flush()
+	{
+	}
+
+	Int64 RingDataStream::Seek( Int64 offset, SeekOrigin origin )
+	{
+		SLIMDX_UNREFERENCED_PARAMETER(offset);
+		SLIMDX_UNREFERENCED_PARAMETER(origin);
+		throw gcnew NotSupportedException("RingDataStream objects cannot seek.");
+	}
+
+	void RingDataStream::SetLength( Int64 value )
+	{
+		SLIMDX_UNREFERENCED_PARAMETER(value);
+		throw gcnew NotSupportedException("RingDataStream objects cannot be resized.");
+	}
+
+	Int64 RingDataStream::Length::get()
+	{
+		throw gcnew NotSupportedException("RingDataStream objects have no length.");
+	}
+
+	Int64 RingDataStream::Position::get()
+	{
+		throw gcnew NotSupportedException("RingDataStream objects have no position.");
+	}
+
+	void RingDataStream::Position::set( Int64 value )
+	{
+		SLIMDX_UNREFERENCED_PARAMETER(value);
+		throw gcnew NotSupportedException("RingDataStream objects have no position.");
+	}
+
+	Int64 RingDataStream::ReadAvailable::get()
+	{
+		CheckDisposed();
+
+		Monitor::Enter( m_Lock );
+		Int64 result = m_WriteTotal - m_ReadTotal;
+		Monitor::Exit( m_Lock );
+		return result;
+	}
+
+	Int64 RingDataStream::WriteAvailable::get()
+	{
+		CheckDisposed();
+
+		Monitor::Enter( m_Lock );
+		Int64 result = m_Capacity - ( m_WriteTotal - m_ReadTotal );
+		Monitor::Exit( m_Lock );
+		return result;
+	}
+
+	bool RingDataStream::IsWritingCompleted::get()
+	{
+		CheckDisposed();
+
+		Monitor::Enter( m_Lock );
+		bool result = m_WritingCompleted;
+		Monitor::Exit( m_Lock );
+		return result;
+	}
+}
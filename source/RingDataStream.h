@@ -0,0 +1,214 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+	/// <summary>
+	/// A fixed-size circular buffer in unmanaged memory with separate read and write cursors, used to stream data from one
+	/// producer thread to one consumer thread, such as from a loader thread to the render thread.
+	/// </summary>
+	/// <remarks>
+	/// Exactly one thread may write and one thread may read at a time. Blocking writes wait for the reader to free space,
+	/// and blocking reads wait for the writer to provide data until <see cref="CompleteWriting"/> is called, after which
+	/// reads drain the remaining data and then return zero. The stream cannot seek.
+	/// </remarks>
+	/// <unmanaged>None</unmanaged>
+	public ref class RingDataStream : public System::IO::Stream
+	{
+	private:
+		char* m_Buffer;
+		System::Int64 m_Capacity;
+
+		// running totals; the cursors are these modulo the capacity
+		System::Int64 m_ReadTotal;
+		System::Int64 m_WriteTotal;
+		bool m_WritingCompleted;
+
+		// the buffer is freed by whichever of Dispose and the last copy in flight comes second
+		bool m_Disposed;
+		int m_CopiesInFlight;
+
+		System::Object^ m_Lock;
+
+		void CopyIn( System::Int64 total, const char* source, System::Int64 count );
+		void CopyOut( System::Int64 total, char* destination, System::Int64 count );
+		void CheckDisposed();
+		void EndCopy();
+		void FreeBuffer();
+		void WriteCore( const char* source, System::Int64 count );
+		System::Int64 ReadCore( char* destination, System::Int64 count, bool wait );
+		void Destruct();
+
+	public:
+		/// <summary>
+		/// Initializes a new instance of the <see cref="RingDataStream"/> class.
+		/// </summary>
+		/// <param name="capacity">The size of the buffer, in bytes.</param>
+		/// <exception cref="System::ArgumentOutOfRangeException"><paramref name="capacity" /> is less than 1.</exception>
+		RingDataStream( System::Int64 capacity );
+
+		/// <summary>
+		/// Releases all resources used by the <see cref="RingDataStream"/>. Blocked reads and writes throw
+		/// <see cref="System::ObjectDisposedException"/>; a copy already in progress finishes before the buffer is freed.
+		/// </summary>
+		~RingDataStream();
+
+		/// <summary>
+		/// Releases unmanaged resources and performs other cleanup operations before the <see cref="RingDataStream"/> is reclaimed by garbage collection.
+		/// </summary>
+		!RingDataStream();
+
+		/// <summary>
+		/// Signals that no more data will be written. Blocked and later reads return whatever data remains, and then zero.
+		/// </summary>
+		void CompleteWriting();
+
+		/// <summary>
+		/// Writes bytes to the stream, waiting for the reader to free space as needed.
+		/// </summary>
+		/// <param name="buffer">The array to copy from.</param>
+		/// <param name="offset">The zero-based byte offset in buffer at which to begin copying bytes.</param>
+		/// <param name="count">The number of bytes to write.</param>
+		/// <exception cref="System::InvalidOperationException"><see cref="CompleteWriting"/> has been called.</exception>
+		virtual void Write( array<System::Byte>^ buffer, int offset, int count ) override;
+
+		/// <summary>
+		/// Writes bytes from unmanaged memory to the stream, waiting for the reader to free space as needed.
+		/// </summary>
+		/// <param name="source">A pointer to the bytes to write.</param>
+		/// <param name="count">The number of bytes to write.</param>
+		/// <exception cref="System::InvalidOperationException"><see cref="CompleteWriting"/> has been called.</exception>
+		void WriteRange( System::IntPtr source, System::Int64 count );
+
+		/// <summary>
+		/// Writes bytes from unmanaged memory to the stream if all of them fit, without waiting.
+		/// </summary>
+		/// <param name="source">A pointer to the bytes to write.</param>
+		/// <param name="count">The number of bytes to write.</param>
+		/// <returns><c>true</c> if the bytes were written; <c>false</c> if there was not enough free space.</returns>
+		/// <exception cref="System::InvalidOperationException"><see cref="CompleteWriting"/> has been called.</exception>
+		bool TryWrite( System::IntPtr source, System::Int64 count );
+
+		/// <summary>
+		/// Reads bytes from the stream, waiting until at least one byte is available or writing has completed.
+		/// </summary>
+		/// <param name="buffer">The array to copy to.</param>
+		/// <param name="offset">The zero-based byte offset in buffer at which to begin storing bytes.</param>
+		/// <param name="count">The maximum number of bytes to read.</param>
+		/// <returns>The number of bytes read, which is zero only once writing has completed and the stream is empty.</returns>
+		virtual int Read( array<System::Byte>^ buffer, int offset, int count ) override;
+
+		/// <summary>
+		/// Reads bytes from the stream into unmanaged memory, waiting until at least one byte is available or writing has completed.
+		/// </summary>
+		/// <param name="destination">A pointer to the memory to copy to.</param>
+		/// <param name="count">The maximum number of bytes to read.</param>
+		/// <returns>The number of bytes read, which is zero only once writing has completed and the stream is empty.</returns>
+		System::Int64 ReadRange( System::IntPtr destination, System::Int64 count );
+
+		/// <summary>
+		/// Reads the bytes that are currently available into unmanaged memory, without waiting.
+		/// </summary>
+		/// <param name="destination">A pointer to the memory to copy to.</param>
+		/// <param name="count">The maximum number of bytes to read.</param>
+		/// <returns>The number of bytes read.</returns>
+		System::Int64 TryRead( System::IntPtr destination, System::Int64 count );
+
+		/// <summary>
+		/// Does nothing; written data is immediately visible to the reader.
+		/// </summary>
+		virtual void Flush() override;
+
+		/// <summary>
+		/// Not supported.
+		/// </summary>
+		/// <exception cref="System::NotSupportedException">Always thrown.</exception>
+		virtual System::Int64 Seek( System::Int64 offset, System::IO::SeekOrigin origin ) override;
+
+		/// <summary>
+		/// Not supported.
+		/// </summary>
+		/// <exception cref="System::NotSupportedException">Always thrown.</exception>
+		virtual void SetLength( System::Int64 value ) override;
+
+		/// <summary>Gets a value indicating whether the current stream supports reading.</summary>
+		/// <value><c>true</c> until the stream is disposed.</value>
+		property bool CanRead
+		{
+			virtual bool get() override { return !m_Disposed; }
+		}
+
+		/// <summary>Gets a value indicating whether the current stream supports seeking.</summary>
+		/// <value>Always <c>false</c>.</value>
+		property bool CanSeek
+		{
+			virtual bool get() override { return false; }
+		}
+
+		/// <summary>Gets a value indicating whether the current stream supports writing.</summary>
+		/// <value><c>true</c> until the stream is disposed.</value>
+		property bool CanWrite
+		{
+			virtual bool get() override { return !m_Disposed; }
+		}
+
+		/// <summary>Not supported.</summary>
+		/// <exception cref="System::NotSupportedException">Always thrown.</exception>
+		property System::Int64 Length
+		{
+			virtual System::Int64 get() override;
+		}
+
+		/// <summary>Not supported.</summary>
+		/// <exception cref="System::NotSupportedException">Always thrown.</exception>
+		property System::Int64 Position
+		{
+			virtual System::Int64 get() override;
+			virtual void set( System::Int64 ) override;
+		}
+
+		/// <summary>Gets the size of the buffer, in bytes.</summary>
+		property System::Int64 Capacity
+		{
+			System::Int64 get() { return m_Capacity; }
+		}
+
+		/// <summary>Gets the number of bytes waiting to be read.</summary>
+		property System::Int64 ReadAvailable
+		{
+			System::Int64 get();
+		}
+
+		/// <summary>Gets the number of bytes that can be written without waiting.</summary>
+		property System::Int64 WriteAvailable
+		{
+			System::Int64 get();
+		}
+
+		/// <summary>Gets a value indicating whether <see cref="CompleteWriting"/> has been called.</summary>
+		property bool IsWritingCompleted
+		{
+			bool get();
+		}
+	};
+}
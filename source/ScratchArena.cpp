@@ -0,0 +1,240 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma managed(push, off)
+
+#include "ScratchArena.h"
+
+namespace SlimDX
+{
+	namespace
+	{
+		const size_t Alignment = 16;
+		const size_t InitialBlockSize = 64 * 1024;
+
+		// anything bigger is not scratch and would pin that much memory to the thread for its lifetime
+		const size_t MaximumArenaAllocation = 1024 * 1024;
+
+		// _malloca serves requests up to this size from the stack
+		const size_t MallocaStackLimit = 1024;
+
+		struct ScratchBlock
+		{
+			ScratchBlock* Previous;
+			size_t Size;
+			size_t Used;
+		};
+
+		struct Arena
+		{
+			ScratchBlock* Current;
+			size_t LiveCount;
+		};
+
+		const size_t HeaderSize = ( sizeof(ScratchBlock) + Alignment - 1 ) & ~( Alignment - 1 );
+
+		volatile LONG64 s_ArenaBytes;
+		volatile LONG64 s_LargeArenaBytes;
+		volatile LONG64 s_HeapBytes;
+
+		volatile LONG s_FlsIndex = FLS_OUT_OF_INDEXES;
+
+		char* BlockData( ScratchBlock* block )
+		{
+			return reinterpret_cast<char*>( block ) + HeaderSize;
+		}
+
+		ScratchBlock* CreateBlock( size_t size, ScratchBlock* previous )
+		{
+			ScratchBlock* block = static_cast<ScratchBlock*>( _aligned_malloc( HeaderSize + size, Alignment ) );
+			if( block == NULL )
+				return NULL;
+
+			block->Previous = previous;
+			block->Size = size;
+			block->Used = 0;
+			InterlockedExchangeAdd64( &s_HeapBytes, static_cast<LONG64>( size ) );
+			return block;
+		}
+
+		void FreeBlocks( ScratchBlock* block )
+		{
+			while( block != NULL )
+			{
+				ScratchBlock* previous = block->Previous;
+				_aligned_free( block );
+				block = previous;
+			}
+		}
+
+		void WINAPI DestroyArena( void* data )
+		{
+			Arena* arena = static_cast<Arena*>( data );
+			if( arena == NULL )
+				return;
+
+			FreeBlocks( arena->Current );
+			delete arena;
+		}
+
+		DWORD GetFlsIndex()
+		{
+			DWORD index = static_cast<DWORD>( s_FlsIndex );
+			if( index != FLS_OUT_OF_INDEXES )
+				return index;
+
+			// the fiber local storage callback releases a thread's arena when the thread exits
+			DWORD created = FlsAlloc( DestroyArena );
+			DWORD existing = static_cast<DWORD>( InterlockedCompareExchange( &s_FlsIndex, static_cast<LONG>( created ), static_cast<LONG>( FLS_OUT_OF_INDEXES ) ) );
+			if( existing != FLS_OUT_OF_INDEXES )
+			{
+				FlsFree( created );
+				return existing;
+			}
+
+			return created;
+		}
+
+		Arena* GetArena( bool create )
+		{
+			DWORD index = GetFlsIndex();
+			if( index == FLS_OUT_OF_INDEXES )
+				return NULL;
+
+			Arena* arena = static_cast<Arena*>( FlsGetValue( index ) );
+			if( arena == NULL && create )
+			{
+				arena = new (std::nothrow) Arena();
+				if( arena != NULL )
+				{
+					arena->Current = NULL;
+					arena->LiveCount = 0;
+					FlsSetValue( index, arena );
+				}
+			}
+
+			return arena;
+		}
+
+		size_t RoundUp( size_t size )
+		{
+			return ( size + Alignment - 1 ) & ~( Alignment - 1 );
+		}
+
+		void* HeapAllocate( size_t size )
+		{
+			void* memory = _aligned_malloc( size, Alignment );
+			if( memory != NULL )
+				InterlockedExchangeAdd64( &s_HeapBytes, static_cast<LONG64>( size ) );
+
+			return memory;
+		}
+	}
+
+	void* ScratchAllocate( size_t size )
+	{
+		size_t rounded = RoundUp( std::max( size, static_cast<size_t>( 1 ) ) );
+		if( rounded > MaximumArenaAllocation )
+			return HeapAllocate( rounded );
+
+		Arena* arena = GetArena( true );
+		if( arena == NULL )
+			return HeapAllocate( rounded );
+
+		ScratchBlock* block = arena->Current;
+		if( block == NULL || block->Size - block->Used < rounded )
+		{
+			size_t blockSize = std::max( block == NULL ? InitialBlockSize : block->Size * 2, rounded );
+			ScratchBlock* created = CreateBlock( blockSize, block );
+			if( created == NULL )
+				return HeapAllocate( rounded );
+
+			arena->Current = block = created;
+		}
+
+		void* result = BlockData( block ) + block->Used;
+		block->Used += rounded;
+		arena->LiveCount++;
+
+		InterlockedExchangeAdd64( &s_ArenaBytes, static_cast<LONG64>( rounded ) );
+		if( size > MallocaStackLimit )
+			InterlockedExchangeAdd64( &s_LargeArenaBytes, static_cast<LONG64>( rounded ) );
+
+		return result;
+	}
+
+	void ScratchFree( void* memory, size_t size )
+	{
+		if( memory == NULL )
+			return;
+
+		size_t rounded = RoundUp( std::max( size, static_cast<size_t>( 1 ) ) );
+		Arena* arena = rounded > MaximumArenaAllocation ? NULL : GetArena( false );
+
+		// requests that were sent to the heap never came from the arena
+		ScratchBlock* block = arena == NULL ? NULL : arena->Current;
+		bool fromArena = false;
+		for( ScratchBlock* search = block; search != NULL; search = search->Previous )
+		{
+			char* data = BlockData( search );
+			if( memory >= data && memory < data + search->Size )
+			{
+				fromArena = true;
+				break;
+			}
+		}
+
+		if( !fromArena )
+		{
+			_aligned_free( memory );
+			return;
+		}
+
+		// pop the allocation if it is on top; otherwise its space comes back when the arena empties
+		if( static_cast<char*>( memory ) + rounded == BlockData( block ) + block->Used )
+			block->Used -= rounded;
+
+		if( --arena->LiveCount == 0 )
+		{
+			// keep only the newest, largest block so that the arena settles into a single block of its working size
+			FreeBlocks( block->Previous );
+			block->Previous = NULL;
+			block->Used = 0;
+		}
+	}
+
+	void GetScratchCounters( ScratchCounters& counters )
+	{
+		counters.ArenaBytes = s_ArenaBytes;
+		counters.LargeArenaBytes = s_LargeArenaBytes;
+		counters.HeapBytes = s_HeapBytes;
+	}
+
+	void ResetScratchCounters()
+	{
+		InterlockedExchange64( &s_ArenaBytes, 0 );
+		InterlockedExchange64( &s_LargeArenaBytes, 0 );
+		InterlockedExchange64( &s_HeapBytes, 0 );
+	}
+}
+
+#pragma managed(pop)
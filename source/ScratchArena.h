@@ -0,0 +1,43 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+	// Per-thread bump allocator for short-lived marshalling buffers. Allocations are popped when freed in reverse order,
+	// and each thread's arena rewinds completely whenever its last live allocation is freed, so a wrapper call that
+	// frees everything it took costs no heap traffic once the arena has grown to its working size.
+	// Memory must be freed on the thread that allocated it, with the size it was allocated with. Returns NULL if the
+	// request had to go to the heap and the heap allocation failed.
+	void* ScratchAllocate( size_t size );
+	void ScratchFree( void* memory, size_t size );
+
+	struct ScratchCounters
+	{
+		int64_t ArenaBytes;			// bytes served from arenas
+		int64_t LargeArenaBytes;	// arena bytes from requests over 1 KB, which _malloca would have sent to the heap
+		int64_t HeapBytes;			// bytes that still went to the heap, for oversized requests and arena growth
+	};
+
+	void GetScratchCounters( ScratchCounters& counters );
+	void ResetScratchCounters();
+}
@@ -0,0 +1,68 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+	/// <summary>
+	/// Reports how the temporary buffers SlimDX uses to marshal arguments were allocated.
+	/// </summary>
+	/// <remarks>
+	/// Marshalling buffers come from a per-thread scratch arena. The counters are totals across all threads since the last
+	/// call to <see cref="ResetCounters"/>; reset them once per frame to obtain per-frame figures.
+	/// </remarks>
+	public ref class ScratchMemory sealed
+	{
+	private:
+		ScratchMemory();
+
+	public:
+		/// <summary>
+		/// Gets the number of bytes served from scratch arenas.
+		/// </summary>
+		static property System::Int64 ArenaBytes
+		{
+			System::Int64 get();
+		}
+
+		/// <summary>
+		/// Gets the number of arena bytes for buffers larger than 1 KB. This is part of <see cref="ArenaBytes"/>.
+		/// </summary>
+		static property System::Int64 LargeArenaBytes
+		{
+			System::Int64 get();
+		}
+
+		/// <summary>
+		/// Gets the number of bytes that still had to be allocated on the heap, for arena growth and for buffers too large to keep in an arena.
+		/// </summary>
+		static property System::Int64 HeapBytes
+		{
+			System::Int64 get();
+		}
+
+		/// <summary>
+		/// Sets all counters back to zero.
+		/// </summary>
+		static void ResetCounters();
+	};
+}
@@ -0,0 +1,182 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "DataStream.h"
+#include "StreamContents.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Runtime::InteropServices;
+
+namespace SlimDX
+{
+	StreamContents::StreamContents( Stream^ stream )
+	{
+		if( stream == nullptr )
+			throw gcnew ArgumentNullException( "stream" );
+		if( !stream->CanRead )
+			throw gcnew NotSupportedException();
+
+		DataStream^ dataStream = dynamic_cast<DataStream^>( stream );
+		if( dataStream != nullptr )
+		{
+			m_Size = dataStream->RemainingLength;
+			m_Data = dataStream->SeekToEnd();
+			GC::SuppressFinalize( this );
+			return;
+		}
+
+		MemoryStream^ memoryStream = dynamic_cast<MemoryStream^>( stream );
+		ArraySegment<Byte> segment;
+		if( memoryStream != nullptr && memoryStream->TryGetBuffer( segment ) )
+		{
+			// the segment starts at the stream's origin; positions are relative to it
+			Int64 position = std::min( memoryStream->Position, memoryStream->Length );
+			m_Handle = GCHandle::Alloc( segment.Array, GCHandleType::Pinned );
+			m_Data = static_cast<char*>( m_Handle.AddrOfPinnedObject().ToPointer() ) + segment.Offset + position;
+			m_Size = memoryStream->Length - position;
+			memoryStream->Position = memoryStream->Length;
+			return;
+		}
+
+		FileStream^ fileStream = dynamic_cast<FileStream^>( stream );
+		if( fileStream != nullptr && MapFile( fileStream ) )
+			return;
+
+		ReadChunks( stream );
+	}
+
+	StreamContents::~StreamContents()
+	{
+		Destruct();
+		GC::SuppressFinalize( this );
+	}
+
+	StreamContents::!StreamContents()
+	{
+		Destruct();
+	}
+
+	void StreamContents::Destruct()
+	{
+		if( m_Buffer != 0 )
+		{
+			_aligned_free( m_Buffer );
+			GC::RemoveMemoryPressure( m_Capacity );
+			m_Buffer = 0;
+		}
+
+		if( m_View != 0 )
+		{
+			UnmapViewOfFile( m_View );
+			m_View = 0;
+		}
+
+		if( m_Handle.IsAllocated )
+			m_Handle.Free();
+
+		m_Data = 0;
+	}
+
+	bool StreamContents::MapFile( FileStream^ stream )
+	{
+		// buffered writes have to reach the file before it is mapped
+		if( stream->CanWrite )
+			stream->Flush();
+
+		Int64 position = stream->Position;
+		Int64 length = stream->Length;
+		if( position >= length )
+			return false;
+
+		// views have to start on an allocation granularity boundary
+		SYSTEM_INFO info;
+		GetSystemInfo( &info );
+		Int64 viewStart = position - position % info.dwAllocationGranularity;
+		if( static_cast<UInt64>( length - viewStart ) > static_cast<UInt64>( SIZE_MAX ) )
+			return false;
+
+		HANDLE file = stream->SafeFileHandle->DangerousGetHandle().ToPointer();
+		HANDLE mapping = CreateFileMappingW( file, NULL, PAGE_READONLY, 0, 0, NULL );
+		if( mapping == NULL )
+			return false;
+
+		void* view = MapViewOfFile( mapping, FILE_MAP_READ, static_cast<DWORD>( viewStart >> 32 ),
+			static_cast<DWORD>( viewStart ), static_cast<SIZE_T>( length - viewStart ) );
+		CloseHandle( mapping );
+		GC::KeepAlive( stream );
+		if( view == NULL )
+			return false;
+
+		m_View = view;
+		m_Data = static_cast<char*>( view ) + ( position - viewStart );
+		m_Size = length - position;
+		stream->Position = length;
+		return true;
+	}
+
+	void StreamContents::ReadChunks( Stream^ stream )
+	{
+		// a seekable stream tells us how much to allocate; anything else grows geometrically
+		Int64 capacity = ChunkSize;
+		if( stream->CanSeek )
+			capacity = std::max( stream->Length - stream->Position, static_cast<Int64>( 16 ) );
+
+		// Manual Allocation: released in Destruct
+		m_Buffer = static_cast<char*>( _aligned_malloc( static_cast<size_t>( capacity ), 16 ) );
+		if( m_Buffer == 0 )
+			throw gcnew OutOfMemoryException();
+		m_Capacity = capacity;
+		GC::AddMemoryPressure( m_Capacity );
+
+		array<Byte>^ chunk = gcnew array<Byte>( ChunkSize );
+		pin_ptr<Byte> pinnedChunk = &chunk[0];
+
+		for( ;; )
+		{
+			int bytesRead = stream->Read( chunk, 0, ChunkSize );
+			if( bytesRead == 0 )
+				break;
+
+			if( m_Size + bytesRead > m_Capacity )
+			{
+				Int64 newCapacity = std::max( m_Capacity * 2, m_Size + bytesRead );
+				char* buffer = static_cast<char*>( _aligned_malloc( static_cast<size_t>( newCapacity ), 16 ) );
+				if( buffer == 0 )
+					throw gcnew OutOfMemoryException();
+
+				memcpy( buffer, m_Buffer, static_cast<size_t>( m_Size ) );
+				_aligned_free( m_Buffer );
+				GC::RemoveMemoryPressure( m_Capacity );
+
+				m_Buffer = buffer;
+				m_Capacity = newCapacity;
+				GC::AddMemoryPressure( m_Capacity );
+			}
+
+			memcpy( m_Buffer + m_Size, pinnedChunk, bytesRead );
+			m_Size += bytesRead;
+		}
+
+		m_Data = m_Buffer;
+	}
+}
@@ -0,0 +1,62 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+	// Exposes the remaining contents of a stream to native code as one contiguous block, copying only when the stream
+	// offers no other way in. DataStreams are used in place, MemoryStreams are pinned, FileStreams are memory-mapped,
+	// and anything else is read in chunks into aligned native memory. The stream is advanced past the contents.
+	// The block stays valid until the object is disposed, and for DataStreams, as long as the stream itself.
+	ref class StreamContents sealed
+	{
+	private:
+		char* m_Data;
+		System::Int64 m_Size;
+
+		char* m_Buffer;
+		System::Int64 m_Capacity;
+		void* m_View;
+		System::Runtime::InteropServices::GCHandle m_Handle;
+
+		literal int ChunkSize = 64 * 1024;
+
+		bool MapFile( System::IO::FileStream^ stream );
+		void ReadChunks( System::IO::Stream^ stream );
+		void Destruct();
+
+	public:
+		StreamContents( System::IO::Stream^ stream );
+		~StreamContents();
+		!StreamContents();
+
+		property char* Data
+		{
+			char* get() { return m_Data; }
+		}
+
+		property System::Int64 Size
+		{
+			System::Int64 get() { return m_Size; }
+		}
+	};
+}
@@ -0,0 +1,83 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma managed(push, off)
+
+#include <emmintrin.h>
+
+#include "StreamingCopy.h"
+
+namespace SlimDX
+{
+	namespace
+	{
+		// below this the fence and the alignment prologue cost more than the cache pollution they avoid
+		const size_t MinimumStreamingSize = 256;
+	}
+
+	void StreamingCopy( void* destination, const void* source, size_t size )
+	{
+		char* dst = static_cast<char*>( destination );
+		const char* src = static_cast<const char*>( source );
+
+		if( size < MinimumStreamingSize )
+		{
+			memcpy( dst, src, size );
+			return;
+		}
+
+		// non-temporal stores need an aligned destination; the source is read unaligned
+		size_t head = ( 16 - ( reinterpret_cast<uintptr_t>( dst ) & 15 ) ) & 15;
+		memcpy( dst, src, head );
+		dst += head;
+		src += head;
+		size -= head;
+
+		// whole 64 byte lines fill write-combining buffers completely
+		for( size_t lines = size / 64; lines > 0; lines-- )
+		{
+			__m128i a = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src ) );
+			__m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + 16 ) );
+			__m128i c = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + 32 ) );
+			__m128i d = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + 48 ) );
+			_mm_stream_si128( reinterpret_cast<__m128i*>( dst ), a );
+			_mm_stream_si128( reinterpret_cast<__m128i*>( dst + 16 ), b );
+			_mm_stream_si128( reinterpret_cast<__m128i*>( dst + 32 ), c );
+			_mm_stream_si128( reinterpret_cast<__m128i*>( dst + 48 ), d );
+			dst += 64;
+			src += 64;
+		}
+		size &= 63;
+
+		for( ; size >= 16; size -= 16 )
+		{
+			_mm_stream_si128( reinterpret_cast<__m128i*>( dst ), _mm_loadu_si128( reinterpret_cast<const __m128i*>( src ) ) );
+			dst += 16;
+			src += 16;
+		}
+
+		memcpy( dst, src, size );
+		_mm_sfence();
+	}
+}
+
+#pragma managed(pop)
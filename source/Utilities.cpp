@@ -21,6 +21,8 @@
 * THE SOFTWARE.
 */
 
+#include "dxgi/FormatTable.h"
+
 #include "DataStream.h"
 #include "Utilities.h"
 
@@ -97,161 +99,18 @@ namespace SlimDX
 
 	bool Utilities::IsCompressed(DXGI_FORMAT format)
 	{
-		switch (format)
-		{
-		case DXGI_FORMAT_BC1_TYPELESS:
-		case DXGI_FORMAT_BC1_UNORM:
-		case DXGI_FORMAT_BC1_UNORM_SRGB:
-		case DXGI_FORMAT_BC4_TYPELESS:
-		case DXGI_FORMAT_BC4_UNORM:
-		case DXGI_FORMAT_BC4_SNORM:
-		case DXGI_FORMAT_BC2_TYPELESS:
-		case DXGI_FORMAT_BC2_UNORM:
-		case DXGI_FORMAT_BC2_UNORM_SRGB:
-		case DXGI_FORMAT_BC3_TYPELESS:
-		case DXGI_FORMAT_BC3_UNORM:
-		case DXGI_FORMAT_BC3_UNORM_SRGB:
-		case DXGI_FORMAT_BC5_TYPELESS:
-		case DXGI_FORMAT_BC5_UNORM:
-		case DXGI_FORMAT_BC5_SNORM:
-		case DXGI_FORMAT_BC6H_UF16:
-		case DXGI_FORMAT_BC6H_SF16:
-		case DXGI_FORMAT_BC6H_TYPELESS:
-		case DXGI_FORMAT_BC7_UNORM:
-		case DXGI_FORMAT_BC7_UNORM_SRGB:
-		case DXGI_FORMAT_BC7_TYPELESS:
-			return true;
-		}
-
-		return false;
+		const DXGI::FormatDescriptor* descriptor = DXGI::GetFormatDescriptor( format );
+		return descriptor != NULL && descriptor->BlockSize != 0;
 	}
 
 	int Utilities::SizeOfFormatElement( DXGI_FORMAT format )
 	{
-		switch( format )
-		{
-			case DXGI_FORMAT_R32G32B32A32_TYPELESS:
-			case DXGI_FORMAT_R32G32B32A32_FLOAT:
-			case DXGI_FORMAT_R32G32B32A32_UINT:
-			case DXGI_FORMAT_R32G32B32A32_SINT:
-				return 128;
-				
-			case DXGI_FORMAT_R32G32B32_TYPELESS:
-			case DXGI_FORMAT_R32G32B32_FLOAT:
-			case DXGI_FORMAT_R32G32B32_UINT:
-			case DXGI_FORMAT_R32G32B32_SINT:
-				return 96;
-				
-			case DXGI_FORMAT_R16G16B16A16_TYPELESS:
-			case DXGI_FORMAT_R16G16B16A16_FLOAT:
-			case DXGI_FORMAT_R16G16B16A16_UNORM:
-			case DXGI_FORMAT_R16G16B16A16_UINT:
-			case DXGI_FORMAT_R16G16B16A16_SNORM:
-			case DXGI_FORMAT_R16G16B16A16_SINT:
-			case DXGI_FORMAT_R32G32_TYPELESS:
-			case DXGI_FORMAT_R32G32_FLOAT:
-			case DXGI_FORMAT_R32G32_UINT:
-			case DXGI_FORMAT_R32G32_SINT:
-			case DXGI_FORMAT_R32G8X24_TYPELESS:
-			case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
-			case DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS:
-			case DXGI_FORMAT_X32_TYPELESS_G8X24_UINT:
-				return 64;
-			
-			case DXGI_FORMAT_R10G10B10A2_TYPELESS:
-			case DXGI_FORMAT_R10G10B10A2_UNORM:
-			case DXGI_FORMAT_R10G10B10A2_UINT:
-			case DXGI_FORMAT_R11G11B10_FLOAT:
-			case DXGI_FORMAT_R8G8B8A8_TYPELESS:
-			case DXGI_FORMAT_R8G8B8A8_UNORM:
-			case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
-			case DXGI_FORMAT_R8G8B8A8_UINT:
-			case DXGI_FORMAT_R8G8B8A8_SNORM:
-			case DXGI_FORMAT_R8G8B8A8_SINT:
-			case DXGI_FORMAT_R16G16_TYPELESS:
-			case DXGI_FORMAT_R16G16_FLOAT:
-			case DXGI_FORMAT_R16G16_UNORM:
-			case DXGI_FORMAT_R16G16_UINT:
-			case DXGI_FORMAT_R16G16_SNORM:
-			case DXGI_FORMAT_R16G16_SINT:
-			case DXGI_FORMAT_R32_TYPELESS:
-			case DXGI_FORMAT_D32_FLOAT:
-			case DXGI_FORMAT_R32_FLOAT:
-			case DXGI_FORMAT_R32_UINT:
-			case DXGI_FORMAT_R32_SINT:
-			case DXGI_FORMAT_R24G8_TYPELESS:
-			case DXGI_FORMAT_D24_UNORM_S8_UINT:
-			case DXGI_FORMAT_R24_UNORM_X8_TYPELESS:
-			case DXGI_FORMAT_X24_TYPELESS_G8_UINT:
-			case DXGI_FORMAT_B8G8R8A8_UNORM:
-			case DXGI_FORMAT_B8G8R8X8_UNORM:
-				return 32;
-				
-			case DXGI_FORMAT_R8G8_TYPELESS:
-			case DXGI_FORMAT_R8G8_UNORM:
-			case DXGI_FORMAT_R8G8_UINT:
-			case DXGI_FORMAT_R8G8_SNORM:
-			case DXGI_FORMAT_R8G8_SINT:
-			case DXGI_FORMAT_R16_TYPELESS:
-			case DXGI_FORMAT_R16_FLOAT:
-			case DXGI_FORMAT_D16_UNORM:
-			case DXGI_FORMAT_R16_UNORM:
-			case DXGI_FORMAT_R16_UINT:
-			case DXGI_FORMAT_R16_SNORM:
-			case DXGI_FORMAT_R16_SINT:
-			case DXGI_FORMAT_B5G6R5_UNORM:
-			case DXGI_FORMAT_B5G5R5A1_UNORM:
-				return 16;
-				
-			case DXGI_FORMAT_R8_TYPELESS:
-			case DXGI_FORMAT_R8_UNORM:
-			case DXGI_FORMAT_R8_UINT:
-			case DXGI_FORMAT_R8_SNORM:
-			case DXGI_FORMAT_R8_SINT:
-			case DXGI_FORMAT_A8_UNORM:
-				return 8;
-			
-			// Compressed format; http://msdn2.microsoft.com/en-us/library/bb694531(VS.85).aspx
-		case DXGI_FORMAT_BC2_TYPELESS:
-		case DXGI_FORMAT_BC2_UNORM:
-		case DXGI_FORMAT_BC2_UNORM_SRGB:
-		case DXGI_FORMAT_BC3_TYPELESS:
-		case DXGI_FORMAT_BC3_UNORM:
-		case DXGI_FORMAT_BC3_UNORM_SRGB:
-		case DXGI_FORMAT_BC5_TYPELESS:
-		case DXGI_FORMAT_BC5_UNORM:
-		case DXGI_FORMAT_BC5_SNORM:
-		case DXGI_FORMAT_BC6H_UF16:
-		case DXGI_FORMAT_BC6H_SF16:
-		case DXGI_FORMAT_BC6H_TYPELESS:
-		case DXGI_FORMAT_BC7_UNORM:
-		case DXGI_FORMAT_BC7_UNORM_SRGB:
-		case DXGI_FORMAT_BC7_TYPELESS:
-			return 128;
-
-			// Compressed format; http://msdn2.microsoft.com/en-us/library/bb694531(VS.85).aspx
-			case DXGI_FORMAT_R1_UNORM:
-			case DXGI_FORMAT_BC1_TYPELESS:
-			case DXGI_FORMAT_BC1_UNORM:
-			case DXGI_FORMAT_BC1_UNORM_SRGB:
-			case DXGI_FORMAT_BC4_TYPELESS:
-			case DXGI_FORMAT_BC4_UNORM:
-			case DXGI_FORMAT_BC4_SNORM:
-				return 64;
-			
-			// Compressed format; http://msdn2.microsoft.com/en-us/library/bb694531(VS.85).aspx
-			case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
-				return 32;
-			
-			// These are compressed, but bit-size information is unclear.
-			case DXGI_FORMAT_R8G8_B8G8_UNORM:
-			case DXGI_FORMAT_G8R8_G8B8_UNORM:
-				return 32;
-
-			case DXGI_FORMAT_UNKNOWN:
-			default:
-				throw gcnew InvalidOperationException( "Cannot determine format element size; invalid format specified." );
-		}
+		// block compressed formats report the size of a 4x4 block
+		const DXGI::FormatDescriptor* descriptor = DXGI::GetFormatDescriptor( format );
+		if( descriptor == NULL || descriptor->BitsPerElement == 0 )
+			throw gcnew InvalidOperationException( "Cannot determine format element size; invalid format specified." );
+
+		return descriptor->BitsPerElement;
 	}
 	
 	Drawing::Rectangle Utilities::ConvertRect(RECT rect)
@@ -298,59 +157,36 @@ namespace SlimDX
 			return nullptr;
 		}
 
-		//It turns out this can fail because MemoryStream keeps an exposable parameter, and defaults it to
-		//false, so that most of the time, MemoryStream->GetBuffer() can't be used. We might use reflection
-		//to pull the internal array directly. Until then, MemoryStream can literally GO FUCK ITS OWN INTERFACE.
-		/*//if we're reading an entire memory stream from beginning to end, just return the internal buffer
+		// TryGetBuffer only succeeds for MemoryStreams whose buffer is publicly visible
 		MemoryStream^ ms = dynamic_cast<MemoryStream^>( stream );
-		if( ms != nullptr && stream->Position == 0 && readLength == stream->Length )
+		ArraySegment<Byte> segment;
+		if( ms != nullptr && ms->TryGetBuffer( segment ) )
 		{
-			return ms->GetBuffer();
-		}*/
-
-		array<Byte>^ buffer = gcnew array<Byte>( readLength ); 
-		int bytesRead = 0;
-		while( bytesRead < readLength )
-			bytesRead += stream->Read( buffer, bytesRead, readLength - bytesRead );
+			int start = segment.Offset + static_cast<int>( ms->Position );
+			ms->Position += readLength;
 
-		return buffer;
-	}
-
-	char* Utilities::ReadStream( Stream^ stream, int% readLength, bool% cleanUp )
-	{
-		if( stream == nullptr )
-			throw gcnew ArgumentNullException( "stream" );
-		if( !stream->CanRead )
-			throw gcnew NotSupportedException();
+			// if we're reading the whole of the internal buffer, just return it
+			if( start == 0 && readLength == segment.Array->Length )
+				return segment.Array;
 
-		if( readLength > stream->Length - stream->Position )
-			throw gcnew ArgumentOutOfRangeException( "readLength" );
-		if( readLength == 0 )
-			readLength = static_cast<int>( stream->Length - stream->Position );
-		if( readLength < 0 )
-			throw gcnew ArgumentOutOfRangeException( "readLength" );
-		if( readLength == 0 )
-		{
-			cleanUp = true;
-			return new char[0];
+			array<Byte>^ result = gcnew array<Byte>( readLength );
+			Buffer::BlockCopy( segment.Array, start, result, 0, readLength );
+			return result;
 		}
 
-		// if we're reading a DataStream, don't return anything and send back the casted DataStream
-		DataStream^ ds = dynamic_cast<DataStream^>( stream );
-		if( ds != nullptr )
+		array<Byte>^ buffer = gcnew array<Byte>( readLength ); 
+		int bytesRead = 0;
+		while( bytesRead < readLength )
 		{
-			cleanUp = false;
-			return ds->RawPointer;
+			int count = stream->Read( buffer, bytesRead, readLength - bytesRead );
+			if( count == 0 )
+				throw gcnew EndOfStreamException();
+			bytesRead += count;
 		}
 
-		cleanUp = true;
-		char *result = new char[readLength];
-		for (int i = 0; i < readLength; i++)
-			result[i] = (char)stream->ReadByte();
-
-		return result;
+		return buffer;
 	}
-	
+
 	void Utilities::CheckArrayBounds( Array^ data, int offset, int% count )
 	{
 		if( data == nullptr )
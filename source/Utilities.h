@@ -48,6 +48,7 @@ namespace SlimDX
 		static System::Guid ConvertNativeGuid( const GUID &guid );
 		static GUID ConvertManagedGuid( System::Guid guid );
 		
+		// Returns bits per element, or per 4x4 block for block compressed formats; R1_UNORM is 1.
 		static int SizeOfFormatElement( DXGI_FORMAT format );
 
 		static bool IsCompressed(DXGI_FORMAT format);
@@ -57,7 +58,6 @@ namespace SlimDX
 
 		static System::String^ BlobToString( ID3DBlob *blob );
 
-		static char* ReadStream( System::IO::Stream^ stream, int% readLength, bool% cleanUp );
 		static array<System::Byte>^ ReadStream( System::IO::Stream^ stream, DataStream^* dataStream );
 		static array<System::Byte>^ ReadStream( System::IO::Stream^ stream, int% readLength, DataStream^* dataStream );
 
@@ -21,9 +21,8 @@
 */
 #include "stdafx.h"
 
-#include "../Utilities.h"
-#include "../DataStream.h"
 #include "../SlimDXException.h"
+#include "../StreamContents.h"
 
 #include "IncludeDC.h"
 
@@ -63,25 +62,12 @@ namespace D3DCompiler
 			if( stream == nullptr )
 				return E_FAIL;
 
-			if(stream->GetType() == DataStream::typeid)
-			{
-				// Magic shortcut if we happen to get a DataStream
-				DataStream^ data = safe_cast<DataStream^>( stream );
-				*ppData = data->PositionPointer;
-				*pBytes = static_cast<UINT>( data->Length );
+			// DataStreams and MemoryStreams are used in place and FileStreams are mapped; other streams get copied
+			StreamContents^ contents = gcnew StreamContents( stream );
+			*ppData = contents->Data;
+			*pBytes = static_cast<UINT>( contents->Size );
 
-				m_Frames->Add( IntPtr( const_cast<void*>( *ppData ) ), IncludeFrame( stream, GCHandle() ) );
-			}
-			else
-			{
-				// Read the stream into a byte array and pin it
-				array<Byte>^ data = Utilities::ReadStream( stream, NULL );
-				GCHandle handle = GCHandle::Alloc( data, GCHandleType::Pinned );
-				*ppData = handle.AddrOfPinnedObject().ToPointer();
-				*pBytes = data->Length;
-
-				m_Frames->Add( IntPtr( const_cast<void*>( *ppData ) ), IncludeFrame( stream, handle ) );
-			}
+			m_Frames->Add( IntPtr( const_cast<void*>( *ppData ) ), IncludeFrame( stream, contents ) );
 
 			return S_OK;
 		}
@@ -122,10 +108,10 @@ namespace D3DCompiler
 
 	void IncludeFrame::Close()
 	{
+		if( m_contents != nullptr )
+			delete m_contents;
 		if( m_stream != nullptr )
 			delete m_stream;
-		if( m_handle.IsAllocated )
-			m_handle.Free();
 	}
 }
 }
\ No newline at end of file
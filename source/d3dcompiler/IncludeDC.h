@@ -27,6 +27,8 @@ using System::Runtime::InteropServices::OutAttribute;
 
 namespace SlimDX
 {
+	ref class StreamContents;
+
 	namespace D3DCompiler
 	{
 		/// <summary>
@@ -55,11 +57,11 @@ namespace SlimDX
 		{
 		private:
 			System::IO::Stream^ m_stream;
-			System::Runtime::InteropServices::GCHandle m_handle;
+			StreamContents^ m_contents;
 
 		public:
-			IncludeFrame(System::IO::Stream^ stream, System::Runtime::InteropServices::GCHandle handle)
-				: m_stream(stream), m_handle(handle) 
+			IncludeFrame(System::IO::Stream^ stream, StreamContents^ contents)
+				: m_stream(stream), m_contents(contents) 
 			{
 			}
 
@@ -23,6 +23,7 @@
 
 #include "../CompilationException.h"
 #include "../DataStream.h"
+#include "../StreamContents.h"
 #include "../Utilities.h"
 
 #include "D3DCompilerException.h"
@@ -69,14 +70,9 @@ namespace D3DCompiler
 	{
 		Stream^ stream = assembly->GetManifestResourceStream(resourceName);
 
-		int size = 0;
-		bool cleanup = true;
-		std::unique_ptr<char> dataPtr;
-		char *data = Utilities::ReadStream(stream, size, cleanup);
-		if (cleanup)
-			dataPtr.reset(data);
+		StreamContents data(stream);
 
-		return gcnew ShaderBytecode((BYTE*)data, (UINT)size);
+		return gcnew ShaderBytecode((BYTE*)data.Data, (UINT)data.Size);
 	}
 
 	ShaderBytecode^ ShaderBytecode::Compile( String^ shaderSource, String^ profile )
@@ -0,0 +1,100 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "AtlasEntry.h"
+
+using namespace System;
+using namespace System::Drawing;
+using namespace System::Globalization;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	AtlasEntry::AtlasEntry( int id, int arraySlice, Rectangle bounds, RectangleF textureCoordinates )
+	: m_Id( id ), m_ArraySlice( arraySlice ), m_Bounds( bounds ), m_TextureCoordinates( textureCoordinates )
+	{
+	}
+
+	int AtlasEntry::Id::get()
+	{
+		return m_Id;
+	}
+
+	int AtlasEntry::ArraySlice::get()
+	{
+		return m_ArraySlice;
+	}
+
+	Rectangle AtlasEntry::Bounds::get()
+	{
+		return m_Bounds;
+	}
+
+	RectangleF AtlasEntry::TextureCoordinates::get()
+	{
+		return m_TextureCoordinates;
+	}
+
+	String^ AtlasEntry::ToString()
+	{
+		return String::Format( CultureInfo::CurrentCulture, "Id:{0} ArraySlice:{1} Bounds:{2}", m_Id, m_ArraySlice, m_Bounds );
+	}
+
+	bool AtlasEntry::operator == ( AtlasEntry left, AtlasEntry right )
+	{
+		return AtlasEntry::Equals( left, right );
+	}
+
+	bool AtlasEntry::operator != ( AtlasEntry left, AtlasEntry right )
+	{
+		return !AtlasEntry::Equals( left, right );
+	}
+
+	int AtlasEntry::GetHashCode()
+	{
+		return m_Id.GetHashCode() + m_ArraySlice.GetHashCode() + m_Bounds.GetHashCode();
+	}
+
+	bool AtlasEntry::Equals( Object^ value )
+	{
+		if( value == nullptr )
+			return false;
+
+		if( value->GetType() != GetType() )
+			return false;
+
+		return Equals( safe_cast<AtlasEntry>( value ) );
+	}
+
+	bool AtlasEntry::Equals( AtlasEntry value )
+	{
+		return ( m_Id == value.m_Id && m_ArraySlice == value.m_ArraySlice && m_Bounds == value.m_Bounds );
+	}
+
+	bool AtlasEntry::Equals( AtlasEntry% value1, AtlasEntry% value2 )
+	{
+		return ( value1.m_Id == value2.m_Id && value1.m_ArraySlice == value2.m_ArraySlice && value1.m_Bounds == value2.m_Bounds );
+	}
+}
+}
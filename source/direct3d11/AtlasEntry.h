@@ -0,0 +1,127 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+	namespace Direct3D11
+	{
+		/// <summary>
+		/// Identifies an image stored in a <see cref="TextureAtlas"/>.
+		/// </summary>
+		/// <unmanaged>None</unmanaged>
+		public value class AtlasEntry : System::IEquatable<AtlasEntry>
+		{
+			int m_Id;
+			int m_ArraySlice;
+			System::Drawing::Rectangle m_Bounds;
+			System::Drawing::RectangleF m_TextureCoordinates;
+
+		internal:
+			AtlasEntry( int id, int arraySlice, System::Drawing::Rectangle bounds, System::Drawing::RectangleF textureCoordinates );
+
+		public:
+			/// <summary>
+			/// Gets the identifier the atlas assigned to the entry. Identifiers are not reused while the atlas is alive.
+			/// </summary>
+			property int Id
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the array slice (page) of the atlas texture that holds the image.
+			/// </summary>
+			property int ArraySlice
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the texels the image occupies within its page, excluding padding.
+			/// </summary>
+			property System::Drawing::Rectangle Bounds
+			{
+				System::Drawing::Rectangle get();
+			}
+
+			/// <summary>
+			/// Gets the normalized texture coordinates of the image within its page.
+			/// </summary>
+			property System::Drawing::RectangleF TextureCoordinates
+			{
+				System::Drawing::RectangleF get();
+			}
+
+			/// <summary>
+			/// Converts the value of the object to its equivalent string representation.
+			/// </summary>
+			/// <returns>The string representation of the value of this instance.</returns>
+			virtual System::String^ ToString() override;
+
+			/// <summary>
+			/// Tests for equality between two objects.
+			/// </summary>
+			/// <param name="left">The first value to compare.</param>
+			/// <param name="right">The second value to compare.</param>
+			/// <returns><c>true</c> if <paramref name="left"/> has the same value as <paramref name="right"/>; otherwise, <c>false</c>.</returns>
+			static bool operator == ( AtlasEntry left, AtlasEntry right );
+
+			/// <summary>
+			/// Tests for inequality between two objects.
+			/// </summary>
+			/// <param name="left">The first value to compare.</param>
+			/// <param name="right">The second value to compare.</param>
+			/// <returns><c>true</c> if <paramref name="left"/> has a different value than <paramref name="right"/>; otherwise, <c>false</c>.</returns>
+			static bool operator != ( AtlasEntry left, AtlasEntry right );
+
+			/// <summary>
+			/// Returns the hash code for this instance.
+			/// </summary>
+			/// <returns>A 32-bit signed integer hash code.</returns>
+			virtual int GetHashCode() override;
+
+			/// <summary>
+			/// Returns a value that indicates whether the current instance is equal to a specified object. 
+			/// </summary>
+			/// <param name="obj">Object to make the comparison with.</param>
+			/// <returns><c>true</c> if the current instance is equal to the specified object; <c>false</c> otherwise.</returns>
+			virtual bool Equals( System::Object^ obj ) override;
+
+			/// <summary>
+			/// Returns a value that indicates whether the current instance is equal to the specified object. 
+			/// </summary>
+			/// <param name="other">Object to make the comparison with.</param>
+			/// <returns><c>true</c> if the current instance is equal to the specified object; <c>false</c> otherwise.</returns>
+			virtual bool Equals( AtlasEntry other );
+
+			/// <summary>
+			/// Determines whether the specified object instances are considered equal. 
+			/// </summary>
+			/// <param name="value1">The first value to compare.</param>
+			/// <param name="value2">The second value to compare.</param>
+			/// <returns><c>true</c> if <paramref name="value1"/> is the same instance as <paramref name="value2"/> or 
+			/// if both are <c>null</c> references or if <c>value1.Equals(value2)</c> returns <c>true</c>; otherwise, <c>false</c>.</returns>
+			static bool Equals( AtlasEntry% value1, AtlasEntry% value2 );
+		};
+	}
+}
@@ -0,0 +1,181 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#pragma managed(push, off)
+
+#include <climits>
+
+#include "AtlasPacker.h"
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+namespace
+{
+	inline bool Contains( const AtlasRect& outer, const AtlasRect& inner )
+	{
+		return inner.X >= outer.X && inner.Y >= outer.Y &&
+			inner.X + inner.Width <= outer.X + outer.Width && inner.Y + inner.Height <= outer.Y + outer.Height;
+	}
+
+	inline bool Intersects( const AtlasRect& a, const AtlasRect& b )
+	{
+		return a.X < b.X + b.Width && b.X < a.X + a.Width && a.Y < b.Y + b.Height && b.Y < a.Y + a.Height;
+	}
+
+	inline AtlasRect MakeRect( int x, int y, int width, int height )
+	{
+		AtlasRect rect = { x, y, width, height };
+		return rect;
+	}
+}
+
+	AtlasPacker::AtlasPacker( int width, int height )
+	: m_Width( width ), m_Height( height ), m_UsedArea( 0 )
+	{
+		Reset();
+	}
+
+	void AtlasPacker::Reset()
+	{
+		m_Free.clear();
+		m_Free.push_back( MakeRect( 0, 0, m_Width, m_Height ) );
+		m_Used.clear();
+		m_UsedArea = 0;
+	}
+
+	bool AtlasPacker::Insert( int width, int height, AtlasRect& result )
+	{
+		int bestShort = INT_MAX;
+		int bestLong = INT_MAX;
+		size_t best = m_Free.size();
+
+		for( size_t index = 0; index < m_Free.size(); index++ )
+		{
+			const AtlasRect& free = m_Free[index];
+			if( free.Width < width || free.Height < height )
+				continue;
+
+			const int leftoverX = free.Width - width;
+			const int leftoverY = free.Height - height;
+			const int shortSide = std::min( leftoverX, leftoverY );
+			const int longSide = std::max( leftoverX, leftoverY );
+			if( shortSide < bestShort || ( shortSide == bestShort && longSide < bestLong ) )
+			{
+				bestShort = shortSide;
+				bestLong = longSide;
+				best = index;
+			}
+		}
+
+		if( best == m_Free.size() )
+			return false;
+
+		result = MakeRect( m_Free[best].X, m_Free[best].Y, width, height );
+		SplitFreeRects( result );
+		PruneFreeRects();
+
+		m_Used.push_back( result );
+		m_UsedArea += static_cast<int64_t>( width ) * height;
+		return true;
+	}
+
+	void AtlasPacker::Release( const AtlasRect& rect )
+	{
+		size_t index = 0;
+		while( index < m_Used.size() && !( m_Used[index].X == rect.X && m_Used[index].Y == rect.Y &&
+			m_Used[index].Width == rect.Width && m_Used[index].Height == rect.Height ) )
+			index++;
+
+		if( index == m_Used.size() )
+			return;
+
+		m_Used[index] = m_Used.back();
+		m_Used.pop_back();
+		m_UsedArea -= static_cast<int64_t>( rect.Width ) * rect.Height;
+
+		// Merging the released rectangle into its neighbours only works when they share a whole edge, and repeated
+		// add and remove would fragment the page. Splitting the empty page by every rectangle still in use yields
+		// exactly the maximal free rectangles instead.
+		m_Free.clear();
+		m_Free.push_back( MakeRect( 0, 0, m_Width, m_Height ) );
+		for( size_t used = 0; used < m_Used.size(); used++ )
+		{
+			SplitFreeRects( m_Used[used] );
+			PruneFreeRects();
+		}
+	}
+
+	// Replaces every free rectangle the new allocation overlaps with the up to four maximal rectangles left around it.
+	void AtlasPacker::SplitFreeRects( const AtlasRect& used )
+	{
+		const size_t count = m_Free.size();
+		for( size_t index = 0; index < count; index++ )
+		{
+			const AtlasRect free = m_Free[index];
+			if( !Intersects( free, used ) )
+				continue;
+
+			if( used.X > free.X )
+				m_Free.push_back( MakeRect( free.X, free.Y, used.X - free.X, free.Height ) );
+			if( used.X + used.Width < free.X + free.Width )
+				m_Free.push_back( MakeRect( used.X + used.Width, free.Y, free.X + free.Width - used.X - used.Width, free.Height ) );
+			if( used.Y > free.Y )
+				m_Free.push_back( MakeRect( free.X, free.Y, free.Width, used.Y - free.Y ) );
+			if( used.Y + used.Height < free.Y + free.Height )
+				m_Free.push_back( MakeRect( free.X, used.Y + used.Height, free.Width, free.Y + free.Height - used.Y - used.Height ) );
+
+			// mark for removal by PruneFreeRects
+			m_Free[index].Width = 0;
+		}
+	}
+
+	// Drops empty free rectangles and any that lie entirely inside another.
+	void AtlasPacker::PruneFreeRects()
+	{
+		for( size_t i = 0; i < m_Free.size(); )
+		{
+			bool redundant = m_Free[i].Width == 0 || m_Free[i].Height == 0;
+			for( size_t j = 0; j < m_Free.size() && !redundant; j++ )
+			{
+				if( j != i && m_Free[j].Width != 0 && Contains( m_Free[j], m_Free[i] ) &&
+					( !Contains( m_Free[i], m_Free[j] ) || j < i ) )
+					redundant = true;
+			}
+
+			if( redundant )
+			{
+				m_Free[i] = m_Free.back();
+				m_Free.pop_back();
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+}
+}
+
+#pragma managed(pop)
@@ -0,0 +1,68 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include <vector>
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	struct AtlasRect
+	{
+		int X;
+		int Y;
+		int Width;
+		int Height;
+	};
+
+	// Packs rectangles into one atlas page with the MaxRects algorithm (best short side fit). Unlike a skyline,
+	// the free list can take space back, so entries can be released and the space reused in any order. The free
+	// list always holds exactly the maximal free rectangles, so released neighbours coalesce whatever their shape.
+	class AtlasPacker
+	{
+	public:
+		AtlasPacker( int width, int height );
+
+		// Places a rectangle of the given size, returning false if the page has no room for it.
+		bool Insert( int width, int height, AtlasRect& result );
+
+		// Returns a rectangle previously handed out by Insert to the free list. The free list is rebuilt from the
+		// rectangles still in use, so a release costs time proportional to their number times the free list size.
+		void Release( const AtlasRect& rect );
+
+		void Reset();
+
+		int64_t GetUsedArea() const { return m_UsedArea; }
+
+	private:
+		void SplitFreeRects( const AtlasRect& used );
+		void PruneFreeRects();
+
+		std::vector<AtlasRect> m_Free;
+		std::vector<AtlasRect> m_Used;
+		int m_Width;
+		int m_Height;
+		int64_t m_UsedArea;
+	};
+}
+}
@@ -0,0 +1,132 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	// Native BC1-BC7 block routines used by BlockCompression. They are compiled as unmanaged code
+	// so that they can use SSE2 intrinsics; the managed side only validates arguments and schedules rows.
+	namespace BlockCodec
+	{
+		// Returns the size of a single 4x4 block in bytes, or 0 if the format is not block compressed.
+		size_t GetBlockSize( DXGI_FORMAT format );
+
+		// Returns the uncompressed format a block compressed format decodes into, or DXGI_FORMAT_UNKNOWN.
+		// BC1-BC3 and BC7 decode to R8G8B8A8, BC4 to R8, BC5 to R8G8 and BC6H to R16G16B16A16_FLOAT.
+		DXGI_FORMAT GetDecompressedFormat( DXGI_FORMAT format );
+
+		// Returns the size of one pixel of GetDecompressedFormat( format ), in bytes.
+		size_t GetDecompressedPixelSize( DXGI_FORMAT format );
+
+		struct DecodeJob
+		{
+			DXGI_FORMAT Format;
+			size_t Width;
+			size_t Height;
+			const uint8_t* Source;
+			size_t SourcePitch;
+			uint8_t* Destination;
+			size_t DestinationPitch;
+		};
+
+		// Decodes one row of blocks (four rows of pixels) of the job. Matches ParallelForBody.
+		void DecodeBlockRow( void* job, int blockRow );
+
+		enum EncodeQuality
+		{
+			FastQuality = 0,
+			NormalQuality = 1,
+			HighQuality = 2
+		};
+
+		struct EncodeJob
+		{
+			DXGI_FORMAT Format;
+			EncodeQuality Quality;
+			size_t Width;
+			size_t Height;
+			const uint8_t* Source;
+			size_t SourcePitch;
+			uint8_t* Destination;
+			size_t DestinationPitch;
+		};
+
+		// Returns true if EncodeBlockRow can produce the format.
+		bool CanEncode( DXGI_FORMAT format );
+
+		// Encodes one row of blocks of the job from R8G8B8A8 source pixels. BC4 takes the red channel and
+		// BC5 the red and green channels. Partial blocks at the edges replicate the last row and column.
+		// The output depends only on the source pixels and the quality, never on scheduling. Matches ParallelForBody.
+		void EncodeBlockRow( void* job, int blockRow );
+
+		struct BC7Mode
+		{
+			uint8_t Subsets;
+			uint8_t PartitionBits;
+			uint8_t RotationBits;
+			uint8_t IndexSelectionBits;
+			uint8_t ColorBits;
+			uint8_t AlphaBits;
+			uint8_t EndpointPBits;
+			uint8_t SharedPBits;
+			uint8_t IndexBits;
+			uint8_t SecondaryIndexBits;
+		};
+
+		// BC6H/BC7 partition, anchor, interpolation weight and mode tables, defined in BlockDecoder.cpp.
+		extern const uint8_t Partitions2[64][16];
+		extern const uint8_t Partitions3[64][16];
+		extern const uint8_t Anchors2[64];
+		extern const uint8_t Anchors3[2][64];
+		extern const uint16_t Weights2[4];
+		extern const uint16_t Weights3[8];
+		extern const uint16_t Weights4[16];
+		extern const BC7Mode BC7Modes[8];
+
+		// Interpolates count palette entries between two packed R8G8B8A8 endpoints, as (e0 * (64 - w) + e1 * w + 32) >> 6.
+		// The encoder builds its candidate palettes with this too, so both sides agree bit for bit.
+		void BuildPalette( uint32_t endpoint0, uint32_t endpoint1, const uint16_t* weights, size_t count, uint32_t* palette );
+
+		// Expands a BC7 endpoint component of the given precision (including its p-bit) to eight bits.
+		inline uint8_t Unquantize( uint32_t value, size_t precision )
+		{
+			value <<= 8 - precision;
+			return static_cast<uint8_t>( value | ( value >> precision ) );
+		}
+
+		// Expands an R5G6B5 colour to opaque R8G8B8A8.
+		inline uint32_t Expand565( uint16_t color )
+		{
+			uint32_t r = ( color >> 11 ) & 0x1f;
+			uint32_t g = ( color >> 5 ) & 0x3f;
+			uint32_t b = color & 0x1f;
+
+			r = ( r << 3 ) | ( r >> 2 );
+			g = ( g << 2 ) | ( g >> 4 );
+			b = ( b << 3 ) | ( b >> 2 );
+			return r | ( g << 8 ) | ( b << 16 ) | 0xff000000;
+		}
+	}
+}
+}
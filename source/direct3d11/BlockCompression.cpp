@@ -0,0 +1,232 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "../DataBox.h"
+#include "../DataRectangle.h"
+#include "../DataStream.h"
+#include "../ParallelFor.h"
+
+#include "BlockCodec.h"
+#include "BlockCompression.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	DXGI::Format BlockCompression::GetDecompressedFormat( DXGI::Format format )
+	{
+		DXGI_FORMAT result = BlockCodec::GetDecompressedFormat( static_cast<DXGI_FORMAT>( format ) );
+		if( result == DXGI_FORMAT_UNKNOWN )
+			throw gcnew ArgumentException( "The format is not a block compressed format.", "format" );
+
+		return static_cast<DXGI::Format>( result );
+	}
+
+	void BlockCompression::Decompress( DXGI::Format format, int width, int height, DataStream^ source, int sourcePitch, DataStream^ destination, int destinationPitch )
+	{
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+		if( destination == nullptr )
+			throw gcnew ArgumentNullException( "destination" );
+
+		DXGI_FORMAT nativeFormat = static_cast<DXGI_FORMAT>( format );
+		size_t blockSize = BlockCodec::GetBlockSize( nativeFormat );
+		if( blockSize == 0 )
+			throw gcnew ArgumentException( "The format is not a block compressed format.", "format" );
+		if( width < 1 )
+			throw gcnew ArgumentOutOfRangeException( "width" );
+		if( height < 1 )
+			throw gcnew ArgumentOutOfRangeException( "height" );
+
+		Int64 blocksWide = ( static_cast<Int64>( width ) + 3 ) / 4;
+		Int64 blocksHigh = ( static_cast<Int64>( height ) + 3 ) / 4;
+		Int64 blockRowSize = blocksWide * static_cast<Int64>( blockSize );
+		if( sourcePitch < blockRowSize )
+			throw gcnew ArgumentException( "The source pitch is smaller than one row of blocks.", "source" );
+		if( ( blocksHigh - 1 ) * sourcePitch + blockRowSize > source->RemainingLength )
+			throw gcnew ArgumentException( "The source does not contain enough data for a surface of the given size.", "source" );
+
+		Int64 rowSize = width * static_cast<Int64>( BlockCodec::GetDecompressedPixelSize( nativeFormat ) );
+		if( destinationPitch < rowSize )
+			throw gcnew ArgumentException( "The destination pitch is smaller than one row of pixels.", "destination" );
+		if( ( height - 1 ) * static_cast<Int64>( destinationPitch ) + rowSize > destination->RemainingLength )
+			throw gcnew ArgumentException( "The destination is too small for a surface of the given size.", "destination" );
+
+		BlockCodec::DecodeJob job;
+		job.Format = nativeFormat;
+		job.Width = width;
+		job.Height = height;
+		job.Source = reinterpret_cast<const uint8_t*>( source->PositionPointer );
+		job.SourcePitch = sourcePitch;
+		job.Destination = reinterpret_cast<uint8_t*>( destination->PositionPointer );
+		job.DestinationPitch = destinationPitch;
+
+		// below a few dozen block rows the work is cheaper than waking the thread pool
+		ParallelFor( static_cast<int>( blocksHigh ), 16, &BlockCodec::DecodeBlockRow, &job );
+	}
+
+	void BlockCompression::Decompress( DXGI::Format format, int width, int height, DataRectangle^ source, DataRectangle^ destination )
+	{
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+		if( destination == nullptr )
+			throw gcnew ArgumentNullException( "destination" );
+
+		Decompress( format, width, height, source->Data, source->Pitch, destination->Data, destination->Pitch );
+	}
+
+	void BlockCompression::Decompress( DXGI::Format format, int width, int height, DataBox^ source, DataBox^ destination )
+	{
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+		if( destination == nullptr )
+			throw gcnew ArgumentNullException( "destination" );
+
+		Decompress( format, width, height, source->Data, source->RowPitch, destination->Data, destination->RowPitch );
+	}
+
+	DataRectangle^ BlockCompression::Decompress( DXGI::Format format, int width, int height, DataRectangle^ source )
+	{
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+		if( width < 1 )
+			throw gcnew ArgumentOutOfRangeException( "width" );
+		if( height < 1 )
+			throw gcnew ArgumentOutOfRangeException( "height" );
+
+		Int64 pitch = width * static_cast<Int64>( BlockCodec::GetDecompressedPixelSize( static_cast<DXGI_FORMAT>( format ) ) );
+		if( pitch == 0 )
+			throw gcnew ArgumentException( "The format is not a block compressed format.", "format" );
+		if( pitch > Int32::MaxValue )
+			throw gcnew ArgumentOutOfRangeException( "width", "A row of decompressed pixels does not fit in a 32-bit pitch." );
+
+		DataStream^ result = gcnew DataStream( static_cast<Int64>( pitch ) * height, true, true );
+		Decompress( format, width, height, source->Data, source->Pitch, result, static_cast<int>( pitch ) );
+		return gcnew DataRectangle( static_cast<int>( pitch ), result );
+	}
+
+	DataRectangle^ BlockCompression::Decompress( DXGI::Format format, int width, int height, DataBox^ source )
+	{
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+
+		return Decompress( format, width, height, gcnew DataRectangle( source->RowPitch, source->Data ) );
+	}
+
+	int BlockCompression::GetRowPitch( DXGI::Format format, int width )
+	{
+		size_t blockSize = BlockCodec::GetBlockSize( static_cast<DXGI_FORMAT>( format ) );
+		if( blockSize == 0 )
+			throw gcnew ArgumentException( "The format is not a block compressed format.", "format" );
+		if( width < 0 )
+			throw gcnew ArgumentOutOfRangeException( "width" );
+
+		Int64 pitch = std::max( 1LL, ( static_cast<Int64>( width ) + 3 ) / 4 ) * static_cast<Int64>( blockSize );
+		if( pitch > Int32::MaxValue )
+			throw gcnew ArgumentOutOfRangeException( "width", "A row of blocks does not fit in a 32-bit pitch." );
+
+		return static_cast<int>( pitch );
+	}
+
+	int BlockCompression::GetRowCount( int height )
+	{
+		if( height < 0 )
+			throw gcnew ArgumentOutOfRangeException( "height" );
+
+		return static_cast<int>( std::max( 1LL, ( static_cast<Int64>( height ) + 3 ) / 4 ) );
+	}
+
+	void BlockCompression::Compress( DXGI::Format format, int width, int height, DataStream^ source, int sourcePitch, DataStream^ destination, int destinationPitch, BlockCompressionQuality quality )
+	{
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+		if( destination == nullptr )
+			throw gcnew ArgumentNullException( "destination" );
+
+		DXGI_FORMAT nativeFormat = static_cast<DXGI_FORMAT>( format );
+		if( !BlockCodec::CanEncode( nativeFormat ) )
+			throw gcnew ArgumentException( "The format cannot be produced by the block compressor.", "format" );
+		if( width < 1 )
+			throw gcnew ArgumentOutOfRangeException( "width" );
+		if( height < 1 )
+			throw gcnew ArgumentOutOfRangeException( "height" );
+		if( quality < BlockCompressionQuality::Fast || quality > BlockCompressionQuality::High )
+			throw gcnew ArgumentOutOfRangeException( "quality" );
+
+		Int64 rowSize = static_cast<Int64>( width ) * 4;
+		if( sourcePitch < rowSize )
+			throw gcnew ArgumentException( "The source pitch is smaller than one row of pixels.", "source" );
+		if( ( height - 1 ) * static_cast<Int64>( sourcePitch ) + rowSize > source->RemainingLength )
+			throw gcnew ArgumentException( "The source does not contain enough data for a surface of the given size.", "source" );
+
+		Int64 blocksHigh = ( static_cast<Int64>( height ) + 3 ) / 4;
+		Int64 blockRowSize = GetRowPitch( format, width );
+		if( destinationPitch < blockRowSize )
+			throw gcnew ArgumentException( "The destination pitch is smaller than one row of blocks.", "destination" );
+		if( ( blocksHigh - 1 ) * destinationPitch + blockRowSize > destination->RemainingLength )
+			throw gcnew ArgumentException( "The destination is too small for a surface of the given size.", "destination" );
+
+		BlockCodec::EncodeJob job;
+		job.Format = nativeFormat;
+		job.Quality = static_cast<BlockCodec::EncodeQuality>( quality );
+		job.Width = width;
+		job.Height = height;
+		job.Source = reinterpret_cast<const uint8_t*>( source->PositionPointer );
+		job.SourcePitch = sourcePitch;
+		job.Destination = reinterpret_cast<uint8_t*>( destination->PositionPointer );
+		job.DestinationPitch = destinationPitch;
+
+		// encoding costs far more per block than decoding, so even small surfaces are worth spreading out
+		ParallelFor( static_cast<int>( blocksHigh ), 4, &BlockCodec::EncodeBlockRow, &job );
+	}
+
+	void BlockCompression::Compress( DXGI::Format format, int width, int height, DataRectangle^ source, DataRectangle^ destination, BlockCompressionQuality quality )
+	{
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+		if( destination == nullptr )
+			throw gcnew ArgumentNullException( "destination" );
+
+		Compress( format, width, height, source->Data, source->Pitch, destination->Data, destination->Pitch, quality );
+	}
+
+	DataRectangle^ BlockCompression::Compress( DXGI::Format format, int width, int height, DataRectangle^ source, BlockCompressionQuality quality )
+	{
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+		if( !BlockCodec::CanEncode( static_cast<DXGI_FORMAT>( format ) ) )
+			throw gcnew ArgumentException( "The format cannot be produced by the block compressor.", "format" );
+		if( width < 1 )
+			throw gcnew ArgumentOutOfRangeException( "width" );
+		if( height < 1 )
+			throw gcnew ArgumentOutOfRangeException( "height" );
+
+		int pitch = GetRowPitch( format, width );
+		DataStream^ result = gcnew DataStream( static_cast<Int64>( pitch ) * GetRowCount( height ), true, true );
+		Compress( format, width, height, source->Data, source->Pitch, result, pitch, quality );
+		return gcnew DataRectangle( pitch, result );
+	}
+}
+}
@@ -0,0 +1,140 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "../dxgi/Enums.h"
+
+#include "Enums11.h"
+
+namespace SlimDX
+{
+	ref class DataBox;
+	ref class DataRectangle;
+	ref class DataStream;
+
+	namespace Direct3D11
+	{
+		/// <summary>
+		/// Provides methods for encoding and decoding block compressed (BC1 through BC7) texture data on the CPU.
+		/// </summary>
+		/// <remarks>
+		/// Rows of blocks are processed in parallel on the thread pool. BC1, BC2, BC3 and BC7 decode to R8G8B8A8,
+		/// BC4 to R8, BC5 to R8G8 and BC6H to R16G16B16A16_Float; see <see cref="GetDecompressedFormat"/>.
+		/// Encoding always reads R8G8B8A8 pixels and is deterministic: the same pixels and quality produce the same
+		/// blocks on every run, regardless of how many threads take part.
+		/// </remarks>
+		/// <unmanaged>None</unmanaged>
+		public ref class BlockCompression sealed
+		{
+		private:
+			BlockCompression() { }
+
+			static void Decompress( DXGI::Format format, int width, int height, DataStream^ source, int sourcePitch, DataStream^ destination, int destinationPitch );
+			static void Compress( DXGI::Format format, int width, int height, DataStream^ source, int sourcePitch, DataStream^ destination, int destinationPitch, BlockCompressionQuality quality );
+
+		public:
+			/// <summary>
+			/// Gets the uncompressed format that data of a block compressed format decodes into.
+			/// </summary>
+			/// <param name="format">A block compressed format.</param>
+			/// <returns>The format of the decompressed data.</returns>
+			/// <exception cref="System::ArgumentException"><paramref name="format"/> is not a block compressed format.</exception>
+			static DXGI::Format GetDecompressedFormat( DXGI::Format format );
+
+			/// <summary>
+			/// Decompresses a block compressed surface into caller-provided memory.
+			/// </summary>
+			/// <param name="format">The block compressed format of the source data.</param>
+			/// <param name="width">The width of the surface, in pixels.</param>
+			/// <param name="height">The height of the surface, in pixels.</param>
+			/// <param name="source">The compressed data, starting at the current position of its stream. The pitch is the distance between rows of blocks.</param>
+			/// <param name="destination">Receives the decompressed data, starting at the current position of its stream.</param>
+			static void Decompress( DXGI::Format format, int width, int height, DataRectangle^ source, DataRectangle^ destination );
+
+			/// <summary>
+			/// Decompresses a block compressed surface, such as a mapped subresource, into caller-provided memory.
+			/// </summary>
+			/// <param name="format">The block compressed format of the source data.</param>
+			/// <param name="width">The width of the surface, in pixels.</param>
+			/// <param name="height">The height of the surface, in pixels.</param>
+			/// <param name="source">The compressed data, starting at the current position of its stream. The row pitch is the distance between rows of blocks.</param>
+			/// <param name="destination">Receives the decompressed data, starting at the current position of its stream.</param>
+			static void Decompress( DXGI::Format format, int width, int height, DataBox^ source, DataBox^ destination );
+
+			/// <summary>
+			/// Decompresses a block compressed surface into newly allocated memory.
+			/// </summary>
+			/// <param name="format">The block compressed format of the source data.</param>
+			/// <param name="width">The width of the surface, in pixels.</param>
+			/// <param name="height">The height of the surface, in pixels.</param>
+			/// <param name="source">The compressed data, starting at the current position of its stream.</param>
+			/// <returns>The decompressed data, tightly packed.</returns>
+			static DataRectangle^ Decompress( DXGI::Format format, int width, int height, DataRectangle^ source );
+
+			/// <summary>
+			/// Decompresses a block compressed surface, such as a mapped subresource, into newly allocated memory.
+			/// </summary>
+			/// <param name="format">The block compressed format of the source data.</param>
+			/// <param name="width">The width of the surface, in pixels.</param>
+			/// <param name="height">The height of the surface, in pixels.</param>
+			/// <param name="source">The compressed data, starting at the current position of its stream.</param>
+			/// <returns>The decompressed data, tightly packed.</returns>
+			static DataRectangle^ Decompress( DXGI::Format format, int width, int height, DataBox^ source );
+			/// <summary>
+			/// Gets the row pitch of a block compressed surface, following the DDS surface layout rules.
+			/// </summary>
+			/// <param name="format">A block compressed format.</param>
+			/// <param name="width">The width of the surface, in pixels.</param>
+			/// <returns>The size of one row of blocks, in bytes.</returns>
+			static int GetRowPitch( DXGI::Format format, int width );
+
+			/// <summary>
+			/// Gets the number of rows of blocks in a block compressed surface.
+			/// </summary>
+			/// <param name="height">The height of the surface, in pixels.</param>
+			/// <returns>The number of rows of blocks.</returns>
+			static int GetRowCount( int height );
+
+			/// <summary>
+			/// Compresses R8G8B8A8 pixels into caller-provided memory, such as a mapped staging texture.
+			/// </summary>
+			/// <param name="format">The block compressed format to produce. BC1, BC2, BC3, BC7 and the unsigned BC4 and BC5 formats are supported.</param>
+			/// <param name="width">The width of the surface, in pixels.</param>
+			/// <param name="height">The height of the surface, in pixels.</param>
+			/// <param name="source">The R8G8B8A8 pixels, starting at the current position of its stream. BC4 encodes the red channel and BC5 the red and green channels.</param>
+			/// <param name="destination">Receives the compressed blocks, starting at the current position of its stream. The pitch is the distance between rows of blocks.</param>
+			/// <param name="quality">The trade-off between encoding speed and quality.</param>
+			static void Compress( DXGI::Format format, int width, int height, DataRectangle^ source, DataRectangle^ destination, BlockCompressionQuality quality );
+
+			/// <summary>
+			/// Compresses R8G8B8A8 pixels into newly allocated memory laid out as a DDS surface.
+			/// </summary>
+			/// <param name="format">The block compressed format to produce. BC1, BC2, BC3, BC7 and the unsigned BC4 and BC5 formats are supported.</param>
+			/// <param name="width">The width of the surface, in pixels.</param>
+			/// <param name="height">The height of the surface, in pixels.</param>
+			/// <param name="source">The R8G8B8A8 pixels, starting at the current position of its stream. BC4 encodes the red channel and BC5 the red and green channels.</param>
+			/// <param name="quality">The trade-off between encoding speed and quality.</param>
+			/// <returns>The compressed surface, with a pitch of <see cref="GetRowPitch"/> bytes, ready to initialize a <see cref="Texture2D"/>.</returns>
+			static DataRectangle^ Compress( DXGI::Format format, int width, int height, DataRectangle^ source, BlockCompressionQuality quality );
+		};
+	}
+}
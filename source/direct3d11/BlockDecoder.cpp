@@ -0,0 +1,881 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#pragma managed(push, off)
+
+#include <emmintrin.h>
+
+#include "BlockCodec.h"
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+namespace BlockCodec
+{
+	const uint8_t Partitions2[64][16] =
+	{
+		{ 0,0,1,1, 0,0,1,1, 0,0,1,1, 0,0,1,1 }, { 0,0,0,1, 0,0,0,1, 0,0,0,1, 0,0,0,1 },
+		{ 0,1,1,1, 0,1,1,1, 0,1,1,1, 0,1,1,1 }, { 0,0,0,1, 0,0,1,1, 0,0,1,1, 0,1,1,1 },
+		{ 0,0,0,0, 0,0,0,1, 0,0,0,1, 0,0,1,1 }, { 0,0,1,1, 0,1,1,1, 0,1,1,1, 1,1,1,1 },
+		{ 0,0,0,1, 0,0,1,1, 0,1,1,1, 1,1,1,1 }, { 0,0,0,0, 0,0,0,1, 0,0,1,1, 0,1,1,1 },
+		{ 0,0,0,0, 0,0,0,0, 0,0,0,1, 0,0,1,1 }, { 0,0,1,1, 0,1,1,1, 1,1,1,1, 1,1,1,1 },
+		{ 0,0,0,0, 0,0,0,1, 0,1,1,1, 1,1,1,1 }, { 0,0,0,0, 0,0,0,0, 0,0,0,1, 0,1,1,1 },
+		{ 0,0,0,1, 0,1,1,1, 1,1,1,1, 1,1,1,1 }, { 0,0,0,0, 0,0,0,0, 1,1,1,1, 1,1,1,1 },
+		{ 0,0,0,0, 1,1,1,1, 1,1,1,1, 1,1,1,1 }, { 0,0,0,0, 0,0,0,0, 0,0,0,0, 1,1,1,1 },
+		{ 0,0,0,0, 1,0,0,0, 1,1,1,0, 1,1,1,1 }, { 0,1,1,1, 0,0,0,1, 0,0,0,0, 0,0,0,0 },
+		{ 0,0,0,0, 0,0,0,0, 1,0,0,0, 1,1,1,0 }, { 0,1,1,1, 0,0,1,1, 0,0,0,1, 0,0,0,0 },
+		{ 0,0,1,1, 0,0,0,1, 0,0,0,0, 0,0,0,0 }, { 0,0,0,0, 1,0,0,0, 1,1,0,0, 1,1,1,0 },
+		{ 0,0,0,0, 0,0,0,0, 1,0,0,0, 1,1,0,0 }, { 0,1,1,1, 0,0,1,1, 0,0,1,1, 0,0,0,1 },
+		{ 0,0,1,1, 0,0,0,1, 0,0,0,1, 0,0,0,0 }, { 0,0,0,0, 1,0,0,0, 1,0,0,0, 1,1,0,0 },
+		{ 0,1,1,0, 0,1,1,0, 0,1,1,0, 0,1,1,0 }, { 0,0,1,1, 0,1,1,0, 0,1,1,0, 1,1,0,0 },
+		{ 0,0,0,1, 0,1,1,1, 1,1,1,0, 1,0,0,0 }, { 0,0,0,0, 1,1,1,1, 1,1,1,1, 0,0,0,0 },
+		{ 0,1,1,1, 0,0,0,1, 1,0,0,0, 1,1,1,0 }, { 0,0,1,1, 1,0,0,1, 1,0,0,1, 1,1,0,0 },
+		{ 0,1,0,1, 0,1,0,1, 0,1,0,1, 0,1,0,1 }, { 0,0,0,0, 1,1,1,1, 0,0,0,0, 1,1,1,1 },
+		{ 0,1,0,1, 1,0,1,0, 0,1,0,1, 1,0,1,0 }, { 0,0,1,1, 0,0,1,1, 1,1,0,0, 1,1,0,0 },
+		{ 0,0,1,1, 1,1,0,0, 0,0,1,1, 1,1,0,0 }, { 0,1,0,1, 0,1,0,1, 1,0,1,0, 1,0,1,0 },
+		{ 0,1,1,0, 1,0,0,1, 0,1,1,0, 1,0,0,1 }, { 0,1,0,1, 1,0,1,0, 1,0,1,0, 0,1,0,1 },
+		{ 0,1,1,1, 0,0,1,1, 1,1,0,0, 1,1,1,0 }, { 0,0,0,1, 0,0,1,1, 1,1,0,0, 1,0,0,0 },
+		{ 0,0,1,1, 0,0,1,0, 0,1,0,0, 1,1,0,0 }, { 0,0,1,1, 1,0,1,1, 1,1,0,1, 1,1,0,0 },
+		{ 0,1,1,0, 1,0,0,1, 1,0,0,1, 0,1,1,0 }, { 0,0,1,1, 1,1,0,0, 1,1,0,0, 0,0,1,1 },
+		{ 0,1,1,0, 0,1,1,0, 1,0,0,1, 1,0,0,1 }, { 0,0,0,0, 0,1,1,0, 0,1,1,0, 0,0,0,0 },
+		{ 0,1,0,0, 1,1,1,0, 0,1,0,0, 0,0,0,0 }, { 0,0,1,0, 0,1,1,1, 0,0,1,0, 0,0,0,0 },
+		{ 0,0,0,0, 0,0,1,0, 0,1,1,1, 0,0,1,0 }, { 0,0,0,0, 0,1,0,0, 1,1,1,0, 0,1,0,0 },
+		{ 0,1,1,0, 1,1,0,0, 1,0,0,1, 0,0,1,1 }, { 0,0,1,1, 0,1,1,0, 1,1,0,0, 1,0,0,1 },
+		{ 0,1,1,0, 0,0,1,1, 1,0,0,1, 1,1,0,0 }, { 0,0,1,1, 1,0,0,1, 1,1,0,0, 0,1,1,0 },
+		{ 0,1,1,0, 1,1,0,0, 1,1,0,0, 1,0,0,1 }, { 0,1,1,0, 0,0,1,1, 0,0,1,1, 1,0,0,1 },
+		{ 0,1,1,1, 1,1,1,0, 1,0,0,0, 0,0,0,1 }, { 0,0,0,1, 1,0,0,0, 1,1,1,0, 0,1,1,1 },
+		{ 0,0,0,0, 1,1,1,1, 0,0,1,1, 0,0,1,1 }, { 0,0,1,1, 0,0,1,1, 1,1,1,1, 0,0,0,0 },
+		{ 0,0,1,0, 0,0,1,0, 1,1,1,0, 1,1,1,0 }, { 0,1,0,0, 0,1,0,0, 0,1,1,1, 0,1,1,1 }
+	};
+
+	const uint8_t Partitions3[64][16] =
+	{
+		{ 0,0,1,1, 0,0,1,1, 0,2,2,1, 2,2,2,2 }, { 0,0,0,1, 0,0,1,1, 2,2,1,1, 2,2,2,1 },
+		{ 0,0,0,0, 2,0,0,1, 2,2,1,1, 2,2,1,1 }, { 0,2,2,2, 0,0,2,2, 0,0,1,1, 0,1,1,1 },
+		{ 0,0,0,0, 0,0,0,0, 1,1,2,2, 1,1,2,2 }, { 0,0,1,1, 0,0,1,1, 0,0,2,2, 0,0,2,2 },
+		{ 0,0,2,2, 0,0,2,2, 1,1,1,1, 1,1,1,1 }, { 0,0,1,1, 0,0,1,1, 2,2,1,1, 2,2,1,1 },
+		{ 0,0,0,0, 0,0,0,0, 1,1,1,1, 2,2,2,2 }, { 0,0,0,0, 1,1,1,1, 1,1,1,1, 2,2,2,2 },
+		{ 0,0,0,0, 1,1,1,1, 2,2,2,2, 2,2,2,2 }, { 0,0,1,2, 0,0,1,2, 0,0,1,2, 0,0,1,2 },
+		{ 0,1,1,2, 0,1,1,2, 0,1,1,2, 0,1,1,2 }, { 0,1,2,2, 0,1,2,2, 0,1,2,2, 0,1,2,2 },
+		{ 0,0,1,1, 0,1,1,2, 1,1,2,2, 1,2,2,2 }, { 0,0,1,1, 2,0,0,1, 2,2,0,0, 2,2,2,0 },
+		{ 0,0,0,1, 0,0,1,1, 0,1,1,2, 1,1,2,2 }, { 0,1,1,1, 0,0,1,1, 2,0,0,1, 2,2,0,0 },
+		{ 0,0,0,0, 1,1,2,2, 1,1,2,2, 1,1,2,2 }, { 0,0,2,2, 0,0,2,2, 0,0,2,2, 1,1,1,1 },
+		{ 0,1,1,1, 0,1,1,1, 0,2,2,2, 0,2,2,2 }, { 0,0,0,1, 0,0,0,1, 2,2,2,1, 2,2,2,1 },
+		{ 0,0,0,0, 0,0,1,1, 0,1,2,2, 0,1,2,2 }, { 0,0,0,0, 1,1,0,0, 2,2,1,0, 2,2,1,0 },
+		{ 0,1,2,2, 0,1,2,2, 0,0,1,1, 0,0,0,0 }, { 0,0,1,2, 0,0,1,2, 1,1,2,2, 2,2,2,2 },
+		{ 0,1,1,0, 1,2,2,1, 1,2,2,1, 0,1,1,0 }, { 0,0,0,0, 0,1,1,0, 1,2,2,1, 1,2,2,1 },
+		{ 0,0,2,2, 1,1,0,2, 1,1,0,2, 0,0,2,2 }, { 0,1,1,0, 0,1,1,0, 2,0,0,2, 2,2,2,2 },
+		{ 0,0,1,1, 0,1,2,2, 0,1,2,2, 0,0,1,1 }, { 0,0,0,0, 2,0,0,0, 2,2,1,1, 2,2,2,1 },
+		{ 0,0,0,0, 0,0,0,2, 1,1,2,2, 1,2,2,2 }, { 0,2,2,2, 0,0,2,2, 0,0,1,2, 0,0,1,1 },
+		{ 0,0,1,1, 0,0,1,2, 0,0,2,2, 0,2,2,2 }, { 0,1,2,0, 0,1,2,0, 0,1,2,0, 0,1,2,0 },
+		{ 0,0,0,0, 1,1,1,1, 2,2,2,2, 0,0,0,0 }, { 0,1,2,0, 1,2,0,1, 2,0,1,2, 0,1,2,0 },
+		{ 0,1,2,0, 2,0,1,2, 1,2,0,1, 0,1,2,0 }, { 0,0,1,1, 2,2,0,0, 1,1,2,2, 0,0,1,1 },
+		{ 0,0,1,1, 1,1,2,2, 2,2,0,0, 0,0,1,1 }, { 0,1,0,1, 0,1,0,1, 2,2,2,2, 2,2,2,2 },
+		{ 0,0,0,0, 0,0,0,0, 2,1,2,1, 2,1,2,1 }, { 0,0,2,2, 1,1,2,2, 0,0,2,2, 1,1,2,2 },
+		{ 0,0,2,2, 0,0,1,1, 0,0,2,2, 0,0,1,1 }, { 0,2,2,0, 1,2,2,1, 0,2,2,0, 1,2,2,1 },
+		{ 0,1,0,1, 2,2,2,2, 2,2,2,2, 0,1,0,1 }, { 0,0,0,0, 2,1,2,1, 2,1,2,1, 2,1,2,1 },
+		{ 0,1,0,1, 0,1,0,1, 0,1,0,1, 2,2,2,2 }, { 0,2,2,2, 0,1,1,1, 0,2,2,2, 0,1,1,1 },
+		{ 0,0,0,2, 1,1,1,2, 0,0,0,2, 1,1,1,2 }, { 0,0,0,0, 2,1,1,2, 2,1,1,2, 2,1,1,2 },
+		{ 0,2,2,2, 0,1,1,1, 0,1,1,1, 0,2,2,2 }, { 0,0,0,2, 1,1,1,2, 1,1,1,2, 0,0,0,2 },
+		{ 0,1,1,0, 0,1,1,0, 0,1,1,0, 2,2,2,2 }, { 0,0,0,0, 0,0,0,0, 2,1,1,2, 2,1,1,2 },
+		{ 0,1,1,0, 0,1,1,0, 2,2,2,2, 2,2,2,2 }, { 0,0,2,2, 0,0,1,1, 0,0,1,1, 0,0,2,2 },
+		{ 0,0,2,2, 1,1,2,2, 1,1,2,2, 0,0,2,2 }, { 0,0,0,0, 0,0,0,0, 0,0,0,0, 2,1,1,2 },
+		{ 0,0,0,2, 0,0,0,1, 0,0,0,2, 0,0,0,1 }, { 0,2,2,2, 1,2,2,2, 0,2,2,2, 1,2,2,2 },
+		{ 0,1,0,1, 2,2,2,2, 2,2,2,2, 2,2,2,2 }, { 0,1,1,1, 2,0,1,1, 2,2,0,1, 2,2,2,0 }
+	};
+
+	const uint8_t Anchors2[64] =
+	{
+		15,15,15,15,15,15,15,15, 15,15,15,15,15,15,15,15,
+		15, 2, 8, 2, 2, 8, 8,15,  2, 8, 2, 2, 8, 8, 2, 2,
+		15,15, 6, 8, 2, 8,15,15,  2, 8, 2, 2, 2,15,15, 6,
+		 6, 2, 6, 8,15,15, 2, 2, 15,15,15,15,15, 2, 2,15
+	};
+
+	const uint8_t Anchors3[2][64] =
+	{
+		{
+			 3, 3,15,15, 8, 3,15,15,  8, 8, 6, 6, 6, 5, 3, 3,
+			 3, 3, 8,15, 3, 3, 6,10,  5, 8, 8, 6, 8, 5,15,15,
+			 8,15, 3, 5, 6,10, 8,15, 15, 3,15, 5,15,15,15,15,
+			 3,15, 5, 5, 5, 8, 5,10,  5,10, 8,13,15,12, 3, 3
+		},
+		{
+			15, 8, 8, 3,15,15, 3, 8, 15,15,15,15,15,15,15, 8,
+			15, 8,15, 3,15, 8,15, 8,  3,15, 6,10,15,15,10, 8,
+			15, 3,15,10,10, 8, 9,10,  6,15, 8,15, 3, 6, 6, 8,
+			15, 3,15,15,15,15,15,15, 15,15,15,15, 3,15,15, 8
+		}
+	};
+
+	const uint16_t Weights2[4] = { 0, 21, 43, 64 };
+	const uint16_t Weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+	const uint16_t Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	const BC7Mode BC7Modes[8] =
+	{
+		{ 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+		{ 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+		{ 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+		{ 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+		{ 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+		{ 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+		{ 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+		{ 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 }
+	};
+
+	// Interpolates count palette entries between two packed R8G8B8A8 endpoints, two entries per iteration,
+	// as (e0 * (64 - w) + e1 * w + 32) >> 6.
+	void BuildPalette( uint32_t endpoint0, uint32_t endpoint1, const uint16_t* weights, size_t count, uint32_t* palette )
+	{
+		const __m128i zero = _mm_setzero_si128();
+		__m128i a = _mm_unpacklo_epi8( _mm_cvtsi32_si128( static_cast<int>( endpoint0 ) ), zero );
+		__m128i b = _mm_unpacklo_epi8( _mm_cvtsi32_si128( static_cast<int>( endpoint1 ) ), zero );
+		a = _mm_unpacklo_epi64( a, a );
+		b = _mm_unpacklo_epi64( b, b );
+
+		const __m128i sixtyFour = _mm_set1_epi16( 64 );
+		const __m128i bias = _mm_set1_epi16( 32 );
+		for( size_t entry = 0; entry < count; entry += 2 )
+		{
+			short w0 = static_cast<short>( weights[entry] );
+			short w1 = static_cast<short>( weights[entry + 1] );
+			__m128i w = _mm_set_epi16( w1, w1, w1, w1, w0, w0, w0, w0 );
+			__m128i value = _mm_add_epi16( _mm_mullo_epi16( a, _mm_sub_epi16( sixtyFour, w ) ), _mm_mullo_epi16( b, w ) );
+			value = _mm_srli_epi16( _mm_add_epi16( value, bias ), 6 );
+			_mm_storel_epi64( reinterpret_cast<__m128i*>( palette + entry ), _mm_packus_epi16( value, value ) );
+		}
+	}
+
+namespace
+{
+	const uint8_t SingleSubset[16] = { 0 };
+
+	const uint16_t* const WeightTables[5] = { NULL, NULL, Weights2, Weights3, Weights4 };
+
+	// Pulls little-endian bit fields out of a 128-bit block, least significant bit first.
+	class BitReader
+	{
+	private:
+		uint64_t m_Low;
+		uint64_t m_High;
+		size_t m_Position;
+
+	public:
+		explicit BitReader( const uint8_t* block )
+		: m_Position( 0 )
+		{
+			memcpy( &m_Low, block, sizeof( m_Low ) );
+			memcpy( &m_High, block + sizeof( m_Low ), sizeof( m_High ) );
+		}
+
+		void Skip( size_t count )
+		{
+			m_Position += count;
+		}
+
+		uint32_t Read( size_t count )
+		{
+			if( count == 0 )
+				return 0;
+
+			uint64_t bits;
+			if( m_Position >= 64 )
+				bits = m_High >> ( m_Position - 64 );
+			else if( m_Position + count <= 64 )
+				bits = m_Low >> m_Position;
+			else
+				bits = ( m_Low >> m_Position ) | ( m_High << ( 64 - m_Position ) );
+
+			m_Position += count;
+			return static_cast<uint32_t>( bits & ( ( 1ull << count ) - 1 ) );
+		}
+	};
+
+	// Decodes the 64-bit colour half shared by BC1, BC2 and BC3 into sixteen R8G8B8A8 pixels.
+	// BC2 and BC3 always use the four colour mode regardless of endpoint order.
+	void DecodeColorBlock( const uint8_t* block, uint32_t* tile, bool allowPunchThrough )
+	{
+		uint16_t color0, color1;
+		uint32_t indices;
+		memcpy( &color0, block, sizeof( color0 ) );
+		memcpy( &color1, block + 2, sizeof( color1 ) );
+		memcpy( &indices, block + 4, sizeof( indices ) );
+
+		const __m128i zero = _mm_setzero_si128();
+		__m128i endpoints = _mm_unpacklo_epi8( _mm_set_epi32( 0, 0, Expand565( color1 ), Expand565( color0 ) ), zero );
+		__m128i swapped = _mm_shuffle_epi32( endpoints, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+		__m128i interpolated;
+
+		if( !allowPunchThrough || color0 > color1 )
+		{
+			// (2a + b + 1) / 3 for both interpolants at once; the high half of x * 21846 is x / 3 for x < 768.
+			__m128i sum = _mm_add_epi16( _mm_add_epi16( endpoints, endpoints ), swapped );
+			interpolated = _mm_mulhi_epu16( _mm_add_epi16( sum, _mm_set1_epi16( 1 ) ), _mm_set1_epi16( 21846 ) );
+		}
+		else
+		{
+			// midpoint and transparent black
+			interpolated = _mm_and_si128( _mm_avg_epu16( endpoints, swapped ), _mm_set_epi32( 0, 0, -1, -1 ) );
+		}
+
+		__declspec(align(16)) uint32_t palette[4];
+		_mm_store_si128( reinterpret_cast<__m128i*>( palette ), _mm_packus_epi16( endpoints, interpolated ) );
+
+		for( int row = 0; row < 4; ++row, indices >>= 8 )
+		{
+			__m128i pixels = _mm_set_epi32( palette[( indices >> 6 ) & 3], palette[( indices >> 4 ) & 3], palette[( indices >> 2 ) & 3], palette[indices & 3] );
+			_mm_store_si128( reinterpret_cast<__m128i*>( tile + row * 4 ), pixels );
+		}
+	}
+
+	// Decodes a BC4-style 64-bit channel block into sixteen bytes spaced stride bytes apart.
+	// Signed blocks are biased into 0..254 for interpolation, which is exact because the weights sum to the divisor.
+	void DecodeChannelBlock( const uint8_t* block, uint8_t* output, size_t stride, bool isSigned )
+	{
+		int endpoint0 = block[0];
+		int endpoint1 = block[1];
+		int maximum = 255;
+		bool eightValues = endpoint0 > endpoint1;
+
+		if( isSigned )
+		{
+			// the mode comes from the raw codes, since -128 and -127 compare differently before the clamp
+			eightValues = static_cast<int8_t>( block[0] ) > static_cast<int8_t>( block[1] );
+			endpoint0 = std::max( static_cast<int>( static_cast<int8_t>( block[0] ) ), -127 ) + 127;
+			endpoint1 = std::max( static_cast<int>( static_cast<int8_t>( block[1] ) ), -127 ) + 127;
+			maximum = 254;
+		}
+
+		__m128i value;
+		const __m128i a = _mm_set1_epi16( static_cast<short>( endpoint0 ) );
+		const __m128i b = _mm_set1_epi16( static_cast<short>( endpoint1 ) );
+		if( eightValues )
+		{
+			// eight entries: e0, e1 and six sevenths in between; x * 9363 >> 16 is x / 7 for x < 1792
+			value = _mm_add_epi16( _mm_mullo_epi16( a, _mm_setr_epi16( 7, 0, 6, 5, 4, 3, 2, 1 ) ),
+				_mm_mullo_epi16( b, _mm_setr_epi16( 0, 7, 1, 2, 3, 4, 5, 6 ) ) );
+			value = _mm_mulhi_epu16( _mm_add_epi16( value, _mm_set1_epi16( 3 ) ), _mm_set1_epi16( 9363 ) );
+		}
+		else
+		{
+			// six entries: e0, e1 and four fifths in between, then the two extremes; x * 13108 >> 16 is x / 5 for x < 1280
+			value = _mm_add_epi16( _mm_mullo_epi16( a, _mm_setr_epi16( 5, 0, 4, 3, 2, 1, 0, 0 ) ),
+				_mm_mullo_epi16( b, _mm_setr_epi16( 0, 5, 1, 2, 3, 4, 0, 0 ) ) );
+			value = _mm_mulhi_epu16( _mm_add_epi16( value, _mm_set1_epi16( 2 ) ), _mm_set1_epi16( 13108 ) );
+			value = _mm_insert_epi16( value, maximum, 7 );
+		}
+
+		if( isSigned )
+			value = _mm_sub_epi16( value, _mm_set1_epi16( 127 ) );
+
+		__declspec(align(16)) uint8_t palette[16];
+		_mm_store_si128( reinterpret_cast<__m128i*>( palette ), isSigned ? _mm_packs_epi16( value, value ) : _mm_packus_epi16( value, value ) );
+
+		uint64_t indices = 0;
+		memcpy( &indices, block + 2, 6 );
+		for( int pixel = 0; pixel < 16; ++pixel, indices >>= 3 )
+			output[pixel * stride] = palette[indices & 7];
+	}
+
+	void DecodeBC1( const uint8_t* block, uint8_t* tile )
+	{
+		DecodeColorBlock( block, reinterpret_cast<uint32_t*>( tile ), true );
+	}
+
+	void DecodeBC2( const uint8_t* block, uint8_t* tile )
+	{
+		DecodeColorBlock( block + 8, reinterpret_cast<uint32_t*>( tile ), false );
+
+		uint64_t alpha;
+		memcpy( &alpha, block, sizeof( alpha ) );
+		for( int pixel = 0; pixel < 16; ++pixel, alpha >>= 4 )
+			tile[pixel * 4 + 3] = static_cast<uint8_t>( ( alpha & 0xf ) * 17 );
+	}
+
+	void DecodeBC3( const uint8_t* block, uint8_t* tile )
+	{
+		DecodeColorBlock( block + 8, reinterpret_cast<uint32_t*>( tile ), false );
+		DecodeChannelBlock( block, tile + 3, 4, false );
+	}
+
+	void DecodeBC4U( const uint8_t* block, uint8_t* tile )
+	{
+		DecodeChannelBlock( block, tile, 1, false );
+	}
+
+	void DecodeBC4S( const uint8_t* block, uint8_t* tile )
+	{
+		DecodeChannelBlock( block, tile, 1, true );
+	}
+
+	void DecodeBC5U( const uint8_t* block, uint8_t* tile )
+	{
+		DecodeChannelBlock( block, tile, 2, false );
+		DecodeChannelBlock( block + 8, tile + 1, 2, false );
+	}
+
+	void DecodeBC5S( const uint8_t* block, uint8_t* tile )
+	{
+		DecodeChannelBlock( block, tile, 2, true );
+		DecodeChannelBlock( block + 8, tile + 1, 2, true );
+	}
+
+	void DecodeBC7( const uint8_t* block, uint8_t* output )
+	{
+		uint32_t* tile = reinterpret_cast<uint32_t*>( output );
+
+		size_t mode = 0;
+		while( mode < 8 && !( block[0] & ( 1 << mode ) ) )
+			++mode;
+
+		// reserved mode; the block decodes to transparent black
+		if( mode == 8 )
+		{
+			memset( tile, 0, 16 * sizeof( uint32_t ) );
+			return;
+		}
+
+		const BC7Mode& info = BC7Modes[mode];
+		BitReader reader( block );
+		reader.Skip( mode + 1 );
+
+		const uint32_t partition = reader.Read( info.PartitionBits );
+		const uint32_t rotation = reader.Read( info.RotationBits );
+		const uint32_t indexSelection = reader.Read( info.IndexSelectionBits );
+
+		const size_t endpointCount = info.Subsets * 2u;
+		uint8_t endpoints[6][4];
+		for( size_t channel = 0; channel < 3; ++channel )
+		{
+			for( size_t endpoint = 0; endpoint < endpointCount; ++endpoint )
+				endpoints[endpoint][channel] = static_cast<uint8_t>( reader.Read( info.ColorBits ) );
+		}
+
+		for( size_t endpoint = 0; endpoint < endpointCount; ++endpoint )
+			endpoints[endpoint][3] = info.AlphaBits ? static_cast<uint8_t>( reader.Read( info.AlphaBits ) ) : 0xff;
+
+		uint32_t pbits[6] = { 0 };
+		if( info.EndpointPBits )
+		{
+			for( size_t endpoint = 0; endpoint < endpointCount; ++endpoint )
+				pbits[endpoint] = reader.Read( 1 );
+		}
+		else if( info.SharedPBits )
+		{
+			for( size_t subset = 0; subset < info.Subsets; ++subset )
+				pbits[subset * 2] = pbits[subset * 2 + 1] = reader.Read( 1 );
+		}
+
+		const size_t hasPBits = ( info.EndpointPBits || info.SharedPBits ) ? 1 : 0;
+		uint32_t packed[6];
+		for( size_t endpoint = 0; endpoint < endpointCount; ++endpoint )
+		{
+			for( size_t channel = 0; channel < 3; ++channel )
+				endpoints[endpoint][channel] = Unquantize( ( endpoints[endpoint][channel] << hasPBits ) | pbits[endpoint], info.ColorBits + hasPBits );
+
+			if( info.AlphaBits )
+				endpoints[endpoint][3] = Unquantize( ( endpoints[endpoint][3] << hasPBits ) | pbits[endpoint], info.AlphaBits + hasPBits );
+
+			memcpy( &packed[endpoint], endpoints[endpoint], sizeof( uint32_t ) );
+		}
+
+		const uint8_t* subsets = SingleSubset;
+		size_t anchor1 = 0, anchor2 = 0;
+		if( info.Subsets == 2 )
+		{
+			subsets = Partitions2[partition];
+			anchor1 = Anchors2[partition];
+		}
+		else if( info.Subsets == 3 )
+		{
+			subsets = Partitions3[partition];
+			anchor1 = Anchors3[0][partition];
+			anchor2 = Anchors3[1][partition];
+		}
+
+		uint8_t indices[16], secondaryIndices[16];
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+		{
+			bool anchor = pixel == 0 || pixel == anchor1 || pixel == anchor2;
+			indices[pixel] = static_cast<uint8_t>( reader.Read( info.IndexBits - ( anchor ? 1 : 0 ) ) );
+		}
+
+		if( info.SecondaryIndexBits )
+		{
+			for( size_t pixel = 0; pixel < 16; ++pixel )
+				secondaryIndices[pixel] = static_cast<uint8_t>( reader.Read( info.SecondaryIndexBits - ( pixel == 0 ? 1 : 0 ) ) );
+		}
+
+		// modes 4 and 5 carry a second index set; the selection bit decides which one drives colour
+		const uint8_t* colorIndices = indices;
+		const uint8_t* alphaIndices = indices;
+		size_t colorIndexBits = info.IndexBits;
+		size_t alphaIndexBits = info.IndexBits;
+		if( info.SecondaryIndexBits )
+		{
+			if( indexSelection )
+			{
+				colorIndices = secondaryIndices;
+				colorIndexBits = info.SecondaryIndexBits;
+			}
+			else
+			{
+				alphaIndices = secondaryIndices;
+				alphaIndexBits = info.SecondaryIndexBits;
+			}
+		}
+
+		__declspec(align(16)) uint32_t palettes[3][16];
+		__declspec(align(16)) uint32_t alphaPalette[16];
+		for( size_t subset = 0; subset < info.Subsets; ++subset )
+			BuildPalette( packed[subset * 2], packed[subset * 2 + 1], WeightTables[colorIndexBits], size_t( 1 ) << colorIndexBits, palettes[subset] );
+
+		if( info.SecondaryIndexBits )
+			BuildPalette( packed[0], packed[1], WeightTables[alphaIndexBits], size_t( 1 ) << alphaIndexBits, alphaPalette );
+
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+		{
+			uint32_t color = palettes[subsets[pixel]][colorIndices[pixel]];
+			if( info.SecondaryIndexBits )
+				color = ( color & 0x00ffffff ) | ( alphaPalette[alphaIndices[pixel]] & 0xff000000 );
+
+			if( rotation != 0 )
+			{
+				// swap alpha with red, green or blue
+				const uint32_t shift = ( rotation - 1 ) * 8;
+				const uint32_t channel = ( color >> shift ) & 0xff;
+				const uint32_t alpha = color >> 24;
+				color = ( color & ~( ( 0xffu << shift ) | 0xff000000 ) ) | ( alpha << shift ) | ( channel << 24 );
+			}
+
+			tile[pixel] = color;
+		}
+	}
+
+	enum BC6HField
+	{
+		RW, RX, RY, RZ, GW, GX, GY, GZ, BW, BX, BY, BZ, D, BC6HFieldCount
+	};
+
+	// A run of bits belonging to one field; first > last means the bits are stored most significant first.
+	struct BC6HFieldRun
+	{
+		uint8_t Field;
+		uint8_t First;
+		uint8_t Last;
+	};
+
+	struct BC6HMode
+	{
+		bool Transformed;
+		uint8_t Regions;
+		uint8_t EndpointBits;
+		uint8_t DeltaBits[3];
+		const BC6HFieldRun* Runs;
+		size_t RunCount;
+	};
+
+	const BC6HFieldRun BC6HRuns0[] = { { GY,4,4 }, { BY,4,4 }, { BZ,4,4 }, { RW,0,9 }, { GW,0,9 }, { BW,0,9 }, { RX,0,4 }, { GZ,4,4 }, { GY,0,3 }, { GX,0,4 }, { BZ,0,0 }, { GZ,0,3 }, { BX,0,4 }, { BZ,1,1 }, { BY,0,3 }, { RY,0,4 }, { BZ,2,2 }, { RZ,0,4 }, { BZ,3,3 }, { D,0,4 } };
+	const BC6HFieldRun BC6HRuns1[] = { { GY,5,5 }, { GZ,4,5 }, { RW,0,6 }, { BZ,0,1 }, { BY,4,4 }, { GW,0,6 }, { BY,5,5 }, { BZ,2,2 }, { GY,4,4 }, { BW,0,6 }, { BZ,3,3 }, { BZ,5,5 }, { BZ,4,4 }, { RX,0,5 }, { GY,0,3 }, { GX,0,5 }, { GZ,0,3 }, { BX,0,5 }, { BY,0,3 }, { RY,0,5 }, { RZ,0,5 }, { D,0,4 } };
+	const BC6HFieldRun BC6HRuns2[] = { { RW,0,9 }, { GW,0,9 }, { BW,0,9 }, { RX,0,4 }, { RW,10,10 }, { GY,0,3 }, { GX,0,3 }, { GW,10,10 }, { BZ,0,0 }, { GZ,0,3 }, { BX,0,3 }, { BW,10,10 }, { BZ,1,1 }, { BY,0,3 }, { RY,0,4 }, { BZ,2,2 }, { RZ,0,4 }, { BZ,3,3 }, { D,0,4 } };
+	const BC6HFieldRun BC6HRuns3[] = { { RW,0,9 }, { GW,0,9 }, { BW,0,9 }, { RX,0,3 }, { RW,10,10 }, { GZ,4,4 }, { GY,0,3 }, { GX,0,4 }, { GW,10,10 }, { GZ,0,3 }, { BX,0,3 }, { BW,10,10 }, { BZ,1,1 }, { BY,0,3 }, { RY,0,3 }, { BZ,0,0 }, { BZ,2,2 }, { RZ,0,3 }, { GY,4,4 }, { BZ,3,3 }, { D,0,4 } };
+	const BC6HFieldRun BC6HRuns4[] = { { RW,0,9 }, { GW,0,9 }, { BW,0,9 }, { RX,0,3 }, { RW,10,10 }, { BY,4,4 }, { GY,0,3 }, { GX,0,3 }, { GW,10,10 }, { BZ,0,0 }, { GZ,0,3 }, { BX,0,4 }, { BW,10,10 }, { BY,0,3 }, { RY,0,3 }, { BZ,1,2 }, { RZ,0,3 }, { BZ,4,4 }, { BZ,3,3 }, { D,0,4 } };
+	const BC6HFieldRun BC6HRuns5[] = { { RW,0,8 }, { BY,4,4 }, { GW,0,8 }, { GY,4,4 }, { BW,0,8 }, { BZ,4,4 }, { RX,0,4 }, { GZ,4,4 }, { GY,0,3 }, { GX,0,4 }, { BZ,0,0 }, { GZ,0,3 }, { BX,0,4 }, { BZ,1,1 }, { BY,0,3 }, { RY,0,4 }, { BZ,2,2 }, { RZ,0,4 }, { BZ,3,3 }, { D,0,4 } };
+	const BC6HFieldRun BC6HRuns6[] = { { RW,0,7 }, { GZ,4,4 }, { BY,4,4 }, { GW,0,7 }, { BZ,2,2 }, { GY,4,4 }, { BW,0,7 }, { BZ,3,4 }, { RX,0,5 }, { GY,0,3 }, { GX,0,4 }, { BZ,0,0 }, { GZ,0,3 }, { BX,0,4 }, { BZ,1,1 }, { BY,0,3 }, { RY,0,5 }, { RZ,0,5 }, { D,0,4 } };
+	const BC6HFieldRun BC6HRuns7[] = { { RW,0,7 }, { BZ,0,0 }, { BY,4,4 }, { GW,0,7 }, { GY,5,5 }, { GY,4,4 }, { BW,0,7 }, { GZ,5,5 }, { BZ,4,4 }, { RX,0,4 }, { GZ,4,4 }, { GY,0,3 }, { GX,0,5 }, { GZ,0,3 }, { BX,0,4 }, { BZ,1,1 }, { BY,0,3 }, { RY,0,4 }, { BZ,2,2 }, { RZ,0,4 }, { BZ,3,3 }, { D,0,4 } };
+	const BC6HFieldRun BC6HRuns8[] = { { RW,0,7 }, { BZ,1,1 }, { BY,4,4 }, { GW,0,7 }, { BY,5,5 }, { GY,4,4 }, { BW,0,7 }, { BZ,5,5 }, { BZ,4,4 }, { RX,0,4 }, { GZ,4,4 }, { GY,0,3 }, { GX,0,4 }, { BZ,0,0 }, { GZ,0,3 }, { BX,0,5 }, { BY,0,3 }, { RY,0,4 }, { BZ,2,2 }, { RZ,0,4 }, { BZ,3,3 }, { D,0,4 } };
+	const BC6HFieldRun BC6HRuns9[] = { { RW,0,5 }, { GZ,4,4 }, { BZ,0,1 }, { BY,4,4 }, { GW,0,5 }, { GY,5,5 }, { BY,5,5 }, { BZ,2,2 }, { GY,4,4 }, { BW,0,5 }, { GZ,5,5 }, { BZ,3,3 }, { BZ,5,5 }, { BZ,4,4 }, { RX,0,5 }, { GY,0,3 }, { GX,0,5 }, { GZ,0,3 }, { BX,0,5 }, { BY,0,3 }, { RY,0,5 }, { RZ,0,5 }, { D,0,4 } };
+	const BC6HFieldRun BC6HRuns10[] = { { RW,0,9 }, { GW,0,9 }, { BW,0,9 }, { RX,0,9 }, { GX,0,9 }, { BX,0,9 } };
+	const BC6HFieldRun BC6HRuns11[] = { { RW,0,9 }, { GW,0,9 }, { BW,0,9 }, { RX,0,8 }, { RW,10,10 }, { GX,0,8 }, { GW,10,10 }, { BX,0,8 }, { BW,10,10 } };
+	const BC6HFieldRun BC6HRuns12[] = { { RW,0,9 }, { GW,0,9 }, { BW,0,9 }, { RX,0,7 }, { RW,11,10 }, { GX,0,7 }, { GW,11,10 }, { BX,0,7 }, { BW,11,10 } };
+	const BC6HFieldRun BC6HRuns13[] = { { RW,0,9 }, { GW,0,9 }, { BW,0,9 }, { RX,0,3 }, { RW,15,10 }, { GX,0,3 }, { GW,15,10 }, { BX,0,3 }, { BW,15,10 } };
+
+#define BC6H_MODE(transformed, regions, endpointBits, r, g, b, runs) { transformed, regions, endpointBits, { r, g, b }, runs, _countof( runs ) }
+
+	const BC6HMode BC6HModes[14] =
+	{
+		BC6H_MODE( true, 2, 10, 5, 5, 5, BC6HRuns0 ),
+		BC6H_MODE( true, 2, 7, 6, 6, 6, BC6HRuns1 ),
+		BC6H_MODE( true, 2, 11, 5, 4, 4, BC6HRuns2 ),
+		BC6H_MODE( true, 2, 11, 4, 5, 4, BC6HRuns3 ),
+		BC6H_MODE( true, 2, 11, 4, 4, 5, BC6HRuns4 ),
+		BC6H_MODE( true, 2, 9, 5, 5, 5, BC6HRuns5 ),
+		BC6H_MODE( true, 2, 8, 6, 5, 5, BC6HRuns6 ),
+		BC6H_MODE( true, 2, 8, 5, 6, 5, BC6HRuns7 ),
+		BC6H_MODE( true, 2, 8, 5, 5, 6, BC6HRuns8 ),
+		BC6H_MODE( false, 2, 6, 6, 6, 6, BC6HRuns9 ),
+		BC6H_MODE( false, 1, 10, 10, 10, 10, BC6HRuns10 ),
+		BC6H_MODE( true, 1, 11, 9, 9, 9, BC6HRuns11 ),
+		BC6H_MODE( true, 1, 12, 8, 8, 8, BC6HRuns12 ),
+		BC6H_MODE( true, 1, 16, 4, 4, 4, BC6HRuns13 )
+	};
+
+#undef BC6H_MODE
+
+	// Maps the (up to) five mode bits to an index into BC6HModes; -1 marks the reserved modes.
+	const int BC6HModeIndices[32] =
+	{
+		0, 1, 2, 10, -1, -1, 3, 11, -1, -1, 4, 12, -1, -1, 5, 13,
+		-1, -1, 6, -1, -1, -1, 7, -1, -1, -1, 8, -1, -1, -1, 9, -1
+	};
+
+	inline int SignExtend( int value, size_t bits )
+	{
+		return ( value & ( 1 << ( bits - 1 ) ) ) ? ( value | ~( ( 1 << bits ) - 1 ) ) : value;
+	}
+
+	int UnquantizeBC6H( int value, size_t bits, bool isSigned )
+	{
+		if( isSigned )
+		{
+			if( bits >= 16 )
+				return value;
+
+			bool negative = value < 0;
+			if( negative )
+				value = -value;
+
+			int result;
+			if( value == 0 )
+				result = 0;
+			else if( value >= ( 1 << ( bits - 1 ) ) - 1 )
+				result = 0x7fff;
+			else
+				result = ( ( value << 15 ) + 0x4000 ) >> ( bits - 1 );
+
+			return negative ? -result : result;
+		}
+
+		if( bits >= 15 )
+			return value;
+		if( value == 0 )
+			return 0;
+		if( value == ( 1 << bits ) - 1 )
+			return 0xffff;
+
+		return ( ( value << 16 ) + 0x8000 ) >> bits;
+	}
+
+	// Scales an interpolated value back into the bit pattern of a half float.
+	inline uint16_t FinishUnquantizeBC6H( int value, bool isSigned )
+	{
+		if( !isSigned )
+			return static_cast<uint16_t>( ( value * 31 ) >> 6 );
+
+		if( value < 0 )
+			return static_cast<uint16_t>( 0x8000 | ( ( -value * 31 ) >> 5 ) );
+
+		return static_cast<uint16_t>( ( value * 31 ) >> 5 );
+	}
+
+	void DecodeBC6H( const uint8_t* block, uint8_t* output, bool isSigned )
+	{
+		const uint16_t HalfOne = 0x3c00;
+		uint16_t* tile = reinterpret_cast<uint16_t*>( output );
+
+		BitReader reader( block );
+		uint32_t modeBits = reader.Read( 2 );
+		if( modeBits > 1 )
+			modeBits |= reader.Read( 3 ) << 2;
+
+		const int modeIndex = BC6HModeIndices[modeBits];
+		if( modeIndex < 0 )
+		{
+			// reserved mode; the block decodes to opaque black
+			for( size_t pixel = 0; pixel < 16; ++pixel )
+			{
+				tile[pixel * 4 + 0] = tile[pixel * 4 + 1] = tile[pixel * 4 + 2] = 0;
+				tile[pixel * 4 + 3] = HalfOne;
+			}
+
+			return;
+		}
+
+		const BC6HMode& mode = BC6HModes[modeIndex];
+		int fields[BC6HFieldCount] = { 0 };
+		for( size_t run = 0; run < mode.RunCount; ++run )
+		{
+			const BC6HFieldRun& current = mode.Runs[run];
+			if( current.First <= current.Last )
+			{
+				for( int bit = current.First; bit <= current.Last; ++bit )
+					fields[current.Field] |= reader.Read( 1 ) << bit;
+			}
+			else
+			{
+				for( int bit = current.First; bit >= current.Last; --bit )
+					fields[current.Field] |= reader.Read( 1 ) << bit;
+			}
+		}
+
+		// endpoints are A0, B0 for the first region and A1, B1 for the second
+		int endpoints[4][3] =
+		{
+			{ fields[RW], fields[GW], fields[BW] },
+			{ fields[RX], fields[GX], fields[BX] },
+			{ fields[RY], fields[GY], fields[BY] },
+			{ fields[RZ], fields[GZ], fields[BZ] }
+		};
+
+		const size_t endpointCount = mode.Regions * 2u;
+		for( size_t channel = 0; channel < 3; ++channel )
+		{
+			if( isSigned )
+				endpoints[0][channel] = SignExtend( endpoints[0][channel], mode.EndpointBits );
+
+			if( isSigned || mode.Transformed )
+			{
+				for( size_t endpoint = 1; endpoint < endpointCount; ++endpoint )
+					endpoints[endpoint][channel] = SignExtend( endpoints[endpoint][channel], mode.DeltaBits[channel] );
+			}
+
+			if( mode.Transformed )
+			{
+				const int mask = ( 1 << mode.EndpointBits ) - 1;
+				for( size_t endpoint = 1; endpoint < endpointCount; ++endpoint )
+				{
+					endpoints[endpoint][channel] = ( endpoints[0][channel] + endpoints[endpoint][channel] ) & mask;
+					if( isSigned )
+						endpoints[endpoint][channel] = SignExtend( endpoints[endpoint][channel], mode.EndpointBits );
+				}
+			}
+
+			for( size_t endpoint = 0; endpoint < endpointCount; ++endpoint )
+				endpoints[endpoint][channel] = UnquantizeBC6H( endpoints[endpoint][channel], mode.EndpointBits, isSigned );
+		}
+
+		const size_t indexBits = mode.Regions == 2 ? 3 : 4;
+		const uint16_t* weights = WeightTables[indexBits];
+		const uint8_t* regions = mode.Regions == 2 ? Partitions2[fields[D]] : SingleSubset;
+		const size_t anchor = mode.Regions == 2 ? Anchors2[fields[D]] : 0;
+
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+		{
+			const int weight = weights[reader.Read( indexBits - ( ( pixel == 0 || pixel == anchor ) ? 1 : 0 ) )];
+			const int* a = endpoints[regions[pixel] * 2];
+			const int* b = endpoints[regions[pixel] * 2 + 1];
+
+			for( size_t channel = 0; channel < 3; ++channel )
+				tile[pixel * 4 + channel] = FinishUnquantizeBC6H( ( a[channel] * ( 64 - weight ) + b[channel] * weight + 32 ) >> 6, isSigned );
+
+			tile[pixel * 4 + 3] = HalfOne;
+		}
+	}
+
+	void DecodeBC6HU( const uint8_t* block, uint8_t* tile )
+	{
+		DecodeBC6H( block, tile, false );
+	}
+
+	void DecodeBC6HS( const uint8_t* block, uint8_t* tile )
+	{
+		DecodeBC6H( block, tile, true );
+	}
+
+	typedef void (*BlockDecoder)( const uint8_t* block, uint8_t* tile );
+
+	BlockDecoder GetBlockDecoder( DXGI_FORMAT format )
+	{
+		switch( format )
+		{
+		case DXGI_FORMAT_BC1_TYPELESS:
+		case DXGI_FORMAT_BC1_UNORM:
+		case DXGI_FORMAT_BC1_UNORM_SRGB:
+			return DecodeBC1;
+
+		case DXGI_FORMAT_BC2_TYPELESS:
+		case DXGI_FORMAT_BC2_UNORM:
+		case DXGI_FORMAT_BC2_UNORM_SRGB:
+			return DecodeBC2;
+
+		case DXGI_FORMAT_BC3_TYPELESS:
+		case DXGI_FORMAT_BC3_UNORM:
+		case DXGI_FORMAT_BC3_UNORM_SRGB:
+			return DecodeBC3;
+
+		case DXGI_FORMAT_BC4_TYPELESS:
+		case DXGI_FORMAT_BC4_UNORM:
+			return DecodeBC4U;
+
+		case DXGI_FORMAT_BC4_SNORM:
+			return DecodeBC4S;
+
+		case DXGI_FORMAT_BC5_TYPELESS:
+		case DXGI_FORMAT_BC5_UNORM:
+			return DecodeBC5U;
+
+		case DXGI_FORMAT_BC5_SNORM:
+			return DecodeBC5S;
+
+		case DXGI_FORMAT_BC6H_TYPELESS:
+		case DXGI_FORMAT_BC6H_UF16:
+			return DecodeBC6HU;
+
+		case DXGI_FORMAT_BC6H_SF16:
+			return DecodeBC6HS;
+
+		case DXGI_FORMAT_BC7_TYPELESS:
+		case DXGI_FORMAT_BC7_UNORM:
+		case DXGI_FORMAT_BC7_UNORM_SRGB:
+			return DecodeBC7;
+		}
+
+		return NULL;
+	}
+}
+
+	size_t GetBlockSize( DXGI_FORMAT format )
+	{
+		switch( format )
+		{
+		case DXGI_FORMAT_BC1_TYPELESS:
+		case DXGI_FORMAT_BC1_UNORM:
+		case DXGI_FORMAT_BC1_UNORM_SRGB:
+		case DXGI_FORMAT_BC4_TYPELESS:
+		case DXGI_FORMAT_BC4_UNORM:
+		case DXGI_FORMAT_BC4_SNORM:
+			return 8;
+
+		case DXGI_FORMAT_BC2_TYPELESS:
+		case DXGI_FORMAT_BC2_UNORM:
+		case DXGI_FORMAT_BC2_UNORM_SRGB:
+		case DXGI_FORMAT_BC3_TYPELESS:
+		case DXGI_FORMAT_BC3_UNORM:
+		case DXGI_FORMAT_BC3_UNORM_SRGB:
+		case DXGI_FORMAT_BC5_TYPELESS:
+		case DXGI_FORMAT_BC5_UNORM:
+		case DXGI_FORMAT_BC5_SNORM:
+		case DXGI_FORMAT_BC6H_TYPELESS:
+		case DXGI_FORMAT_BC6H_UF16:
+		case DXGI_FORMAT_BC6H_SF16:
+		case DXGI_FORMAT_BC7_TYPELESS:
+		case DXGI_FORMAT_BC7_UNORM:
+		case DXGI_FORMAT_BC7_UNORM_SRGB:
+			return 16;
+		}
+
+		return 0;
+	}
+
+	DXGI_FORMAT GetDecompressedFormat( DXGI_FORMAT format )
+	{
+		switch( format )
+		{
+		case DXGI_FORMAT_BC1_TYPELESS:
+		case DXGI_FORMAT_BC2_TYPELESS:
+		case DXGI_FORMAT_BC3_TYPELESS:
+		case DXGI_FORMAT_BC7_TYPELESS:
+			return DXGI_FORMAT_R8G8B8A8_TYPELESS;
+
+		case DXGI_FORMAT_BC1_UNORM:
+		case DXGI_FORMAT_BC2_UNORM:
+		case DXGI_FORMAT_BC3_UNORM:
+		case DXGI_FORMAT_BC7_UNORM:
+			return DXGI_FORMAT_R8G8B8A8_UNORM;
+
+		case DXGI_FORMAT_BC1_UNORM_SRGB:
+		case DXGI_FORMAT_BC2_UNORM_SRGB:
+		case DXGI_FORMAT_BC3_UNORM_SRGB:
+		case DXGI_FORMAT_BC7_UNORM_SRGB:
+			return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+
+		case DXGI_FORMAT_BC4_TYPELESS:
+			return DXGI_FORMAT_R8_TYPELESS;
+		case DXGI_FORMAT_BC4_UNORM:
+			return DXGI_FORMAT_R8_UNORM;
+		case DXGI_FORMAT_BC4_SNORM:
+			return DXGI_FORMAT_R8_SNORM;
+
+		case DXGI_FORMAT_BC5_TYPELESS:
+			return DXGI_FORMAT_R8G8_TYPELESS;
+		case DXGI_FORMAT_BC5_UNORM:
+			return DXGI_FORMAT_R8G8_UNORM;
+		case DXGI_FORMAT_BC5_SNORM:
+			return DXGI_FORMAT_R8G8_SNORM;
+
+		case DXGI_FORMAT_BC6H_TYPELESS:
+			return DXGI_FORMAT_R16G16B16A16_TYPELESS;
+		case DXGI_FORMAT_BC6H_UF16:
+		case DXGI_FORMAT_BC6H_SF16:
+			return DXGI_FORMAT_R16G16B16A16_FLOAT;
+		}
+
+		return DXGI_FORMAT_UNKNOWN;
+	}
+
+	size_t GetDecompressedPixelSize( DXGI_FORMAT format )
+	{
+		switch( GetDecompressedFormat( format ) )
+		{
+		case DXGI_FORMAT_R8_TYPELESS:
+		case DXGI_FORMAT_R8_UNORM:
+		case DXGI_FORMAT_R8_SNORM:
+			return 1;
+
+		case DXGI_FORMAT_R8G8_TYPELESS:
+		case DXGI_FORMAT_R8G8_UNORM:
+		case DXGI_FORMAT_R8G8_SNORM:
+			return 2;
+
+		case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+		case DXGI_FORMAT_R16G16B16A16_FLOAT:
+			return 8;
+
+		case DXGI_FORMAT_UNKNOWN:
+			return 0;
+		}
+
+		return 4;
+	}
+
+	void DecodeBlockRow( void* context, int blockRow )
+	{
+		const DecodeJob& job = *static_cast<const DecodeJob*>( context );
+		const BlockDecoder decoder = GetBlockDecoder( job.Format );
+		const size_t blockSize = GetBlockSize( job.Format );
+		const size_t pixelSize = GetDecompressedPixelSize( job.Format );
+		const size_t tilePitch = pixelSize * 4;
+
+		const size_t y = static_cast<size_t>( blockRow ) * 4;
+		const size_t rows = std::min<size_t>( 4, job.Height - y );
+		const uint8_t* block = job.Source + blockRow * job.SourcePitch;
+		uint8_t* destination = job.Destination + y * job.DestinationPitch;
+
+		__declspec(align(16)) uint8_t tile[16 * 8];
+		for( size_t x = 0; x < job.Width; x += 4, block += blockSize )
+		{
+			decoder( block, tile );
+
+			const size_t columns = std::min<size_t>( 4, job.Width - x );
+			uint8_t* target = destination + x * pixelSize;
+			for( size_t row = 0; row < rows; ++row, target += job.DestinationPitch )
+				memcpy( target, tile + row * tilePitch, columns * pixelSize );
+		}
+	}
+}
+}
+}
+
+#pragma managed(pop)
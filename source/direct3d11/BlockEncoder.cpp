@@ -0,0 +1,1103 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#pragma managed(push, off)
+
+#include <emmintrin.h>
+
+#include "BlockCodec.h"
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+namespace BlockCodec
+{
+namespace
+{
+	const uint8_t SingleSubset[16] = { 0 };
+
+	const uint16_t* const WeightTables[5] = { NULL, NULL, Weights2, Weights3, Weights4 };
+
+	// Interpolation weights of the BC1 four and three colour modes, as the fraction taken from the second endpoint.
+	const float ColorWeights4[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+	const float ColorWeights3[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+
+	const uint32_t ColorMask = 0x00ffffff;
+	const uint32_t AlphaMask = 0xff000000;
+	const uint32_t AllChannels = 0xffffffff;
+
+	// Accumulates little-endian bit fields into a 128-bit block, least significant bit first.
+	class BitWriter
+	{
+	private:
+		uint64_t m_Low;
+		uint64_t m_High;
+		size_t m_Position;
+
+	public:
+		BitWriter()
+		: m_Low( 0 ), m_High( 0 ), m_Position( 0 )
+		{
+		}
+
+		void Write( uint32_t value, size_t count )
+		{
+			if( count == 0 )
+				return;
+
+			uint64_t bits = value & ( ( 1ull << count ) - 1 );
+			if( m_Position >= 64 )
+			{
+				m_High |= bits << ( m_Position - 64 );
+			}
+			else
+			{
+				m_Low |= bits << m_Position;
+				if( m_Position + count > 64 )
+					m_High |= bits >> ( 64 - m_Position );
+			}
+
+			m_Position += count;
+		}
+
+		void Store( uint8_t* block ) const
+		{
+			memcpy( block, &m_Low, sizeof( m_Low ) );
+			memcpy( block + sizeof( m_Low ), &m_High, sizeof( m_High ) );
+		}
+	};
+
+	inline float Clamp255( float value )
+	{
+		return std::min( std::max( value, 0.0f ), 255.0f );
+	}
+
+	inline int Channel( uint32_t pixel, size_t channel )
+	{
+		return static_cast<int>( ( pixel >> ( channel * 8 ) ) & 0xff );
+	}
+
+	inline bool IsActive( uint32_t mask, size_t channel )
+	{
+		return ( ( mask >> ( channel * 8 ) ) & 0xff ) != 0;
+	}
+
+	// Finds the nearest palette entry to each pixel, comparing only the channels in mask, and returns the summed
+	// squared error. Four entries are compared per step as (error << 4) | index keys, so ties resolve to the
+	// lowest index. paletteSize must be a multiple of four, up to sixteen.
+	uint32_t FitIndices( const uint32_t* pixels, size_t count, const uint32_t* palette, size_t paletteSize, uint32_t mask, uint8_t* indices )
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i channelMask = _mm_set1_epi32( static_cast<int>( mask ) );
+
+		__m128i entries[8];
+		for( size_t entry = 0; entry < paletteSize; entry += 2 )
+		{
+			__m128i pair = _mm_and_si128( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( palette + entry ) ), channelMask );
+			entries[entry / 2] = _mm_unpacklo_epi8( pair, zero );
+		}
+
+		uint32_t error = 0;
+		for( size_t pixel = 0; pixel < count; ++pixel )
+		{
+			const __m128i value = _mm_unpacklo_epi8( _mm_and_si128( _mm_set1_epi32( static_cast<int>( pixels[pixel] ) ), channelMask ), zero );
+			__m128i best = _mm_set1_epi32( 0x7fffffff );
+
+			for( size_t entry = 0; entry < paletteSize; entry += 4 )
+			{
+				__m128i low = _mm_sub_epi16( value, entries[entry / 2] );
+				__m128i high = _mm_sub_epi16( value, entries[entry / 2 + 1] );
+				low = _mm_madd_epi16( low, low );
+				high = _mm_madd_epi16( high, high );
+
+				// each entry left two partial sums (r + g, b + a); gather and add them
+				__m128 even = _mm_shuffle_ps( _mm_castsi128_ps( low ), _mm_castsi128_ps( high ), _MM_SHUFFLE( 2, 0, 2, 0 ) );
+				__m128 odd = _mm_shuffle_ps( _mm_castsi128_ps( low ), _mm_castsi128_ps( high ), _MM_SHUFFLE( 3, 1, 3, 1 ) );
+				__m128i distance = _mm_add_epi32( _mm_castps_si128( even ), _mm_castps_si128( odd ) );
+
+				const int base = static_cast<int>( entry );
+				__m128i key = _mm_or_si128( _mm_slli_epi32( distance, 4 ), _mm_setr_epi32( base, base + 1, base + 2, base + 3 ) );
+				__m128i less = _mm_cmplt_epi32( key, best );
+				best = _mm_or_si128( _mm_and_si128( less, key ), _mm_andnot_si128( less, best ) );
+			}
+
+			__m128i other = _mm_shuffle_epi32( best, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+			__m128i less = _mm_cmplt_epi32( other, best );
+			best = _mm_or_si128( _mm_and_si128( less, other ), _mm_andnot_si128( less, best ) );
+			other = _mm_shuffle_epi32( best, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+			less = _mm_cmplt_epi32( other, best );
+			best = _mm_or_si128( _mm_and_si128( less, other ), _mm_andnot_si128( less, best ) );
+
+			const uint32_t key = static_cast<uint32_t>( _mm_cvtsi128_si32( best ) );
+			indices[pixel] = static_cast<uint8_t>( key & 0xf );
+			error += key >> 4;
+		}
+
+		return error;
+	}
+
+	// Computes the mean of the pixels and the principal axis of their covariance over the channels in mask,
+	// by power iteration. Returns the variance left unexplained by the axis, which ranks candidate partitions.
+	float PrincipalAxis( const uint32_t* pixels, size_t count, uint32_t mask, float* mean, float* axis )
+	{
+		float covariance[4][4] = { { 0 } };
+		for( size_t channel = 0; channel < 4; ++channel )
+		{
+			mean[channel] = 0;
+			axis[channel] = 0;
+		}
+
+		for( size_t pixel = 0; pixel < count; ++pixel )
+		{
+			for( size_t channel = 0; channel < 4; ++channel )
+				mean[channel] += static_cast<float>( Channel( pixels[pixel], channel ) );
+		}
+
+		for( size_t channel = 0; channel < 4; ++channel )
+			mean[channel] /= static_cast<float>( count );
+
+		for( size_t pixel = 0; pixel < count; ++pixel )
+		{
+			float delta[4];
+			for( size_t channel = 0; channel < 4; ++channel )
+				delta[channel] = IsActive( mask, channel ) ? static_cast<float>( Channel( pixels[pixel], channel ) ) - mean[channel] : 0.0f;
+
+			for( size_t row = 0; row < 4; ++row )
+			{
+				for( size_t column = row; column < 4; ++column )
+					covariance[row][column] += delta[row] * delta[column];
+			}
+		}
+
+		float trace = 0;
+		size_t largest = 0;
+		for( size_t row = 0; row < 4; ++row )
+		{
+			for( size_t column = 0; column < row; ++column )
+				covariance[row][column] = covariance[column][row];
+
+			trace += covariance[row][row];
+			if( covariance[row][row] > covariance[largest][largest] )
+				largest = row;
+		}
+
+		if( trace <= 0.0f )
+			return 0.0f;
+
+		// start from the most varied channel's row, which is never orthogonal to the dominant axis
+		float vector[4];
+		for( size_t channel = 0; channel < 4; ++channel )
+			vector[channel] = covariance[largest][channel];
+
+		float length = 0;
+		for( int iteration = 0; iteration < 8; ++iteration )
+		{
+			float next[4];
+			for( size_t row = 0; row < 4; ++row )
+				next[row] = covariance[row][0] * vector[0] + covariance[row][1] * vector[1] + covariance[row][2] * vector[2] + covariance[row][3] * vector[3];
+
+			length = std::sqrt( next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3] );
+			if( length <= 0.0f )
+				return trace;
+
+			for( size_t channel = 0; channel < 4; ++channel )
+				vector[channel] = next[channel] / length;
+		}
+
+		for( size_t channel = 0; channel < 4; ++channel )
+			axis[channel] = vector[channel];
+
+		// length converges on the largest eigenvalue once vector is a unit eigenvector
+		return std::max( trace - length, 0.0f );
+	}
+
+	// Places two endpoints at the extremes of the pixels' projection onto their principal axis.
+	void FitEndpoints( const uint32_t* pixels, size_t count, uint32_t mask, float* endpoint0, float* endpoint1 )
+	{
+		float mean[4], axis[4];
+		PrincipalAxis( pixels, count, mask, mean, axis );
+
+		float minimum = 0, maximum = 0;
+		for( size_t pixel = 0; pixel < count; ++pixel )
+		{
+			float projection = 0;
+			for( size_t channel = 0; channel < 4; ++channel )
+				projection += ( static_cast<float>( Channel( pixels[pixel], channel ) ) - mean[channel] ) * axis[channel];
+
+			minimum = std::min( minimum, projection );
+			maximum = std::max( maximum, projection );
+		}
+
+		for( size_t channel = 0; channel < 4; ++channel )
+		{
+			endpoint0[channel] = Clamp255( mean[channel] + axis[channel] * minimum );
+			endpoint1[channel] = Clamp255( mean[channel] + axis[channel] * maximum );
+		}
+	}
+
+	// Solves for the endpoints that minimise the squared error of the given index assignment. weights holds
+	// the fraction of the second endpoint for each index. Returns false if the assignment is degenerate.
+	bool SolveEndpoints( const uint32_t* pixels, size_t count, const uint8_t* indices, const float* weights, float* endpoint0, float* endpoint1 )
+	{
+		float aa = 0, bb = 0, ab = 0;
+		float ax[4] = { 0 }, bx[4] = { 0 };
+		for( size_t pixel = 0; pixel < count; ++pixel )
+		{
+			const float b = weights[indices[pixel]];
+			const float a = 1.0f - b;
+			aa += a * a;
+			bb += b * b;
+			ab += a * b;
+
+			for( size_t channel = 0; channel < 4; ++channel )
+			{
+				const float value = static_cast<float>( Channel( pixels[pixel], channel ) );
+				ax[channel] += a * value;
+				bx[channel] += b * value;
+			}
+		}
+
+		const float determinant = aa * bb - ab * ab;
+		if( determinant < 1e-4f )
+			return false;
+
+		const float inverse = 1.0f / determinant;
+		for( size_t channel = 0; channel < 4; ++channel )
+		{
+			endpoint0[channel] = Clamp255( ( ax[channel] * bb - bx[channel] * ab ) * inverse );
+			endpoint1[channel] = Clamp255( ( bx[channel] * aa - ax[channel] * ab ) * inverse );
+		}
+
+		return true;
+	}
+
+	//
+	// BC4 style channel blocks (BC3 alpha, BC4, BC5)
+	//
+
+	// Builds the palette DecodeChannelBlock produces for an unsigned endpoint pair, with the same fixed point divides.
+	void BuildChannelPalette( int endpoint0, int endpoint1, uint8_t* palette )
+	{
+		palette[0] = static_cast<uint8_t>( endpoint0 );
+		palette[1] = static_cast<uint8_t>( endpoint1 );
+
+		if( endpoint0 > endpoint1 )
+		{
+			for( int step = 1; step < 7; ++step )
+				palette[step + 1] = static_cast<uint8_t>( ( ( endpoint0 * ( 7 - step ) + endpoint1 * step + 3 ) * 9363 ) >> 16 );
+		}
+		else
+		{
+			for( int step = 1; step < 5; ++step )
+				palette[step + 1] = static_cast<uint8_t>( ( ( endpoint0 * ( 5 - step ) + endpoint1 * step + 2 ) * 13108 ) >> 16 );
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+	}
+
+	// Picks the nearest of eight palette entries for each value and returns the summed squared error.
+	// Distances are packed as (distance << 3) | index into 16-bit lanes so one horizontal minimum finds both.
+	uint32_t FitChannelIndices( const uint8_t* values, const uint8_t* palette, uint8_t* indices )
+	{
+		const __m128i entries = _mm_unpacklo_epi8( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( palette ) ), _mm_setzero_si128() );
+		const __m128i lanes = _mm_setr_epi16( 0, 1, 2, 3, 4, 5, 6, 7 );
+
+		uint32_t error = 0;
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+		{
+			const __m128i value = _mm_set1_epi16( values[pixel] );
+			__m128i distance = _mm_or_si128( _mm_subs_epu16( value, entries ), _mm_subs_epu16( entries, value ) );
+			__m128i key = _mm_or_si128( _mm_slli_epi16( distance, 3 ), lanes );
+			key = _mm_min_epi16( key, _mm_shuffle_epi32( key, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+			key = _mm_min_epi16( key, _mm_shuffle_epi32( key, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+			key = _mm_min_epi16( key, _mm_shufflelo_epi16( key, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+			const uint32_t best = static_cast<uint32_t>( _mm_cvtsi128_si32( key ) ) & 0xffff;
+			indices[pixel] = static_cast<uint8_t>( best & 7 );
+			error += ( best >> 3 ) * ( best >> 3 );
+		}
+
+		return error;
+	}
+
+	uint32_t EvaluateChannelEndpoints( const uint8_t* values, int endpoint0, int endpoint1, uint8_t* indices )
+	{
+		__declspec(align(16)) uint8_t palette[8];
+		BuildChannelPalette( endpoint0, endpoint1, palette );
+		return FitChannelIndices( values, palette, indices );
+	}
+
+	// Encodes sixteen channel values as a BC4 block. The fast tier uses the eight value mode between the
+	// extremes; higher tiers also try the six value mode and search a small window around both endpoint pairs.
+	void EncodeChannelBlock( const uint8_t* values, EncodeQuality quality, uint8_t* block )
+	{
+		int minimum = 255, maximum = 0;
+		int innerMinimum = 255, innerMaximum = 0;
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+		{
+			const int value = values[pixel];
+			minimum = std::min( minimum, value );
+			maximum = std::max( maximum, value );
+
+			// the six value mode gets 0 and 255 for free, so only the values in between shape its endpoints
+			if( value != 0 && value != 255 )
+			{
+				innerMinimum = std::min( innerMinimum, value );
+				innerMaximum = std::max( innerMaximum, value );
+			}
+		}
+
+		if( innerMinimum > innerMaximum )
+			innerMinimum = innerMaximum = 0;
+
+		uint8_t indices[16], candidate[16];
+		int best0 = maximum, best1 = minimum;
+		uint32_t bestError = EvaluateChannelEndpoints( values, best0, best1, indices );
+
+		if( quality != FastQuality && bestError > 0 )
+		{
+			const int radius = quality == HighQuality ? 4 : 1;
+			const int starts[2][2] = { { maximum, minimum }, { innerMinimum, innerMaximum } };
+
+			for( size_t start = 0; start < 2 && bestError > 0; ++start )
+			{
+				for( int delta0 = -radius; delta0 <= radius; ++delta0 )
+				{
+					for( int delta1 = -radius; delta1 <= radius; ++delta1 )
+					{
+						const int endpoint0 = starts[start][0] + delta0;
+						const int endpoint1 = starts[start][1] + delta1;
+						if( endpoint0 < 0 || endpoint0 > 255 || endpoint1 < 0 || endpoint1 > 255 )
+							continue;
+
+						const uint32_t error = EvaluateChannelEndpoints( values, endpoint0, endpoint1, candidate );
+						if( error < bestError )
+						{
+							bestError = error;
+							best0 = endpoint0;
+							best1 = endpoint1;
+							memcpy( indices, candidate, sizeof( indices ) );
+						}
+					}
+				}
+			}
+		}
+
+		uint64_t packed = 0;
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+			packed |= static_cast<uint64_t>( indices[pixel] ) << ( pixel * 3 );
+
+		block[0] = static_cast<uint8_t>( best0 );
+		block[1] = static_cast<uint8_t>( best1 );
+		memcpy( block + 2, &packed, 6 );
+	}
+
+	void GatherChannel( const uint32_t* tile, size_t channel, uint8_t* values )
+	{
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+			values[pixel] = static_cast<uint8_t>( Channel( tile[pixel], channel ) );
+	}
+
+	//
+	// BC1 style colour blocks (BC1, BC2, BC3)
+	//
+
+	inline uint16_t Quantize565( const float* color )
+	{
+		const int r = static_cast<int>( Clamp255( color[0] ) * ( 31.0f / 255.0f ) + 0.5f );
+		const int g = static_cast<int>( Clamp255( color[1] ) * ( 63.0f / 255.0f ) + 0.5f );
+		const int b = static_cast<int>( Clamp255( color[2] ) * ( 31.0f / 255.0f ) + 0.5f );
+		return static_cast<uint16_t>( ( r << 11 ) | ( g << 5 ) | b );
+	}
+
+	// Builds the palette DecodeColorBlock produces for the endpoints. In the three colour mode the transparent
+	// entry is replaced by a copy of the first, so opaque pixels are never fitted to it.
+	void BuildColorPalette( uint16_t color0, uint16_t color1, bool threeColor, uint32_t* palette )
+	{
+		const uint32_t a = Expand565( color0 );
+		const uint32_t b = Expand565( color1 );
+		palette[0] = a;
+		palette[1] = b;
+		palette[2] = 0;
+		palette[3] = 0;
+
+		for( size_t channel = 0; channel < 4; ++channel )
+		{
+			const uint32_t ca = Channel( a, channel );
+			const uint32_t cb = Channel( b, channel );
+			if( threeColor )
+			{
+				palette[2] |= ( ( ca + cb + 1 ) >> 1 ) << ( channel * 8 );
+			}
+			else
+			{
+				palette[2] |= ( ( ( 2 * ca + cb + 1 ) * 21846 ) >> 16 ) << ( channel * 8 );
+				palette[3] |= ( ( ( ca + 2 * cb + 1 ) * 21846 ) >> 16 ) << ( channel * 8 );
+			}
+		}
+
+		if( threeColor )
+			palette[3] = a;
+	}
+
+	struct ColorFit
+	{
+		uint16_t Color0;
+		uint16_t Color1;
+		bool ThreeColor;
+		uint32_t Error;
+		uint8_t Indices[16];
+	};
+
+	void EvaluateColorEndpoints( const uint32_t* colors, size_t count, const float* endpoint0, const float* endpoint1, bool threeColor, ColorFit& fit )
+	{
+		__declspec(align(16)) uint32_t palette[4];
+		fit.Color0 = Quantize565( endpoint0 );
+		fit.Color1 = Quantize565( endpoint1 );
+		fit.ThreeColor = threeColor;
+		BuildColorPalette( fit.Color0, fit.Color1, threeColor, palette );
+		fit.Error = FitIndices( colors, count, palette, 4, ColorMask, fit.Indices );
+	}
+
+	// Fits one colour mode starting from the given endpoints, then refines them by least squares while that helps.
+	void FitColorMode( const uint32_t* colors, size_t count, const float* start0, const float* start1, bool threeColor, int refinements, ColorFit& fit )
+	{
+		EvaluateColorEndpoints( colors, count, start0, start1, threeColor, fit );
+
+		for( int pass = 0; pass < refinements && fit.Error > 0; ++pass )
+		{
+			float endpoint0[4], endpoint1[4];
+			if( !SolveEndpoints( colors, count, fit.Indices, threeColor ? ColorWeights3 : ColorWeights4, endpoint0, endpoint1 ) )
+				break;
+
+			ColorFit candidate;
+			EvaluateColorEndpoints( colors, count, endpoint0, endpoint1, threeColor, candidate );
+			if( candidate.Error >= fit.Error )
+				break;
+
+			fit = candidate;
+		}
+	}
+
+	// Cheap endpoints for the fast tier: the inset bounding box, with red and blue flipped onto the diagonal
+	// that matches their correlation with green.
+	void BoundingBoxEndpoints( const uint32_t* colors, size_t count, float* endpoint0, float* endpoint1 )
+	{
+		float minimum[3] = { 255, 255, 255 }, maximum[3] = { 0, 0, 0 }, mean[3] = { 0, 0, 0 };
+		for( size_t pixel = 0; pixel < count; ++pixel )
+		{
+			for( size_t channel = 0; channel < 3; ++channel )
+			{
+				const float value = static_cast<float>( Channel( colors[pixel], channel ) );
+				minimum[channel] = std::min( minimum[channel], value );
+				maximum[channel] = std::max( maximum[channel], value );
+				mean[channel] += value;
+			}
+		}
+
+		float redGreen = 0, blueGreen = 0;
+		for( size_t pixel = 0; pixel < count; ++pixel )
+		{
+			const float green = static_cast<float>( Channel( colors[pixel], 1 ) ) - mean[1] / count;
+			redGreen += ( static_cast<float>( Channel( colors[pixel], 0 ) ) - mean[0] / count ) * green;
+			blueGreen += ( static_cast<float>( Channel( colors[pixel], 2 ) ) - mean[2] / count ) * green;
+		}
+
+		for( size_t channel = 0; channel < 3; ++channel )
+		{
+			const float inset = ( maximum[channel] - minimum[channel] ) / 16.0f;
+			endpoint0[channel] = maximum[channel] - inset;
+			endpoint1[channel] = minimum[channel] + inset;
+		}
+
+		if( redGreen < 0 )
+			std::swap( endpoint0[0], endpoint1[0] );
+		if( blueGreen < 0 )
+			std::swap( endpoint0[2], endpoint1[2] );
+
+		endpoint0[3] = endpoint1[3] = 255;
+	}
+
+	// Encodes the 64-bit colour half of a BC1, BC2 or BC3 block. With allowPunchThrough (BC1 only) pixels whose
+	// alpha is below 128 select the transparent entry of the three colour mode.
+	void EncodeColorBlock( const uint32_t* tile, bool allowPunchThrough, EncodeQuality quality, uint8_t* block )
+	{
+		uint32_t colors[16];
+		uint8_t positions[16];
+		size_t count = 0;
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+		{
+			if( allowPunchThrough && ( tile[pixel] >> 24 ) < 128 )
+				continue;
+
+			colors[count] = tile[pixel];
+			positions[count] = static_cast<uint8_t>( pixel );
+			++count;
+		}
+
+		uint16_t color0 = 0, color1 = 0;
+		uint32_t indices = 0xffffffff;
+
+		if( count > 0 )
+		{
+			const bool transparent = count < 16;
+			const int refinements = quality == HighQuality ? 3 : ( quality == NormalQuality ? 1 : 0 );
+
+			float endpoint0[4], endpoint1[4];
+			if( quality == FastQuality )
+				BoundingBoxEndpoints( colors, count, endpoint0, endpoint1 );
+			else
+				FitEndpoints( colors, count, ColorMask, endpoint0, endpoint1 );
+
+			ColorFit fit;
+			FitColorMode( colors, count, endpoint0, endpoint1, transparent, refinements, fit );
+
+			// opaque BC1 blocks may still prefer the three colour mode's midpoint
+			if( allowPunchThrough && !transparent && quality == HighQuality && fit.Error > 0 )
+			{
+				ColorFit candidate;
+				FitColorMode( colors, count, endpoint0, endpoint1, true, refinements, candidate );
+				if( candidate.Error < fit.Error )
+					fit = candidate;
+			}
+
+			// the decoder tells the modes apart by endpoint order, so swap them into place
+			color0 = fit.Color0;
+			color1 = fit.Color1;
+			const bool swap = fit.ThreeColor ? color0 > color1 : color0 < color1;
+			if( swap )
+				std::swap( color0, color1 );
+
+			for( size_t pixel = 0; pixel < count; ++pixel )
+			{
+				uint32_t index = fit.Indices[pixel];
+				if( swap )
+					index = fit.ThreeColor ? ( index < 2 ? index ^ 1 : index ) : index ^ 1;
+
+				indices &= ~( 3u << ( positions[pixel] * 2 ) );
+				indices |= index << ( positions[pixel] * 2 );
+			}
+		}
+
+		memcpy( block, &color0, sizeof( color0 ) );
+		memcpy( block + 2, &color1, sizeof( color1 ) );
+		memcpy( block + 4, &indices, sizeof( indices ) );
+	}
+
+	void EncodeBC1( const uint32_t* tile, EncodeQuality quality, uint8_t* block )
+	{
+		EncodeColorBlock( tile, true, quality, block );
+	}
+
+	void EncodeBC2( const uint32_t* tile, EncodeQuality quality, uint8_t* block )
+	{
+		uint64_t alpha = 0;
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+			alpha |= static_cast<uint64_t>( ( ( tile[pixel] >> 24 ) + 8 ) / 17 ) << ( pixel * 4 );
+
+		memcpy( block, &alpha, sizeof( alpha ) );
+		EncodeColorBlock( tile, false, quality, block + 8 );
+	}
+
+	void EncodeBC3( const uint32_t* tile, EncodeQuality quality, uint8_t* block )
+	{
+		uint8_t values[16];
+		GatherChannel( tile, 3, values );
+		EncodeChannelBlock( values, quality, block );
+		EncodeColorBlock( tile, false, quality, block + 8 );
+	}
+
+	void EncodeBC4( const uint32_t* tile, EncodeQuality quality, uint8_t* block )
+	{
+		uint8_t values[16];
+		GatherChannel( tile, 0, values );
+		EncodeChannelBlock( values, quality, block );
+	}
+
+	void EncodeBC5( const uint32_t* tile, EncodeQuality quality, uint8_t* block )
+	{
+		uint8_t values[16];
+		GatherChannel( tile, 0, values );
+		EncodeChannelBlock( values, quality, block );
+		GatherChannel( tile, 1, values );
+		EncodeChannelBlock( values, quality, block + 8 );
+	}
+
+	//
+	// BC7
+	//
+
+	struct SubsetFit
+	{
+		uint32_t Quantized[2][4];
+		uint32_t PBits[2];
+		uint8_t Indices[16];
+		uint32_t Error;
+	};
+
+	// Quantizes one endpoint for the given p-bit, choosing per channel among the codes nearest the target.
+	// Returns the squared quantization error over the channels in mask.
+	float QuantizeEndpoint( const BC7Mode& info, const float* value, uint32_t mask, uint32_t pbit, uint32_t* quantized, uint32_t& packed )
+	{
+		const uint32_t hasPBit = ( info.EndpointPBits || info.SharedPBits ) ? 1 : 0;
+		float error = 0;
+		packed = 0;
+
+		for( size_t channel = 0; channel < 4; ++channel )
+		{
+			const size_t bits = channel < 3 ? info.ColorBits : info.AlphaBits;
+			if( bits == 0 )
+			{
+				quantized[channel] = 0;
+				packed |= 0xffu << ( channel * 8 );
+				continue;
+			}
+
+			const size_t precision = bits + hasPBit;
+			const int maximum = ( 1 << bits ) - 1;
+			const float target = Clamp255( value[channel] );
+			const int guess = static_cast<int>( ( target * ( ( 1 << precision ) - 1 ) / 255.0f - pbit ) / ( 1 << hasPBit ) + 0.5f );
+
+			int best = 0;
+			float bestError = 1e30f;
+			for( int code = std::max( guess - 1, 0 ); code <= std::min( guess + 1, maximum ); ++code )
+			{
+				const float delta = Unquantize( ( code << hasPBit ) | pbit, precision ) - target;
+				if( delta * delta < bestError )
+				{
+					bestError = delta * delta;
+					best = code;
+				}
+			}
+
+			quantized[channel] = best;
+			packed |= static_cast<uint32_t>( Unquantize( ( best << hasPBit ) | pbit, precision ) ) << ( channel * 8 );
+			if( IsActive( mask, channel ) )
+				error += bestError;
+		}
+
+		return error;
+	}
+
+	// Quantizes both endpoints of a subset, picking the p-bits that lose the least precision, then fits indices.
+	void EvaluateSubset( const BC7Mode& info, const uint32_t* pixels, size_t count, size_t indexBits, uint32_t mask, const float* endpoint0, const float* endpoint1, SubsetFit& fit )
+	{
+		uint32_t packed[2];
+		const float* endpoints[2] = { endpoint0, endpoint1 };
+
+		if( info.EndpointPBits )
+		{
+			for( size_t endpoint = 0; endpoint < 2; ++endpoint )
+			{
+				uint32_t quantized[4], candidate;
+				const float error0 = QuantizeEndpoint( info, endpoints[endpoint], mask, 0, fit.Quantized[endpoint], packed[endpoint] );
+				const float error1 = QuantizeEndpoint( info, endpoints[endpoint], mask, 1, quantized, candidate );
+				fit.PBits[endpoint] = 0;
+				if( error1 < error0 )
+				{
+					memcpy( fit.Quantized[endpoint], quantized, sizeof( quantized ) );
+					packed[endpoint] = candidate;
+					fit.PBits[endpoint] = 1;
+				}
+			}
+		}
+		else if( info.SharedPBits )
+		{
+			uint32_t quantized[2][4], candidate[2];
+			const float error0 = QuantizeEndpoint( info, endpoint0, mask, 0, fit.Quantized[0], packed[0] ) + QuantizeEndpoint( info, endpoint1, mask, 0, fit.Quantized[1], packed[1] );
+			const float error1 = QuantizeEndpoint( info, endpoint0, mask, 1, quantized[0], candidate[0] ) + QuantizeEndpoint( info, endpoint1, mask, 1, quantized[1], candidate[1] );
+			fit.PBits[0] = fit.PBits[1] = 0;
+			if( error1 < error0 )
+			{
+				memcpy( fit.Quantized, quantized, sizeof( quantized ) );
+				packed[0] = candidate[0];
+				packed[1] = candidate[1];
+				fit.PBits[0] = fit.PBits[1] = 1;
+			}
+		}
+		else
+		{
+			fit.PBits[0] = fit.PBits[1] = 0;
+			QuantizeEndpoint( info, endpoint0, mask, 0, fit.Quantized[0], packed[0] );
+			QuantizeEndpoint( info, endpoint1, mask, 0, fit.Quantized[1], packed[1] );
+		}
+
+		__declspec(align(16)) uint32_t palette[16];
+		BuildPalette( packed[0], packed[1], WeightTables[indexBits], size_t( 1 ) << indexBits, palette );
+		fit.Error = FitIndices( pixels, count, palette, size_t( 1 ) << indexBits, mask, fit.Indices );
+	}
+
+	void FitSubset( const BC7Mode& info, const uint32_t* pixels, size_t count, size_t indexBits, uint32_t mask, int refinements, SubsetFit& fit )
+	{
+		float endpoint0[4], endpoint1[4];
+		FitEndpoints( pixels, count, mask, endpoint0, endpoint1 );
+		EvaluateSubset( info, pixels, count, indexBits, mask, endpoint0, endpoint1, fit );
+
+		float weights[16];
+		for( size_t index = 0; index < ( size_t( 1 ) << indexBits ); ++index )
+			weights[index] = WeightTables[indexBits][index] / 64.0f;
+
+		for( int pass = 0; pass < refinements && fit.Error > 0; ++pass )
+		{
+			if( !SolveEndpoints( pixels, count, fit.Indices, weights, endpoint0, endpoint1 ) )
+				break;
+
+			SubsetFit candidate;
+			EvaluateSubset( info, pixels, count, indexBits, mask, endpoint0, endpoint1, candidate );
+			if( candidate.Error >= fit.Error )
+				break;
+
+			fit = candidate;
+		}
+	}
+
+	const uint8_t* GetPartitionTable( size_t subsets, uint32_t partition )
+	{
+		if( subsets == 2 )
+			return Partitions2[partition];
+		if( subsets == 3 )
+			return Partitions3[partition];
+
+		return SingleSubset;
+	}
+
+	size_t GatherSubset( const uint32_t* tile, const uint8_t* table, size_t subset, uint32_t* pixels, uint8_t* positions )
+	{
+		size_t count = 0;
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+		{
+			if( table[pixel] != subset )
+				continue;
+
+			pixels[count] = tile[pixel];
+			positions[count] = static_cast<uint8_t>( pixel );
+			++count;
+		}
+
+		return count;
+	}
+
+	// Ranks the partitions of a two or three subset mode by how much variance a line through each subset
+	// leaves unexplained, and writes the best count of them to best in ascending order of that estimate.
+	size_t RankPartitions( const uint32_t* tile, size_t subsets, size_t partitionCount, uint32_t mask, size_t count, uint32_t* best )
+	{
+		float scores[8];
+		size_t ranked = 0;
+
+		for( uint32_t partition = 0; partition < partitionCount; ++partition )
+		{
+			const uint8_t* table = GetPartitionTable( subsets, partition );
+			float score = 0;
+			for( size_t subset = 0; subset < subsets; ++subset )
+			{
+				uint32_t pixels[16];
+				uint8_t positions[16];
+				float mean[4], axis[4];
+				const size_t pixelCount = GatherSubset( tile, table, subset, pixels, positions );
+				score += PrincipalAxis( pixels, pixelCount, mask, mean, axis );
+			}
+
+			// insertion into the short sorted list; equal scores keep the lower partition first
+			size_t slot = ranked;
+			while( slot > 0 && score < scores[slot - 1] )
+				--slot;
+
+			if( slot >= count )
+				continue;
+
+			const size_t last = std::min( ranked, count - 1 );
+			for( size_t move = last; move > slot; --move )
+			{
+				scores[move] = scores[move - 1];
+				best[move] = best[move - 1];
+			}
+
+			scores[slot] = score;
+			best[slot] = partition;
+			ranked = std::min( ranked + 1, count );
+		}
+
+		return ranked;
+	}
+
+	struct BC7Encoding
+	{
+		uint32_t Error;
+		uint8_t Block[16];
+	};
+
+	// Makes the anchor index of a subset fit in one bit less by swapping its endpoints and mirroring its
+	// indices, which leaves the decoded palette unchanged because the weight tables are symmetric.
+	void FixAnchor( uint8_t* indices, const uint8_t* table, size_t subset, size_t anchor, size_t indexBits, uint32_t quantized[][4], uint32_t* pbits, size_t firstChannel, size_t lastChannel )
+	{
+		const uint8_t highBit = static_cast<uint8_t>( 1 << ( indexBits - 1 ) );
+		if( !( indices[anchor] & highBit ) )
+			return;
+
+		const uint8_t maximum = static_cast<uint8_t>( ( 1 << indexBits ) - 1 );
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+		{
+			if( table[pixel] == subset )
+				indices[pixel] = maximum - indices[pixel];
+		}
+
+		for( size_t channel = firstChannel; channel <= lastChannel; ++channel )
+			std::swap( quantized[subset * 2][channel], quantized[subset * 2 + 1][channel] );
+
+		if( pbits != NULL )
+			std::swap( pbits[subset * 2], pbits[subset * 2 + 1] );
+	}
+
+	// Encodes the tile in one BC7 mode and partition and keeps the result if it beats best.
+	// Modes 4 and 5 are only used without rotation and with the colour channels on the primary indices.
+	void TryBC7Mode( const uint32_t* tile, size_t mode, uint32_t partition, int refinements, BC7Encoding& best )
+	{
+		const BC7Mode& info = BC7Modes[mode];
+		const uint8_t* table = GetPartitionTable( info.Subsets, partition );
+		const uint32_t mask = ( info.AlphaBits && !info.SecondaryIndexBits ) ? AllChannels : ColorMask;
+
+		uint32_t quantized[6][4];
+		uint32_t pbits[6];
+		uint8_t indices[16], secondaryIndices[16];
+		uint32_t error = 0;
+
+		for( size_t subset = 0; subset < info.Subsets; ++subset )
+		{
+			uint32_t pixels[16];
+			uint8_t positions[16];
+			const size_t count = GatherSubset( tile, table, subset, pixels, positions );
+
+			SubsetFit fit;
+			FitSubset( info, pixels, count, info.IndexBits, mask, refinements, fit );
+			error += fit.Error;
+			if( error >= best.Error )
+				return;
+
+			memcpy( quantized[subset * 2], fit.Quantized, sizeof( fit.Quantized ) );
+			pbits[subset * 2] = fit.PBits[0];
+			pbits[subset * 2 + 1] = fit.PBits[1];
+			for( size_t pixel = 0; pixel < count; ++pixel )
+				indices[positions[pixel]] = fit.Indices[pixel];
+		}
+
+		if( info.SecondaryIndexBits )
+		{
+			SubsetFit fit;
+			FitSubset( info, tile, 16, info.SecondaryIndexBits, AlphaMask, refinements, fit );
+			error += fit.Error;
+			if( error >= best.Error )
+				return;
+
+			quantized[0][3] = fit.Quantized[0][3];
+			quantized[1][3] = fit.Quantized[1][3];
+			memcpy( secondaryIndices, fit.Indices, sizeof( secondaryIndices ) );
+		}
+
+		const uint32_t* pbitSource = ( info.EndpointPBits || info.SharedPBits ) ? pbits : NULL;
+		const size_t lastChannel = info.SecondaryIndexBits ? 2 : 3;
+		FixAnchor( indices, table, 0, 0, info.IndexBits, quantized, pbits, 0, lastChannel );
+		if( info.Subsets == 2 )
+		{
+			FixAnchor( indices, table, 1, Anchors2[partition], info.IndexBits, quantized, pbits, 0, lastChannel );
+		}
+		else if( info.Subsets == 3 )
+		{
+			FixAnchor( indices, table, 1, Anchors3[0][partition], info.IndexBits, quantized, pbits, 0, lastChannel );
+			FixAnchor( indices, table, 2, Anchors3[1][partition], info.IndexBits, quantized, pbits, 0, lastChannel );
+		}
+
+		if( info.SecondaryIndexBits )
+			FixAnchor( secondaryIndices, SingleSubset, 0, 0, info.SecondaryIndexBits, quantized, NULL, 3, 3 );
+
+		const size_t anchor1 = info.Subsets == 2 ? Anchors2[partition] : ( info.Subsets == 3 ? Anchors3[0][partition] : 0 );
+		const size_t anchor2 = info.Subsets == 3 ? Anchors3[1][partition] : 0;
+		const size_t endpointCount = info.Subsets * 2u;
+
+		BitWriter writer;
+		writer.Write( 1u << mode, mode + 1 );
+		writer.Write( partition, info.PartitionBits );
+		writer.Write( 0, info.RotationBits );
+		writer.Write( 0, info.IndexSelectionBits );
+
+		for( size_t channel = 0; channel < 3; ++channel )
+		{
+			for( size_t endpoint = 0; endpoint < endpointCount; ++endpoint )
+				writer.Write( quantized[endpoint][channel], info.ColorBits );
+		}
+
+		for( size_t endpoint = 0; endpoint < endpointCount && info.AlphaBits; ++endpoint )
+			writer.Write( quantized[endpoint][3], info.AlphaBits );
+
+		if( info.EndpointPBits )
+		{
+			for( size_t endpoint = 0; endpoint < endpointCount; ++endpoint )
+				writer.Write( pbitSource[endpoint], 1 );
+		}
+		else if( info.SharedPBits )
+		{
+			for( size_t subset = 0; subset < info.Subsets; ++subset )
+				writer.Write( pbitSource[subset * 2], 1 );
+		}
+
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+		{
+			const bool anchor = pixel == 0 || pixel == anchor1 || pixel == anchor2;
+			writer.Write( indices[pixel], info.IndexBits - ( anchor ? 1 : 0 ) );
+		}
+
+		if( info.SecondaryIndexBits )
+		{
+			for( size_t pixel = 0; pixel < 16; ++pixel )
+				writer.Write( secondaryIndices[pixel], info.SecondaryIndexBits - ( pixel == 0 ? 1 : 0 ) );
+		}
+
+		best.Error = error;
+		writer.Store( best.Block );
+	}
+
+	void TryBC7Partitions( const uint32_t* tile, size_t mode, size_t candidates, int refinements, BC7Encoding& best )
+	{
+		const BC7Mode& info = BC7Modes[mode];
+		const uint32_t mask = info.AlphaBits ? AllChannels : ColorMask;
+
+		uint32_t partitions[8];
+		const size_t count = RankPartitions( tile, info.Subsets, size_t( 1 ) << info.PartitionBits, mask, candidates, partitions );
+		for( size_t candidate = 0; candidate < count && best.Error > 0; ++candidate )
+			TryBC7Mode( tile, mode, partitions[candidate], refinements, best );
+	}
+
+	// Mode 6 alone for the fast tier. Higher tiers add the two subset modes on their best ranked partitions,
+	// and the high tier adds the three subset modes and widens the partition search.
+	void EncodeBC7( const uint32_t* tile, EncodeQuality quality, uint8_t* block )
+	{
+		bool opaque = true;
+		for( size_t pixel = 0; pixel < 16; ++pixel )
+			opaque = opaque && ( tile[pixel] >> 24 ) == 0xff;
+
+		const int refinements = static_cast<int>( quality );
+		const size_t candidates = quality == HighQuality ? 4 : 1;
+
+		BC7Encoding best;
+		best.Error = 0xffffffff;
+		TryBC7Mode( tile, 6, 0, refinements, best );
+
+		if( quality != FastQuality && best.Error > 0 )
+		{
+			if( opaque )
+			{
+				TryBC7Partitions( tile, 1, candidates, refinements, best );
+				TryBC7Partitions( tile, 3, candidates, refinements, best );
+
+				if( quality == HighQuality )
+				{
+					TryBC7Partitions( tile, 0, 2, refinements, best );
+					TryBC7Partitions( tile, 2, 2, refinements, best );
+				}
+			}
+			else
+			{
+				TryBC7Mode( tile, 5, 0, refinements, best );
+				TryBC7Partitions( tile, 7, candidates, refinements, best );
+			}
+		}
+
+		memcpy( block, best.Block, sizeof( best.Block ) );
+	}
+
+	typedef void (*BlockEncoder)( const uint32_t* tile, EncodeQuality quality, uint8_t* block );
+
+	BlockEncoder GetBlockEncoder( DXGI_FORMAT format )
+	{
+		switch( format )
+		{
+		case DXGI_FORMAT_BC1_TYPELESS:
+		case DXGI_FORMAT_BC1_UNORM:
+		case DXGI_FORMAT_BC1_UNORM_SRGB:
+			return EncodeBC1;
+
+		case DXGI_FORMAT_BC2_TYPELESS:
+		case DXGI_FORMAT_BC2_UNORM:
+		case DXGI_FORMAT_BC2_UNORM_SRGB:
+			return EncodeBC2;
+
+		case DXGI_FORMAT_BC3_TYPELESS:
+		case DXGI_FORMAT_BC3_UNORM:
+		case DXGI_FORMAT_BC3_UNORM_SRGB:
+			return EncodeBC3;
+
+		case DXGI_FORMAT_BC4_TYPELESS:
+		case DXGI_FORMAT_BC4_UNORM:
+			return EncodeBC4;
+
+		case DXGI_FORMAT_BC5_TYPELESS:
+		case DXGI_FORMAT_BC5_UNORM:
+			return EncodeBC5;
+
+		case DXGI_FORMAT_BC7_TYPELESS:
+		case DXGI_FORMAT_BC7_UNORM:
+		case DXGI_FORMAT_BC7_UNORM_SRGB:
+			return EncodeBC7;
+		}
+
+		return NULL;
+	}
+}
+
+	bool CanEncode( DXGI_FORMAT format )
+	{
+		return GetBlockEncoder( format ) != NULL;
+	}
+
+	void EncodeBlockRow( void* context, int blockRow )
+	{
+		const EncodeJob& job = *static_cast<const EncodeJob*>( context );
+		const BlockEncoder encoder = GetBlockEncoder( job.Format );
+		const size_t blockSize = GetBlockSize( job.Format );
+
+		const size_t y = static_cast<size_t>( blockRow ) * 4;
+		uint8_t* block = job.Destination + blockRow * job.DestinationPitch;
+
+		const uint8_t* rows[4];
+		for( size_t row = 0; row < 4; ++row )
+			rows[row] = job.Source + std::min( y + row, job.Height - 1 ) * job.SourcePitch;
+
+		__declspec(align(16)) uint32_t tile[16];
+		for( size_t x = 0; x < job.Width; x += 4, block += blockSize )
+		{
+			for( size_t column = 0; column < 4; ++column )
+			{
+				const size_t offset = std::min( x + column, job.Width - 1 ) * 4;
+				for( size_t row = 0; row < 4; ++row )
+					memcpy( &tile[row * 4 + column], rows[row] + offset, sizeof( uint32_t ) );
+			}
+
+			encoder( tile, job.Quality, block );
+		}
+	}
+}
+}
+}
+
+#pragma managed(pop)
@@ -0,0 +1,100 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "CachedGlyph.h"
+
+using namespace System;
+using namespace System::Drawing;
+using namespace System::Globalization;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	CachedGlyph::CachedGlyph( int arraySlice, RectangleF textureCoordinates, Rectangle blackBox )
+	: m_ArraySlice( arraySlice ), m_TextureCoordinates( textureCoordinates ), m_BlackBox( blackBox )
+	{
+	}
+
+	int CachedGlyph::ArraySlice::get()
+	{
+		return m_ArraySlice;
+	}
+
+	RectangleF CachedGlyph::TextureCoordinates::get()
+	{
+		return m_TextureCoordinates;
+	}
+
+	Rectangle CachedGlyph::BlackBox::get()
+	{
+		return m_BlackBox;
+	}
+
+	bool CachedGlyph::IsEmpty::get()
+	{
+		return m_ArraySlice < 0;
+	}
+
+	String^ CachedGlyph::ToString()
+	{
+		return String::Format( CultureInfo::CurrentCulture, "ArraySlice:{0} TextureCoordinates:{1} BlackBox:{2}", m_ArraySlice, m_TextureCoordinates, m_BlackBox );
+	}
+
+	bool CachedGlyph::operator == ( CachedGlyph left, CachedGlyph right )
+	{
+		return CachedGlyph::Equals( left, right );
+	}
+
+	bool CachedGlyph::operator != ( CachedGlyph left, CachedGlyph right )
+	{
+		return !CachedGlyph::Equals( left, right );
+	}
+
+	int CachedGlyph::GetHashCode()
+	{
+		return m_ArraySlice.GetHashCode() + m_TextureCoordinates.GetHashCode() + m_BlackBox.GetHashCode();
+	}
+
+	bool CachedGlyph::Equals( Object^ value )
+	{
+		if( value == nullptr )
+			return false;
+
+		if( value->GetType() != GetType() )
+			return false;
+
+		return Equals( safe_cast<CachedGlyph>( value ) );
+	}
+
+	bool CachedGlyph::Equals( CachedGlyph value )
+	{
+		return ( m_ArraySlice == value.m_ArraySlice && m_TextureCoordinates == value.m_TextureCoordinates && m_BlackBox == value.m_BlackBox );
+	}
+
+	bool CachedGlyph::Equals( CachedGlyph% value1, CachedGlyph% value2 )
+	{
+		return ( value1.m_ArraySlice == value2.m_ArraySlice && value1.m_TextureCoordinates == value2.m_TextureCoordinates && value1.m_BlackBox == value2.m_BlackBox );
+	}
+}
+}
@@ -21,6 +21,7 @@
 */
 #include "stdafx.h"
 
+#include "../ComObjectFactory.h"
 #include "../stack_array.h"
 
 #include "../dxgi/Factory1.h"
@@ -33,7 +34,6 @@
 #include "Device11.h"
 
 using namespace System;
-using namespace System::Reflection;
 
 namespace SlimDX
 {
@@ -363,18 +363,15 @@ namespace Direct3D11
 	generic<typename T> where T : ComObject
 	T Device::OpenSharedResource(System::IntPtr handle)
 	{
-		GUID guid = Utilities::GetNativeGuidForType( T::typeid );
+		GUID guid = Utilities::ConvertManagedGuid( ComObjectFactory<T>::NativeInterface );
 		ID3D11Resource* resultPointer;
 
 		HRESULT hr = InternalPointer->OpenSharedResource( handle.ToPointer(), guid, (void**)&resultPointer );
 		if( RECORD_D3D11( hr ).IsFailure )
 			return T();
 
-		MethodInfo^ method = T::typeid->GetMethod( "FromPointer", BindingFlags::Public | BindingFlags::Static );
-		T result = safe_cast<T>( method->Invoke( nullptr, gcnew array<Object^> { IntPtr( resultPointer ) } ) );
-
-		resultPointer->Release();
-		return result;
+		// the reference returned by OpenSharedResource is handed to the wrapper
+		return ComObjectFactory<T>::FromPointer( resultPointer, nullptr );
 	}
 
 #pragma warning(disable : 4947)
@@ -339,7 +339,7 @@ namespace Direct3D11
 	DataBox^ DeviceContext::MapSubresource(Texture1D^ resource, int mipSlice, int arraySlice, MapMode mode, MapFlags flags)
 	{
 		Texture1DDescription desc = resource->Description;
-		int sizeInBytes = Resource::GetMipSize(mipSlice, desc.Width) * Utilities::SizeOfFormatElement(static_cast<DXGI_FORMAT>(desc.Format)) / 8;
+		Int64 sizeInBytes = (static_cast<Int64>(Resource::GetMipSize(mipSlice, desc.Width)) * Utilities::SizeOfFormatElement(static_cast<DXGI_FORMAT>(desc.Format)) + 7) / 8;
 		int subresource = D3D11CalcSubresource(mipSlice, arraySlice, desc.MipLevels);
 
 		D3D11_MAPPED_SUBRESOURCE mapped;
@@ -0,0 +1,216 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#pragma managed(push, off)
+
+#include <vector>
+
+#include "../ParallelFor.h"
+
+#include "DistanceField.h"
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+namespace DistanceField
+{
+namespace
+{
+	// Squared distances start out "infinite" for every texel that is not a feature.
+	const float Far = 1e20f;
+
+	// Below this many lines a pass is cheaper to run on the calling thread.
+	const int MinimumParallelLines = 32;
+
+	// Lines of a pass are dealt out to this many interleaved batches, each with its own scratch space.
+	const int MaximumBatches = 64;
+
+	// Squared distance to the nearest feature for both sides of the edge, plus the scratch space of the
+	// one dimensional transform for every batch.
+	struct Grid
+	{
+		std::vector<float> Outside;
+		std::vector<float> Inside;
+		std::vector<float> Values;
+		std::vector<float> Bounds;
+		std::vector<int> Parabolas;
+		int Width;
+		int Height;
+		int Length;
+		int Batches;
+	};
+
+	// Felzenszwalb and Huttenlocher's lower envelope of parabolas; replaces the squared distances of one line
+	// of the grid, read and written with the given stride, by the squared distances along that line.
+	void Transform( float* data, int stride, int length, float* values, float* bounds, int* parabolas )
+	{
+		for( int q = 0; q < length; q++ )
+			values[q] = data[q * stride];
+
+		int k = 0;
+		parabolas[0] = 0;
+		bounds[0] = -Far;
+		bounds[1] = Far;
+
+		for( int q = 1; q < length; q++ )
+		{
+			// bounds[0] is below any intersection, so the search always stops by the first parabola
+			float s;
+			for( ;; )
+			{
+				int r = parabolas[k];
+				s = ( values[q] - values[r] + static_cast<float>( q * q - r * r ) ) / static_cast<float>( 2 * ( q - r ) );
+				if( s > bounds[k] )
+					break;
+				k--;
+			}
+
+			k++;
+			parabolas[k] = q;
+			bounds[k] = s;
+			bounds[k + 1] = Far;
+		}
+
+		k = 0;
+		for( int q = 0; q < length; q++ )
+		{
+			while( bounds[k + 1] < static_cast<float>( q ) )
+				k++;
+
+			int r = parabolas[k];
+			data[q * stride] = values[r] + static_cast<float>( ( q - r ) * ( q - r ) );
+		}
+	}
+
+	void TransformRows( void* context, int batch )
+	{
+		Grid& grid = *static_cast<Grid*>( context );
+		size_t scratch = static_cast<size_t>( batch ) * ( grid.Length + 1 );
+
+		for( int row = batch; row < grid.Height; row += grid.Batches )
+		{
+			size_t offset = static_cast<size_t>( row ) * grid.Width;
+			Transform( &grid.Outside[offset], 1, grid.Width, &grid.Values[scratch], &grid.Bounds[scratch], &grid.Parabolas[scratch] );
+			Transform( &grid.Inside[offset], 1, grid.Width, &grid.Values[scratch], &grid.Bounds[scratch], &grid.Parabolas[scratch] );
+		}
+	}
+
+	void TransformColumns( void* context, int batch )
+	{
+		Grid& grid = *static_cast<Grid*>( context );
+		size_t scratch = static_cast<size_t>( batch ) * ( grid.Length + 1 );
+
+		for( int column = batch; column < grid.Width; column += grid.Batches )
+		{
+			Transform( &grid.Outside[column], grid.Width, grid.Height, &grid.Values[scratch], &grid.Bounds[scratch], &grid.Parabolas[scratch] );
+			Transform( &grid.Inside[column], grid.Width, grid.Height, &grid.Values[scratch], &grid.Bounds[scratch], &grid.Parabolas[scratch] );
+		}
+	}
+
+	struct ResolvePass
+	{
+		const Grid* Distances;
+		int Scale;
+		float Factor;
+		BYTE* Output;
+		int OutputPitch;
+	};
+
+	// Averages the signed distances of each block of supersampled texels into one output texel.
+	void ResolveRow( void* context, int row )
+	{
+		const ResolvePass& pass = *static_cast<const ResolvePass*>( context );
+		const Grid& grid = *pass.Distances;
+		BYTE* output = pass.Output + static_cast<size_t>( row ) * pass.OutputPitch;
+		int outputWidth = grid.Width / pass.Scale;
+
+		for( int x = 0; x < outputWidth; x++ )
+		{
+			float sum = 0.0f;
+			for( int y = row * pass.Scale; y < ( row + 1 ) * pass.Scale; y++ )
+			{
+				size_t offset = static_cast<size_t>( y ) * grid.Width + x * pass.Scale;
+				for( int i = 0; i < pass.Scale; i++ )
+				{
+					// texel centres are half a texel from the edge they sit against
+					float outside = grid.Outside[offset + i];
+					sum += outside > 0.0f ? sqrtf( outside ) - 0.5f : 0.5f - sqrtf( grid.Inside[offset + i] );
+				}
+			}
+
+			float value = 127.5f - sum * pass.Factor;
+			output[x] = static_cast<BYTE>( std::min( 255.0f, std::max( 0.0f, value + 0.5f ) ) );
+		}
+	}
+}
+
+	bool Generate( const FieldJob& job )
+	{
+		try
+		{
+			Grid grid;
+			grid.Width = job.Width;
+			grid.Height = job.Height;
+			grid.Length = std::max( job.Width, job.Height );
+
+			// small masks run as a single batch on the calling thread
+			int lines = std::min( job.Width, job.Height );
+			grid.Batches = lines < MinimumParallelLines ? 1 : std::min( lines, MaximumBatches );
+
+			size_t count = static_cast<size_t>( job.Width ) * job.Height;
+			size_t scratch = static_cast<size_t>( grid.Batches ) * ( grid.Length + 1 );
+			grid.Outside.resize( count );
+			grid.Inside.resize( count );
+			grid.Values.resize( scratch );
+			grid.Bounds.resize( scratch );
+			grid.Parabolas.resize( scratch );
+
+			// Outside holds the distance to the nearest inside texel, Inside the distance to the nearest outside one
+			for( size_t i = 0; i < count; i++ )
+			{
+				bool inside = job.Coverage[i] >= 128;
+				grid.Outside[i] = inside ? 0.0f : Far;
+				grid.Inside[i] = inside ? Far : 0.0f;
+			}
+
+			ParallelFor( grid.Batches, 2, TransformRows, &grid );
+			ParallelFor( grid.Batches, 2, TransformColumns, &grid );
+
+			// the sum covers Scale * Scale texels measured in supersampled units
+			float factor = 127.5f / ( static_cast<float>( job.Spread ) * job.Scale * job.Scale * job.Scale );
+			ResolvePass resolve = { &grid, job.Scale, factor, job.Output, job.OutputPitch };
+			ParallelFor( job.Height / job.Scale, MinimumParallelLines, ResolveRow, &resolve );
+		}
+		catch( std::bad_alloc& )
+		{
+			return false;
+		}
+
+		return true;
+	}
+}
+}
+}
+
+#pragma managed(pop)
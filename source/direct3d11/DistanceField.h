@@ -0,0 +1,53 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	// Native signed distance field generation used by GlyphAtlas. The field is computed with an exact Euclidean
+	// distance transform on a supersampled coverage mask and averaged down to the output resolution.
+	namespace DistanceField
+	{
+		struct FieldJob
+		{
+			// Coverage of the supersampled mask, one byte per texel; texels of 128 and above are inside.
+			// The width and height must be multiples of Scale.
+			const BYTE* Coverage;
+			int Width;
+			int Height;
+			int Scale;
+
+			// The distance, in output texels, that maps to 0 outside and 255 inside; the edge itself maps to 128.
+			int Spread;
+
+			// Receives Width / Scale by Height / Scale texels.
+			BYTE* Output;
+			int OutputPitch;
+		};
+
+		// Rows and columns of each pass run in parallel. Returns false if the working memory could not be allocated.
+		bool Generate( const FieldJob& job );
+	}
+}
+}
@@ -231,6 +231,26 @@ namespace SlimDX
 			InverseSecondarySourceAlpha = D3D11_BLEND_INV_SRC1_ALPHA
 		};
 
+		/// <summary>Selects the trade-off between encoding speed and quality made by <see cref="BlockCompression">BlockCompression.Compress</see>.</summary>
+		/// <unmanaged>None</unmanaged>
+		public enum class BlockCompressionQuality : System::Int32
+		{
+			/// <summary>
+			/// Fits endpoints with a single pass and no refinement. Suitable for data regenerated every frame.
+			/// </summary>
+			Fast = 0,
+
+			/// <summary>
+			/// Refines endpoints once and, for BC7, searches the most promising partition of the common modes.
+			/// </summary>
+			Normal = 1,
+
+			/// <summary>
+			/// Refines endpoints repeatedly and, for BC7, searches several partitions of every supported mode.
+			/// </summary>
+			High = 2
+		};
+
 		/// <summary>Identifies which components of each pixel of a render target are writable during blending.</summary>
 		/// <unmanaged>D3D11_COLOR_WRITE_ENABLE</unmanaged>
 		[System::Flags]
@@ -1085,6 +1105,21 @@ namespace SlimDX
 			Info = D3D11_MESSAGE_SEVERITY_INFO
 		};
 
+		/// <summary>Specifies the filter <see cref="MipGenerator"/> uses to reduce each level to the next.</summary>
+		/// <unmanaged>None</unmanaged>
+		public enum class MipFilter : System::Int32
+		{
+			/// <summary>
+			/// Averages the texels each destination texel covers. Fast, and exact for odd sizes, but slightly blurry.
+			/// </summary>
+			Box = 0,
+
+			/// <summary>
+			/// A Kaiser-windowed sinc three texels wide. Keeps detail sharper than the box filter at a higher cost.
+			/// </summary>
+			Kaiser = 1
+		};
+
 		/// <summary>Specifies how the pipeline should interpret vertex data bound to the input assembler stage.</summary>
 		/// <unmanaged>D3D11_PRIMITIVE_TOPOLOGY</unmanaged>
 		public enum class PrimitiveTopology : System::Int32
@@ -0,0 +1,355 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma managed(push, off)
+
+#include "DistanceField.h"
+#include "GlyphAtlas.h"
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	namespace
+	{
+		// one texel of empty border keeps bilinear filtering from picking up neighbouring glyphs
+		const int Padding = 1;
+
+		// distance fields are computed from an aliased rendering at this many times the field size
+		const int FieldScale = 4;
+
+		// the rendering mode stored in the key of distance field glyphs; DirectWrite modes are all smaller
+		const UINT8 FieldMode = 0xFF;
+
+		inline int FloorDivide( int value, int divisor )
+		{
+			return value >= 0 ? value / divisor : -( ( -value + divisor - 1 ) / divisor );
+		}
+	}
+
+	GlyphAtlas::GlyphAtlas( IDWriteFactory* factory, int pageSize, int pageCount, int subpixelPositions, float fieldEmSize, int fieldSpread )
+	: m_Factory( factory ), m_PageSize( pageSize ), m_SubpixelPositions( subpixelPositions ), m_FieldEmSize( fieldEmSize ),
+	  m_FieldSpread( fieldSpread ), m_Frame( 1 ), m_Pages( pageCount, Page( pageSize ) ),
+	  m_Pixels( static_cast<size_t>( pageSize ) * pageSize * pageCount ), m_Hits( 0 ), m_Misses( 0 ), m_Evictions( 0 )
+	{
+		m_Factory->AddRef();
+	}
+
+	GlyphAtlas::~GlyphAtlas()
+	{
+		Clear();
+		m_Factory->Release();
+	}
+
+	HRESULT GlyphAtlas::Find( IDWriteFontFace* face, float emSize, DWRITE_RENDERING_MODE mode, float subpixelOffset, UINT16 glyph, GlyphSlot& slot )
+	{
+		float fraction = subpixelOffset - floorf( subpixelOffset );
+		int subpixel = static_cast<int>( fraction * m_SubpixelPositions + 0.5f ) % m_SubpixelPositions;
+
+		GlyphKey key = { face, emSize, glyph, static_cast<UINT8>( mode ), static_cast<UINT8>( subpixel ) };
+		return Find( key, slot );
+	}
+
+	HRESULT GlyphAtlas::FindField( IDWriteFontFace* face, UINT16 glyph, GlyphSlot& slot )
+	{
+		GlyphKey key = { face, m_FieldEmSize, glyph, FieldMode, 0 };
+		return Find( key, slot );
+	}
+
+	HRESULT GlyphAtlas::Find( const GlyphKey& key, GlyphSlot& slot )
+	{
+		std::unordered_map<GlyphKey, GlyphSlot, GlyphKeyHash>::const_iterator found = m_Glyphs.find( key );
+		if( found != m_Glyphs.end() )
+		{
+			slot = found->second;
+			if( slot.Page >= 0 )
+				m_Pages[slot.Page].LastUsed = m_Frame;
+
+			m_Hits++;
+			return S_OK;
+		}
+
+		m_Misses++;
+		HRESULT hr = key.Mode == FieldMode ? RasterizeField( key, slot ) : Rasterize( key, slot );
+		if( hr != S_OK )
+			return hr;
+
+		// the key holds the face pointer, so the face has to outlive the entry
+		if( m_Faces.insert( key.Face ).second )
+			key.Face->AddRef();
+
+		m_Glyphs[key] = slot;
+		if( slot.Page >= 0 )
+			m_Pages[slot.Page].Keys.push_back( key );
+
+		return S_OK;
+	}
+
+	HRESULT GlyphAtlas::CreateAnalysis( const GlyphKey& key, float emSize, DWRITE_RENDERING_MODE mode, IDWriteGlyphRunAnalysis** analysis )
+	{
+		UINT16 glyph = key.Glyph;
+		FLOAT advance = 0.0f;
+		DWRITE_GLYPH_OFFSET offset = { 0.0f, 0.0f };
+
+		DWRITE_GLYPH_RUN run = {};
+		run.fontFace = key.Face;
+		run.fontEmSize = emSize;
+		run.glyphCount = 1;
+		run.glyphIndices = &glyph;
+		run.glyphAdvances = &advance;
+		run.glyphOffsets = &offset;
+
+		return m_Factory->CreateGlyphRunAnalysis( &run, 1.0f, NULL, mode, DWRITE_MEASURING_MODE_NATURAL,
+			static_cast<float>( key.Subpixel ) / m_SubpixelPositions, 0.0f, analysis );
+	}
+
+	HRESULT GlyphAtlas::Rasterize( const GlyphKey& key, GlyphSlot& slot )
+	{
+		DWRITE_RENDERING_MODE mode = static_cast<DWRITE_RENDERING_MODE>( key.Mode );
+		if( mode == DWRITE_RENDERING_MODE_DEFAULT || mode == DWRITE_RENDERING_MODE_OUTLINE )
+			return E_INVALIDARG;
+
+		IDWriteGlyphRunAnalysis* analysis = NULL;
+		HRESULT hr = CreateAnalysis( key, key.EmSize, mode, &analysis );
+		if( FAILED( hr ) )
+			return hr;
+
+		// DirectWrite only antialiases through the ClearType texture; it is averaged down to a single channel below
+		DWRITE_TEXTURE_TYPE type = mode == DWRITE_RENDERING_MODE_ALIASED ? DWRITE_TEXTURE_ALIASED_1x1 : DWRITE_TEXTURE_CLEARTYPE_3x1;
+		int channels = type == DWRITE_TEXTURE_ALIASED_1x1 ? 1 : 3;
+
+		RECT bounds;
+		hr = analysis->GetAlphaTextureBounds( type, &bounds );
+		if( FAILED( hr ) )
+		{
+			analysis->Release();
+			return hr;
+		}
+
+		int width = bounds.right - bounds.left;
+		int height = bounds.bottom - bounds.top;
+		if( width <= 0 || height <= 0 )
+		{
+			analysis->Release();
+
+			GlyphSlot empty = { -1, 0.0f, 0.0f, 0.0f, 0.0f, 0, 0, 0, 0 };
+			slot = empty;
+			return S_OK;
+		}
+
+		if( width + Padding * 2 > m_PageSize || height + Padding * 2 > m_PageSize )
+		{
+			analysis->Release();
+			return S_FALSE;
+		}
+
+		m_Alpha.resize( static_cast<size_t>( width ) * height * channels );
+		hr = analysis->CreateAlphaTexture( type, &bounds, &m_Alpha[0], static_cast<UINT32>( m_Alpha.size() ) );
+		analysis->Release();
+		if( FAILED( hr ) )
+			return hr;
+
+		// aliased coverage is 0 or 255 already; ClearType is averaged in place, which never overtakes the source
+		if( channels == 3 )
+		{
+			size_t count = static_cast<size_t>( width ) * height;
+			for( size_t i = 0; i < count; i++ )
+				m_Alpha[i] = static_cast<BYTE>( ( m_Alpha[i * 3] + m_Alpha[i * 3 + 1] + m_Alpha[i * 3 + 2] + 1 ) / 3 );
+		}
+
+		return Store( &m_Alpha[0], width, height, bounds.left, bounds.top, slot );
+	}
+
+	HRESULT GlyphAtlas::RasterizeField( const GlyphKey& key, GlyphSlot& slot )
+	{
+		IDWriteGlyphRunAnalysis* analysis = NULL;
+		HRESULT hr = CreateAnalysis( key, key.EmSize * FieldScale, DWRITE_RENDERING_MODE_ALIASED, &analysis );
+		if( FAILED( hr ) )
+			return hr;
+
+		RECT bounds;
+		hr = analysis->GetAlphaTextureBounds( DWRITE_TEXTURE_ALIASED_1x1, &bounds );
+		if( FAILED( hr ) )
+		{
+			analysis->Release();
+			return hr;
+		}
+
+		int sourceWidth = bounds.right - bounds.left;
+		int sourceHeight = bounds.bottom - bounds.top;
+		if( sourceWidth <= 0 || sourceHeight <= 0 )
+		{
+			analysis->Release();
+
+			GlyphSlot empty = { -1, 0.0f, 0.0f, 0.0f, 0.0f, 0, 0, 0, 0 };
+			slot = empty;
+			return S_OK;
+		}
+
+		// the field covers the black box rounded out to whole field texels, plus the spread on every side
+		int left = FloorDivide( bounds.left, FieldScale ) - m_FieldSpread;
+		int top = FloorDivide( bounds.top, FieldScale ) - m_FieldSpread;
+		int right = -FloorDivide( -bounds.right, FieldScale ) + m_FieldSpread;
+		int bottom = -FloorDivide( -bounds.bottom, FieldScale ) + m_FieldSpread;
+		int width = right - left;
+		int height = bottom - top;
+
+		if( width + Padding * 2 > m_PageSize || height + Padding * 2 > m_PageSize )
+		{
+			analysis->Release();
+			return S_FALSE;
+		}
+
+		m_Alpha.resize( static_cast<size_t>( sourceWidth ) * sourceHeight );
+		hr = analysis->CreateAlphaTexture( DWRITE_TEXTURE_ALIASED_1x1, &bounds, &m_Alpha[0], static_cast<UINT32>( m_Alpha.size() ) );
+		analysis->Release();
+		if( FAILED( hr ) )
+			return hr;
+
+		int maskWidth = width * FieldScale;
+		int maskHeight = height * FieldScale;
+		int offsetX = bounds.left - left * FieldScale;
+		int offsetY = bounds.top - top * FieldScale;
+
+		m_Field.assign( static_cast<size_t>( maskWidth ) * maskHeight + static_cast<size_t>( width ) * height, 0 );
+		for( int y = 0; y < sourceHeight; y++ )
+			memcpy( &m_Field[static_cast<size_t>( offsetY + y ) * maskWidth + offsetX], &m_Alpha[static_cast<size_t>( y ) * sourceWidth], sourceWidth );
+
+		BYTE* field = &m_Field[static_cast<size_t>( maskWidth ) * maskHeight];
+		DistanceField::FieldJob job = { &m_Field[0], maskWidth, maskHeight, FieldScale, m_FieldSpread, field, width };
+		if( !DistanceField::Generate( job ) )
+			return E_OUTOFMEMORY;
+
+		return Store( field, width, height, left, top, slot );
+	}
+
+	HRESULT GlyphAtlas::Store( const BYTE* pixels, int width, int height, int left, int top, GlyphSlot& slot )
+	{
+		AtlasRect rect;
+		int page = Place( width + Padding * 2, height + Padding * 2, rect );
+		if( page < 0 )
+			return S_FALSE;
+
+		// clear the padding too, since an evicted page still holds the texels of its old glyphs
+		BYTE* target = &m_Pixels[static_cast<size_t>( page ) * m_PageSize * m_PageSize];
+		for( int y = 0; y < rect.Height; y++ )
+			memset( target + static_cast<size_t>( rect.Y + y ) * m_PageSize + rect.X, 0, rect.Width );
+
+		for( int y = 0; y < height; y++ )
+			memcpy( target + static_cast<size_t>( rect.Y + Padding + y ) * m_PageSize + rect.X + Padding, pixels + static_cast<size_t>( y ) * width, width );
+
+		Page& used = m_Pages[page];
+		used.LastUsed = m_Frame;
+		used.DirtyLeft = std::min( used.DirtyLeft, rect.X );
+		used.DirtyTop = std::min( used.DirtyTop, rect.Y );
+		used.DirtyRight = std::max( used.DirtyRight, rect.X + rect.Width );
+		used.DirtyBottom = std::max( used.DirtyBottom, rect.Y + rect.Height );
+
+		float scale = 1.0f / m_PageSize;
+		slot.Page = page;
+		slot.U0 = ( rect.X + Padding ) * scale;
+		slot.V0 = ( rect.Y + Padding ) * scale;
+		slot.U1 = ( rect.X + Padding + width ) * scale;
+		slot.V1 = ( rect.Y + Padding + height ) * scale;
+		slot.Left = left;
+		slot.Top = top;
+		slot.Width = width;
+		slot.Height = height;
+		return S_OK;
+	}
+
+	int GlyphAtlas::Place( int width, int height, AtlasRect& rect )
+	{
+		for( size_t page = 0; page < m_Pages.size(); page++ )
+		{
+			if( m_Pages[page].Packer.Insert( width, height, rect ) )
+				return static_cast<int>( page );
+		}
+
+		// glyphs handed out this frame may already be referenced by vertices, so their pages stay
+		int oldest = -1;
+		for( size_t page = 0; page < m_Pages.size(); page++ )
+		{
+			if( m_Pages[page].LastUsed == m_Frame )
+				continue;
+			if( oldest < 0 || m_Pages[page].LastUsed < m_Pages[oldest].LastUsed )
+				oldest = static_cast<int>( page );
+		}
+
+		if( oldest < 0 )
+			return -1;
+
+		Evict( oldest );
+		return m_Pages[oldest].Packer.Insert( width, height, rect ) ? oldest : -1;
+	}
+
+	void GlyphAtlas::Evict( int page )
+	{
+		Page& target = m_Pages[page];
+		for( size_t i = 0; i < target.Keys.size(); i++ )
+			m_Glyphs.erase( target.Keys[i] );
+
+		target.Keys.clear();
+		target.Packer.Reset();
+		m_Evictions++;
+	}
+
+	void GlyphAtlas::Upload( ID3D11DeviceContext* context, ID3D11Resource* texture )
+	{
+		for( size_t page = 0; page < m_Pages.size(); page++ )
+		{
+			Page& target = m_Pages[page];
+			if( target.DirtyRight <= target.DirtyLeft || target.DirtyBottom <= target.DirtyTop )
+				continue;
+
+			const BYTE* pixels = &m_Pixels[page * m_PageSize * m_PageSize + static_cast<size_t>( target.DirtyTop ) * m_PageSize + target.DirtyLeft];
+			D3D11_BOX box = { static_cast<UINT>( target.DirtyLeft ), static_cast<UINT>( target.DirtyTop ), 0,
+				static_cast<UINT>( target.DirtyRight ), static_cast<UINT>( target.DirtyBottom ), 1 };
+			context->UpdateSubresource( texture, D3D11CalcSubresource( 0, static_cast<UINT>( page ), 1 ), &box, pixels, m_PageSize, 0 );
+
+			target.DirtyLeft = m_PageSize;
+			target.DirtyTop = m_PageSize;
+			target.DirtyRight = 0;
+			target.DirtyBottom = 0;
+		}
+
+		m_Frame++;
+	}
+
+	void GlyphAtlas::Clear()
+	{
+		m_Glyphs.clear();
+		for( size_t page = 0; page < m_Pages.size(); page++ )
+		{
+			m_Pages[page].Keys.clear();
+			m_Pages[page].Packer.Reset();
+			m_Pages[page].LastUsed = 0;
+		}
+
+		for( std::unordered_set<IDWriteFontFace*>::iterator face = m_Faces.begin(); face != m_Faces.end(); ++face )
+			( *face )->Release();
+		m_Faces.clear();
+	}
+}
+}
+
+#pragma managed(pop)
@@ -0,0 +1,152 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "AtlasPacker.h"
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	// Where a rasterized glyph lives. Page is -1 for glyphs without ink, such as spaces.
+	struct GlyphSlot
+	{
+		int Page;
+		float U0;
+		float V0;
+		float U1;
+		float V1;
+
+		// the black box in pixels, relative to the pen position on the baseline
+		int Left;
+		int Top;
+		int Width;
+		int Height;
+	};
+
+	struct GlyphKey
+	{
+		IDWriteFontFace* Face;
+		float EmSize;
+		UINT16 Glyph;
+		UINT8 Mode;
+		UINT8 Subpixel;
+
+		bool operator == ( const GlyphKey& other ) const
+		{
+			return Face == other.Face && EmSize == other.EmSize && Glyph == other.Glyph && Mode == other.Mode && Subpixel == other.Subpixel;
+		}
+	};
+
+	struct GlyphKeyHash
+	{
+		size_t operator () ( const GlyphKey& key ) const
+		{
+			size_t hash = reinterpret_cast<size_t>( key.Face ) >> 4;
+			hash = hash * 31 + std::hash<float>()( key.EmSize );
+			hash = hash * 31 + ( static_cast<size_t>( key.Glyph ) << 16 | static_cast<size_t>( key.Mode ) << 8 | key.Subpixel );
+			return hash;
+		}
+	};
+
+	// Rasterizes glyphs with DirectWrite into a CPU copy of a set of single channel atlas pages, and uploads the
+	// changed regions of each page in one UpdateSubresource call per page. When every page is full, the least recently
+	// used page that has not been used since the last upload is evicted as a whole. Glyphs can be stored either as
+	// coverage at one size, or as a signed distance field at a reference size that scales to any size.
+	class GlyphAtlas
+	{
+	public:
+		GlyphAtlas( IDWriteFactory* factory, int pageSize, int pageCount, int subpixelPositions, float fieldEmSize, int fieldSpread );
+		~GlyphAtlas();
+
+		// Returns S_OK with the slot of the glyph, rasterizing it if needed; S_FALSE if there is no room for it
+		// in this frame; or a failure code from DirectWrite.
+		HRESULT Find( IDWriteFontFace* face, float emSize, DWRITE_RENDERING_MODE mode, float subpixelOffset, UINT16 glyph, GlyphSlot& slot );
+
+		// As Find, but stores the signed distance field of the glyph at the field em size. The slot describes the
+		// field including its spread, in pixels at that size.
+		HRESULT FindField( IDWriteFontFace* face, UINT16 glyph, GlyphSlot& slot );
+
+		// Uploads every region changed since the last call, and starts a new frame.
+		void Upload( ID3D11DeviceContext* context, ID3D11Resource* texture );
+
+		void Clear();
+
+		int GetPageSize() const { return m_PageSize; }
+		int GetPageCount() const { return static_cast<int>( m_Pages.size() ); }
+		int GetSubpixelPositions() const { return m_SubpixelPositions; }
+		float GetFieldEmSize() const { return m_FieldEmSize; }
+		int GetFieldSpread() const { return m_FieldSpread; }
+		int GetCount() const { return static_cast<int>( m_Glyphs.size() ); }
+		int64_t GetHits() const { return m_Hits; }
+		int64_t GetMisses() const { return m_Misses; }
+		int64_t GetEvictions() const { return m_Evictions; }
+
+	private:
+		struct Page
+		{
+			Page( int size ) : Packer( size, size ), LastUsed( 0 ), DirtyLeft( size ), DirtyTop( size ), DirtyRight( 0 ), DirtyBottom( 0 ) {}
+
+			AtlasPacker Packer;
+			std::vector<GlyphKey> Keys;
+			uint64_t LastUsed;
+			int DirtyLeft;
+			int DirtyTop;
+			int DirtyRight;
+			int DirtyBottom;
+		};
+
+		GlyphAtlas( const GlyphAtlas& );
+		GlyphAtlas& operator = ( const GlyphAtlas& );
+
+		HRESULT Find( const GlyphKey& key, GlyphSlot& slot );
+		HRESULT Rasterize( const GlyphKey& key, GlyphSlot& slot );
+		HRESULT RasterizeField( const GlyphKey& key, GlyphSlot& slot );
+		HRESULT CreateAnalysis( const GlyphKey& key, float emSize, DWRITE_RENDERING_MODE mode, IDWriteGlyphRunAnalysis** analysis );
+		HRESULT Store( const BYTE* pixels, int width, int height, int left, int top, GlyphSlot& slot );
+		int Place( int width, int height, AtlasRect& rect );
+		void Evict( int page );
+
+		IDWriteFactory* m_Factory;
+		int m_PageSize;
+		int m_SubpixelPositions;
+		float m_FieldEmSize;
+		int m_FieldSpread;
+		uint64_t m_Frame;
+
+		std::vector<Page> m_Pages;
+		std::vector<BYTE> m_Pixels;
+		std::vector<BYTE> m_Alpha;
+		std::vector<BYTE> m_Field;
+		std::unordered_map<GlyphKey, GlyphSlot, GlyphKeyHash> m_Glyphs;
+		std::unordered_set<IDWriteFontFace*> m_Faces;
+
+		int64_t m_Hits;
+		int64_t m_Misses;
+		int64_t m_Evictions;
+	};
+}
+}
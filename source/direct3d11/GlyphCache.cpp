@@ -0,0 +1,238 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "../directwrite/DirectWriteException.h"
+#include "../directwrite/FactoryDW.h"
+#include "../directwrite/FontFace.h"
+
+#include "Device11.h"
+#include "DeviceContext11.h"
+#include "ShaderResourceView11.h"
+#include "Texture2D11.h"
+#include "Texture2DDescription11.h"
+#include "GlyphCache.h"
+
+using namespace System;
+using namespace System::Drawing;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	namespace
+	{
+		const float DefaultFieldEmSize = 32.0f;
+		const int DefaultFieldSpread = 4;
+	}
+
+	GlyphCache::GlyphCache( Device^ device, DirectWrite::Factory^ factory, int pageSize, int pageCount, int subpixelPositions )
+	{
+		Init( device, factory, pageSize, pageCount, subpixelPositions, DefaultFieldEmSize, DefaultFieldSpread );
+	}
+
+	GlyphCache::GlyphCache( Device^ device, DirectWrite::Factory^ factory, int pageSize, int pageCount, int subpixelPositions, float distanceFieldEmSize, int distanceFieldSpread )
+	{
+		Init( device, factory, pageSize, pageCount, subpixelPositions, distanceFieldEmSize, distanceFieldSpread );
+	}
+
+	void GlyphCache::Init( Device^ device, DirectWrite::Factory^ factory, int pageSize, int pageCount, int subpixelPositions, float distanceFieldEmSize, int distanceFieldSpread )
+	{
+		if( device == nullptr )
+			throw gcnew ArgumentNullException( "device" );
+		if( factory == nullptr )
+			throw gcnew ArgumentNullException( "factory" );
+		if( pageSize < 16 || pageSize > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION )
+			throw gcnew ArgumentOutOfRangeException( "pageSize" );
+		if( pageCount < 1 || pageCount > D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION )
+			throw gcnew ArgumentOutOfRangeException( "pageCount" );
+		if( subpixelPositions < 1 || subpixelPositions > 16 )
+			throw gcnew ArgumentOutOfRangeException( "subpixelPositions" );
+		if( !( distanceFieldEmSize >= 1.0f ) || distanceFieldEmSize * 2 > pageSize )
+			throw gcnew ArgumentOutOfRangeException( "distanceFieldEmSize" );
+		if( distanceFieldSpread < 1 || distanceFieldSpread > 64 )
+			throw gcnew ArgumentOutOfRangeException( "distanceFieldSpread" );
+
+		Texture2DDescription description;
+		description.Width = pageSize;
+		description.Height = pageSize;
+		description.MipLevels = 1;
+		description.ArraySize = pageCount;
+		description.Format = DXGI::Format::R8_UNorm;
+		description.SampleDescription = DXGI::SampleDescription( 1, 0 );
+		description.Usage = ResourceUsage::Default;
+		description.BindFlags = BindFlags::ShaderResource;
+		description.CpuAccessFlags = CpuAccessFlags::None;
+		description.OptionFlags = ResourceOptionFlags::None;
+
+		m_Texture = gcnew Texture2D( device, description );
+		m_View = gcnew Direct3D11::ShaderResourceView( device, m_Texture );
+
+		// Manual Allocation: released in Destruct
+		// the CPU copy of the pages is one byte per texel
+		m_Atlas = new GlyphAtlas( factory->InternalPointer, pageSize, pageCount, subpixelPositions, distanceFieldEmSize, distanceFieldSpread );
+		GC::AddMemoryPressure( static_cast<Int64>( pageSize ) * pageSize * pageCount );
+	}
+
+	GlyphCache::~GlyphCache()
+	{
+		delete m_View;
+		delete m_Texture;
+		m_View = nullptr;
+		m_Texture = nullptr;
+
+		Destruct();
+		GC::SuppressFinalize( this );
+	}
+
+	GlyphCache::!GlyphCache()
+	{
+		Destruct();
+	}
+
+	void GlyphCache::Destruct()
+	{
+		if( m_Atlas == 0 )
+			return;
+
+		Int64 size = static_cast<Int64>( m_Atlas->GetPageSize() ) * m_Atlas->GetPageSize() * m_Atlas->GetPageCount();
+		delete m_Atlas;
+		m_Atlas = 0;
+		GC::RemoveMemoryPressure( size );
+	}
+
+	GlyphAtlas* GlyphCache::Atlas::get()
+	{
+		if( m_Atlas == 0 )
+			throw gcnew ObjectDisposedException( "GlyphCache" );
+
+		return m_Atlas;
+	}
+
+	Texture2D^ GlyphCache::Texture::get()
+	{
+		return m_Texture;
+	}
+
+	Direct3D11::ShaderResourceView^ GlyphCache::ShaderResourceView::get()
+	{
+		return m_View;
+	}
+
+	int GlyphCache::PageSize::get()
+	{
+		return Atlas->GetPageSize();
+	}
+
+	int GlyphCache::PageCount::get()
+	{
+		return Atlas->GetPageCount();
+	}
+
+	int GlyphCache::SubpixelPositions::get()
+	{
+		return Atlas->GetSubpixelPositions();
+	}
+
+	float GlyphCache::DistanceFieldEmSize::get()
+	{
+		return Atlas->GetFieldEmSize();
+	}
+
+	int GlyphCache::DistanceFieldSpread::get()
+	{
+		return Atlas->GetFieldSpread();
+	}
+
+	int GlyphCache::Count::get()
+	{
+		return Atlas->GetCount();
+	}
+
+	Int64 GlyphCache::HitCount::get()
+	{
+		return Atlas->GetHits();
+	}
+
+	Int64 GlyphCache::MissCount::get()
+	{
+		return Atlas->GetMisses();
+	}
+
+	Int64 GlyphCache::EvictionCount::get()
+	{
+		return Atlas->GetEvictions();
+	}
+
+	bool GlyphCache::TryGetGlyph( DirectWrite::FontFace^ fontFace, float emSize, DirectWrite::RenderingMode renderingMode, float subpixelOffset, short glyphIndex, [Out] CachedGlyph% glyph )
+	{
+		if( fontFace == nullptr )
+			throw gcnew ArgumentNullException( "fontFace" );
+		if( !( emSize > 0.0f ) )
+			throw gcnew ArgumentOutOfRangeException( "emSize" );
+		if( renderingMode == DirectWrite::RenderingMode::Default || renderingMode == DirectWrite::RenderingMode::Outline )
+			throw gcnew ArgumentException( "The glyph cache needs an explicit, non-outline rendering mode.", "renderingMode" );
+
+		glyph = CachedGlyph();
+
+		GlyphSlot slot;
+		HRESULT hr = Atlas->Find( fontFace->InternalPointer, emSize, static_cast<DWRITE_RENDERING_MODE>( renderingMode ),
+			subpixelOffset, static_cast<UINT16>( glyphIndex ), slot );
+		if( RECORD_DW( hr ).IsFailure || hr == S_FALSE )
+			return false;
+
+		glyph = CachedGlyph( slot.Page, RectangleF( slot.U0, slot.V0, slot.U1 - slot.U0, slot.V1 - slot.V0 ),
+			Rectangle( slot.Left, slot.Top, slot.Width, slot.Height ) );
+		return true;
+	}
+
+	bool GlyphCache::TryGetDistanceFieldGlyph( DirectWrite::FontFace^ fontFace, short glyphIndex, [Out] CachedGlyph% glyph )
+	{
+		if( fontFace == nullptr )
+			throw gcnew ArgumentNullException( "fontFace" );
+
+		glyph = CachedGlyph();
+
+		GlyphSlot slot;
+		HRESULT hr = Atlas->FindField( fontFace->InternalPointer, static_cast<UINT16>( glyphIndex ), slot );
+		if( RECORD_DW( hr ).IsFailure || hr == S_FALSE )
+			return false;
+
+		glyph = CachedGlyph( slot.Page, RectangleF( slot.U0, slot.V0, slot.U1 - slot.U0, slot.V1 - slot.V0 ),
+			Rectangle( slot.Left, slot.Top, slot.Width, slot.Height ) );
+		return true;
+	}
+
+	void GlyphCache::Commit( DeviceContext^ context )
+	{
+		if( context == nullptr )
+			throw gcnew ArgumentNullException( "context" );
+
+		Atlas->Upload( context->InternalPointer, m_Texture->InternalPointer );
+	}
+
+	void GlyphCache::Clear()
+	{
+		Atlas->Clear();
+	}
+}
+}
@@ -0,0 +1,236 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "../directwrite/Enums.h"
+
+#include "CachedGlyph.h"
+#include "GlyphAtlas.h"
+
+using System::Runtime::InteropServices::OutAttribute;
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class Factory;
+		ref class FontFace;
+	}
+
+	namespace Direct3D11
+	{
+		ref class Device;
+		ref class DeviceContext;
+		ref class ShaderResourceView;
+		ref class Texture2D;
+
+		/// <summary>
+		/// Rasterizes DirectWrite glyphs on demand into the array slices (pages) of a single channel texture array,
+		/// so that text can be drawn as textured quads from one shader resource view.
+		/// </summary>
+		/// <remarks>
+		/// Glyphs are keyed by font face, size, rendering mode, glyph index and quantized horizontal subpixel offset.
+		/// New glyphs are rasterized into a CPU copy of the pages; <see cref="Commit"/> uploads the changed region of
+		/// each page with a single UpdateSubresource call. When every page is full, the least recently used page that
+		/// has not been used since the last commit is evicted as a whole. ClearType coverage is averaged to a single
+		/// channel, so the texture is R8_UNorm and can be sampled as alpha. The cache is not thread safe.
+		///
+		/// Glyphs fetched with <see cref="TryGetDistanceFieldGlyph"/> are stored as a signed distance field instead, rendered
+		/// once at <see cref="DistanceFieldEmSize"/> and scaled to any size. Their texels hold 0.5 on the outline, rising
+		/// towards 1 inside the glyph and falling towards 0 outside over <see cref="DistanceFieldSpread"/> pixels of the
+		/// reference size. A pixel shader turns a sample into coverage with smoothstep( 0.5 - w, 0.5 + w, value ), where w is
+		/// about fwidth( value ) * 0.7 for crisp edges; lowering the lower bound adds weight, and a second lookup offset
+		/// away from the light gives a drop shadow. Both kinds of glyph share the pages.
+		/// </remarks>
+		/// <unmanaged>None</unmanaged>
+		public ref class GlyphCache sealed
+		{
+		private:
+			GlyphAtlas* m_Atlas;
+			Texture2D^ m_Texture;
+			ShaderResourceView^ m_View;
+
+			void Init( Device^ device, DirectWrite::Factory^ factory, int pageSize, int pageCount, int subpixelPositions, float distanceFieldEmSize, int distanceFieldSpread );
+			void Destruct();
+
+		internal:
+			property GlyphAtlas* Atlas
+			{
+				GlyphAtlas* get();
+			}
+
+		public:
+			/// <summary>
+			/// Initializes a new instance of the <see cref="GlyphCache"/> class.
+			/// </summary>
+			/// <param name="device">The device with which to associate the cache texture.</param>
+			/// <param name="factory">The DirectWrite factory used to rasterize glyphs.</param>
+			/// <param name="pageSize">The width and height of each page, in pixels.</param>
+			/// <param name="pageCount">The number of pages, which is the array size of the cache texture.</param>
+			/// <param name="subpixelPositions">The number of horizontal subpixel positions a glyph is rasterized at, from 1 to 16.</param>
+			GlyphCache( Device^ device, DirectWrite::Factory^ factory, int pageSize, int pageCount, int subpixelPositions );
+
+			/// <summary>
+			/// Initializes a new instance of the <see cref="GlyphCache"/> class.
+			/// </summary>
+			/// <param name="device">The device with which to associate the cache texture.</param>
+			/// <param name="factory">The DirectWrite factory used to rasterize glyphs.</param>
+			/// <param name="pageSize">The width and height of each page, in pixels.</param>
+			/// <param name="pageCount">The number of pages, which is the array size of the cache texture.</param>
+			/// <param name="subpixelPositions">The number of horizontal subpixel positions a glyph is rasterized at, from 1 to 16.</param>
+			/// <param name="distanceFieldEmSize">The size, in pixels per em, at which distance field glyphs are stored.</param>
+			/// <param name="distanceFieldSpread">The distance, in pixels at <paramref name="distanceFieldEmSize"/>, that a distance field extends from the outline.</param>
+			GlyphCache( Device^ device, DirectWrite::Factory^ factory, int pageSize, int pageCount, int subpixelPositions, float distanceFieldEmSize, int distanceFieldSpread );
+
+			/// <summary>
+			/// Releases the cache texture and the rasterized glyphs.
+			/// </summary>
+			~GlyphCache();
+
+			/// <summary>
+			/// Releases the rasterized glyphs.
+			/// </summary>
+			!GlyphCache();
+
+			/// <summary>
+			/// Gets the texture array holding the pages.
+			/// </summary>
+			property Texture2D^ Texture
+			{
+				Texture2D^ get();
+			}
+
+			/// <summary>
+			/// Gets a shader resource view of all pages of the cache.
+			/// </summary>
+			property Direct3D11::ShaderResourceView^ ShaderResourceView
+			{
+				Direct3D11::ShaderResourceView^ get();
+			}
+
+			/// <summary>
+			/// Gets the width and height of each page, in pixels.
+			/// </summary>
+			property int PageSize
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the number of pages in the cache.
+			/// </summary>
+			property int PageCount
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the number of horizontal subpixel positions a glyph is rasterized at.
+			/// </summary>
+			property int SubpixelPositions
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the size, in pixels per em, at which distance field glyphs are stored.
+			/// </summary>
+			property float DistanceFieldEmSize
+			{
+				float get();
+			}
+
+			/// <summary>
+			/// Gets the distance, in pixels at <see cref="DistanceFieldEmSize"/>, that a distance field extends from the outline.
+			/// </summary>
+			property int DistanceFieldSpread
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the number of glyphs currently stored in the cache.
+			/// </summary>
+			property int Count
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the number of lookups that found the glyph already rasterized.
+			/// </summary>
+			property System::Int64 HitCount
+			{
+				System::Int64 get();
+			}
+
+			/// <summary>
+			/// Gets the number of lookups that had to rasterize the glyph.
+			/// </summary>
+			property System::Int64 MissCount
+			{
+				System::Int64 get();
+			}
+
+			/// <summary>
+			/// Gets the number of pages that have been evicted to make room for new glyphs.
+			/// </summary>
+			property System::Int64 EvictionCount
+			{
+				System::Int64 get();
+			}
+
+			/// <summary>
+			/// Finds a glyph in the cache, rasterizing it if it is not present.
+			/// </summary>
+			/// <param name="fontFace">The font face of the glyph.</param>
+			/// <param name="emSize">The size of the font, in pixels per em.</param>
+			/// <param name="renderingMode">The rendering mode; <see cref="DirectWrite::RenderingMode::Default"/> and <see cref="DirectWrite::RenderingMode::Outline"/> are not supported.</param>
+			/// <param name="subpixelOffset">The horizontal pen position of the glyph; only its fractional part is used.</param>
+			/// <param name="glyphIndex">The index of the glyph in the font face.</param>
+			/// <param name="glyph">When the method completes, contains the location of the glyph.</param>
+			/// <returns><c>true</c> if the glyph is available; <c>false</c> if there is no room for it until the next <see cref="Commit"/>, or rasterization failed.</returns>
+			bool TryGetGlyph( DirectWrite::FontFace^ fontFace, float emSize, DirectWrite::RenderingMode renderingMode, float subpixelOffset, short glyphIndex, [Out] CachedGlyph% glyph );
+
+			/// <summary>
+			/// Finds the signed distance field of a glyph in the cache, generating it if it is not present.
+			/// </summary>
+			/// <param name="fontFace">The font face of the glyph.</param>
+			/// <param name="glyphIndex">The index of the glyph in the font face.</param>
+			/// <param name="glyph">When the method completes, contains the location of the field. The black box includes the spread and is
+			/// measured in pixels at <see cref="DistanceFieldEmSize"/>; scale it by the drawn size divided by that size.</param>
+			/// <returns><c>true</c> if the glyph is available; <c>false</c> if there is no room for it until the next <see cref="Commit"/>, or rasterization failed.</returns>
+			bool TryGetDistanceFieldGlyph( DirectWrite::FontFace^ fontFace, short glyphIndex, [Out] CachedGlyph% glyph );
+
+			/// <summary>
+			/// Uploads the glyphs rasterized since the last commit, and allows the pages used since then to be evicted again.
+			/// </summary>
+			/// <param name="context">The context used to upload the glyphs.</param>
+			void Commit( DeviceContext^ context );
+
+			/// <summary>
+			/// Removes every glyph from the cache. The texels are left unchanged.
+			/// </summary>
+			void Clear();
+		};
+	}
+}
@@ -0,0 +1,58 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "../DataRectangle.h"
+#include "../DataStream.h"
+
+#include "MipChain.h"
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	MipChain::MipChain( DataStream^ data, array<DataRectangle^>^ levels )
+	: m_Data( data ), m_Levels( levels )
+	{
+	}
+
+	MipChain::~MipChain()
+	{
+		delete m_Data;
+	}
+
+	DataStream^ MipChain::Data::get()
+	{
+		return m_Data;
+	}
+
+	array<DataRectangle^>^ MipChain::Levels::get()
+	{
+		return m_Levels;
+	}
+
+	int MipChain::LevelCount::get()
+	{
+		return m_Levels->Length;
+	}
+}
+}
@@ -0,0 +1,78 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+	ref class DataRectangle;
+	ref class DataStream;
+
+	namespace Direct3D11
+	{
+		/// <summary>
+		/// A complete set of mip levels stored in a single contiguous buffer, as produced by <see cref="MipGenerator"/>.
+		/// </summary>
+		/// <remarks>
+		/// The streams of the individual levels are views into <see cref="Data"/>; they remain valid until the chain is disposed.
+		/// </remarks>
+		/// <unmanaged>None</unmanaged>
+		public ref class MipChain sealed
+		{
+		private:
+			DataStream^ m_Data;
+			array<DataRectangle^>^ m_Levels;
+
+		internal:
+			MipChain( DataStream^ data, array<DataRectangle^>^ levels );
+
+		public:
+			/// <summary>
+			/// Releases the buffer holding the mip levels.
+			/// </summary>
+			~MipChain();
+
+			/// <summary>
+			/// Gets the buffer holding every level, largest first.
+			/// </summary>
+			property DataStream^ Data
+			{
+				DataStream^ get();
+			}
+
+			/// <summary>
+			/// Gets one rectangle per level, largest first, suitable for passing to the <see cref="Texture2D"/> constructor.
+			/// </summary>
+			property array<DataRectangle^>^ Levels
+			{
+				array<DataRectangle^>^ get();
+			}
+
+			/// <summary>
+			/// Gets the number of levels in the chain.
+			/// </summary>
+			property int LevelCount
+			{
+				int get();
+			}
+		};
+	}
+}
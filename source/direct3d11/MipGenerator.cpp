@@ -0,0 +1,145 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <vector>
+
+#include "../DataRectangle.h"
+#include "../DataStream.h"
+#include "../dxgi/FormatTable.h"
+
+#include "MipKernels.h"
+#include "MipGenerator.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	int MipGenerator::GetLevelCount( int width, int height )
+	{
+		if( width < 1 )
+			throw gcnew ArgumentOutOfRangeException( "width" );
+		if( height < 1 )
+			throw gcnew ArgumentOutOfRangeException( "height" );
+
+		int count = 1;
+		for( int size = std::max( width, height ); size > 1; size /= 2 )
+			count++;
+
+		return count;
+	}
+
+	bool MipGenerator::CanGenerate( DXGI::Format format )
+	{
+		return MipKernels::CanGenerate( static_cast<DXGI_FORMAT>( format ) );
+	}
+
+	MipChain^ MipGenerator::Generate( DXGI::Format format, int width, int height, DataRectangle^ source, MipFilter filter )
+	{
+		const DXGI::FormatDescriptor* descriptor = DXGI::GetFormatDescriptor( static_cast<DXGI_FORMAT>( format ) );
+		bool srgb = descriptor != NULL && descriptor->Type == DXGI::FormatType_UNormSrgb;
+
+		return Generate( format, width, height, source, 0, filter, srgb );
+	}
+
+	MipChain^ MipGenerator::Generate( DXGI::Format format, int width, int height, DataRectangle^ source, int levelCount, MipFilter filter, bool gammaCorrect )
+	{
+		DXGI_FORMAT nativeFormat = static_cast<DXGI_FORMAT>( format );
+		if( !MipKernels::CanGenerate( nativeFormat ) )
+			throw gcnew ArgumentException( "Mip chains cannot be generated for the format.", "format" );
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+		if( filter < MipFilter::Box || filter > MipFilter::Kaiser )
+			throw gcnew ArgumentOutOfRangeException( "filter" );
+
+		int fullCount = GetLevelCount( width, height );
+		if( levelCount < 0 || levelCount > fullCount )
+			throw gcnew ArgumentOutOfRangeException( "levelCount" );
+		if( levelCount == 0 )
+			levelCount = fullCount;
+
+		const DXGI::FormatDescriptor* descriptor = DXGI::GetFormatDescriptor( nativeFormat );
+		int pixelSize = descriptor->BitsPerElement / 8;
+		Int64 rowSize = static_cast<Int64>( width ) * pixelSize;
+		if( source->Pitch < rowSize )
+			throw gcnew ArgumentException( "The source pitch is smaller than one row of pixels.", "source" );
+		if( ( height - 1 ) * static_cast<Int64>( source->Pitch ) + rowSize > source->Data->RemainingLength )
+			throw gcnew ArgumentException( "The source does not contain enough data for an image of the given size.", "source" );
+
+		// the codec of the other member of an sRGB pair reads the same bytes in the other colour space
+		DXGI_FORMAT codecFormat = nativeFormat;
+		if( gammaCorrect != ( descriptor->Type == DXGI::FormatType_UNormSrgb ) )
+		{
+			if( descriptor->SrgbPair == DXGI_FORMAT_UNKNOWN )
+				throw gcnew ArgumentException( "Gamma correct filtering requires an 8-bit UNorm format with an sRGB counterpart.", "gammaCorrect" );
+
+			codecFormat = descriptor->SrgbPair;
+		}
+
+		// levels are tightly packed rows, each level starting on a 16 byte boundary
+		std::vector<size_t> offsets( levelCount );
+		std::vector<size_t> pitches( levelCount );
+		Int64 totalSize = 0;
+		for( int level = 0, levelWidth = width, levelHeight = height; level < levelCount; level++ )
+		{
+			offsets[level] = static_cast<size_t>( totalSize );
+			pitches[level] = static_cast<size_t>( levelWidth ) * pixelSize;
+			totalSize += ( static_cast<Int64>( pitches[level] ) * levelHeight + 15 ) & ~static_cast<Int64>( 15 );
+
+			levelWidth = std::max( 1, levelWidth / 2 );
+			levelHeight = std::max( 1, levelHeight / 2 );
+		}
+
+		DataStream^ data = gcnew DataStream( totalSize, true, true );
+
+		MipKernels::MipChainJob job;
+		job.CodecFormat = codecFormat;
+		job.Filter = static_cast<MipKernels::FilterKind>( filter );
+		job.Width = width;
+		job.Height = height;
+		job.LevelCount = levelCount;
+		job.Source = reinterpret_cast<const uint8_t*>( source->Data->PositionPointer );
+		job.SourcePitch = source->Pitch;
+		job.Destination = reinterpret_cast<uint8_t*>( data->DataPointer.ToPointer() );
+		job.LevelOffsets = &offsets[0];
+		job.LevelPitches = &pitches[0];
+
+		if( !MipKernels::GenerateMipChain( job ) )
+		{
+			delete data;
+			throw gcnew OutOfMemoryException();
+		}
+
+		array<DataRectangle^>^ levels = gcnew array<DataRectangle^>( levelCount );
+		for( int level = 0; level < levelCount; level++ )
+		{
+			Int64 levelSize = ( level + 1 < levelCount ? static_cast<Int64>( offsets[level + 1] ) : totalSize ) - static_cast<Int64>( offsets[level] );
+			DataStream^ view = gcnew DataStream( job.Destination + offsets[level], levelSize, true, true, false );
+			levels[level] = gcnew DataRectangle( static_cast<int>( pitches[level] ), view );
+		}
+
+		return gcnew MipChain( data, levels );
+	}
+}
+}
@@ -0,0 +1,94 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "../dxgi/Enums.h"
+
+#include "Enums11.h"
+#include "MipChain.h"
+
+namespace SlimDX
+{
+	ref class DataRectangle;
+
+	namespace Direct3D11
+	{
+		/// <summary>
+		/// Builds mip chains on the CPU, for formats and filters that <see cref="DeviceContext::GenerateMips"/> cannot handle.
+		/// </summary>
+		/// <remarks>
+		/// Each level is filtered from the full precision result of the previous one, with the rows of every pass processed
+		/// in parallel on the thread pool. Supported formats are R8G8B8A8, B8G8R8A8 and B8G8R8X8 (with their sRGB variants),
+		/// R10G10B10A2_UNorm, R16G16B16A16_UNorm, R16G16B16A16_Float and R32G32B32A32_Float.
+		/// Working memory of roughly 32 bytes per texel of the top level is needed while the chain is built.
+		/// </remarks>
+		/// <unmanaged>None</unmanaged>
+		public ref class MipGenerator sealed
+		{
+		private:
+			MipGenerator() { }
+
+		public:
+			/// <summary>
+			/// Gets the number of levels in a full mip chain down to 1x1.
+			/// </summary>
+			/// <param name="width">The width of the top level, in pixels.</param>
+			/// <param name="height">The height of the top level, in pixels.</param>
+			/// <returns>The number of levels in the full chain.</returns>
+			static int GetLevelCount( int width, int height );
+
+			/// <summary>
+			/// Determines whether mip chains can be generated for data of a format.
+			/// </summary>
+			/// <param name="format">The format to check.</param>
+			/// <returns><c>true</c> if <see cref="Generate"/> accepts the format; otherwise, <c>false</c>.</returns>
+			static bool CanGenerate( DXGI::Format format );
+
+			/// <summary>
+			/// Generates a full mip chain. Colour channels of sRGB formats are filtered in linear light; other formats are filtered as stored.
+			/// </summary>
+			/// <param name="format">The format of the source data and of the generated levels.</param>
+			/// <param name="width">The width of the source image, in pixels.</param>
+			/// <param name="height">The height of the source image, in pixels.</param>
+			/// <param name="source">The top level, starting at the current position of its stream. It is copied unchanged into the chain.</param>
+			/// <param name="filter">The filter used to reduce each level.</param>
+			/// <returns>The generated mip chain.</returns>
+			static MipChain^ Generate( DXGI::Format format, int width, int height, DataRectangle^ source, MipFilter filter );
+
+			/// <summary>
+			/// Generates a mip chain.
+			/// </summary>
+			/// <param name="format">The format of the source data and of the generated levels.</param>
+			/// <param name="width">The width of the source image, in pixels.</param>
+			/// <param name="height">The height of the source image, in pixels.</param>
+			/// <param name="source">The top level, starting at the current position of its stream. It is copied unchanged into the chain.</param>
+			/// <param name="levelCount">The number of levels to generate, including the top level, or 0 for a full chain.</param>
+			/// <param name="filter">The filter used to reduce each level.</param>
+			/// <param name="gammaCorrect"><c>true</c> to filter colour channels in linear light, treating 8-bit UNorm data as sRGB encoded;
+			/// <c>false</c> to filter the stored values directly, even for sRGB formats. Alpha is always filtered as stored.
+			/// Only formats with an sRGB counterpart can be filtered in linear light.</param>
+			/// <returns>The generated mip chain.</returns>
+			/// <exception cref="System::ArgumentException"><paramref name="gammaCorrect"/> is <c>true</c> and <paramref name="format"/> has no sRGB counterpart.</exception>
+			static MipChain^ Generate( DXGI::Format format, int width, int height, DataRectangle^ source, int levelCount, MipFilter filter, bool gammaCorrect );
+		};
+	}
+}
@@ -0,0 +1,328 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#pragma managed(push, off)
+
+#include <emmintrin.h>
+#include <vector>
+
+#include "../ParallelFor.h"
+#include "../dxgi/PixelCodec.h"
+
+#include "MipKernels.h"
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+namespace MipKernels
+{
+namespace
+{
+	// Kaiser-windowed sinc, measured in destination pixels.
+	const double KaiserWidth = 3.0;
+	const double KaiserAlpha = 4.0;
+
+	// Below this many rows a pass is cheaper to run on the calling thread.
+	const int MinimumParallelRows = 16;
+
+	struct Tap
+	{
+		uint32_t Index;
+		float Weight;
+	};
+
+	// Normalized weights for resampling one axis; the taps of destination pixel i are Taps[Starts[i]] to Taps[Starts[i + 1]].
+	struct Kernel
+	{
+		std::vector<Tap> Taps;
+		std::vector<size_t> Starts;
+	};
+
+	// Owns 16-byte aligned pixel storage for one float RGBA surface.
+	class PixelBuffer
+	{
+	public:
+		PixelBuffer() : m_Pixels( NULL ) { }
+		~PixelBuffer() { _aligned_free( m_Pixels ); }
+
+		bool Allocate( size_t count )
+		{
+			_aligned_free( m_Pixels );
+			m_Pixels = static_cast<__m128*>( _aligned_malloc( std::max<size_t>( count, 1 ) * sizeof( __m128 ), 16 ) );
+			return m_Pixels != NULL;
+		}
+
+		void Swap( PixelBuffer& other ) { std::swap( m_Pixels, other.m_Pixels ); }
+		__m128* Get() const { return m_Pixels; }
+
+	private:
+		PixelBuffer( const PixelBuffer& );
+		PixelBuffer& operator=( const PixelBuffer& );
+
+		__m128* m_Pixels;
+	};
+
+	double Sinc( double x )
+	{
+		const double Pi = 3.14159265358979323846;
+		if( fabs( x ) < 1e-6 )
+			return 1.0;
+
+		return sin( Pi * x ) / ( Pi * x );
+	}
+
+	// Zeroth order modified Bessel function of the first kind, by its power series.
+	double BesselI0( double x )
+	{
+		double sum = 1.0;
+		double term = 1.0;
+		const double quarter = x * x * 0.25;
+		for( int k = 1; k < 64 && term > sum * 1e-12; k++ )
+		{
+			term *= quarter / ( k * k );
+			sum += term;
+		}
+
+		return sum;
+	}
+
+	double Kaiser( double x )
+	{
+		const double ratio = x / KaiserWidth;
+		if( ratio <= -1.0 || ratio >= 1.0 )
+			return 0.0;
+
+		return Sinc( x ) * BesselI0( KaiserAlpha * sqrt( 1.0 - ratio * ratio ) ) / BesselI0( KaiserAlpha );
+	}
+
+	// Builds the weights that take sourceSize samples to destinationSize. The box filter weighs each source texel by how
+	// much of it the destination texel covers, which keeps odd sizes exact; the Kaiser filter is evaluated at texel centres.
+	// Taps that fall outside the source are clamped to the edge.
+	void BuildKernel( FilterKind filter, size_t sourceSize, size_t destinationSize, Kernel& kernel )
+	{
+		const double scale = static_cast<double>( sourceSize ) / destinationSize;
+		const double radius = filter == KaiserFilter ? KaiserWidth * scale : scale * 0.5;
+		const int last = static_cast<int>( sourceSize ) - 1;
+
+		kernel.Taps.clear();
+		kernel.Starts.assign( 1, 0 );
+
+		for( size_t i = 0; i < destinationSize; i++ )
+		{
+			const double center = ( i + 0.5 ) * scale;
+			const int first = static_cast<int>( floor( center - radius ) );
+			const int end = static_cast<int>( ceil( center + radius ) );
+			const size_t start = kernel.Taps.size();
+
+			double total = 0.0;
+			for( int j = first; j < end; j++ )
+			{
+				double weight;
+				if( filter == KaiserFilter )
+					weight = Kaiser( ( j + 0.5 - center ) / scale );
+				else
+					weight = std::max( 0.0, std::min<double>( j + 1, center + radius ) - std::max<double>( j, center - radius ) );
+
+				if( weight == 0.0 )
+					continue;
+
+				const uint32_t index = static_cast<uint32_t>( std::min( std::max( j, 0 ), last ) );
+				if( kernel.Taps.size() > start && kernel.Taps.back().Index == index )
+				{
+					kernel.Taps.back().Weight += static_cast<float>( weight );
+				}
+				else
+				{
+					Tap tap = { index, static_cast<float>( weight ) };
+					kernel.Taps.push_back( tap );
+				}
+
+				total += weight;
+			}
+
+			const float normalize = static_cast<float>( 1.0 / total );
+			for( size_t tap = start; tap < kernel.Taps.size(); tap++ )
+				kernel.Taps[tap].Weight *= normalize;
+
+			kernel.Starts.push_back( kernel.Taps.size() );
+		}
+	}
+
+	struct UnpackPass
+	{
+		const DXGI::FormatConversion::PixelCodec* Codec;
+		const uint8_t* Source;
+		size_t SourcePitch;
+		__m128* Destination;
+		size_t Width;
+	};
+
+	void UnpackLevelRow( void* context, int row )
+	{
+		const UnpackPass& pass = *static_cast<const UnpackPass*>( context );
+		pass.Codec->Unpack( pass.Source + row * pass.SourcePitch, pass.Destination + row * pass.Width, pass.Width );
+	}
+
+	struct HorizontalPass
+	{
+		const Kernel* Filter;
+		const __m128* Source;
+		size_t SourceWidth;
+		__m128* Destination;
+		size_t DestinationWidth;
+	};
+
+	void FilterHorizontalRow( void* context, int row )
+	{
+		const HorizontalPass& pass = *static_cast<const HorizontalPass*>( context );
+		const __m128* source = pass.Source + row * pass.SourceWidth;
+		__m128* destination = pass.Destination + row * pass.DestinationWidth;
+		const Tap* taps = &pass.Filter->Taps[0];
+		const size_t* starts = &pass.Filter->Starts[0];
+
+		for( size_t x = 0; x < pass.DestinationWidth; x++ )
+		{
+			__m128 sum = _mm_setzero_ps();
+			for( size_t tap = starts[x]; tap < starts[x + 1]; tap++ )
+				sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( taps[tap].Weight ), source[taps[tap].Index] ) );
+
+			destination[x] = sum;
+		}
+	}
+
+	struct VerticalPass
+	{
+		const Kernel* Filter;
+		const __m128* Source;
+		__m128* Destination;
+		size_t Width;
+		const DXGI::FormatConversion::PixelCodec* Codec;
+		uint8_t* Output;
+		size_t OutputPitch;
+	};
+
+	// Accumulates whole source rows so the inner loop streams through memory, then encodes the finished row.
+	void FilterVerticalRow( void* context, int row )
+	{
+		const VerticalPass& pass = *static_cast<const VerticalPass*>( context );
+		__m128* destination = pass.Destination + row * pass.Width;
+		const Tap* taps = &pass.Filter->Taps[0];
+		const size_t* starts = &pass.Filter->Starts[0];
+
+		for( size_t x = 0; x < pass.Width; x++ )
+			destination[x] = _mm_setzero_ps();
+
+		for( size_t tap = starts[row]; tap < starts[row + 1]; tap++ )
+		{
+			const __m128 weight = _mm_set1_ps( taps[tap].Weight );
+			const __m128* source = pass.Source + taps[tap].Index * pass.Width;
+
+			size_t x = 0;
+			for( ; x + 4 <= pass.Width; x += 4 )
+			{
+				destination[x + 0] = _mm_add_ps( destination[x + 0], _mm_mul_ps( weight, source[x + 0] ) );
+				destination[x + 1] = _mm_add_ps( destination[x + 1], _mm_mul_ps( weight, source[x + 1] ) );
+				destination[x + 2] = _mm_add_ps( destination[x + 2], _mm_mul_ps( weight, source[x + 2] ) );
+				destination[x + 3] = _mm_add_ps( destination[x + 3], _mm_mul_ps( weight, source[x + 3] ) );
+			}
+
+			for( ; x < pass.Width; x++ )
+				destination[x] = _mm_add_ps( destination[x], _mm_mul_ps( weight, source[x] ) );
+		}
+
+		pass.Codec->Pack( destination, pass.Output + row * pass.OutputPitch, pass.Width );
+	}
+
+	inline size_t NextSize( size_t size )
+	{
+		return std::max<size_t>( 1, size / 2 );
+	}
+}
+
+	bool CanGenerate( DXGI_FORMAT format )
+	{
+		return DXGI::FormatConversion::FindCodec( format ) != NULL;
+	}
+
+	bool GenerateMipChain( const MipChainJob& job )
+	{
+		const DXGI::FormatConversion::PixelCodec* codec = DXGI::FormatConversion::FindCodec( job.CodecFormat );
+		const size_t rowSize = std::min( job.SourcePitch, job.LevelPitches[0] );
+
+		for( size_t y = 0; y < job.Height; y++ )
+			memcpy( job.Destination + job.LevelOffsets[0] + y * job.LevelPitches[0], job.Source + y * job.SourcePitch, rowSize );
+
+		if( job.LevelCount < 2 )
+			return true;
+
+		try
+		{
+			PixelBuffer current;
+			PixelBuffer next;
+			PixelBuffer intermediate;
+			Kernel horizontal;
+			Kernel vertical;
+
+			if( !current.Allocate( job.Width * job.Height ) ||
+				!next.Allocate( NextSize( job.Width ) * NextSize( job.Height ) ) ||
+				!intermediate.Allocate( NextSize( job.Width ) * job.Height ) )
+				return false;
+
+			UnpackPass unpack = { codec, job.Source, job.SourcePitch, current.Get(), job.Width };
+			ParallelFor( static_cast<int>( job.Height ), MinimumParallelRows, UnpackLevelRow, &unpack );
+
+			size_t width = job.Width;
+			size_t height = job.Height;
+			for( size_t level = 1; level < job.LevelCount; level++ )
+			{
+				const size_t levelWidth = NextSize( width );
+				const size_t levelHeight = NextSize( height );
+
+				BuildKernel( job.Filter, width, levelWidth, horizontal );
+				BuildKernel( job.Filter, height, levelHeight, vertical );
+
+				HorizontalPass across = { &horizontal, current.Get(), width, intermediate.Get(), levelWidth };
+				ParallelFor( static_cast<int>( height ), MinimumParallelRows, FilterHorizontalRow, &across );
+
+				VerticalPass down = { &vertical, intermediate.Get(), next.Get(), levelWidth, codec, job.Destination + job.LevelOffsets[level], job.LevelPitches[level] };
+				ParallelFor( static_cast<int>( levelHeight ), MinimumParallelRows, FilterVerticalRow, &down );
+
+				// the level just written becomes the full precision source of the next one
+				current.Swap( next );
+				width = levelWidth;
+				height = levelHeight;
+			}
+		}
+		catch( std::bad_alloc& )
+		{
+			return false;
+		}
+
+		return true;
+	}
+}
+}
+}
+
+#pragma managed(pop)
@@ -0,0 +1,62 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	// Native resampling routines used by MipGenerator. They are compiled as unmanaged code so that they can
+	// use SSE2 intrinsics; the managed side only validates arguments and lays out the destination buffer.
+	namespace MipKernels
+	{
+		enum FilterKind
+		{
+			BoxFilter = 0,
+			KaiserFilter = 1
+		};
+
+		struct MipChainJob
+		{
+			// The format whose float codec decodes and encodes the pixels. Choosing the sRGB or linear member of
+			// a pair selects whether colour channels are filtered in linear light or as stored.
+			DXGI_FORMAT CodecFormat;
+			FilterKind Filter;
+			size_t Width;
+			size_t Height;
+			size_t LevelCount;
+			const uint8_t* Source;
+			size_t SourcePitch;
+			uint8_t* Destination;
+			const size_t* LevelOffsets;
+			const size_t* LevelPitches;
+		};
+
+		// Returns true if GenerateMipChain can filter data of the format.
+		bool CanGenerate( DXGI_FORMAT format );
+
+		// Copies the source into level 0 and filters each further level from the full precision result of the
+		// previous one. Rows of every pass run in parallel. Returns false if the working memory could not be allocated.
+		bool GenerateMipChain( const MipChainJob& job );
+	}
+}
+}
@@ -20,6 +20,7 @@
 * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 * THE SOFTWARE.
 */
+#include "../ComObjectFactory.h"
 #include "../ObjectTable.h"
 #include "../DataStream.h"
 
@@ -34,8 +35,6 @@
 
 using namespace System;
 using namespace System::IO;
-using namespace System::Reflection;
-using namespace System::Globalization;
 
 namespace SlimDX
 {
@@ -57,20 +56,12 @@ namespace Direct3D11
 		T Resource::FromSwapChain( SlimDX::DXGI::SwapChain^ swapChain, int index )
 	{
 		IUnknown* unknown = 0;
-		GUID guid = Utilities::GetNativeGuidForType( T::typeid );
+		GUID guid = Utilities::ConvertManagedGuid( ComObjectFactory<T>::NativeInterface );
 		RECORD_D3D11( swapChain->InternalPointer->GetBuffer( index, guid, reinterpret_cast<void**>( &unknown ) ) );
 		if( Result::Last.IsFailure )
 			return T();
 
-		BindingFlags flags = BindingFlags::Static | BindingFlags::InvokeMethod | BindingFlags::NonPublic;
-		array<System::Object^>^ args = gcnew array<System::Object^>( 1 );
-		args[ 0 ] = IntPtr( unknown );
-
-		// Trying to invoke "FromPointer" directly will choose the IntPtr overload since it's more
-		// cumbersome to pass a native pointer as an argument here. The IntPtr overload is intended
-		// to be the user-pointer overload, however, which isn't what we want; thus the thunk.
-		T result = safe_cast<T>( T::typeid->InvokeMember( "FromPointerReflectionThunk", flags, nullptr, nullptr, args, CultureInfo::InvariantCulture ) );
-		return result;
+		return ComObjectFactory<T>::FromPointer( unknown, nullptr );
 	}
 
 	Resource^ Resource::FromPointer( ID3D11Resource* pointer )
@@ -0,0 +1,95 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "TextGeometryRenderer.h"
+#include "TextColorEffect.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	TextColorEffect::TextColorEffect( Color4 color )
+	{
+		m_Effect = new ColorDrawingEffect( PackColor( color ) );
+	}
+
+	TextColorEffect::~TextColorEffect()
+	{
+		Destruct();
+		GC::SuppressFinalize( this );
+	}
+
+	TextColorEffect::!TextColorEffect()
+	{
+		Destruct();
+	}
+
+	void TextColorEffect::Destruct()
+	{
+		// a layout may still hold a reference, so the effect lives on until that is released too
+		if( m_Effect != 0 )
+			m_Effect->Release();
+
+		m_Effect = 0;
+	}
+
+	Color4 TextColorEffect::Color::get()
+	{
+		if( m_Effect == 0 )
+			throw gcnew ObjectDisposedException( "TextColorEffect" );
+
+		return UnpackColor( m_Effect->GetColor() );
+	}
+
+	void TextColorEffect::Color::set( Color4 value )
+	{
+		if( m_Effect == 0 )
+			throw gcnew ObjectDisposedException( "TextColorEffect" );
+
+		m_Effect->SetColor( PackColor( value ) );
+	}
+
+	IntPtr TextColorEffect::ComPointer::get()
+	{
+		return IntPtr( static_cast<IUnknown*>( m_Effect ) );
+	}
+
+	static UINT32 PackChannel( float value )
+	{
+		return static_cast<UINT32>( std::max( 0.0f, std::min( 1.0f, value ) ) * 255.0f + 0.5f );
+	}
+
+	UINT32 TextColorEffect::PackColor( Color4 color )
+	{
+		return PackChannel( color.Red ) | PackChannel( color.Green ) << 8 | PackChannel( color.Blue ) << 16 | PackChannel( color.Alpha ) << 24;
+	}
+
+	Color4 TextColorEffect::UnpackColor( UINT32 color )
+	{
+		const float scale = 1.0f / 255.0f;
+		return Color4( ( color >> 24 ) * scale, ( color & 0xff ) * scale, ( ( color >> 8 ) & 0xff ) * scale, ( ( color >> 16 ) & 0xff ) * scale );
+	}
+}
+}
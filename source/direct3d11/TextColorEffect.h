@@ -0,0 +1,85 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "../directwrite/IClientDrawingEffect.h"
+
+namespace SlimDX
+{
+	namespace Direct3D11
+	{
+		class ColorDrawingEffect;
+
+		/// <summary>
+		/// A drawing effect that sets the color of the quads a <see cref="TextGeometryBuilder"/> writes for a range of text.
+		/// </summary>
+		/// <remarks>
+		/// Apply it with <see cref="DirectWrite::TextLayout::SetDrawingEffect"/>. Text without an effect uses the default color of the builder.
+		/// </remarks>
+		/// <unmanaged>None</unmanaged>
+		public ref class TextColorEffect sealed : DirectWrite::IClientDrawingEffect
+		{
+		private:
+			ColorDrawingEffect* m_Effect;
+
+			void Destruct();
+
+		public:
+			/// <summary>
+			/// Initializes a new instance of the <see cref="TextColorEffect"/> class.
+			/// </summary>
+			/// <param name="color">The color of the text.</param>
+			TextColorEffect( Color4 color );
+
+			/// <summary>
+			/// Releases the native effect.
+			/// </summary>
+			~TextColorEffect();
+
+			/// <summary>
+			/// Releases the native effect.
+			/// </summary>
+			!TextColorEffect();
+
+			/// <summary>
+			/// Gets or sets the color of the text. A change is seen by the next build.
+			/// </summary>
+			property Color4 Color
+			{
+				Color4 get();
+				void set( Color4 value );
+			}
+
+			/// <summary>
+			/// Gets a pointer to the native effect.
+			/// </summary>
+			property System::IntPtr ComPointer
+			{
+				virtual System::IntPtr get();
+			}
+
+		internal:
+			static UINT32 PackColor( Color4 color );
+			static Color4 UnpackColor( UINT32 color );
+		};
+	}
+}
@@ -0,0 +1,205 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "../DataStream.h"
+#include "../directwrite/DirectWriteException.h"
+#include "../directwrite/TextLayout.h"
+
+#include "Direct3D11Exception.h"
+
+#include "Buffer11.h"
+#include "DeviceContext11.h"
+#include "GlyphCache.h"
+#include "TextColorEffect.h"
+#include "TextGeometryRenderer.h"
+#include "TextGeometryBuilder.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	TextGeometryBuilder::TextGeometryBuilder( GlyphCache^ cache )
+	{
+		if( cache == nullptr )
+			throw gcnew ArgumentNullException( "cache" );
+
+		m_Renderer = new TextGeometryRenderer( cache->Atlas );
+		m_Cache = cache;
+		m_Transform = Matrix3x2::Identity;
+		m_PixelsPerDip = 1.0f;
+		m_DefaultColor = Color4( 1.0f, 1.0f, 1.0f, 1.0f );
+		m_RenderingMode = DirectWrite::RenderingMode::ClearTypeNatural;
+	}
+
+	TextGeometryBuilder::~TextGeometryBuilder()
+	{
+		Destruct();
+		GC::SuppressFinalize( this );
+	}
+
+	TextGeometryBuilder::!TextGeometryBuilder()
+	{
+		Destruct();
+	}
+
+	void TextGeometryBuilder::Destruct()
+	{
+		if( m_Renderer != 0 )
+			m_Renderer->Release();
+
+		m_Renderer = 0;
+	}
+
+	GlyphCache^ TextGeometryBuilder::Cache::get()
+	{
+		return m_Cache;
+	}
+
+	Matrix3x2 TextGeometryBuilder::Transform::get()
+	{
+		return m_Transform;
+	}
+
+	void TextGeometryBuilder::Transform::set( Matrix3x2 value )
+	{
+		m_Transform = value;
+	}
+
+	float TextGeometryBuilder::PixelsPerDip::get()
+	{
+		return m_PixelsPerDip;
+	}
+
+	void TextGeometryBuilder::PixelsPerDip::set( float value )
+	{
+		if( !( value > 0.0f ) )
+			throw gcnew ArgumentOutOfRangeException( "value" );
+
+		m_PixelsPerDip = value;
+	}
+
+	Color4 TextGeometryBuilder::DefaultColor::get()
+	{
+		return m_DefaultColor;
+	}
+
+	void TextGeometryBuilder::DefaultColor::set( Color4 value )
+	{
+		m_DefaultColor = value;
+	}
+
+	DirectWrite::RenderingMode TextGeometryBuilder::RenderingMode::get()
+	{
+		return m_RenderingMode;
+	}
+
+	void TextGeometryBuilder::RenderingMode::set( DirectWrite::RenderingMode value )
+	{
+		if( value == DirectWrite::RenderingMode::Default || value == DirectWrite::RenderingMode::Outline )
+			throw gcnew ArgumentException( "The glyph cache needs an explicit, non-outline rendering mode.", "value" );
+
+		m_RenderingMode = value;
+	}
+
+	int TextGeometryBuilder::DroppedCount::get()
+	{
+		return m_DroppedCount;
+	}
+
+	int TextGeometryBuilder::Build( DirectWrite::TextLayout^ layout, float originX, float originY, void* destination, UINT32 capacity )
+	{
+		Matrix3x2 transform = m_Transform;
+		m_Renderer->SetTransform( *reinterpret_cast<DWRITE_MATRIX*>( &transform ), m_PixelsPerDip );
+		m_Renderer->SetDefaultColor( TextColorEffect::PackColor( m_DefaultColor ) );
+		m_Renderer->SetRenderingMode( static_cast<DWRITE_RENDERING_MODE>( m_RenderingMode ) );
+		m_Renderer->Begin( destination, capacity );
+
+		HRESULT hr = layout->InternalPointer->Draw( NULL, m_Renderer, originX, originY );
+		if( SUCCEEDED( hr ) )
+			hr = m_Renderer->GetError();
+
+		m_DroppedCount = static_cast<int>( m_Renderer->GetDropped() );
+		RECORD_DW( hr );
+		return static_cast<int>( m_Renderer->GetCount() );
+	}
+
+	int TextGeometryBuilder::Build( DirectWrite::TextLayout^ layout, float originX, float originY, DataStream^ destination )
+	{
+		if( m_Renderer == 0 )
+			throw gcnew ObjectDisposedException( "TextGeometryBuilder" );
+		if( m_Cache->Texture == nullptr )
+			throw gcnew ObjectDisposedException( "GlyphCache" );
+		if( layout == nullptr )
+			throw gcnew ArgumentNullException( "layout" );
+		if( destination == nullptr )
+			throw gcnew ArgumentNullException( "destination" );
+		if( !destination->CanWrite )
+			throw gcnew NotSupportedException( "The destination stream does not support writing." );
+
+		UINT32 capacity = static_cast<UINT32>( std::min<Int64>( destination->RemainingLength / TextQuad::SizeInBytes, UINT_MAX ) );
+		int count = Build( layout, originX, originY, destination->PositionPointer, capacity );
+
+		destination->Position += static_cast<Int64>( count ) * TextQuad::SizeInBytes;
+		return count;
+	}
+
+	int TextGeometryBuilder::Build( DirectWrite::TextLayout^ layout, float originX, float originY, DeviceContext^ context, Buffer^ buffer, int quadOffset )
+	{
+		if( m_Renderer == 0 )
+			throw gcnew ObjectDisposedException( "TextGeometryBuilder" );
+		if( m_Cache->Texture == nullptr )
+			throw gcnew ObjectDisposedException( "GlyphCache" );
+		if( layout == nullptr )
+			throw gcnew ArgumentNullException( "layout" );
+		if( context == nullptr )
+			throw gcnew ArgumentNullException( "context" );
+		if( buffer == nullptr )
+			throw gcnew ArgumentNullException( "buffer" );
+
+		D3D11_BUFFER_DESC description;
+		buffer->InternalPointer->GetDesc( &description );
+
+		UINT32 quadCount = description.ByteWidth / TextQuad::SizeInBytes;
+		if( quadOffset < 0 || static_cast<UINT32>( quadOffset ) > quadCount )
+			throw gcnew ArgumentOutOfRangeException( "quadOffset" );
+
+		D3D11_MAP mode = quadOffset == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+		D3D11_MAPPED_SUBRESOURCE mapped;
+		if( RECORD_D3D11( context->InternalPointer->Map( buffer->InternalPointer, 0, mode, 0, &mapped ) ).IsFailure )
+			return 0;
+
+		// drawing the layout can throw through RECORD_DW, and the buffer must not stay mapped
+		try
+		{
+			TextQuadData* quads = static_cast<TextQuadData*>( mapped.pData ) + quadOffset;
+			return Build( layout, originX, originY, quads, quadCount - quadOffset );
+		}
+		finally
+		{
+			context->InternalPointer->Unmap( buffer->InternalPointer, 0 );
+		}
+	}
+}
+}
@@ -0,0 +1,163 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "../directwrite/Enums.h"
+
+#include "TextQuad.h"
+
+namespace SlimDX
+{
+	ref class DataStream;
+
+	namespace DirectWrite
+	{
+		ref class TextLayout;
+	}
+
+	namespace Direct3D11
+	{
+		ref class Buffer;
+		ref class DeviceContext;
+		ref class GlyphCache;
+		class TextGeometryRenderer;
+
+		/// <summary>
+		/// Turns text layouts into <see cref="TextQuad"/> instances that sample a <see cref="GlyphCache"/>, without
+		/// calling back into managed code for each glyph run.
+		/// </summary>
+		/// <remarks>
+		/// The layout is drawn through a native text renderer that looks every glyph up in the cache, applies the origin,
+		/// <see cref="Transform"/> and <see cref="PixelsPerDip"/>, takes colors from <see cref="TextColorEffect"/> drawing
+		/// effects, and writes the quads straight into the destination memory. Glyphs are rasterized upright; the transform
+		/// moves them and scales their size, but does not rotate or skew them. Call <see cref="GlyphCache::Commit"/> before
+		/// drawing the quads. The builder is not thread safe.
+		/// </remarks>
+		/// <unmanaged>None</unmanaged>
+		public ref class TextGeometryBuilder sealed
+		{
+		private:
+			TextGeometryRenderer* m_Renderer;
+			GlyphCache^ m_Cache;
+			Matrix3x2 m_Transform;
+			float m_PixelsPerDip;
+			Color4 m_DefaultColor;
+			DirectWrite::RenderingMode m_RenderingMode;
+			int m_DroppedCount;
+
+			int Build( DirectWrite::TextLayout^ layout, float originX, float originY, void* destination, UINT32 capacity );
+			void Destruct();
+
+		public:
+			/// <summary>
+			/// Initializes a new instance of the <see cref="TextGeometryBuilder"/> class.
+			/// </summary>
+			/// <param name="cache">The glyph cache that glyphs are looked up in and rasterized into.</param>
+			TextGeometryBuilder( GlyphCache^ cache );
+
+			/// <summary>
+			/// Releases the native text renderer.
+			/// </summary>
+			~TextGeometryBuilder();
+
+			/// <summary>
+			/// Releases the native text renderer.
+			/// </summary>
+			!TextGeometryBuilder();
+
+			/// <summary>
+			/// Gets the glyph cache used by the builder.
+			/// </summary>
+			property GlyphCache^ Cache
+			{
+				GlyphCache^ get();
+			}
+
+			/// <summary>
+			/// Gets or sets the transform from layout coordinates to device independent pixels. The default is the identity.
+			/// </summary>
+			property Matrix3x2 Transform
+			{
+				Matrix3x2 get();
+				void set( Matrix3x2 value );
+			}
+
+			/// <summary>
+			/// Gets or sets the number of pixels per device independent pixel. The default is 1.
+			/// </summary>
+			property float PixelsPerDip
+			{
+				float get();
+				void set( float value );
+			}
+
+			/// <summary>
+			/// Gets or sets the color of text that has no <see cref="TextColorEffect"/>. The default is opaque white.
+			/// </summary>
+			property Color4 DefaultColor
+			{
+				Color4 get();
+				void set( Color4 value );
+			}
+
+			/// <summary>
+			/// Gets or sets the rendering mode glyphs are rasterized with. The default is <see cref="DirectWrite::RenderingMode::ClearTypeNatural"/>.
+			/// </summary>
+			property DirectWrite::RenderingMode RenderingMode
+			{
+				DirectWrite::RenderingMode get();
+				void set( DirectWrite::RenderingMode value );
+			}
+
+			/// <summary>
+			/// Gets the number of glyphs and lines left out of the last build, because the destination was full or the glyph cache had no room.
+			/// </summary>
+			property int DroppedCount
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Writes the quads of a layout to a stream, starting at its current position, and advances the position past them.
+			/// </summary>
+			/// <param name="layout">The layout to convert.</param>
+			/// <param name="originX">The horizontal position of the layout, in layout coordinates.</param>
+			/// <param name="originY">The vertical position of the layout, in layout coordinates.</param>
+			/// <param name="destination">The stream that receives the quads.</param>
+			/// <returns>The number of quads written.</returns>
+			int Build( DirectWrite::TextLayout^ layout, float originX, float originY, DataStream^ destination );
+
+			/// <summary>
+			/// Writes the quads of a layout to a dynamic buffer.
+			/// </summary>
+			/// <param name="layout">The layout to convert.</param>
+			/// <param name="originX">The horizontal position of the layout, in layout coordinates.</param>
+			/// <param name="originY">The vertical position of the layout, in layout coordinates.</param>
+			/// <param name="context">The context used to map the buffer.</param>
+			/// <param name="buffer">A dynamic buffer with CPU write access.</param>
+			/// <param name="quadOffset">The index of the first quad to write. The buffer is mapped with <see cref="MapMode::WriteDiscard"/>
+			/// when this is zero, and with <see cref="MapMode::WriteNoOverwrite"/> otherwise, so several layouts can be appended to one buffer.</param>
+			/// <returns>The number of quads written.</returns>
+			int Build( DirectWrite::TextLayout^ layout, float originX, float originY, DeviceContext^ context, Buffer^ buffer, int quadOffset );
+		};
+	}
+}
@@ -0,0 +1,293 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma managed(push, off)
+
+#include "TextGeometryRenderer.h"
+
+// {6F1C3A52-8D0E-4B7A-9C2E-513D7A40E819}
+const IID IID_ColorDrawingEffect = { 0x6f1c3a52, 0x8d0e, 0x4b7a, { 0x9c, 0x2e, 0x51, 0x3d, 0x7a, 0x40, 0xe8, 0x19 } };
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	static_assert( sizeof( TextQuadData ) == 40, "TextQuadData must match the managed TextQuad." );
+
+	HRESULT ColorDrawingEffect::QueryInterface( REFIID riid, void** ppvObject )
+	{
+		if( ppvObject == NULL )
+			return E_POINTER;
+
+		if( riid == IID_ColorDrawingEffect || riid == __uuidof( IUnknown ) )
+		{
+			AddRef();
+			*ppvObject = this;
+			return S_OK;
+		}
+
+		*ppvObject = NULL;
+		return E_NOINTERFACE;
+	}
+
+	ULONG ColorDrawingEffect::AddRef()
+	{
+		return InterlockedIncrement( &m_RefCount );
+	}
+
+	ULONG ColorDrawingEffect::Release()
+	{
+		ULONG count = InterlockedDecrement( &m_RefCount );
+		if( count == 0 )
+			delete this;
+
+		return count;
+	}
+
+	TextGeometryRenderer::TextGeometryRenderer( GlyphAtlas* atlas )
+	: m_RefCount( 1 ), m_Atlas( atlas ), m_Output( NULL ), m_Capacity( 0 ), m_Count( 0 ), m_Dropped( 0 ), m_Error( S_OK ),
+	  m_PixelsPerDip( 1.0f ), m_Scale( 1.0f ), m_DefaultColor( 0xffffffff ), m_Mode( DWRITE_RENDERING_MODE_CLEARTYPE_NATURAL ),
+	  m_LastEffect( NULL ), m_LastColor( 0 )
+	{
+		DWRITE_MATRIX identity = { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+		m_Transform = identity;
+	}
+
+	HRESULT TextGeometryRenderer::QueryInterface( REFIID riid, void** ppvObject )
+	{
+		if( ppvObject == NULL )
+			return E_POINTER;
+
+		if( riid == __uuidof( IDWriteTextRenderer ) || riid == __uuidof( IDWritePixelSnapping ) || riid == __uuidof( IUnknown ) )
+		{
+			AddRef();
+			*ppvObject = static_cast<IDWriteTextRenderer*>( this );
+			return S_OK;
+		}
+
+		*ppvObject = NULL;
+		return E_NOINTERFACE;
+	}
+
+	ULONG TextGeometryRenderer::AddRef()
+	{
+		return InterlockedIncrement( &m_RefCount );
+	}
+
+	ULONG TextGeometryRenderer::Release()
+	{
+		ULONG count = InterlockedDecrement( &m_RefCount );
+		if( count == 0 )
+			delete this;
+
+		return count;
+	}
+
+	void TextGeometryRenderer::SetTransform( const DWRITE_MATRIX& transform, float pixelsPerDip )
+	{
+		m_Transform = transform;
+		m_PixelsPerDip = pixelsPerDip;
+
+		// glyphs are rasterized upright, so only the overall scale of the transform reaches their size
+		m_Scale = sqrtf( fabsf( transform.m11 * transform.m22 - transform.m12 * transform.m21 ) );
+	}
+
+	void TextGeometryRenderer::Begin( void* output, UINT32 capacity )
+	{
+		m_Output = static_cast<TextQuadData*>( output );
+		m_Capacity = capacity;
+		m_Count = 0;
+		m_Dropped = 0;
+		m_Error = S_OK;
+
+		// the color of an effect may have changed since the last build
+		m_LastEffect = NULL;
+	}
+
+	HRESULT TextGeometryRenderer::IsPixelSnappingDisabled( void*, BOOL* isDisabled )
+	{
+		*isDisabled = FALSE;
+		return S_OK;
+	}
+
+	HRESULT TextGeometryRenderer::GetCurrentTransform( void*, DWRITE_MATRIX* transform )
+	{
+		*transform = m_Transform;
+		return S_OK;
+	}
+
+	HRESULT TextGeometryRenderer::GetPixelsPerDip( void*, FLOAT* pixelsPerDip )
+	{
+		*pixelsPerDip = m_PixelsPerDip;
+		return S_OK;
+	}
+
+	UINT32 TextGeometryRenderer::ColorOf( IUnknown* effect )
+	{
+		if( effect == NULL )
+			return m_DefaultColor;
+		if( effect == m_LastEffect )
+			return m_LastColor;
+
+		ColorDrawingEffect* color = NULL;
+		if( SUCCEEDED( effect->QueryInterface( IID_ColorDrawingEffect, reinterpret_cast<void**>( &color ) ) ) )
+		{
+			m_LastColor = color->GetColor();
+			color->Release();
+		}
+		else
+		{
+			m_LastColor = m_DefaultColor;
+		}
+
+		m_LastEffect = effect;
+		return m_LastColor;
+	}
+
+	void TextGeometryRenderer::ToDevice( float x, float y, float& deviceX, float& deviceY ) const
+	{
+		deviceX = ( x * m_Transform.m11 + y * m_Transform.m21 + m_Transform.dx ) * m_PixelsPerDip;
+		deviceY = ( x * m_Transform.m12 + y * m_Transform.m22 + m_Transform.dy ) * m_PixelsPerDip;
+	}
+
+	HRESULT TextGeometryRenderer::DrawGlyphRun( void*, FLOAT baselineOriginX, FLOAT baselineOriginY, DWRITE_MEASURING_MODE,
+		DWRITE_GLYPH_RUN const* glyphRun, DWRITE_GLYPH_RUN_DESCRIPTION const*, IUnknown* clientDrawingEffect )
+	{
+		UINT32 color = ColorOf( clientDrawingEffect );
+		float emSize = glyphRun->fontEmSize * m_PixelsPerDip * m_Scale;
+		bool rightToLeft = ( glyphRun->bidiLevel & 1 ) != 0;
+		int positions = m_Atlas->GetSubpixelPositions();
+
+		float pen = 0.0f;
+		for( UINT32 i = 0; i < glyphRun->glyphCount; i++ )
+		{
+			float advance = glyphRun->glyphAdvances != NULL ? glyphRun->glyphAdvances[i] : 0.0f;
+			float advanceOffset = 0.0f;
+			float ascenderOffset = 0.0f;
+			if( glyphRun->glyphOffsets != NULL )
+			{
+				advanceOffset = glyphRun->glyphOffsets[i].advanceOffset;
+				ascenderOffset = glyphRun->glyphOffsets[i].ascenderOffset;
+			}
+
+			// right-to-left runs advance leftwards from the origin, and each glyph sits to the left of its pen position
+			float x = rightToLeft ? baselineOriginX - pen - advance - advanceOffset : baselineOriginX + pen + advanceOffset;
+			float y = baselineOriginY - ascenderOffset;
+			pen += advance;
+
+			float deviceX;
+			float deviceY;
+			ToDevice( x, y, deviceX, deviceY );
+
+			// snap to the same subpixel grid the atlas rasterizes on, carrying a rounded-up position into the next pixel
+			float quantized = floorf( deviceX * positions + 0.5f );
+			float pixelX = floorf( quantized / positions );
+			float subpixel = quantized - pixelX * positions;
+			float pixelY = floorf( deviceY + 0.5f );
+
+			GlyphSlot slot;
+			HRESULT hr = m_Atlas->Find( glyphRun->fontFace, emSize, m_Mode, subpixel / positions, glyphRun->glyphIndices[i], slot );
+			if( hr != S_OK )
+			{
+				if( FAILED( hr ) )
+					m_Error = hr;
+
+				m_Dropped++;
+				continue;
+			}
+
+			if( slot.Page < 0 )
+				continue;
+
+			if( m_Count == m_Capacity )
+			{
+				m_Dropped++;
+				continue;
+			}
+
+			TextQuadData& quad = m_Output[m_Count++];
+			quad.X = pixelX + slot.Left;
+			quad.Y = pixelY + slot.Top;
+			quad.Width = static_cast<float>( slot.Width );
+			quad.Height = static_cast<float>( slot.Height );
+			quad.U0 = slot.U0;
+			quad.V0 = slot.V0;
+			quad.U1 = slot.U1;
+			quad.V1 = slot.V1;
+			quad.ArraySlice = slot.Page;
+			quad.Color = color;
+		}
+
+		return S_OK;
+	}
+
+	void TextGeometryRenderer::AddRectangle( float x, float y, float width, float height, IUnknown* effect )
+	{
+		if( m_Count == m_Capacity )
+		{
+			m_Dropped++;
+			return;
+		}
+
+		float left;
+		float top;
+		float right;
+		float bottom;
+		ToDevice( x, y, left, top );
+		ToDevice( x + width, y + height, right, bottom );
+
+		TextQuadData& quad = m_Output[m_Count++];
+		quad.X = std::min( left, right );
+		quad.Y = std::min( top, bottom );
+		quad.Width = fabsf( right - left );
+		quad.Height = fabsf( bottom - top );
+		quad.U0 = 0.0f;
+		quad.V0 = 0.0f;
+		quad.U1 = 0.0f;
+		quad.V1 = 0.0f;
+		quad.ArraySlice = -1;
+		quad.Color = ColorOf( effect );
+	}
+
+	HRESULT TextGeometryRenderer::DrawUnderline( void*, FLOAT baselineOriginX, FLOAT baselineOriginY, DWRITE_UNDERLINE const* underline, IUnknown* clientDrawingEffect )
+	{
+		float x = underline->readingDirection == DWRITE_READING_DIRECTION_RIGHT_TO_LEFT ? baselineOriginX - underline->width : baselineOriginX;
+		AddRectangle( x, baselineOriginY + underline->offset, underline->width, underline->thickness, clientDrawingEffect );
+		return S_OK;
+	}
+
+	HRESULT TextGeometryRenderer::DrawStrikethrough( void*, FLOAT baselineOriginX, FLOAT baselineOriginY, DWRITE_STRIKETHROUGH const* strikethrough, IUnknown* clientDrawingEffect )
+	{
+		float x = strikethrough->readingDirection == DWRITE_READING_DIRECTION_RIGHT_TO_LEFT ? baselineOriginX - strikethrough->width : baselineOriginX;
+		AddRectangle( x, baselineOriginY + strikethrough->offset, strikethrough->width, strikethrough->thickness, clientDrawingEffect );
+		return S_OK;
+	}
+
+	HRESULT TextGeometryRenderer::DrawInlineObject( void* clientDrawingContext, FLOAT originX, FLOAT originY, IDWriteInlineObject* inlineObject,
+		BOOL isSideways, BOOL isRightToLeft, IUnknown* clientDrawingEffect )
+	{
+		return inlineObject->Draw( clientDrawingContext, this, originX, originY, isSideways, isRightToLeft, clientDrawingEffect );
+	}
+}
+}
+
+#pragma managed(pop)
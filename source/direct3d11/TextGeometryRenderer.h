@@ -0,0 +1,132 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "GlyphAtlas.h"
+
+extern const IID IID_ColorDrawingEffect;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	// One glyph instance; matches the managed TextQuad. ArraySlice is -1 for solid rectangles such as underlines.
+	struct TextQuadData
+	{
+		float X;
+		float Y;
+		float Width;
+		float Height;
+		float U0;
+		float V0;
+		float U1;
+		float V1;
+		INT32 ArraySlice;
+		UINT32 Color;
+	};
+
+	// A drawing effect carrying a packed R8G8B8A8 color, recognized by TextGeometryRenderer.
+	class ColorDrawingEffect : public IUnknown
+	{
+	public:
+		explicit ColorDrawingEffect( UINT32 color ) : m_RefCount( 1 ), m_Color( color ) {}
+
+		STDMETHOD(QueryInterface)( REFIID riid, void** ppvObject );
+		STDMETHOD_(ULONG, AddRef)();
+		STDMETHOD_(ULONG, Release)();
+
+		UINT32 GetColor() const { return m_Color; }
+		void SetColor( UINT32 color ) { m_Color = color; }
+
+	private:
+		virtual ~ColorDrawingEffect() {}
+
+		volatile LONG m_RefCount;
+		UINT32 m_Color;
+	};
+
+	// Receives the runs of a text layout and writes one TextQuadData per inked glyph, looking each glyph up in
+	// a GlyphAtlas. Positions are transformed into pixels and snapped the same way the atlas rasterized them,
+	// so a quad drawn with point sampling reproduces the rasterized glyph exactly.
+	class TextGeometryRenderer : public IDWriteTextRenderer
+	{
+	public:
+		explicit TextGeometryRenderer( GlyphAtlas* atlas );
+
+		STDMETHOD(QueryInterface)( REFIID riid, void** ppvObject );
+		STDMETHOD_(ULONG, AddRef)();
+		STDMETHOD_(ULONG, Release)();
+
+		STDMETHOD(IsPixelSnappingDisabled)( void* clientDrawingContext, BOOL* isDisabled );
+		STDMETHOD(GetCurrentTransform)( void* clientDrawingContext, DWRITE_MATRIX* transform );
+		STDMETHOD(GetPixelsPerDip)( void* clientDrawingContext, FLOAT* pixelsPerDip );
+
+		STDMETHOD(DrawGlyphRun)( void* clientDrawingContext, FLOAT baselineOriginX, FLOAT baselineOriginY, DWRITE_MEASURING_MODE measuringMode,
+			DWRITE_GLYPH_RUN const* glyphRun, DWRITE_GLYPH_RUN_DESCRIPTION const* glyphRunDescription, IUnknown* clientDrawingEffect );
+		STDMETHOD(DrawUnderline)( void* clientDrawingContext, FLOAT baselineOriginX, FLOAT baselineOriginY,
+			DWRITE_UNDERLINE const* underline, IUnknown* clientDrawingEffect );
+		STDMETHOD(DrawStrikethrough)( void* clientDrawingContext, FLOAT baselineOriginX, FLOAT baselineOriginY,
+			DWRITE_STRIKETHROUGH const* strikethrough, IUnknown* clientDrawingEffect );
+		STDMETHOD(DrawInlineObject)( void* clientDrawingContext, FLOAT originX, FLOAT originY, IDWriteInlineObject* inlineObject,
+			BOOL isSideways, BOOL isRightToLeft, IUnknown* clientDrawingEffect );
+
+		void SetTransform( const DWRITE_MATRIX& transform, float pixelsPerDip );
+		void SetDefaultColor( UINT32 color ) { m_DefaultColor = color; }
+		void SetRenderingMode( DWRITE_RENDERING_MODE mode ) { m_Mode = mode; }
+
+		// Starts writing quads to output, which has room for capacity quads, and clears the counters.
+		void Begin( void* output, UINT32 capacity );
+
+		UINT32 GetCount() const { return m_Count; }
+		UINT32 GetDropped() const { return m_Dropped; }
+		HRESULT GetError() const { return m_Error; }
+
+	private:
+		virtual ~TextGeometryRenderer() {}
+
+		TextGeometryRenderer( const TextGeometryRenderer& );
+		TextGeometryRenderer& operator = ( const TextGeometryRenderer& );
+
+		UINT32 ColorOf( IUnknown* effect );
+		void ToDevice( float x, float y, float& deviceX, float& deviceY ) const;
+		void AddRectangle( float x, float y, float width, float height, IUnknown* effect );
+
+		volatile LONG m_RefCount;
+		GlyphAtlas* m_Atlas;
+
+		TextQuadData* m_Output;
+		UINT32 m_Capacity;
+		UINT32 m_Count;
+		UINT32 m_Dropped;
+		HRESULT m_Error;
+
+		DWRITE_MATRIX m_Transform;
+		float m_PixelsPerDip;
+		float m_Scale;
+		UINT32 m_DefaultColor;
+		DWRITE_RENDERING_MODE m_Mode;
+
+		IUnknown* m_LastEffect;
+		UINT32 m_LastColor;
+	};
+}
+}
@@ -0,0 +1,97 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+	namespace Direct3D11
+	{
+		/// <summary>
+		/// One glyph instance written by a <see cref="TextGeometryBuilder"/>, laid out for use as per-instance vertex data.
+		/// </summary>
+		/// <remarks>
+		/// The layout is two float4 elements (position and size in pixels, then texture coordinates), followed by a signed
+		/// integer array slice and an R8G8B8A8 color. An array slice of -1 marks a solid rectangle, such as an underline,
+		/// which should not sample the glyph texture.
+		/// </remarks>
+		/// <unmanaged>None</unmanaged>
+		[System::Runtime::InteropServices::StructLayout(System::Runtime::InteropServices::LayoutKind::Sequential)]
+		public value class TextQuad
+		{
+		public:
+			/// <summary>
+			/// The size of a quad, in bytes.
+			/// </summary>
+			literal int SizeInBytes = 40;
+
+			/// <summary>
+			/// The left edge of the quad, in pixels.
+			/// </summary>
+			float X;
+
+			/// <summary>
+			/// The top edge of the quad, in pixels.
+			/// </summary>
+			float Y;
+
+			/// <summary>
+			/// The width of the quad, in pixels.
+			/// </summary>
+			float Width;
+
+			/// <summary>
+			/// The height of the quad, in pixels.
+			/// </summary>
+			float Height;
+
+			/// <summary>
+			/// The left texture coordinate.
+			/// </summary>
+			float U0;
+
+			/// <summary>
+			/// The top texture coordinate.
+			/// </summary>
+			float V0;
+
+			/// <summary>
+			/// The right texture coordinate.
+			/// </summary>
+			float U1;
+
+			/// <summary>
+			/// The bottom texture coordinate.
+			/// </summary>
+			float V1;
+
+			/// <summary>
+			/// The page of the glyph cache that holds the glyph, or -1 for a solid rectangle.
+			/// </summary>
+			int ArraySlice;
+
+			/// <summary>
+			/// The color of the quad, packed as R8G8B8A8 with red in the lowest byte.
+			/// </summary>
+			int Color;
+		};
+	}
+}
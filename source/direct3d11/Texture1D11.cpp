@@ -31,6 +31,7 @@
 #include "DeviceContext11.h"
 #include "Texture1D11.h"
 #include "Texture1DDescription11.h"
+#include "TextureData.h"
 
 using namespace System;
 using namespace System::IO;
@@ -74,6 +75,17 @@ namespace Direct3D11
 		}
 	}
 	
+	Texture1D::Texture1D( SlimDX::Direct3D11::Device^ device, Texture1DDescription description, TextureData^ data )
+	{
+		if( data == nullptr )
+			throw gcnew ArgumentNullException( "data" );
+		if( !data->Matches( ResourceDimension::Texture1D, description.Format, description.Width, 1, 1, description.MipLevels, description.ArraySize ) )
+			throw gcnew ArgumentException( "The texture data was laid out for a different description.", "data" );
+
+		Construct( Build( device, description, data->Subresources ) );
+		GC::KeepAlive( data );
+	}
+	
 	ID3D11Texture1D* Texture1D::Build( SlimDX::Direct3D11::Device^ device, Texture1DDescription description, D3D11_SUBRESOURCE_DATA* data )
 	{
 		ID3D11Texture1D* texture = 0;
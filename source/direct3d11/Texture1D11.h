@@ -32,6 +32,7 @@ namespace SlimDX
 	{
 		ref class Device;
 		ref class DeviceContext;
+		ref class TextureData;
 		value class Texture1DDescription;
 		
 		/// <summary>
@@ -76,6 +77,14 @@ namespace SlimDX
 			/// <param name="description">The description of the texture.</param>
 			/// <param name="data">An array of initial texture data for each subresource.</param>
 			Texture1D( SlimDX::Direct3D11::Device^ device, Texture1DDescription description, array<DataStream^>^ data );
+			
+			/// <summary>
+			/// Initializes a new instance of the <see cref="Texture1D"/> class.
+			/// </summary>
+			/// <param name="device">The device with which to associate the texture.</param>
+			/// <param name="description">The description of the texture.</param>
+			/// <param name="data">The initial data for every subresource, laid out for the same description.</param>
+			Texture1D( SlimDX::Direct3D11::Device^ device, Texture1DDescription description, TextureData^ data );
 		};
 	}
 };
\ No newline at end of file
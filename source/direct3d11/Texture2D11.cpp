@@ -33,6 +33,7 @@
 #include "DeviceContext11.h"
 #include "Texture2D11.h"
 #include "Texture2DDescription11.h"
+#include "TextureData.h"
 
 using namespace System;
 using namespace System::IO;
@@ -80,6 +81,17 @@ namespace Direct3D11
 		}
 	}
 	
+	Texture2D::Texture2D( SlimDX::Direct3D11::Device^ device, Texture2DDescription description, TextureData^ data )
+	{
+		if( data == nullptr )
+			throw gcnew ArgumentNullException( "data" );
+		if( !data->Matches( ResourceDimension::Texture2D, description.Format, description.Width, description.Height, 1, description.MipLevels, description.ArraySize ) )
+			throw gcnew ArgumentException( "The texture data was laid out for a different description.", "data" );
+
+		Construct( Build( device, description, data->Subresources ) );
+		GC::KeepAlive( data );
+	}
+	
 	ID3D11Texture2D* Texture2D::Build( SlimDX::Direct3D11::Device^ device, Texture2DDescription description, D3D11_SUBRESOURCE_DATA* data )
 	{
 		ID3D11Texture2D* texture = 0;
@@ -33,6 +33,7 @@
 #include "DeviceContext11.h"
 #include "Texture3D11.h"
 #include "Texture3DDescription11.h"
+#include "TextureData.h"
 
 using namespace System;
 using namespace System::IO;
@@ -82,6 +83,17 @@ namespace Direct3D11
 		}
 	}
 	
+	Texture3D::Texture3D( SlimDX::Direct3D11::Device^ device, Texture3DDescription description, TextureData^ data )
+	{
+		if( data == nullptr )
+			throw gcnew ArgumentNullException( "data" );
+		if( !data->Matches( ResourceDimension::Texture3D, description.Format, description.Width, description.Height, description.Depth, description.MipLevels, 1 ) )
+			throw gcnew ArgumentException( "The texture data was laid out for a different description.", "data" );
+
+		Construct( Build( device, description, data->Subresources ) );
+		GC::KeepAlive( data );
+	}
+	
 	ID3D11Texture3D* Texture3D::Build( SlimDX::Direct3D11::Device^ device, Texture3DDescription description, D3D11_SUBRESOURCE_DATA* data )
 	{
 		ID3D11Texture3D* texture = 0;
@@ -32,6 +32,7 @@ namespace SlimDX
 	{
 		ref class Device;
 		ref class DeviceContext;
+		ref class TextureData;
 		value class Texture3DDescription;
 
 		/// <summary>
@@ -76,6 +77,14 @@ namespace SlimDX
 			/// <param name="description">The description of the texture.</param>
 			/// <param name="data">An array of initial texture data for each subresource.</param>
 			Texture3D( SlimDX::Direct3D11::Device^ device, Texture3DDescription description, array<DataBox^>^ data );
+			
+			/// <summary>
+			/// Initializes a new instance of the <see cref="Texture3D"/> class.
+			/// </summary>
+			/// <param name="device">The device with which to associate the texture.</param>
+			/// <param name="description">The description of the texture.</param>
+			/// <param name="data">The initial data for every subresource, laid out for the same description.</param>
+			Texture3D( SlimDX::Direct3D11::Device^ device, Texture3DDescription description, TextureData^ data );
 		};
 	}
 };
\ No newline at end of file
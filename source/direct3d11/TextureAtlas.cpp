@@ -0,0 +1,259 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "../DataRectangle.h"
+#include "../DataStream.h"
+#include "../dxgi/FormatTable.h"
+
+#include "Device11.h"
+#include "DeviceContext11.h"
+#include "ShaderResourceView11.h"
+#include "Texture2D11.h"
+#include "Texture2DDescription11.h"
+#include "TextureAtlas.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Drawing;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	TextureAtlas::TextureAtlas( Device^ device, DXGI::Format format, int pageWidth, int pageHeight, int pageCount, int padding )
+	{
+		if( device == nullptr )
+			throw gcnew ArgumentNullException( "device" );
+
+		const DXGI::FormatDescriptor* descriptor = DXGI::GetFormatDescriptor( static_cast<DXGI_FORMAT>( format ) );
+		if( descriptor == NULL || descriptor->BlockSize != 0 || descriptor->BitsPerElement < 8 || descriptor->BitsPerElement % 8 != 0 )
+			throw gcnew ArgumentException( "The atlas format must have a whole number of bytes per pixel.", "format" );
+		if( pageWidth < 1 )
+			throw gcnew ArgumentOutOfRangeException( "pageWidth" );
+		if( pageHeight < 1 )
+			throw gcnew ArgumentOutOfRangeException( "pageHeight" );
+		if( pageCount < 1 )
+			throw gcnew ArgumentOutOfRangeException( "pageCount" );
+		if( padding < 0 || padding * 2 >= std::min( pageWidth, pageHeight ) )
+			throw gcnew ArgumentOutOfRangeException( "padding" );
+
+		Texture2DDescription description;
+		description.Width = pageWidth;
+		description.Height = pageHeight;
+		description.MipLevels = 1;
+		description.ArraySize = pageCount;
+		description.Format = format;
+		description.SampleDescription = DXGI::SampleDescription( 1, 0 );
+		description.Usage = ResourceUsage::Default;
+		description.BindFlags = BindFlags::ShaderResource;
+		description.CpuAccessFlags = CpuAccessFlags::None;
+		description.OptionFlags = ResourceOptionFlags::None;
+
+		m_Texture = gcnew Texture2D( device, description );
+		m_View = gcnew Direct3D11::ShaderResourceView( device, m_Texture );
+
+		m_Pages = new std::vector<AtlasPacker>( pageCount, AtlasPacker( pageWidth, pageHeight ) );
+		m_Entries = gcnew Dictionary<int, AtlasEntry>();
+		m_Format = format;
+		m_PixelSize = descriptor->BitsPerElement / 8;
+		m_PageWidth = pageWidth;
+		m_PageHeight = pageHeight;
+		m_Padding = padding;
+	}
+
+	TextureAtlas::~TextureAtlas()
+	{
+		delete m_View;
+		delete m_Texture;
+		m_View = nullptr;
+		m_Texture = nullptr;
+
+		Destruct();
+		GC::SuppressFinalize( this );
+	}
+
+	TextureAtlas::!TextureAtlas()
+	{
+		Destruct();
+	}
+
+	void TextureAtlas::Destruct()
+	{
+		delete m_Pages;
+		m_Pages = 0;
+	}
+
+	Texture2D^ TextureAtlas::Texture::get()
+	{
+		return m_Texture;
+	}
+
+	Direct3D11::ShaderResourceView^ TextureAtlas::ShaderResourceView::get()
+	{
+		return m_View;
+	}
+
+	DXGI::Format TextureAtlas::Format::get()
+	{
+		return m_Format;
+	}
+
+	int TextureAtlas::PageWidth::get()
+	{
+		return m_PageWidth;
+	}
+
+	int TextureAtlas::PageHeight::get()
+	{
+		return m_PageHeight;
+	}
+
+	int TextureAtlas::PageCount::get()
+	{
+		return m_Pages == 0 ? 0 : static_cast<int>( m_Pages->size() );
+	}
+
+	int TextureAtlas::Count::get()
+	{
+		return m_Entries->Count;
+	}
+
+	bool TextureAtlas::TryAdd( DeviceContext^ context, int width, int height, DataRectangle^ data, [Out] AtlasEntry% entry )
+	{
+		if( m_Pages == 0 )
+			throw gcnew ObjectDisposedException( "TextureAtlas" );
+		if( context == nullptr && data != nullptr )
+			throw gcnew ArgumentNullException( "context" );
+		if( width < 1 )
+			throw gcnew ArgumentOutOfRangeException( "width" );
+		if( height < 1 )
+			throw gcnew ArgumentOutOfRangeException( "height" );
+
+		// checked before anything is placed, so that bad data cannot leave a slot behind
+		if( data != nullptr )
+			Validate( width, height, data );
+
+		entry = AtlasEntry();
+		int paddedWidth = width + m_Padding * 2;
+		int paddedHeight = height + m_Padding * 2;
+		if( paddedWidth > m_PageWidth || paddedHeight > m_PageHeight )
+			return false;
+
+		for( size_t page = 0; page < m_Pages->size(); page++ )
+		{
+			AtlasRect rect;
+			if( !( *m_Pages )[page].Insert( paddedWidth, paddedHeight, rect ) )
+				continue;
+
+			Rectangle bounds( rect.X + m_Padding, rect.Y + m_Padding, width, height );
+			RectangleF coordinates( static_cast<float>( bounds.X ) / m_PageWidth, static_cast<float>( bounds.Y ) / m_PageHeight,
+				static_cast<float>( width ) / m_PageWidth, static_cast<float>( height ) / m_PageHeight );
+
+			entry = AtlasEntry( ++m_NextId, static_cast<int>( page ), bounds, coordinates );
+			m_Entries->Add( entry.Id, entry );
+
+			if( data != nullptr )
+				Upload( context, entry, data );
+
+			return true;
+		}
+
+		return false;
+	}
+
+	AtlasEntry TextureAtlas::Add( DeviceContext^ context, int width, int height, DataRectangle^ data )
+	{
+		AtlasEntry entry;
+		if( !TryAdd( context, width, height, data, entry ) )
+			throw gcnew InvalidOperationException( "The atlas has no room for an image of the given size." );
+
+		return entry;
+	}
+
+	void TextureAtlas::Update( DeviceContext^ context, AtlasEntry entry, DataRectangle^ data )
+	{
+		if( m_Pages == 0 )
+			throw gcnew ObjectDisposedException( "TextureAtlas" );
+		if( context == nullptr )
+			throw gcnew ArgumentNullException( "context" );
+		if( data == nullptr )
+			throw gcnew ArgumentNullException( "data" );
+
+		AtlasEntry stored;
+		if( !m_Entries->TryGetValue( entry.Id, stored ) || stored != entry )
+			throw gcnew ArgumentException( "The entry is not part of the atlas.", "entry" );
+
+		Validate( entry.Bounds.Width, entry.Bounds.Height, data );
+		Upload( context, entry, data );
+	}
+
+	void TextureAtlas::Validate( int width, int height, DataRectangle^ data )
+	{
+		if( data->Data == nullptr )
+			throw gcnew ArgumentException( "The data rectangle has no data stream.", "data" );
+
+		Int64 rowSize = static_cast<Int64>( width ) * m_PixelSize;
+		if( data->Pitch < rowSize )
+			throw gcnew ArgumentException( "The pitch is smaller than one row of the image.", "data" );
+		if( ( height - 1 ) * static_cast<Int64>( data->Pitch ) + rowSize > data->Data->RemainingLength )
+			throw gcnew ArgumentException( "The data does not contain enough pixels for the image.", "data" );
+	}
+
+	// The data must have passed Validate for the bounds of the entry.
+	void TextureAtlas::Upload( DeviceContext^ context, AtlasEntry entry, DataRectangle^ data )
+	{
+		Rectangle bounds = entry.Bounds;
+		D3D11_BOX box = { bounds.Left, bounds.Top, 0, bounds.Right, bounds.Bottom, 1 };
+		context->InternalPointer->UpdateSubresource( m_Texture->InternalPointer, D3D11CalcSubresource( 0, entry.ArraySlice, 1 ),
+			&box, data->Data->PositionPointer, data->Pitch, 0 );
+	}
+
+	bool TextureAtlas::Remove( AtlasEntry entry )
+	{
+		if( m_Pages == 0 )
+			throw gcnew ObjectDisposedException( "TextureAtlas" );
+
+		AtlasEntry stored;
+		if( !m_Entries->TryGetValue( entry.Id, stored ) || stored != entry )
+			return false;
+
+		m_Entries->Remove( entry.Id );
+
+		Rectangle bounds = entry.Bounds;
+		AtlasRect rect = { bounds.X - m_Padding, bounds.Y - m_Padding, bounds.Width + m_Padding * 2, bounds.Height + m_Padding * 2 };
+		( *m_Pages )[entry.ArraySlice].Release( rect );
+		return true;
+	}
+
+	void TextureAtlas::Clear()
+	{
+		if( m_Pages == 0 )
+			throw gcnew ObjectDisposedException( "TextureAtlas" );
+
+		for( size_t page = 0; page < m_Pages->size(); page++ )
+			( *m_Pages )[page].Reset();
+
+		m_Entries->Clear();
+	}
+}
+}
@@ -0,0 +1,191 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "../dxgi/Enums.h"
+
+#include "AtlasEntry.h"
+#include "AtlasPacker.h"
+
+using System::Runtime::InteropServices::OutAttribute;
+
+namespace SlimDX
+{
+	ref class DataRectangle;
+
+	namespace Direct3D11
+	{
+		ref class Device;
+		ref class DeviceContext;
+		ref class ShaderResourceView;
+		ref class Texture2D;
+
+		/// <summary>
+		/// Packs many small images into the array slices (pages) of a single texture array, so that they can share
+		/// one texture object and one shader resource view.
+		/// </summary>
+		/// <remarks>
+		/// Images are placed with the MaxRects algorithm and uploaded with UpdateSubresource. Entries can be added and removed
+		/// in any order; released space is reused by later insertions. Padding texels around each image are reserved but not written.
+		/// The atlas is not thread safe.
+		/// </remarks>
+		/// <unmanaged>None</unmanaged>
+		public ref class TextureAtlas sealed
+		{
+		private:
+			std::vector<AtlasPacker>* m_Pages;
+			System::Collections::Generic::Dictionary<int, AtlasEntry>^ m_Entries;
+			Texture2D^ m_Texture;
+			ShaderResourceView^ m_View;
+			DXGI::Format m_Format;
+			int m_PixelSize;
+			int m_PageWidth;
+			int m_PageHeight;
+			int m_Padding;
+			int m_NextId;
+
+			void Validate( int width, int height, DataRectangle^ data );
+			void Upload( DeviceContext^ context, AtlasEntry entry, DataRectangle^ data );
+			void Destruct();
+
+		public:
+			/// <summary>
+			/// Initializes a new instance of the <see cref="TextureAtlas"/> class.
+			/// </summary>
+			/// <param name="device">The device with which to associate the atlas texture.</param>
+			/// <param name="format">The format of the atlas texture and of every image added to it. Block compressed formats are not supported.</param>
+			/// <param name="pageWidth">The width of each page, in pixels.</param>
+			/// <param name="pageHeight">The height of each page, in pixels.</param>
+			/// <param name="pageCount">The number of pages, which is the array size of the atlas texture.</param>
+			/// <param name="padding">The number of texels left free around each image, to keep filtering from bleeding between neighbours.</param>
+			TextureAtlas( Device^ device, DXGI::Format format, int pageWidth, int pageHeight, int pageCount, int padding );
+
+			/// <summary>
+			/// Releases the atlas texture and the packing state.
+			/// </summary>
+			~TextureAtlas();
+
+			/// <summary>
+			/// Releases the packing state.
+			/// </summary>
+			!TextureAtlas();
+
+			/// <summary>
+			/// Gets the texture array holding the pages.
+			/// </summary>
+			property Texture2D^ Texture
+			{
+				Texture2D^ get();
+			}
+
+			/// <summary>
+			/// Gets a shader resource view of all pages of the atlas.
+			/// </summary>
+			property Direct3D11::ShaderResourceView^ ShaderResourceView
+			{
+				Direct3D11::ShaderResourceView^ get();
+			}
+
+			/// <summary>
+			/// Gets the format of the atlas.
+			/// </summary>
+			property DXGI::Format Format
+			{
+				DXGI::Format get();
+			}
+
+			/// <summary>
+			/// Gets the width of each page, in pixels.
+			/// </summary>
+			property int PageWidth
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the height of each page, in pixels.
+			/// </summary>
+			property int PageHeight
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the number of pages in the atlas.
+			/// </summary>
+			property int PageCount
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the number of images currently stored in the atlas.
+			/// </summary>
+			property int Count
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Attempts to reserve space for an image and upload it.
+			/// </summary>
+			/// <param name="context">The context used to upload the image.</param>
+			/// <param name="width">The width of the image, in pixels.</param>
+			/// <param name="height">The height of the image, in pixels.</param>
+			/// <param name="data">The image, in the format of the atlas, starting at the current position of its stream; or <c>null</c> to only reserve the space.</param>
+			/// <param name="entry">When the method completes, contains the entry describing where the image was placed.</param>
+			/// <returns><c>true</c> if the image was placed; <c>false</c> if no page has room for it.</returns>
+			bool TryAdd( DeviceContext^ context, int width, int height, DataRectangle^ data, [Out] AtlasEntry% entry );
+
+			/// <summary>
+			/// Reserves space for an image and uploads it.
+			/// </summary>
+			/// <param name="context">The context used to upload the image.</param>
+			/// <param name="width">The width of the image, in pixels.</param>
+			/// <param name="height">The height of the image, in pixels.</param>
+			/// <param name="data">The image, in the format of the atlas, starting at the current position of its stream; or <c>null</c> to only reserve the space.</param>
+			/// <returns>The entry describing where the image was placed.</returns>
+			/// <exception cref="System::InvalidOperationException">No page has room for the image.</exception>
+			AtlasEntry Add( DeviceContext^ context, int width, int height, DataRectangle^ data );
+
+			/// <summary>
+			/// Replaces the contents of an entry.
+			/// </summary>
+			/// <param name="context">The context used to upload the image.</param>
+			/// <param name="entry">The entry to update.</param>
+			/// <param name="data">The image, with the same size as the entry, starting at the current position of its stream.</param>
+			void Update( DeviceContext^ context, AtlasEntry entry, DataRectangle^ data );
+
+			/// <summary>
+			/// Removes an entry, making its space available to later insertions. The texels are left unchanged.
+			/// </summary>
+			/// <param name="entry">The entry to remove.</param>
+			/// <returns><c>true</c> if the entry was removed; <c>false</c> if it was not in the atlas.</returns>
+			bool Remove( AtlasEntry entry );
+
+			/// <summary>
+			/// Removes every entry from the atlas.
+			/// </summary>
+			void Clear();
+		};
+	}
+}
@@ -0,0 +1,226 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "../DataBox.h"
+#include "../DataStream.h"
+#include "../dxgi/FormatTable.h"
+
+#include "Texture1DDescription11.h"
+#include "Texture2DDescription11.h"
+#include "Texture3DDescription11.h"
+#include "TextureData.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+	TextureData::TextureData( Texture1DDescription description )
+	{
+		Initialize( ResourceDimension::Texture1D, description.Format, description.Width, 1, 1, description.MipLevels, description.ArraySize );
+	}
+
+	TextureData::TextureData( Texture2DDescription description )
+	{
+		Initialize( ResourceDimension::Texture2D, description.Format, description.Width, description.Height, 1, description.MipLevels, description.ArraySize );
+	}
+
+	TextureData::TextureData( Texture3DDescription description )
+	{
+		Initialize( ResourceDimension::Texture3D, description.Format, description.Width, description.Height, description.Depth, description.MipLevels, 1 );
+	}
+
+	TextureData::~TextureData()
+	{
+		Destruct();
+		GC::SuppressFinalize( this );
+	}
+
+	TextureData::!TextureData()
+	{
+		Destruct();
+	}
+
+	void TextureData::Destruct()
+	{
+		// the stream is a view of the block, so it is disposed with it; disposing clears its pointer
+		if( m_Data != nullptr )
+		{
+			delete m_Data;
+			m_Data = nullptr;
+		}
+
+		if( m_Block != 0 )
+		{
+			delete[] m_Block;
+			GC::RemoveMemoryPressure( m_BlockSize );
+		}
+
+		m_Block = 0;
+		m_Subresources = 0;
+	}
+
+	static int GetFullMipCount( int width, int height, int depth )
+	{
+		int count = 1;
+		for( int size = std::max( width, std::max( height, depth ) ); size > 1; size /= 2 )
+			count++;
+
+		return count;
+	}
+
+	void TextureData::Initialize( ResourceDimension dimension, DXGI::Format format, int width, int height, int depth, int mipLevels, int arraySize )
+	{
+		if( width < 1 || height < 1 || depth < 1 )
+			throw gcnew ArgumentException( "The texture dimensions must be at least one.", "description" );
+		if( arraySize < 1 )
+			throw gcnew ArgumentException( "The array size must be at least one.", "description" );
+
+		int fullMipCount = GetFullMipCount( width, height, depth );
+		if( mipLevels < 0 || mipLevels > fullMipCount )
+			throw gcnew ArgumentException( "The mip level count is not valid for the texture size.", "description" );
+		if( mipLevels == 0 )
+			mipLevels = fullMipCount;
+
+		DXGI_FORMAT nativeFormat = static_cast<DXGI_FORMAT>( format );
+		uint32_t rowPitch;
+		uint32_t rowCount;
+		if( !DXGI::GetSurfacePitch( nativeFormat, 1, 1, rowPitch, rowCount ) )
+			throw gcnew ArgumentException( "The format does not have a defined size.", "description" );
+
+		m_Dimension = dimension;
+		m_Format = format;
+		m_Width = width;
+		m_Height = height;
+		m_Depth = depth;
+		m_MipLevels = mipLevels;
+		m_ArraySize = arraySize;
+
+		// the subresource table and the pixel data share one allocation; the data starts on a 16 byte boundary
+		int count = mipLevels * arraySize;
+		Int64 tableSize = ( static_cast<Int64>( count ) * sizeof( D3D11_SUBRESOURCE_DATA ) + 15 ) & ~static_cast<Int64>( 15 );
+		Int64 dataSize = 0;
+		for( int mip = 0; mip < mipLevels; mip++ )
+		{
+			DXGI::GetSurfacePitch( nativeFormat, std::max( 1, width >> mip ), std::max( 1, height >> mip ), rowPitch, rowCount );
+			Int64 size = static_cast<Int64>( rowPitch ) * rowCount * std::max( 1, depth >> mip );
+			dataSize += ( ( size + 15 ) & ~static_cast<Int64>( 15 ) ) * arraySize;
+		}
+
+		try
+		{
+			// Manual Allocation: released in Destruct
+			m_Block = new char[static_cast<size_t>( tableSize + dataSize )];
+		}
+		catch( std::bad_alloc& )
+		{
+			throw gcnew OutOfMemoryException();
+		}
+
+		m_BlockSize = tableSize + dataSize;
+		GC::AddMemoryPressure( m_BlockSize );
+		memset( m_Block, 0, static_cast<size_t>( m_BlockSize ) );
+
+		m_Subresources = reinterpret_cast<D3D11_SUBRESOURCE_DATA*>( m_Block );
+		char* data = m_Block + tableSize;
+		char* position = data;
+		for( int slice = 0; slice < arraySize; slice++ )
+		{
+			for( int mip = 0; mip < mipLevels; mip++ )
+			{
+				DXGI::GetSurfacePitch( nativeFormat, std::max( 1, width >> mip ), std::max( 1, height >> mip ), rowPitch, rowCount );
+				Int64 size = static_cast<Int64>( rowPitch ) * rowCount * std::max( 1, depth >> mip );
+
+				D3D11_SUBRESOURCE_DATA& subresource = m_Subresources[slice * mipLevels + mip];
+				subresource.pSysMem = position;
+				subresource.SysMemPitch = rowPitch;
+				subresource.SysMemSlicePitch = rowPitch * rowCount;
+				position += ( size + 15 ) & ~static_cast<Int64>( 15 );
+			}
+		}
+
+		m_Data = gcnew DataStream( data, dataSize, true, true, false );
+	}
+
+	bool TextureData::Matches( ResourceDimension dimension, DXGI::Format format, int width, int height, int depth, int mipLevels, int arraySize )
+	{
+		if( m_Subresources == 0 )
+			throw gcnew ObjectDisposedException( "TextureData" );
+
+		if( mipLevels == 0 )
+			mipLevels = GetFullMipCount( width, height, depth );
+
+		return dimension == m_Dimension && format == m_Format && width == m_Width && height == m_Height &&
+			depth == m_Depth && mipLevels == m_MipLevels && arraySize == m_ArraySize;
+	}
+
+	int TextureData::GetSubresource( int mipSlice, int arraySlice )
+	{
+		if( m_Subresources == 0 )
+			throw gcnew ObjectDisposedException( "TextureData" );
+		if( mipSlice < 0 || mipSlice >= m_MipLevels )
+			throw gcnew ArgumentOutOfRangeException( "mipSlice" );
+		if( arraySlice < 0 || arraySlice >= m_ArraySize )
+			throw gcnew ArgumentOutOfRangeException( "arraySlice" );
+
+		return arraySlice * m_MipLevels + mipSlice;
+	}
+
+	DataStream^ TextureData::Data::get()
+	{
+		return m_Data;
+	}
+
+	int TextureData::SubresourceCount::get()
+	{
+		return m_MipLevels * m_ArraySize;
+	}
+
+	Int64 TextureData::GetOffset( int mipSlice, int arraySlice )
+	{
+		const D3D11_SUBRESOURCE_DATA& subresource = m_Subresources[GetSubresource( mipSlice, arraySlice )];
+		return static_cast<const char*>( subresource.pSysMem ) - m_Data->RawPointer;
+	}
+
+	int TextureData::GetRowPitch( int mipSlice )
+	{
+		return m_Subresources[GetSubresource( mipSlice, 0 )].SysMemPitch;
+	}
+
+	int TextureData::GetSlicePitch( int mipSlice )
+	{
+		return m_Subresources[GetSubresource( mipSlice, 0 )].SysMemSlicePitch;
+	}
+
+	DataBox^ TextureData::GetSubresourceData( int mipSlice, int arraySlice )
+	{
+		const D3D11_SUBRESOURCE_DATA& subresource = m_Subresources[GetSubresource( mipSlice, arraySlice )];
+		int depth = std::max( 1, m_Depth >> mipSlice );
+		Int64 size = static_cast<Int64>( subresource.SysMemSlicePitch ) * depth;
+
+		DataStream^ view = gcnew DataStream( const_cast<void*>( subresource.pSysMem ), size, true, true, false );
+		return gcnew DataBox( subresource.SysMemPitch, subresource.SysMemSlicePitch, view );
+	}
+}
+}
@@ -0,0 +1,152 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "../dxgi/Enums.h"
+
+#include "Enums11.h"
+
+namespace SlimDX
+{
+	ref class DataBox;
+	ref class DataStream;
+
+	namespace Direct3D11
+	{
+		value class Texture1DDescription;
+		value class Texture2DDescription;
+		value class Texture3DDescription;
+
+		/// <summary>
+		/// Holds the initial data for every subresource of a texture in a single native allocation.
+		/// </summary>
+		/// <remarks>
+		/// Subresources are laid out in Direct3D subresource order (every mip level of the first array slice, then the next slice)
+		/// with tightly packed rows, each subresource starting on a 16 byte boundary. Fill the buffer through <see cref="Data"/> at the offsets
+		/// reported by <see cref="GetOffset"/>, then pass the object to the matching texture constructor; no per-subresource objects are needed.
+		/// </remarks>
+		/// <unmanaged>D3D11_SUBRESOURCE_DATA</unmanaged>
+		public ref class TextureData sealed
+		{
+		private:
+			char* m_Block;
+			System::Int64 m_BlockSize;
+			D3D11_SUBRESOURCE_DATA* m_Subresources;
+			DataStream^ m_Data;
+
+			ResourceDimension m_Dimension;
+			DXGI::Format m_Format;
+			int m_Width;
+			int m_Height;
+			int m_Depth;
+			int m_MipLevels;
+			int m_ArraySize;
+
+			void Initialize( ResourceDimension dimension, DXGI::Format format, int width, int height, int depth, int mipLevels, int arraySize );
+			void Destruct();
+			int GetSubresource( int mipSlice, int arraySlice );
+
+		internal:
+			property D3D11_SUBRESOURCE_DATA* Subresources
+			{
+				D3D11_SUBRESOURCE_DATA* get() { return m_Subresources; }
+			}
+
+			bool Matches( ResourceDimension dimension, DXGI::Format format, int width, int height, int depth, int mipLevels, int arraySize );
+
+		public:
+			/// <summary>
+			/// Initializes a new instance of the <see cref="TextureData"/> class, laid out for a one-dimensional texture.
+			/// </summary>
+			/// <param name="description">The description of the texture that will be created from the data.</param>
+			TextureData( Texture1DDescription description );
+
+			/// <summary>
+			/// Initializes a new instance of the <see cref="TextureData"/> class, laid out for a two-dimensional texture, texture array or cube map.
+			/// </summary>
+			/// <param name="description">The description of the texture that will be created from the data.</param>
+			TextureData( Texture2DDescription description );
+
+			/// <summary>
+			/// Initializes a new instance of the <see cref="TextureData"/> class, laid out for a three-dimensional texture.
+			/// </summary>
+			/// <param name="description">The description of the texture that will be created from the data.</param>
+			TextureData( Texture3DDescription description );
+
+			/// <summary>
+			/// Releases the native buffer.
+			/// </summary>
+			~TextureData();
+
+			/// <summary>
+			/// Releases the native buffer.
+			/// </summary>
+			!TextureData();
+
+			/// <summary>
+			/// Gets a stream over the whole buffer. The stream is disposed with this object, and is <c>null</c> afterwards.
+			/// </summary>
+			property DataStream^ Data
+			{
+				DataStream^ get();
+			}
+
+			/// <summary>
+			/// Gets the number of subresources the buffer holds.
+			/// </summary>
+			property int SubresourceCount
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the offset of a subresource from the start of <see cref="Data"/>.
+			/// </summary>
+			/// <param name="mipSlice">The mip level of the subresource.</param>
+			/// <param name="arraySlice">The array slice of the subresource. For cube maps this is six times the cube index plus the face.</param>
+			/// <returns>The offset of the subresource, in bytes.</returns>
+			System::Int64 GetOffset( int mipSlice, int arraySlice );
+
+			/// <summary>
+			/// Gets the distance between rows of a mip level. For block compressed formats this is the distance between rows of blocks.
+			/// </summary>
+			/// <param name="mipSlice">The mip level.</param>
+			/// <returns>The row pitch, in bytes.</returns>
+			int GetRowPitch( int mipSlice );
+
+			/// <summary>
+			/// Gets the distance between depth slices of a mip level, which is also the size of one two-dimensional image.
+			/// </summary>
+			/// <param name="mipSlice">The mip level.</param>
+			/// <returns>The slice pitch, in bytes.</returns>
+			int GetSlicePitch( int mipSlice );
+
+			/// <summary>
+			/// Gets a box describing a single subresource. The stream it contains is only valid while this object is alive.
+			/// </summary>
+			/// <param name="mipSlice">The mip level of the subresource.</param>
+			/// <param name="arraySlice">The array slice of the subresource.</param>
+			/// <returns>A box whose stream covers exactly the subresource.</returns>
+			DataBox^ GetSubresourceData( int mipSlice, int arraySlice );
+		};
+	}
+}
@@ -21,7 +21,7 @@
 */
 #include "stdafx.h"
 
-#include "../Utilities.h"
+#include "../StreamContents.h"
 
 #include "Direct3D11Exception.h"
 
@@ -82,15 +82,10 @@ namespace Direct3D11
 		if (data == nullptr)
 			throw gcnew ArgumentNullException("data");
 
-		int ddsDataSize = 0;
-		bool cleanUp = true;
-		std::unique_ptr<char> dataPtr;
-		char *ddsData = Utilities::ReadStream(data, ddsDataSize, cleanUp);
-		if (cleanUp)
-			dataPtr.reset(ddsData);
+		StreamContents ddsData(data);
 
 		ID3D11Resource *texture;
-		HRESULT hr = DirectX::CreateDDSTextureFromMemory(device->InternalPointer, reinterpret_cast<uint8_t*>(ddsData), ddsDataSize, &texture, NULL); 
+		HRESULT hr = DirectX::CreateDDSTextureFromMemory(device->InternalPointer, reinterpret_cast<uint8_t*>(ddsData.Data), static_cast<size_t>(ddsData.Size), &texture, NULL); 
 		if (RECORD_D3D11(hr).IsFailure)
 			return nullptr;
 
@@ -104,18 +99,13 @@ namespace Direct3D11
 		if (data == nullptr)
 			throw gcnew ArgumentNullException("data");
 
-		int ddsDataSize = 0;
-		bool cleanUp = true;
-		std::unique_ptr<char> dataPtr;
-		char *ddsData = Utilities::ReadStream(data, ddsDataSize, cleanUp);
-		if (cleanUp)
-			dataPtr.reset(ddsData);
+		StreamContents ddsData(data);
 
 		ID3D11Resource *texture;
 		ID3D11ShaderResourceView *view;
 		DirectX::DDS_ALPHA_MODE mode;
 
-		HRESULT hr = DirectX::CreateDDSTextureFromMemory(device->InternalPointer, reinterpret_cast<uint8_t*>(ddsData), ddsDataSize, &texture, &view, 0, &mode); 
+		HRESULT hr = DirectX::CreateDDSTextureFromMemory(device->InternalPointer, reinterpret_cast<uint8_t*>(ddsData.Data), static_cast<size_t>(ddsData.Size), &texture, &view, 0, &mode); 
 		if (RECORD_D3D11(hr).IsFailure)
 			return nullptr;
 
@@ -0,0 +1,560 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "../DataStream.h"
+#include "../dxgi/FormatTable.h"
+
+#include "Direct3D11Exception.h"
+
+#include "DeviceContext11.h"
+#include "Resource11.h"
+#include "TextureSaver.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Runtime::InteropServices;
+
+namespace SlimDX
+{
+namespace Direct3D11
+{
+namespace
+{
+#pragma pack(push, 1)
+	struct DdsPixelFormat
+	{
+		uint32_t Size;
+		uint32_t Flags;
+		uint32_t FourCC;
+		uint32_t RGBBitCount;
+		uint32_t RBitMask;
+		uint32_t GBitMask;
+		uint32_t BBitMask;
+		uint32_t ABitMask;
+	};
+
+	struct DdsHeader
+	{
+		uint32_t Size;
+		uint32_t Flags;
+		uint32_t Height;
+		uint32_t Width;
+		uint32_t PitchOrLinearSize;
+		uint32_t Depth;
+		uint32_t MipMapCount;
+		uint32_t Reserved1[11];
+		DdsPixelFormat PixelFormat;
+		uint32_t Caps;
+		uint32_t Caps2;
+		uint32_t Caps3;
+		uint32_t Caps4;
+		uint32_t Reserved2;
+	};
+
+	struct DdsHeaderDxt10
+	{
+		DXGI_FORMAT Format;
+		uint32_t ResourceDimension;
+		uint32_t MiscFlag;
+		uint32_t ArraySize;
+		uint32_t MiscFlags2;
+	};
+
+	struct DdsFile
+	{
+		uint32_t Magic;
+		DdsHeader Header;
+		DdsHeaderDxt10 Extension;
+	};
+#pragma pack(pop)
+
+	const uint32_t DdsMagic = 0x20534444;		// "DDS "
+
+	const uint32_t PixelFormatAlpha = 0x00000002;
+	const uint32_t PixelFormatFourCC = 0x00000004;
+	const uint32_t PixelFormatRgb = 0x00000040;
+	const uint32_t PixelFormatLuminance = 0x00020000;
+	const uint32_t PixelFormatAlphaPixels = 0x00000001;
+
+	const uint32_t HeaderFlagsTexture = 0x00001007;		// DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT
+	const uint32_t HeaderFlagsPitch = 0x00000008;
+	const uint32_t HeaderFlagsMipMap = 0x00020000;
+	const uint32_t HeaderFlagsLinearSize = 0x00080000;
+	const uint32_t HeaderFlagsVolume = 0x00800000;
+
+	const uint32_t CapsComplex = 0x00000008;
+	const uint32_t CapsTexture = 0x00001000;
+	const uint32_t CapsMipMap = 0x00400000;
+
+	const uint32_t Caps2CubeMapAllFaces = 0x0000fe00;
+	const uint32_t Caps2Volume = 0x00200000;
+
+	// Two slots let the copy of the next subresource run on the GPU while the current one is written out.
+	const int StagingRingSize = 2;
+
+	struct TextureLayout
+	{
+		D3D11_RESOURCE_DIMENSION Dimension;
+		DXGI_FORMAT Format;
+		UINT Width;
+		UINT Height;
+		UINT Depth;
+		UINT MipLevels;
+		UINT ArraySize;
+		UINT SampleCount;
+		D3D11_USAGE Usage;
+		UINT CpuAccessFlags;
+		bool IsCube;
+	};
+
+	inline uint32_t MakeFourCC( char a, char b, char c, char d )
+	{
+		return static_cast<uint8_t>( a ) | ( static_cast<uint8_t>( b ) << 8 ) | ( static_cast<uint8_t>( c ) << 16 ) | ( static_cast<uint32_t>( static_cast<uint8_t>( d ) ) << 24 );
+	}
+
+	inline UINT MipSize( UINT size, UINT mipSlice )
+	{
+		return std::max( 1u, size >> mipSlice );
+	}
+
+	// Returns false for buffers, which have no image layout.
+	bool GetTextureLayout( ID3D11Resource* resource, TextureLayout& layout )
+	{
+		memset( &layout, 0, sizeof( layout ) );
+		resource->GetType( &layout.Dimension );
+
+		switch( layout.Dimension )
+		{
+		case D3D11_RESOURCE_DIMENSION_TEXTURE1D:
+			{
+				D3D11_TEXTURE1D_DESC desc;
+				static_cast<ID3D11Texture1D*>( resource )->GetDesc( &desc );
+				layout.Format = desc.Format;
+				layout.Width = desc.Width;
+				layout.Height = 1;
+				layout.Depth = 1;
+				layout.MipLevels = desc.MipLevels;
+				layout.ArraySize = desc.ArraySize;
+				layout.SampleCount = 1;
+				layout.Usage = desc.Usage;
+				layout.CpuAccessFlags = desc.CPUAccessFlags;
+				return true;
+			}
+
+		case D3D11_RESOURCE_DIMENSION_TEXTURE2D:
+			{
+				D3D11_TEXTURE2D_DESC desc;
+				static_cast<ID3D11Texture2D*>( resource )->GetDesc( &desc );
+				layout.Format = desc.Format;
+				layout.Width = desc.Width;
+				layout.Height = desc.Height;
+				layout.Depth = 1;
+				layout.MipLevels = desc.MipLevels;
+				layout.ArraySize = desc.ArraySize;
+				layout.SampleCount = desc.SampleDesc.Count;
+				layout.Usage = desc.Usage;
+				layout.CpuAccessFlags = desc.CPUAccessFlags;
+				layout.IsCube = ( desc.MiscFlags & D3D11_RESOURCE_MISC_TEXTURECUBE ) != 0;
+				return true;
+			}
+
+		case D3D11_RESOURCE_DIMENSION_TEXTURE3D:
+			{
+				D3D11_TEXTURE3D_DESC desc;
+				static_cast<ID3D11Texture3D*>( resource )->GetDesc( &desc );
+				layout.Format = desc.Format;
+				layout.Width = desc.Width;
+				layout.Height = desc.Height;
+				layout.Depth = desc.Depth;
+				layout.MipLevels = desc.MipLevels;
+				layout.ArraySize = 1;
+				layout.SampleCount = 1;
+				layout.Usage = desc.Usage;
+				layout.CpuAccessFlags = desc.CPUAccessFlags;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Fills in the pre-DX10 pixel format for formats that have one, mirroring what DDSTextureLoader recognizes.
+	bool GetLegacyPixelFormat( DXGI_FORMAT format, DdsPixelFormat& pixelFormat )
+	{
+		pixelFormat.Size = sizeof( DdsPixelFormat );
+		pixelFormat.Flags = 0;
+		pixelFormat.FourCC = 0;
+		pixelFormat.RGBBitCount = 0;
+		pixelFormat.RBitMask = pixelFormat.GBitMask = pixelFormat.BBitMask = pixelFormat.ABitMask = 0;
+
+		uint32_t fourCC = 0;
+		switch( format )
+		{
+		case DXGI_FORMAT_R8G8B8A8_UNORM:
+			pixelFormat.Flags = PixelFormatRgb | PixelFormatAlphaPixels;
+			pixelFormat.RGBBitCount = 32;
+			pixelFormat.RBitMask = 0x000000ff;
+			pixelFormat.GBitMask = 0x0000ff00;
+			pixelFormat.BBitMask = 0x00ff0000;
+			pixelFormat.ABitMask = 0xff000000;
+			return true;
+
+		case DXGI_FORMAT_B8G8R8A8_UNORM:
+			pixelFormat.Flags = PixelFormatRgb | PixelFormatAlphaPixels;
+			pixelFormat.RGBBitCount = 32;
+			pixelFormat.RBitMask = 0x00ff0000;
+			pixelFormat.GBitMask = 0x0000ff00;
+			pixelFormat.BBitMask = 0x000000ff;
+			pixelFormat.ABitMask = 0xff000000;
+			return true;
+
+		case DXGI_FORMAT_B8G8R8X8_UNORM:
+			pixelFormat.Flags = PixelFormatRgb;
+			pixelFormat.RGBBitCount = 32;
+			pixelFormat.RBitMask = 0x00ff0000;
+			pixelFormat.GBitMask = 0x0000ff00;
+			pixelFormat.BBitMask = 0x000000ff;
+			return true;
+
+		case DXGI_FORMAT_R16G16_UNORM:
+			pixelFormat.Flags = PixelFormatRgb;
+			pixelFormat.RGBBitCount = 32;
+			pixelFormat.RBitMask = 0x0000ffff;
+			pixelFormat.GBitMask = 0xffff0000;
+			return true;
+
+		case DXGI_FORMAT_B5G6R5_UNORM:
+			pixelFormat.Flags = PixelFormatRgb;
+			pixelFormat.RGBBitCount = 16;
+			pixelFormat.RBitMask = 0xf800;
+			pixelFormat.GBitMask = 0x07e0;
+			pixelFormat.BBitMask = 0x001f;
+			return true;
+
+		case DXGI_FORMAT_B5G5R5A1_UNORM:
+			pixelFormat.Flags = PixelFormatRgb | PixelFormatAlphaPixels;
+			pixelFormat.RGBBitCount = 16;
+			pixelFormat.RBitMask = 0x7c00;
+			pixelFormat.GBitMask = 0x03e0;
+			pixelFormat.BBitMask = 0x001f;
+			pixelFormat.ABitMask = 0x8000;
+			return true;
+
+		case DXGI_FORMAT_R8_UNORM:
+			pixelFormat.Flags = PixelFormatLuminance;
+			pixelFormat.RGBBitCount = 8;
+			pixelFormat.RBitMask = 0x000000ff;
+			return true;
+
+		case DXGI_FORMAT_R16_UNORM:
+			pixelFormat.Flags = PixelFormatLuminance;
+			pixelFormat.RGBBitCount = 16;
+			pixelFormat.RBitMask = 0x0000ffff;
+			return true;
+
+		case DXGI_FORMAT_A8_UNORM:
+			pixelFormat.Flags = PixelFormatAlpha;
+			pixelFormat.RGBBitCount = 8;
+			pixelFormat.ABitMask = 0x000000ff;
+			return true;
+
+		case DXGI_FORMAT_BC1_UNORM: fourCC = MakeFourCC( 'D', 'X', 'T', '1' ); break;
+		case DXGI_FORMAT_BC2_UNORM: fourCC = MakeFourCC( 'D', 'X', 'T', '3' ); break;
+		case DXGI_FORMAT_BC3_UNORM: fourCC = MakeFourCC( 'D', 'X', 'T', '5' ); break;
+		case DXGI_FORMAT_BC4_UNORM: fourCC = MakeFourCC( 'B', 'C', '4', 'U' ); break;
+		case DXGI_FORMAT_BC4_SNORM: fourCC = MakeFourCC( 'B', 'C', '4', 'S' ); break;
+		case DXGI_FORMAT_BC5_UNORM: fourCC = MakeFourCC( 'B', 'C', '5', 'U' ); break;
+		case DXGI_FORMAT_BC5_SNORM: fourCC = MakeFourCC( 'B', 'C', '5', 'S' ); break;
+		case DXGI_FORMAT_R8G8_B8G8_UNORM: fourCC = MakeFourCC( 'R', 'G', 'B', 'G' ); break;
+		case DXGI_FORMAT_G8R8_G8B8_UNORM: fourCC = MakeFourCC( 'G', 'R', 'G', 'B' ); break;
+
+		// D3DFORMAT values stored directly in the FourCC field
+		case DXGI_FORMAT_R16G16B16A16_UNORM: fourCC = 36; break;
+		case DXGI_FORMAT_R16G16B16A16_SNORM: fourCC = 110; break;
+		case DXGI_FORMAT_R16_FLOAT: fourCC = 111; break;
+		case DXGI_FORMAT_R16G16_FLOAT: fourCC = 112; break;
+		case DXGI_FORMAT_R16G16B16A16_FLOAT: fourCC = 113; break;
+		case DXGI_FORMAT_R32_FLOAT: fourCC = 114; break;
+		case DXGI_FORMAT_R32G32_FLOAT: fourCC = 115; break;
+		case DXGI_FORMAT_R32G32B32A32_FLOAT: fourCC = 116; break;
+
+		default:
+			return false;
+		}
+
+		pixelFormat.Flags = PixelFormatFourCC;
+		pixelFormat.FourCC = fourCC;
+		return true;
+	}
+
+	// Builds the file preamble and returns its size in bytes, which depends on whether the DX10 extension is needed.
+	int BuildHeader( const TextureLayout& layout, UINT rowPitch, UINT rowCount, DdsFile& file )
+	{
+		memset( &file, 0, sizeof( file ) );
+		file.Magic = DdsMagic;
+
+		DdsHeader& header = file.Header;
+		header.Size = sizeof( DdsHeader );
+		header.Flags = HeaderFlagsTexture;
+		header.Width = layout.Width;
+		header.Height = layout.Height;
+		header.Depth = layout.Depth;
+		header.MipMapCount = layout.MipLevels;
+		header.Caps = CapsTexture;
+
+		if( DXGI::GetFormatDescriptor( layout.Format )->BlockSize != 0 )
+		{
+			header.Flags |= HeaderFlagsLinearSize;
+			header.PitchOrLinearSize = rowPitch * rowCount;
+		}
+		else
+		{
+			header.Flags |= HeaderFlagsPitch;
+			header.PitchOrLinearSize = rowPitch;
+		}
+
+		if( layout.MipLevels > 1 )
+		{
+			header.Flags |= HeaderFlagsMipMap;
+			header.Caps |= CapsComplex | CapsMipMap;
+		}
+
+		if( layout.Dimension == D3D11_RESOURCE_DIMENSION_TEXTURE3D )
+		{
+			header.Flags |= HeaderFlagsVolume;
+			header.Caps |= CapsComplex;
+			header.Caps2 |= Caps2Volume;
+		}
+
+		if( layout.IsCube )
+		{
+			header.Caps |= CapsComplex;
+			header.Caps2 |= Caps2CubeMapAllFaces;
+		}
+
+		// The legacy header can only express a single 2D texture, cube or volume; loaders read a legacy 1D texture back as 2D.
+		bool single = layout.IsCube ? layout.ArraySize == 6 : layout.ArraySize == 1;
+		if( layout.Dimension == D3D11_RESOURCE_DIMENSION_TEXTURE1D )
+			single = false;
+
+		if( single && GetLegacyPixelFormat( layout.Format, header.PixelFormat ) )
+			return sizeof( uint32_t ) + sizeof( DdsHeader );
+
+		header.PixelFormat.Size = sizeof( DdsPixelFormat );
+		header.PixelFormat.Flags = PixelFormatFourCC;
+		header.PixelFormat.FourCC = MakeFourCC( 'D', 'X', '1', '0' );
+
+		DdsHeaderDxt10& extension = file.Extension;
+		extension.Format = layout.Format;
+		extension.ResourceDimension = layout.Dimension;
+		extension.MiscFlag = layout.IsCube ? D3D11_RESOURCE_MISC_TEXTURECUBE : 0;
+		extension.ArraySize = layout.IsCube ? layout.ArraySize / 6 : layout.ArraySize;
+		return sizeof( DdsFile );
+	}
+
+	// Creates a CPU readable texture large enough to hold the top level of the source.
+	HRESULT CreateStagingTexture( ID3D11Device* device, const TextureLayout& layout, ID3D11Resource** staging )
+	{
+		switch( layout.Dimension )
+		{
+		case D3D11_RESOURCE_DIMENSION_TEXTURE1D:
+			{
+				D3D11_TEXTURE1D_DESC desc = { layout.Width, 1, 1, layout.Format, D3D11_USAGE_STAGING, 0, D3D11_CPU_ACCESS_READ, 0 };
+				return device->CreateTexture1D( &desc, NULL, reinterpret_cast<ID3D11Texture1D**>( staging ) );
+			}
+
+		case D3D11_RESOURCE_DIMENSION_TEXTURE2D:
+			{
+				D3D11_TEXTURE2D_DESC desc = { layout.Width, layout.Height, 1, 1, layout.Format, { 1, 0 }, D3D11_USAGE_STAGING, 0, D3D11_CPU_ACCESS_READ, 0 };
+				return device->CreateTexture2D( &desc, NULL, reinterpret_cast<ID3D11Texture2D**>( staging ) );
+			}
+
+		default:
+			{
+				D3D11_TEXTURE3D_DESC desc = { layout.Width, layout.Height, layout.Depth, 1, layout.Format, D3D11_USAGE_STAGING, 0, D3D11_CPU_ACCESS_READ, 0 };
+				return device->CreateTexture3D( &desc, NULL, reinterpret_cast<ID3D11Texture3D**>( staging ) );
+			}
+		}
+	}
+
+	void WriteBytes( Stream^ stream, DataStream^ dataStream, array<Byte>^ buffer, const void* data, int count )
+	{
+		if( dataStream != nullptr )
+		{
+			dataStream->WriteRange( IntPtr( const_cast<void*>( data ) ), count );
+			return;
+		}
+
+		Marshal::Copy( IntPtr( const_cast<void*>( data ) ), buffer, 0, count );
+		stream->Write( buffer, 0, count );
+	}
+}
+
+	Result TextureSaver::SaveDDS( DeviceContext^ context, Resource^ resource, String^ fileName )
+	{
+		if( String::IsNullOrEmpty( fileName ) )
+			throw gcnew ArgumentNullException( "fileName" );
+
+		// the image is written next to the target and only moved over it once complete, so a failed save
+		// neither leaves a truncated file behind nor destroys an existing one
+		String^ partialName = String::Concat( fileName, ".partial" );
+		Result result;
+		try
+		{
+			FileStream^ file = gcnew FileStream( partialName, FileMode::Create, FileAccess::Write, FileShare::None );
+			try
+			{
+				result = SaveDDS( context, resource, file );
+			}
+			finally
+			{
+				delete file;
+			}
+
+			if( result.IsSuccess )
+			{
+				if( File::Exists( fileName ) )
+					File::Replace( partialName, fileName, nullptr );
+				else
+					File::Move( partialName, fileName );
+			}
+		}
+		finally
+		{
+			if( File::Exists( partialName ) )
+				File::Delete( partialName );
+		}
+
+		return result;
+	}
+
+	Result TextureSaver::SaveDDS( DeviceContext^ context, Resource^ resource, Stream^ stream )
+	{
+		if( context == nullptr )
+			throw gcnew ArgumentNullException( "context" );
+		if( resource == nullptr )
+			throw gcnew ArgumentNullException( "resource" );
+		if( stream == nullptr )
+			throw gcnew ArgumentNullException( "stream" );
+		if( !stream->CanWrite )
+			throw gcnew ArgumentException( "The stream must be writable.", "stream" );
+
+		TextureLayout layout;
+		if( !GetTextureLayout( resource->InternalPointer, layout ) )
+			throw gcnew ArgumentException( "Only textures can be saved as DDS images.", "resource" );
+		if( layout.SampleCount > 1 )
+			throw gcnew ArgumentException( "Multisampled textures must be resolved before they can be saved.", "resource" );
+
+		UINT rowPitch;
+		UINT rowCount;
+		if( !DXGI::GetSurfacePitch( layout.Format, layout.Width, layout.Height, rowPitch, rowCount ) )
+			throw gcnew ArgumentException( "The texture format cannot be saved as a DDS image.", "resource" );
+
+		ID3D11DeviceContext* nativeContext = context->InternalPointer;
+		ID3D11Resource* source = resource->InternalPointer;
+		bool direct = layout.Usage == D3D11_USAGE_STAGING && ( layout.CpuAccessFlags & D3D11_CPU_ACCESS_READ ) != 0;
+		int subresourceCount = layout.MipLevels * layout.ArraySize;
+
+		ID3D11Resource* ring[StagingRingSize] = { NULL };
+		if( !direct )
+		{
+			ID3D11Device* device = NULL;
+			nativeContext->GetDevice( &device );
+
+			HRESULT hr = S_OK;
+			for( int i = 0; i < StagingRingSize && i < subresourceCount && SUCCEEDED( hr ); i++ )
+				hr = CreateStagingTexture( device, layout, &ring[i] );
+			device->Release();
+
+			if( RECORD_D3D11( hr ).IsFailure )
+			{
+				for( int i = 0; i < StagingRingSize; i++ )
+				{
+					if( ring[i] != NULL )
+						ring[i]->Release();
+				}
+				return Result::Last;
+			}
+		}
+
+		try
+		{
+			DdsFile file;
+			int headerSize = BuildHeader( layout, rowPitch, rowCount, file );
+
+			// A single row of the top level is the largest contiguous block written at once.
+			DataStream^ dataStream = dynamic_cast<DataStream^>( stream );
+			array<Byte>^ buffer = dataStream != nullptr ? nullptr : gcnew array<Byte>( std::max( static_cast<int>( rowPitch ), headerSize ) );
+			WriteBytes( stream, dataStream, buffer, &file, headerSize );
+
+			if( !direct )
+				nativeContext->CopySubresourceRegion( ring[0], 0, 0, 0, 0, source, 0, NULL );
+
+			// Subresource order matches the DDS layout: every mip of the first array slice, then the next slice.
+			for( int subresource = 0; subresource < subresourceCount; subresource++ )
+			{
+				if( !direct && subresource + 1 < subresourceCount )
+					nativeContext->CopySubresourceRegion( ring[( subresource + 1 ) % StagingRingSize], 0, 0, 0, 0, source, subresource + 1, NULL );
+
+				ID3D11Resource* surface = direct ? source : ring[subresource % StagingRingSize];
+				UINT mappedIndex = direct ? subresource : 0;
+
+				D3D11_MAPPED_SUBRESOURCE mapped;
+				HRESULT hr = nativeContext->Map( surface, mappedIndex, D3D11_MAP_READ, 0, &mapped );
+				if( RECORD_D3D11( hr ).IsFailure )
+					return Result::Last;
+
+				try
+				{
+					UINT mip = subresource % layout.MipLevels;
+					UINT mipPitch;
+					UINT mipRows;
+					DXGI::GetSurfacePitch( layout.Format, MipSize( layout.Width, mip ), MipSize( layout.Height, mip ), mipPitch, mipRows );
+					UINT mipDepth = MipSize( layout.Depth, mip );
+
+					for( UINT slice = 0; slice < mipDepth; slice++ )
+					{
+						const char* data = static_cast<const char*>( mapped.pData ) + slice * mapped.DepthPitch;
+						for( UINT row = 0; row < mipRows; row++ )
+							WriteBytes( stream, dataStream, buffer, data + row * mapped.RowPitch, mipPitch );
+					}
+				}
+				finally
+				{
+					nativeContext->Unmap( surface, mappedIndex );
+				}
+			}
+		}
+		finally
+		{
+			for( int i = 0; i < StagingRingSize; i++ )
+			{
+				if( ring[i] != NULL )
+					ring[i]->Release();
+			}
+		}
+
+		return Result::Last;
+	}
+}
+}
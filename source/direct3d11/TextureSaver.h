@@ -0,0 +1,66 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+	namespace Direct3D11
+	{
+		/// <summary>
+		/// Provides methods for saving the contents of textures to image data.
+		/// </summary>
+		public ref class TextureSaver sealed
+		{
+		private:
+			TextureSaver() { }
+
+		public:
+			/// <summary>
+			/// Saves the contents of a texture to a DDS file. Mip levels, texture arrays, cube maps and volume textures are all supported;
+			/// formats without a legacy DDS pixel format are written with the DX10 header extension.
+			/// </summary>
+			/// <remarks>
+			/// Subresources are read back through a small ring of staging textures one at a time, so the memory required is bounded by the
+			/// size of the top mip level rather than the whole texture. Textures that are already CPU readable staging resources are mapped directly.
+			/// </remarks>
+			/// <param name="context">The device context used to read back the texture.</param>
+			/// <param name="resource">The texture to save. Multisampled textures must be resolved first.</param>
+			/// <param name="fileName">Name of the file to write. The image is written to a temporary file beside it, which replaces it only if the save succeeds.</param>
+			/// <returns>A <see cref="SlimDX::Result"/> object describing the result of the operation.</returns>
+			static Result SaveDDS( DeviceContext^ context, Resource^ resource, System::String^ fileName );
+
+			/// <summary>
+			/// Saves the contents of a texture to a stream in the DDS format. Mip levels, texture arrays, cube maps and volume textures are all supported;
+			/// formats without a legacy DDS pixel format are written with the DX10 header extension.
+			/// </summary>
+			/// <remarks>
+			/// Subresources are read back through a small ring of staging textures one at a time, so the memory required is bounded by the
+			/// size of the top mip level rather than the whole texture. Textures that are already CPU readable staging resources are mapped directly.
+			/// </remarks>
+			/// <param name="context">The device context used to read back the texture.</param>
+			/// <param name="resource">The texture to save. Multisampled textures must be resolved first.</param>
+			/// <param name="stream">The stream to which the image data is written, starting at its current position.</param>
+			/// <returns>A <see cref="SlimDX::Result"/> object describing the result of the operation.</returns>
+			static Result SaveDDS( DeviceContext^ context, Resource^ resource, System::IO::Stream^ stream );
+		};
+	}
+}
@@ -0,0 +1,97 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "TextLayout.h"
+#include "CachedLayout.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	CachedLayout::CachedLayout( TextLayout^ layout, int textLength )
+	{
+		m_Metrics = layout->Metrics;
+		m_LineMetrics = layout->GetLineMetrics();
+		m_ClusterMetrics = textLength > 0 ? layout->GetClusterMetrics() : nullptr;
+
+		if( m_LineMetrics == nullptr )
+			m_LineMetrics = gcnew array<SlimDX::DirectWrite::LineMetrics>( 0 );
+		if( m_ClusterMetrics == nullptr )
+			m_ClusterMetrics = gcnew array<SlimDX::DirectWrite::ClusterMetrics>( 0 );
+
+		// DirectWrite does not report what a layout costs; this counts the text, the metrics arrays and a rough
+		// per-character figure for the shaping results the layout keeps.
+		m_EstimatedSize = 512 + static_cast<Int64>( textLength ) * 64 +
+			m_LineMetrics->Length * static_cast<Int64>( sizeof( DWRITE_LINE_METRICS ) ) +
+			m_ClusterMetrics->Length * static_cast<Int64>( sizeof( DWRITE_CLUSTER_METRICS ) );
+
+		// taken last: if reading the metrics throws, the caller disposes the layout and the finalizer must not
+		m_Layout = layout;
+	}
+
+	CachedLayout::!CachedLayout()
+	{
+		// the cache drops its reference on eviction, so whoever held the handle last decides when the layout goes
+		delete m_Layout;
+		m_Layout = nullptr;
+	}
+
+	SlimDX::DirectWrite::LineMetrics CachedLayout::GetLineMetrics( int index )
+	{
+		if( index < 0 || index >= m_LineMetrics->Length )
+			throw gcnew ArgumentOutOfRangeException( "index" );
+
+		return m_LineMetrics[index];
+	}
+
+	SlimDX::DirectWrite::ClusterMetrics CachedLayout::GetClusterMetrics( int index )
+	{
+		if( index < 0 || index >= m_ClusterMetrics->Length )
+			throw gcnew ArgumentOutOfRangeException( "index" );
+
+		return m_ClusterMetrics[index];
+	}
+
+	TextLayout^ CachedLayout::Layout::get()
+	{
+		return m_Layout;
+	}
+
+	TextMetrics CachedLayout::Metrics::get()
+	{
+		return m_Metrics;
+	}
+
+	int CachedLayout::LineCount::get()
+	{
+		return m_LineMetrics->Length;
+	}
+
+	int CachedLayout::ClusterCount::get()
+	{
+		return m_ClusterMetrics->Length;
+	}
+}
+}
@@ -0,0 +1,102 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "ClusterMetrics.h"
+#include "LineMetrics.h"
+#include "TextMetrics.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class TextLayout;
+
+		/// <summary>
+		/// A text layout shared through a <see cref="LayoutCache"/>, together with the metrics computed when it was created.
+		/// </summary>
+		/// <remarks>
+		/// Each cache entry has a single handle, returned by every lookup that hits it. The cache never disposes the layout:
+		/// once the entry has been evicted and the handle is no longer referenced, the layout is disposed when the handle is
+		/// finalized. Keep the handle alive for as long as <see cref="Layout"/> is used, and do not modify or dispose the layout.
+		/// </remarks>
+		public ref class CachedLayout sealed
+		{
+		private:
+			TextLayout^ m_Layout;
+			TextMetrics m_Metrics;
+			array<SlimDX::DirectWrite::LineMetrics>^ m_LineMetrics;
+			array<SlimDX::DirectWrite::ClusterMetrics>^ m_ClusterMetrics;
+			System::Int64 m_EstimatedSize;
+
+		internal:
+			CachedLayout( TextLayout^ layout, int textLength );
+
+			property System::Int64 EstimatedSize
+			{
+				System::Int64 get() { return m_EstimatedSize; }
+			}
+
+		public:
+			/// <summary>
+			/// Disposes the layout once neither the cache nor any caller references the handle.
+			/// </summary>
+			!CachedLayout();
+
+			/// <summary>
+			/// Gets the line metrics of one line of the layout.
+			/// </summary>
+			SlimDX::DirectWrite::LineMetrics GetLineMetrics( int index );
+
+			/// <summary>
+			/// Gets the metrics of one cluster of the layout.
+			/// </summary>
+			SlimDX::DirectWrite::ClusterMetrics GetClusterMetrics( int index );
+
+			property TextLayout^ Layout
+			{
+				TextLayout^ get();
+			}
+
+			property TextMetrics Metrics
+			{
+				TextMetrics get();
+			}
+
+			/// <summary>
+			/// Gets the number of lines in the layout.
+			/// </summary>
+			property int LineCount
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the number of clusters in the layout.
+			/// </summary>
+			property int ClusterCount
+			{
+				int get();
+			}
+		};
+	}
+}
@@ -0,0 +1,556 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "FactoryDW.h"
+#include "TextFormat.h"
+#include "TextLayout.h"
+#include "EditableTextLayout.h"
+
+using namespace System;
+using namespace System::Runtime::InteropServices;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	EditableTextLayout::ParagraphTree::ParagraphTree()
+	{
+		m_Seed = 2463534242u;
+	}
+
+	void EditableTextLayout::ParagraphTree::Update( Node^ node )
+	{
+		node->Size = SizeOf( node->Left ) + 1 + SizeOf( node->Right );
+		node->Height = HeightOf( node->Left ) + node->Value.Height + HeightOf( node->Right );
+
+		// every paragraph is followed by its line feed; the last one's is never addressed
+		node->Length = LengthOf( node->Left ) + node->Value.Text->Length + 1 + LengthOf( node->Right );
+	}
+
+	EditableTextLayout::ParagraphTree::Node^ EditableTextLayout::ParagraphTree::Build( array<Paragraph>^ values, int index, int count )
+	{
+		if( count == 0 )
+			return nullptr;
+
+		int middle = count / 2;
+		Node^ node = gcnew Node();
+		node->Value = values[index + middle];
+		node->Left = Build( values, index, middle );
+		node->Right = Build( values, index + middle + 1, count - middle - 1 );
+		Update( node );
+		return node;
+	}
+
+	void EditableTextLayout::ParagraphTree::Collect( Node^ node, array<Paragraph>^ values, int% index )
+	{
+		if( node == nullptr )
+			return;
+
+		Collect( node->Left, values, index );
+		values[index++] = node->Value;
+		Collect( node->Right, values, index );
+	}
+
+	unsigned int EditableTextLayout::ParagraphTree::NextRandom()
+	{
+		m_Seed ^= m_Seed << 13;
+		m_Seed ^= m_Seed >> 17;
+		m_Seed ^= m_Seed << 5;
+		return m_Seed;
+	}
+
+	EditableTextLayout::ParagraphTree::Node^ EditableTextLayout::ParagraphTree::Merge( Node^ left, Node^ right )
+	{
+		if( left == nullptr )
+			return right;
+		if( right == nullptr )
+			return left;
+
+		// choosing the root in proportion to the subtree sizes keeps the tree balanced in expectation without priorities
+		if( NextRandom() % static_cast<unsigned int>( left->Size + right->Size ) < static_cast<unsigned int>( left->Size ) )
+		{
+			left->Right = Merge( left->Right, right );
+			Update( left );
+			return left;
+		}
+
+		right->Left = Merge( left, right->Left );
+		Update( right );
+		return right;
+	}
+
+	void EditableTextLayout::ParagraphTree::Split( Node^ node, int count, Node^% left, Node^% right )
+	{
+		if( node == nullptr )
+		{
+			left = nullptr;
+			right = nullptr;
+			return;
+		}
+
+		if( SizeOf( node->Left ) < count )
+		{
+			Node^ rest;
+			Split( node->Right, count - SizeOf( node->Left ) - 1, rest, right );
+			node->Right = rest;
+			Update( node );
+			left = node;
+		}
+		else
+		{
+			Node^ rest;
+			Split( node->Left, count, left, rest );
+			node->Left = rest;
+			Update( node );
+			right = node;
+		}
+	}
+
+	void EditableTextLayout::ParagraphTree::Reset( array<Paragraph>^ values )
+	{
+		m_Root = Build( values, 0, values->Length );
+	}
+
+	array<EditableTextLayout::Paragraph>^ EditableTextLayout::ParagraphTree::ToArray()
+	{
+		array<Paragraph>^ values = gcnew array<Paragraph>( Count );
+		int index = 0;
+		Collect( m_Root, values, index );
+		return values;
+	}
+
+	array<EditableTextLayout::Paragraph>^ EditableTextLayout::ParagraphTree::Splice( int index, int count, array<Paragraph>^ values )
+	{
+		Node^ left;
+		Node^ middle;
+		Node^ right;
+		Split( m_Root, index, left, middle );
+		Split( middle, count, middle, right );
+		m_Root = Merge( Merge( left, Build( values, 0, values->Length ) ), right );
+
+		array<Paragraph>^ removed = gcnew array<Paragraph>( SizeOf( middle ) );
+		int removedIndex = 0;
+		Collect( middle, removed, removedIndex );
+		return removed;
+	}
+
+	EditableTextLayout::Paragraph EditableTextLayout::ParagraphTree::Get( int index )
+	{
+		if( index < 0 || index >= Count )
+			throw gcnew ArgumentOutOfRangeException( "index" );
+
+		Node^ node = m_Root;
+		while( index != SizeOf( node->Left ) )
+		{
+			if( index < SizeOf( node->Left ) )
+			{
+				node = node->Left;
+			}
+			else
+			{
+				index -= SizeOf( node->Left ) + 1;
+				node = node->Right;
+			}
+		}
+
+		return node->Value;
+	}
+
+	double EditableTextLayout::ParagraphTree::SumHeights( int count )
+	{
+		double sum = 0;
+		for( Node^ node = m_Root; node != nullptr && count > 0; )
+		{
+			if( count <= SizeOf( node->Left ) )
+			{
+				node = node->Left;
+			}
+			else
+			{
+				sum += HeightOf( node->Left ) + node->Value.Height;
+				count -= SizeOf( node->Left ) + 1;
+				node = node->Right;
+			}
+		}
+
+		return sum;
+	}
+
+	int EditableTextLayout::ParagraphTree::SumLengths( int count )
+	{
+		int sum = 0;
+		for( Node^ node = m_Root; node != nullptr && count > 0; )
+		{
+			if( count <= SizeOf( node->Left ) )
+			{
+				node = node->Left;
+			}
+			else
+			{
+				sum += LengthOf( node->Left ) + node->Value.Text->Length + 1;
+				count -= SizeOf( node->Left ) + 1;
+				node = node->Right;
+			}
+		}
+
+		return sum;
+	}
+
+	int EditableTextLayout::ParagraphTree::FindHeight( double height )
+	{
+		int count = 0;
+		for( Node^ node = m_Root; node != nullptr; )
+		{
+			double through = HeightOf( node->Left ) + node->Value.Height;
+			if( through <= height )
+			{
+				height -= through;
+				count += SizeOf( node->Left ) + 1;
+				node = node->Right;
+			}
+			else
+			{
+				node = node->Left;
+			}
+		}
+
+		return count;
+	}
+
+	int EditableTextLayout::ParagraphTree::FindLength( int length )
+	{
+		int count = 0;
+		for( Node^ node = m_Root; node != nullptr; )
+		{
+			int through = LengthOf( node->Left ) + node->Value.Text->Length + 1;
+			if( through <= length )
+			{
+				length -= through;
+				count += SizeOf( node->Left ) + 1;
+				node = node->Right;
+			}
+			else
+			{
+				node = node->Left;
+			}
+		}
+
+		return count;
+	}
+
+	EditableTextLayout::EditableTextLayout( SlimDX::DirectWrite::Factory^ factory, TextFormat^ format, float maxWidth )
+	{
+		if( factory == nullptr )
+			throw gcnew ArgumentNullException( "factory" );
+		if( format == nullptr )
+			throw gcnew ArgumentNullException( "format" );
+
+		m_Factory = factory;
+		m_Format = format;
+		m_MaxWidth = maxWidth;
+		m_Paragraphs = gcnew ParagraphTree();
+		m_Paragraphs->Reset( CreateParagraphs( gcnew array<String^> { String::Empty } ) );
+	}
+
+	EditableTextLayout::EditableTextLayout( SlimDX::DirectWrite::Factory^ factory, TextFormat^ format, float maxWidth, String^ text )
+	{
+		if( factory == nullptr )
+			throw gcnew ArgumentNullException( "factory" );
+		if( format == nullptr )
+			throw gcnew ArgumentNullException( "format" );
+
+		m_Factory = factory;
+		m_Format = format;
+		m_MaxWidth = maxWidth;
+		m_Paragraphs = gcnew ParagraphTree();
+
+		if( text == nullptr )
+			text = String::Empty;
+
+		m_Paragraphs->Reset( CreateParagraphs( text->Split( '\n' ) ) );
+		m_Length = text->Length;
+	}
+
+	EditableTextLayout::~EditableTextLayout()
+	{
+		if( m_Paragraphs == nullptr )
+			return;
+
+		DisposeLayouts( m_Paragraphs->ToArray() );
+		m_Paragraphs = nullptr;
+	}
+
+	EditableTextLayout::Paragraph EditableTextLayout::CreateParagraph( String^ text )
+	{
+		String^ layoutText = text;
+		if( text->Length > 0 && text[text->Length - 1] == '\r' )
+			layoutText = text->Substring( 0, text->Length - 1 );
+
+		Paragraph paragraph;
+		paragraph.Text = text;
+		paragraph.Layout = gcnew TextLayout( m_Factory, layoutText, m_Format, m_MaxWidth, Single::MaxValue );
+		m_LayoutCount++;
+
+		try
+		{
+			paragraph.Height = paragraph.Layout->Metrics.Height;
+		}
+		catch( ... )
+		{
+			delete paragraph.Layout;
+			throw;
+		}
+
+		return paragraph;
+	}
+
+	array<EditableTextLayout::Paragraph>^ EditableTextLayout::CreateParagraphs( array<String^>^ texts )
+	{
+		array<Paragraph>^ created = gcnew array<Paragraph>( texts->Length );
+		int createdCount = 0;
+		try
+		{
+			for( ; createdCount < texts->Length; createdCount++ )
+				created[createdCount] = CreateParagraph( texts[createdCount] );
+		}
+		catch( ... )
+		{
+			for( int i = 0; i < createdCount; i++ )
+				delete created[i].Layout;
+
+			throw;
+		}
+
+		return created;
+	}
+
+	void EditableTextLayout::CheckDisposed()
+	{
+		if( m_Paragraphs == nullptr )
+			throw gcnew ObjectDisposedException( "EditableTextLayout" );
+	}
+
+	void EditableTextLayout::DisposeLayouts( array<Paragraph>^ paragraphs )
+	{
+		for( int i = 0; i < paragraphs->Length; i++ )
+			delete paragraphs[i].Layout;
+	}
+
+	int EditableTextLayout::FindParagraph( int position )
+	{
+		return Math::Min( m_Paragraphs->FindLength( position ), m_Paragraphs->Count - 1 );
+	}
+
+	void EditableTextLayout::Insert( int position, String^ text )
+	{
+		Replace( position, 0, text );
+	}
+
+	void EditableTextLayout::Delete( int position, int length )
+	{
+		Replace( position, length, String::Empty );
+	}
+
+	void EditableTextLayout::Replace( int position, int length, String^ text )
+	{
+		CheckDisposed();
+
+		if( text == nullptr )
+			text = String::Empty;
+		if( position < 0 || length < 0 || position > m_Length - length )
+			throw gcnew ArgumentOutOfRangeException( "position" );
+
+		int first = FindParagraph( position );
+		int last = FindParagraph( position + length );
+		int firstStart = m_Paragraphs->SumLengths( first );
+		int lastStart = m_Paragraphs->SumLengths( last );
+
+		String^ firstText = m_Paragraphs->Get( first ).Text;
+		String^ lastText = m_Paragraphs->Get( last ).Text;
+		String^ combined = String::Concat( firstText->Substring( 0, position - firstStart ), text, lastText->Substring( position + length - lastStart ) );
+
+		// lay out the new paragraphs before disposing the old ones, so a failure leaves the document untouched
+		array<Paragraph>^ created = CreateParagraphs( combined->Split( '\n' ) );
+		DisposeLayouts( m_Paragraphs->Splice( first, last - first + 1, created ) );
+
+		m_Length += text->Length - length;
+	}
+
+	String^ EditableTextLayout::GetText()
+	{
+		CheckDisposed();
+
+		array<Paragraph>^ paragraphs = m_Paragraphs->ToArray();
+		array<String^>^ texts = gcnew array<String^>( paragraphs->Length );
+		for( int i = 0; i < texts->Length; i++ )
+			texts[i] = paragraphs[i].Text;
+
+		return String::Join( "\n", texts );
+	}
+
+	TextLayout^ EditableTextLayout::GetParagraphLayout( int index )
+	{
+		CheckDisposed();
+
+		return m_Paragraphs->Get( index ).Layout;
+	}
+
+	float EditableTextLayout::GetParagraphTop( int index )
+	{
+		CheckDisposed();
+
+		if( index < 0 || index >= m_Paragraphs->Count )
+			throw gcnew ArgumentOutOfRangeException( "index" );
+
+		return static_cast<float>( m_Paragraphs->SumHeights( index ) );
+	}
+
+	int EditableTextLayout::GetParagraphPosition( int index )
+	{
+		CheckDisposed();
+
+		if( index < 0 || index >= m_Paragraphs->Count )
+			throw gcnew ArgumentOutOfRangeException( "index" );
+
+		return m_Paragraphs->SumLengths( index );
+	}
+
+	int EditableTextLayout::GetParagraphAtPosition( int position )
+	{
+		CheckDisposed();
+
+		if( position < 0 || position > m_Length )
+			throw gcnew ArgumentOutOfRangeException( "position" );
+
+		return FindParagraph( position );
+	}
+
+	int EditableTextLayout::GetParagraphAtHeight( float y )
+	{
+		CheckDisposed();
+
+		return Math::Min( m_Paragraphs->FindHeight( y ), m_Paragraphs->Count - 1 );
+	}
+
+	void EditableTextLayout::GetVisibleParagraphs( float top, float bottom, [Out] int% first, [Out] int% count )
+	{
+		if( bottom < top || bottom < 0 || top >= Height )
+		{
+			first = 0;
+			count = 0;
+			return;
+		}
+
+		first = GetParagraphAtHeight( top );
+		count = GetParagraphAtHeight( bottom ) - first + 1;
+	}
+
+	HitTestMetrics EditableTextLayout::HitTestPoint( float pointX, float pointY, [Out] bool% isTrailingHit, [Out] bool% isInside )
+	{
+		int index = GetParagraphAtHeight( pointY );
+		float top = static_cast<float>( m_Paragraphs->SumHeights( index ) );
+
+		HitTestMetrics metrics = m_Paragraphs->Get( index ).Layout->HitTestPoint( pointX, pointY - top, isTrailingHit, isInside );
+		metrics.TextPosition += GetParagraphPosition( index );
+		metrics.Top += top;
+		return metrics;
+	}
+
+	HitTestMetrics EditableTextLayout::HitTestTextPosition( int textPosition, bool isTrailingHit, [Out] float% pointX, [Out] float% pointY )
+	{
+		int index = GetParagraphAtPosition( textPosition );
+		int start = GetParagraphPosition( index );
+		float top = static_cast<float>( m_Paragraphs->SumHeights( index ) );
+
+		// positions on a carriage return before the line feed map to the end of the laid out text
+		Paragraph paragraph = m_Paragraphs->Get( index );
+		int laidOut = paragraph.Text->Length;
+		if( laidOut > 0 && paragraph.Text[laidOut - 1] == '\r' )
+			laidOut--;
+
+		int local = Math::Min( textPosition - start, laidOut );
+
+		HitTestMetrics metrics = paragraph.Layout->HitTestTextPosition( local, isTrailingHit, pointX, pointY );
+		metrics.TextPosition += start;
+		metrics.Top += top;
+		pointY += top;
+		return metrics;
+	}
+
+	SlimDX::DirectWrite::Factory^ EditableTextLayout::Factory::get()
+	{
+		return m_Factory;
+	}
+
+	TextFormat^ EditableTextLayout::Format::get()
+	{
+		return m_Format;
+	}
+
+	float EditableTextLayout::MaxWidth::get()
+	{
+		return m_MaxWidth;
+	}
+
+	void EditableTextLayout::MaxWidth::set( float value )
+	{
+		CheckDisposed();
+
+		m_MaxWidth = value;
+
+		// the layouts can be rewrapped in place; every height changes, so the tree is built again
+		array<Paragraph>^ paragraphs = m_Paragraphs->ToArray();
+		for( int i = 0; i < paragraphs->Length; i++ )
+		{
+			paragraphs[i].Layout->MaxWidth = value;
+			paragraphs[i].Height = paragraphs[i].Layout->Metrics.Height;
+		}
+
+		m_Paragraphs->Reset( paragraphs );
+	}
+
+	int EditableTextLayout::Length::get()
+	{
+		return m_Length;
+	}
+
+	int EditableTextLayout::ParagraphCount::get()
+	{
+		CheckDisposed();
+
+		return m_Paragraphs->Count;
+	}
+
+	float EditableTextLayout::Height::get()
+	{
+		CheckDisposed();
+
+		return static_cast<float>( m_Paragraphs->SumHeights( m_Paragraphs->Count ) );
+	}
+
+	int EditableTextLayout::LayoutCount::get()
+	{
+		return m_LayoutCount;
+	}
+}
+}
@@ -0,0 +1,212 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "HitTestMetrics.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class Factory;
+		ref class TextFormat;
+		ref class TextLayout;
+
+		/// <summary>
+		/// A text layout over a document that is edited in place, laid out one paragraph at a time.
+		/// </summary>
+		/// <remarks>
+		/// The document is split at line feeds into paragraphs, each with its own <see cref="TextLayout"/>. An edit lays out
+		/// again only the paragraphs it touches. The paragraphs are kept in a balanced tree that sums their heights and lengths,
+		/// so locating a paragraph takes logarithmic time, and an edit costs logarithmic time plus the paragraphs it lays out,
+		/// whether or not it adds or removes paragraphs. A carriage return
+		/// before a line feed belongs to its paragraph but is not laid out. Formatting applies to the whole document through
+		/// the text format. The layout is not thread safe.
+		/// </remarks>
+		public ref class EditableTextLayout sealed
+		{
+		private:
+			value class Paragraph
+			{
+			public:
+				System::String^ Text;
+				TextLayout^ Layout;
+				float Height;
+			};
+
+			// An implicit balanced tree of the paragraphs in document order, where every node keeps the total height and
+			// length of its subtree: access by index, prefix sums, searches by sum and splicing all take logarithmic time.
+			ref class ParagraphTree
+			{
+			private:
+				ref class Node
+				{
+				public:
+					Paragraph Value;
+					Node^ Left;
+					Node^ Right;
+					int Size;
+					double Height;
+					int Length;
+				};
+
+				Node^ m_Root;
+				unsigned int m_Seed;
+
+				static int SizeOf( Node^ node ) { return node == nullptr ? 0 : node->Size; }
+				static double HeightOf( Node^ node ) { return node == nullptr ? 0 : node->Height; }
+				static int LengthOf( Node^ node ) { return node == nullptr ? 0 : node->Length; }
+
+				static void Update( Node^ node );
+				static Node^ Build( array<Paragraph>^ values, int index, int count );
+				static void Collect( Node^ node, array<Paragraph>^ values, int% index );
+
+				unsigned int NextRandom();
+				Node^ Merge( Node^ left, Node^ right );
+				void Split( Node^ node, int count, Node^% left, Node^% right );
+
+			public:
+				ParagraphTree();
+
+				void Reset( array<Paragraph>^ values );
+				array<Paragraph>^ ToArray();
+
+				// Replaces count paragraphs starting at index with the given ones, and returns the paragraphs replaced.
+				array<Paragraph>^ Splice( int index, int count, array<Paragraph>^ values );
+
+				Paragraph Get( int index );
+
+				// Return the total height or length of the first count paragraphs.
+				double SumHeights( int count );
+				int SumLengths( int count );
+
+				// Return the number of leading paragraphs whose total height or length does not exceed the given one.
+				int FindHeight( double height );
+				int FindLength( int length );
+
+				property int Count
+				{
+					int get() { return SizeOf( m_Root ); }
+				}
+			};
+
+			SlimDX::DirectWrite::Factory^ m_Factory;
+			TextFormat^ m_Format;
+			float m_MaxWidth;
+			ParagraphTree^ m_Paragraphs;
+			int m_Length;
+			int m_LayoutCount;
+
+			Paragraph CreateParagraph( System::String^ text );
+			void CheckDisposed();
+			array<Paragraph>^ CreateParagraphs( array<System::String^>^ texts );
+			static void DisposeLayouts( array<Paragraph>^ paragraphs );
+			int FindParagraph( int position );
+
+		public:
+			EditableTextLayout( SlimDX::DirectWrite::Factory^ factory, TextFormat^ format, float maxWidth );
+			EditableTextLayout( SlimDX::DirectWrite::Factory^ factory, TextFormat^ format, float maxWidth, System::String^ text );
+
+			/// <summary>
+			/// Disposes the layouts of every paragraph.
+			/// </summary>
+			~EditableTextLayout();
+
+			void Insert( int position, System::String^ text );
+			void Delete( int position, int length );
+
+			/// <summary>
+			/// Replaces a range of the document with new text, laying out only the paragraphs the range touches.
+			/// </summary>
+			void Replace( int position, int length, System::String^ text );
+
+			System::String^ GetText();
+
+			/// <summary>
+			/// Gets the layout of a paragraph, which belongs to this object and is disposed when the paragraph is edited.
+			/// </summary>
+			TextLayout^ GetParagraphLayout( int index );
+			float GetParagraphTop( int index );
+			int GetParagraphPosition( int index );
+
+			/// <summary>
+			/// Gets the paragraph that contains a text position of the document.
+			/// </summary>
+			int GetParagraphAtPosition( int position );
+
+			/// <summary>
+			/// Gets the paragraph at a vertical position, clamped to the first and last paragraph.
+			/// </summary>
+			int GetParagraphAtHeight( float y );
+
+			/// <summary>
+			/// Gets the range of paragraphs that intersect a vertical span, for drawing only what is visible.
+			/// </summary>
+			void GetVisibleParagraphs( float top, float bottom, [System::Runtime::InteropServices::Out] int% first, [System::Runtime::InteropServices::Out] int% count );
+
+			HitTestMetrics HitTestPoint( float pointX, float pointY, [System::Runtime::InteropServices::Out] bool% isTrailingHit, [System::Runtime::InteropServices::Out] bool% isInside );
+			HitTestMetrics HitTestTextPosition( int textPosition, bool isTrailingHit, [System::Runtime::InteropServices::Out] float% pointX, [System::Runtime::InteropServices::Out] float% pointY );
+
+			property SlimDX::DirectWrite::Factory^ Factory
+			{
+				SlimDX::DirectWrite::Factory^ get();
+			}
+
+			property TextFormat^ Format
+			{
+				TextFormat^ get();
+			}
+
+			/// <summary>
+			/// Gets or sets the width paragraphs wrap at; setting it lays out every paragraph again.
+			/// </summary>
+			property float MaxWidth
+			{
+				float get();
+				void set( float value );
+			}
+
+			property int Length
+			{
+				int get();
+			}
+
+			property int ParagraphCount
+			{
+				int get();
+			}
+
+			property float Height
+			{
+				float get();
+			}
+
+			/// <summary>
+			/// Gets the number of paragraph layouts created so far, for measuring how much an edit costs.
+			/// </summary>
+			property int LayoutCount
+			{
+				int get();
+			}
+		};
+	}
+}
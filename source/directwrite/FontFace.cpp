@@ -145,7 +145,15 @@ namespace DirectWrite
 
 	void FontFace::ReleaseFontTable(FontTable^ table)
 	{
+		if (table == nullptr)
+			throw gcnew ArgumentNullException("table");
+
+		// releasing twice would drop a reference the face still holds
+		if (table->IsReleased)
+			return;
+
 		InternalPointer->ReleaseFontTable(table->Context.ToPointer());
+		table->Invalidate();
 	}
 
 	FontFaceType FontFace::Type::get()
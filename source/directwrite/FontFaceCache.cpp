@@ -0,0 +1,210 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "DirectWriteException.h"
+#include "FontFace.h"
+#include "FontFaceCache.h"
+#include "RangeCheck.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	FontFaceCache::FontFaceCache(DirectWrite::FontFace ^fontFace)
+	{
+		if (fontFace == nullptr)
+			throw gcnew ArgumentNullException("fontFace");
+
+		// Manual Allocation: released in Destruct
+		// the dense index table and the metrics arrays grow to a few hundred KB for a large face
+		m_Table = new GlyphTable(fontFace->InternalPointer);
+		m_FontFace = fontFace;
+		GC::AddMemoryPressure(256 * 1024);
+	}
+
+	FontFaceCache::~FontFaceCache()
+	{
+		Destruct();
+		GC::SuppressFinalize(this);
+	}
+
+	FontFaceCache::!FontFaceCache()
+	{
+		Destruct();
+	}
+
+	void FontFaceCache::Destruct()
+	{
+		if (m_Table == 0)
+			return;
+
+		delete m_Table;
+		m_Table = 0;
+		GC::RemoveMemoryPressure(256 * 1024);
+	}
+
+	GlyphTable *FontFaceCache::Table()
+	{
+		if (m_Table == 0)
+			throw gcnew ObjectDisposedException("FontFaceCache");
+
+		return m_Table;
+	}
+
+	DirectWrite::FontFace ^FontFaceCache::FontFace::get()
+	{
+		return m_FontFace;
+	}
+
+	int FontFaceCache::GlyphCount::get()
+	{
+		return static_cast<int>(Table()->GetGlyphCount());
+	}
+
+	Int64 FontFaceCache::LookupCount::get()
+	{
+		return Table()->GetLookups();
+	}
+
+	Int64 FontFaceCache::MissCount::get()
+	{
+		return Table()->GetMisses();
+	}
+
+	short FontFaceCache::GetGlyphIndex(int codePoint)
+	{
+		UINT32 point = static_cast<UINT32>(codePoint);
+		UINT16 index = 0;
+		RECORD_DW(Table()->GetGlyphIndices(&point, 1, &index));
+		return static_cast<short>(index);
+	}
+
+	void FontFaceCache::GetGlyphIndices(array<int> ^codePoints, int codePointsIndex, array<short> ^indices, int indicesIndex, int count)
+	{
+		CheckRange(codePoints, codePointsIndex, count, "codePoints");
+		CheckRange(indices, indicesIndex, count, "indices");
+		if (count == 0)
+			return;
+
+		pin_ptr<int> pinnedPoints = &codePoints[codePointsIndex];
+		pin_ptr<short> pinnedIndices = &indices[indicesIndex];
+		RECORD_DW(Table()->GetGlyphIndices(reinterpret_cast<UINT32*>(pinnedPoints), count, reinterpret_cast<UINT16*>(pinnedIndices)));
+	}
+
+	void FontFaceCache::GetGlyphIndices(DataSpan<int> codePoints, DataSpan<short> indices)
+	{
+		// the table reads and writes straight through the pointers, bypassing the access checks of the spans
+		if (!codePoints.CanRead || !indices.CanWrite)
+			throw gcnew NotSupportedException();
+		if (indices.Count < codePoints.Count)
+			throw gcnew ArgumentException("The indices span is shorter than the code point span.", "indices");
+		if (codePoints.Count == 0)
+			return;
+
+		RECORD_DW(Table()->GetGlyphIndices(reinterpret_cast<UINT32*>(codePoints.DataPointer.ToPointer()), codePoints.Count,
+			reinterpret_cast<UINT16*>(indices.DataPointer.ToPointer())));
+	}
+
+	int FontFaceCache::GetGlyphIndices(String ^text, int textIndex, int length, array<short> ^indices, int indicesIndex)
+	{
+		if (text == nullptr)
+			throw gcnew ArgumentNullException("text");
+		if (textIndex < 0 || length < 0 || textIndex > text->Length - length)
+			throw gcnew ArgumentOutOfRangeException("textIndex");
+
+		// there is never more than one index per UTF-16 unit
+		CheckRange(indices, indicesIndex, length, "indices");
+		if (length == 0)
+			return 0;
+
+		pin_ptr<const wchar_t> pinnedText = PtrToStringChars(text);
+		pin_ptr<short> pinnedIndices = &indices[indicesIndex];
+
+		UINT32 count = 0;
+		if (RECORD_DW(Table()->GetGlyphIndices(pinnedText + textIndex, length, reinterpret_cast<UINT16*>(pinnedIndices), count)).IsFailure)
+			return 0;
+
+		return static_cast<int>(count);
+	}
+
+	GlyphMetrics FontFaceCache::GetDesignGlyphMetrics(short glyphIndex, bool isSideways)
+	{
+		UINT16 index = static_cast<UINT16>(glyphIndex);
+		GlyphMetrics metrics;
+		RECORD_DW(Table()->GetDesignGlyphMetrics(&index, 1, reinterpret_cast<DWRITE_GLYPH_METRICS*>(&metrics), isSideways));
+		return metrics;
+	}
+
+	void FontFaceCache::GetDesignGlyphMetrics(array<short> ^glyphIndices, int glyphIndicesIndex, array<GlyphMetrics> ^metrics, int metricsIndex, int count, bool isSideways)
+	{
+		CheckRange(glyphIndices, glyphIndicesIndex, count, "glyphIndices");
+		CheckRange(metrics, metricsIndex, count, "metrics");
+		if (count == 0)
+			return;
+
+		pin_ptr<short> pinnedIndices = &glyphIndices[glyphIndicesIndex];
+		pin_ptr<GlyphMetrics> pinnedMetrics = &metrics[metricsIndex];
+		RECORD_DW(Table()->GetDesignGlyphMetrics(reinterpret_cast<UINT16*>(pinnedIndices), count, reinterpret_cast<DWRITE_GLYPH_METRICS*>(pinnedMetrics), isSideways));
+	}
+
+	void FontFaceCache::GetDesignGlyphMetrics(DataSpan<short> glyphIndices, DataSpan<GlyphMetrics> metrics, bool isSideways)
+	{
+		if (!glyphIndices.CanRead || !metrics.CanWrite)
+			throw gcnew NotSupportedException();
+		if (metrics.Count < glyphIndices.Count)
+			throw gcnew ArgumentException("The metrics span is shorter than the glyph index span.", "metrics");
+		if (glyphIndices.Count == 0)
+			return;
+
+		RECORD_DW(Table()->GetDesignGlyphMetrics(reinterpret_cast<UINT16*>(glyphIndices.DataPointer.ToPointer()), glyphIndices.Count,
+			reinterpret_cast<DWRITE_GLYPH_METRICS*>(metrics.DataPointer.ToPointer()), isSideways));
+	}
+
+	void FontFaceCache::GetDesignAdvances(array<short> ^glyphIndices, int glyphIndicesIndex, array<int> ^advances, int advancesIndex, int count, bool isSideways)
+	{
+		CheckRange(glyphIndices, glyphIndicesIndex, count, "glyphIndices");
+		CheckRange(advances, advancesIndex, count, "advances");
+		if (count == 0)
+			return;
+
+		pin_ptr<short> pinnedIndices = &glyphIndices[glyphIndicesIndex];
+		pin_ptr<int> pinnedAdvances = &advances[advancesIndex];
+		RECORD_DW(Table()->GetDesignAdvances(reinterpret_cast<UINT16*>(pinnedIndices), count, reinterpret_cast<INT32*>(pinnedAdvances), isSideways));
+	}
+
+	void FontFaceCache::GetDesignAdvances(DataSpan<short> glyphIndices, DataSpan<int> advances, bool isSideways)
+	{
+		if (!glyphIndices.CanRead || !advances.CanWrite)
+			throw gcnew NotSupportedException();
+		if (advances.Count < glyphIndices.Count)
+			throw gcnew ArgumentException("The advances span is shorter than the glyph index span.", "advances");
+		if (glyphIndices.Count == 0)
+			return;
+
+		RECORD_DW(Table()->GetDesignAdvances(reinterpret_cast<UINT16*>(glyphIndices.DataPointer.ToPointer()), glyphIndices.Count,
+			reinterpret_cast<INT32*>(advances.DataPointer.ToPointer()), isSideways));
+	}
+}
+}
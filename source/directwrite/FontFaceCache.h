@@ -0,0 +1,106 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "../DataSpan.h"
+
+#include "GlyphMetrics.h"
+#include "GlyphTable.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class FontFace;
+
+		/// <summary>
+		/// Memoizes the glyph indices and design glyph metrics of a font face, so that repeated queries avoid the COM
+		/// call and the managed arrays of the <see cref="FontFace"/> methods.
+		/// </summary>
+		/// <remarks>
+		/// Code points in the basic multilingual plane are looked up in a dense table, others in a hash map; design metrics
+		/// are kept per glyph in flat arrays. Each batch method fetches everything it is missing with a single COM call
+		/// and writes into storage provided by the caller. GDI compatible metrics depend on size and transform, and are not
+		/// cached. The cache is not thread safe.
+		/// </remarks>
+		public ref class FontFaceCache sealed
+		{
+		private:
+			GlyphTable* m_Table;
+			DirectWrite::FontFace^ m_FontFace;
+
+			GlyphTable* Table();
+			void Destruct();
+
+		public:
+			FontFaceCache( DirectWrite::FontFace^ fontFace );
+			~FontFaceCache();
+			!FontFaceCache();
+
+			property DirectWrite::FontFace^ FontFace
+			{
+				DirectWrite::FontFace^ get();
+			}
+
+			property int GlyphCount
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the number of code points and glyphs looked up through the cache.
+			/// </summary>
+			property System::Int64 LookupCount
+			{
+				System::Int64 get();
+			}
+
+			/// <summary>
+			/// Gets the number of lookups that had to be fetched from the font face.
+			/// </summary>
+			property System::Int64 MissCount
+			{
+				System::Int64 get();
+			}
+
+			short GetGlyphIndex(int codePoint);
+			void GetGlyphIndices(array<int>^ codePoints, int codePointsIndex, array<short>^ indices, int indicesIndex, int count);
+			void GetGlyphIndices(DataSpan<int> codePoints, DataSpan<short> indices);
+
+			/// <summary>
+			/// Maps UTF-16 text to glyph indices, one per code point; surrogate pairs produce a single index.
+			/// </summary>
+			/// <returns>The number of indices written, which is the number of code points in the text.</returns>
+			int GetGlyphIndices(System::String^ text, int textIndex, int length, array<short>^ indices, int indicesIndex);
+
+			GlyphMetrics GetDesignGlyphMetrics(short glyphIndex, bool isSideways);
+			void GetDesignGlyphMetrics(array<short>^ glyphIndices, int glyphIndicesIndex, array<GlyphMetrics>^ metrics, int metricsIndex, int count, bool isSideways);
+			void GetDesignGlyphMetrics(DataSpan<short> glyphIndices, DataSpan<GlyphMetrics> metrics, bool isSideways);
+
+			/// <summary>
+			/// Gets the advance widths, or the advance heights for sideways text, of glyphs in design units.
+			/// </summary>
+			void GetDesignAdvances(array<short>^ glyphIndices, int glyphIndicesIndex, array<int>^ advances, int advancesIndex, int count, bool isSideways);
+			void GetDesignAdvances(DataSpan<short> glyphIndices, DataSpan<int> advances, bool isSideways);
+		};
+	}
+}
@@ -34,7 +34,34 @@ namespace DirectWrite
 	FontTable::FontTable(const void *data, int size, void *context)
 	{
 		this->data = gcnew DataStream(data, size, true, false);
+		this->pointer = static_cast<char*>(const_cast<void*>(data));
+		this->size = size;
 		Context = IntPtr(context);
 	}
+
+	void FontTable::Invalidate()
+	{
+		// the stream wraps the font's memory, so it goes with the table
+		delete data;
+		data = nullptr;
+		pointer = 0;
+		released = true;
+	}
+
+	DataStream^ FontTable::Data::get()
+	{
+		if (released)
+			throw gcnew ObjectDisposedException("FontTable");
+
+		return data;
+	}
+
+	DataSpan<Byte> FontTable::Span::get()
+	{
+		if (released)
+			throw gcnew ObjectDisposedException("FontTable");
+
+		return DataSpan<Byte>(pointer, size, true, false);
+	}
 }
 }
@@ -21,6 +21,8 @@
 */
 #pragma once
 
+#include "../DataSpan.h"
+
 namespace SlimDX
 {
 	ref class DataStream;
@@ -31,15 +33,44 @@ namespace SlimDX
 		{
 		private:
 			DataStream^ data;
+			char *pointer;
+			int size;
+			bool released;
 
 		internal:
 			System::IntPtr Context;
 			FontTable(const void *data, int size, void *context);
+			void Invalidate();
 
 		public:
 			property DataStream^ Data
 			{
-				DataStream^ get() { return data; }
+				DataStream^ get();
+			}
+
+			/// <summary>
+			/// Gets a read-only view of the table data, which stays in place in the font until the table is released
+			/// with <see cref="FontFace::ReleaseFontTable"/>.
+			/// </summary>
+			property DataSpan<System::Byte> Span
+			{
+				DataSpan<System::Byte> get();
+			}
+
+			/// <summary>
+			/// Gets the size of the table, in bytes.
+			/// </summary>
+			property int Size
+			{
+				int get() { return size; }
+			}
+
+			/// <summary>
+			/// Gets a value indicating whether the table has been released, after which its data must not be read.
+			/// </summary>
+			property bool IsReleased
+			{
+				bool get() { return released; }
 			}
 		};
 	}
@@ -0,0 +1,141 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "FontFace.h"
+#include "FontTableCache.h"
+#include "RangeCheck.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	FontTableCache::FontTableCache(DirectWrite::FontFace ^fontFace)
+	{
+		if (fontFace == nullptr)
+			throw gcnew ArgumentNullException("fontFace");
+
+		// Manual Allocation: released in Destruct
+		m_Tables = new OpenTypeTables(fontFace->InternalPointer);
+		m_FontFace = fontFace;
+	}
+
+	FontTableCache::~FontTableCache()
+	{
+		Destruct();
+		GC::SuppressFinalize(this);
+	}
+
+	FontTableCache::!FontTableCache()
+	{
+		Destruct();
+	}
+
+	void FontTableCache::Destruct()
+	{
+		delete m_Tables;
+		m_Tables = 0;
+	}
+
+	OpenTypeTables *FontTableCache::Tables()
+	{
+		if (m_Tables == 0)
+			throw gcnew ObjectDisposedException("FontTableCache");
+
+		return m_Tables;
+	}
+
+	DirectWrite::FontFace ^FontTableCache::FontFace::get()
+	{
+		return m_FontFace;
+	}
+
+	bool FontTableCache::HasCharacterMap::get()
+	{
+		return Tables()->HasCharacterMap();
+	}
+
+	bool FontTableCache::HasHorizontalMetrics::get()
+	{
+		return Tables()->HasHorizontalMetrics();
+	}
+
+	bool FontTableCache::HasKerning::get()
+	{
+		return Tables()->HasKerning();
+	}
+
+	short FontTableCache::GetGlyphIndex(int codePoint)
+	{
+		return static_cast<short>(Tables()->GetGlyphIndex(static_cast<UINT32>(codePoint)));
+	}
+
+	void FontTableCache::GetGlyphIndices(array<int> ^codePoints, int codePointsIndex, array<short> ^indices, int indicesIndex, int count)
+	{
+		CheckRange(codePoints, codePointsIndex, count, "codePoints");
+		CheckRange(indices, indicesIndex, count, "indices");
+
+		OpenTypeTables *tables = Tables();
+		for (int i = 0; i < count; i++)
+			indices[indicesIndex + i] = static_cast<short>(tables->GetGlyphIndex(static_cast<UINT32>(codePoints[codePointsIndex + i])));
+	}
+
+	int FontTableCache::GetAdvanceWidth(short glyphIndex)
+	{
+		UINT16 advance = 0;
+		INT16 bearing = 0;
+		Tables()->GetHorizontalMetrics(static_cast<UINT16>(glyphIndex), advance, bearing);
+		return advance;
+	}
+
+	int FontTableCache::GetLeftSideBearing(short glyphIndex)
+	{
+		UINT16 advance = 0;
+		INT16 bearing = 0;
+		Tables()->GetHorizontalMetrics(static_cast<UINT16>(glyphIndex), advance, bearing);
+		return bearing;
+	}
+
+	int FontTableCache::GetKerning(short left, short right)
+	{
+		return Tables()->GetKerning(static_cast<UINT16>(left), static_cast<UINT16>(right));
+	}
+
+	void FontTableCache::GetKerning(array<short> ^glyphIndices, int glyphIndicesIndex, array<int> ^adjustments, int adjustmentsIndex, int count)
+	{
+		CheckRange(glyphIndices, glyphIndicesIndex, count, "glyphIndices");
+		CheckRange(adjustments, adjustmentsIndex, count, "adjustments");
+
+		OpenTypeTables *tables = Tables();
+		for (int i = 0; i + 1 < count; i++)
+		{
+			adjustments[adjustmentsIndex + i] = tables->GetKerning(static_cast<UINT16>(glyphIndices[glyphIndicesIndex + i]),
+				static_cast<UINT16>(glyphIndices[glyphIndicesIndex + i + 1]));
+		}
+
+		if (count > 0)
+			adjustments[adjustmentsIndex + count - 1] = 0;
+	}
+}
+}
@@ -0,0 +1,105 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "OpenTypeTables.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class FontFace;
+
+		/// <summary>
+		/// Parsed, read-only views of the cmap, hmtx, kern and GPOS tables of a font face, for custom glyph lookup and
+		/// kerning without going through a TextAnalyzer.
+		/// </summary>
+		/// <remarks>
+		/// The tables are acquired once and held until the cache is disposed. Only their headers are parsed up front;
+		/// lookups binary search the font data in place and never allocate. Character maps in format 4 and 12 are
+		/// supported. Kerning comes from the pair adjustments of the GPOS 'kern' feature when the font has them, and
+		/// from the kern table otherwise. All values are in design units. Lookups may run on several threads at once.
+		/// </remarks>
+		public ref class FontTableCache sealed
+		{
+		private:
+			OpenTypeTables* m_Tables;
+			DirectWrite::FontFace^ m_FontFace;
+
+			OpenTypeTables* Tables();
+			void Destruct();
+
+		public:
+			FontTableCache(DirectWrite::FontFace^ fontFace);
+			~FontTableCache();
+			!FontTableCache();
+
+			property DirectWrite::FontFace^ FontFace
+			{
+				DirectWrite::FontFace^ get();
+			}
+
+			/// <summary>
+			/// Gets a value indicating whether the font has a Unicode character map in a supported format.
+			/// </summary>
+			property bool HasCharacterMap
+			{
+				bool get();
+			}
+
+			property bool HasHorizontalMetrics
+			{
+				bool get();
+			}
+
+			/// <summary>
+			/// Gets a value indicating whether the font has GPOS pair adjustments or kern table pairs.
+			/// </summary>
+			property bool HasKerning
+			{
+				bool get();
+			}
+
+			/// <summary>
+			/// Maps a code point to a glyph index through the character map; returns 0 for unmapped code points.
+			/// </summary>
+			short GetGlyphIndex(int codePoint);
+			void GetGlyphIndices(array<int>^ codePoints, int codePointsIndex, array<short>^ indices, int indicesIndex, int count);
+
+			/// <summary>
+			/// Gets the advance width of a glyph from the hmtx table, or 0 if the glyph has no metrics.
+			/// </summary>
+			int GetAdvanceWidth(short glyphIndex);
+			int GetLeftSideBearing(short glyphIndex);
+
+			/// <summary>
+			/// Gets the adjustment to the advance of the left glyph when it is followed by the right glyph.
+			/// </summary>
+			int GetKerning(short left, short right);
+
+			/// <summary>
+			/// Gets the kerning of each adjacent pair in a glyph run; the adjustment of the last glyph is 0.
+			/// </summary>
+			void GetKerning(array<short>^ glyphIndices, int glyphIndicesIndex, array<int>^ adjustments, int adjustmentsIndex, int count);
+		};
+	}
+}
@@ -0,0 +1,211 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "GlyphRunDW.h"
+#include "GlyphRunDescription.h"
+#include "GlyphRunView.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	GlyphRunView::GlyphRunView(const DWRITE_GLYPH_RUN *run, const DWRITE_GLYPH_RUN_DESCRIPTION *description, DirectWrite::FontFace ^fontFace)
+		: m_Run(run), m_Description(description), m_FontFace(fontFace)
+	{
+	}
+
+	static const DWRITE_GLYPH_RUN *CheckRun(const DWRITE_GLYPH_RUN *run)
+	{
+		if (run == NULL)
+			throw gcnew InvalidOperationException("The glyph run view is empty.");
+
+		return run;
+	}
+
+	static int CheckIndex(const DWRITE_GLYPH_RUN *run, int index)
+	{
+		if (index < 0 || index >= static_cast<int>(CheckRun(run)->glyphCount))
+			throw gcnew ArgumentOutOfRangeException("index");
+
+		return index;
+	}
+
+	static const DWRITE_GLYPH_RUN_DESCRIPTION *CheckDescription(const DWRITE_GLYPH_RUN_DESCRIPTION *description)
+	{
+		if (description == NULL)
+			throw gcnew InvalidOperationException("The glyph run has no description.");
+
+		return description;
+	}
+
+	DirectWrite::FontFace^ GlyphRunView::FontFace::get()
+	{
+		return m_FontFace;
+	}
+
+	float GlyphRunView::FontSize::get()
+	{
+		return CheckRun(m_Run)->fontEmSize;
+	}
+
+	int GlyphRunView::GlyphCount::get()
+	{
+		return m_Run == NULL ? 0 : m_Run->glyphCount;
+	}
+
+	bool GlyphRunView::IsSideways::get()
+	{
+		return CheckRun(m_Run)->isSideways != 0;
+	}
+
+	int GlyphRunView::BidiLevel::get()
+	{
+		return CheckRun(m_Run)->bidiLevel;
+	}
+
+	IntPtr GlyphRunView::GlyphIndicesPointer::get()
+	{
+		return IntPtr(const_cast<UINT16*>(CheckRun(m_Run)->glyphIndices));
+	}
+
+	IntPtr GlyphRunView::GlyphAdvancesPointer::get()
+	{
+		return IntPtr(const_cast<FLOAT*>(CheckRun(m_Run)->glyphAdvances));
+	}
+
+	IntPtr GlyphRunView::GlyphOffsetsPointer::get()
+	{
+		return IntPtr(const_cast<DWRITE_GLYPH_OFFSET*>(CheckRun(m_Run)->glyphOffsets));
+	}
+
+	short GlyphRunView::GetGlyphIndex(int index)
+	{
+		return m_Run->glyphIndices[CheckIndex(m_Run, index)];
+	}
+
+	float GlyphRunView::GetGlyphAdvance(int index)
+	{
+		index = CheckIndex(m_Run, index);
+		return m_Run->glyphAdvances == NULL ? 0.0f : m_Run->glyphAdvances[index];
+	}
+
+	GlyphOffset GlyphRunView::GetGlyphOffset(int index)
+	{
+		index = CheckIndex(m_Run, index);
+
+		GlyphOffset result;
+		if (m_Run->glyphOffsets != NULL)
+		{
+			result.AdvanceOffset = m_Run->glyphOffsets[index].advanceOffset;
+			result.AscenderOffset = m_Run->glyphOffsets[index].ascenderOffset;
+		}
+
+		return result;
+	}
+
+	void GlyphRunView::CopyGlyphIndices(array<short> ^destination, int destinationIndex)
+	{
+		if (destination == nullptr)
+			throw gcnew ArgumentNullException("destination");
+
+		int count = GlyphCount;
+		if (destinationIndex < 0 || destinationIndex > destination->Length - count)
+			throw gcnew ArgumentOutOfRangeException("destinationIndex");
+
+		if (count > 0)
+		{
+			pin_ptr<short> pinned = &destination[destinationIndex];
+			memcpy(pinned, m_Run->glyphIndices, sizeof(UINT16) * count);
+		}
+	}
+
+	void GlyphRunView::CopyGlyphAdvances(array<float> ^destination, int destinationIndex)
+	{
+		if (destination == nullptr)
+			throw gcnew ArgumentNullException("destination");
+
+		int count = GlyphCount;
+		if (destinationIndex < 0 || destinationIndex > destination->Length - count)
+			throw gcnew ArgumentOutOfRangeException("destinationIndex");
+
+		if (count > 0)
+		{
+			pin_ptr<float> pinned = &destination[destinationIndex];
+			if (m_Run->glyphAdvances == NULL)
+				memset(pinned, 0, sizeof(FLOAT) * count);
+			else
+				memcpy(pinned, m_Run->glyphAdvances, sizeof(FLOAT) * count);
+		}
+	}
+
+	bool GlyphRunView::HasDescription::get()
+	{
+		return m_Description != NULL;
+	}
+
+	IntPtr GlyphRunView::TextPointer::get()
+	{
+		return IntPtr(const_cast<WCHAR*>(CheckDescription(m_Description)->string));
+	}
+
+	IntPtr GlyphRunView::LocaleNamePointer::get()
+	{
+		return IntPtr(const_cast<WCHAR*>(CheckDescription(m_Description)->localeName));
+	}
+
+	int GlyphRunView::StringLength::get()
+	{
+		return m_Description == NULL ? 0 : m_Description->stringLength;
+	}
+
+	int GlyphRunView::TextPosition::get()
+	{
+		return CheckDescription(m_Description)->textPosition;
+	}
+
+	IntPtr GlyphRunView::ClusterMapPointer::get()
+	{
+		return IntPtr(const_cast<UINT16*>(CheckDescription(m_Description)->clusterMap));
+	}
+
+	short GlyphRunView::GetClusterMapEntry(int index)
+	{
+		if (index < 0 || index >= StringLength)
+			throw gcnew ArgumentOutOfRangeException("index");
+
+		return m_Description->clusterMap[index];
+	}
+
+	GlyphRun^ GlyphRunView::ToGlyphRun()
+	{
+		return gcnew GlyphRun(*CheckRun(m_Run));
+	}
+
+	GlyphRunDescription^ GlyphRunView::ToGlyphRunDescription()
+	{
+		return gcnew GlyphRunDescription(*CheckDescription(m_Description));
+	}
+}
+}
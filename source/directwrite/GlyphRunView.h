@@ -0,0 +1,166 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "FontFace.h"
+#include "GlyphOffset.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class GlyphRun;
+		ref class GlyphRunDescription;
+
+		/// <summary>
+		/// A view of a native glyph run and its description, passed to an <see cref="ITextViewRenderer"/>.
+		/// </summary>
+		/// <remarks>
+		/// The view points directly at the memory DirectWrite passes to the renderer, so it is only valid for the duration
+		/// of the callback that receives it. Use <see cref="ToGlyphRun"/> to keep a copy.
+		/// </remarks>
+		public value class GlyphRunView
+		{
+		private:
+			const DWRITE_GLYPH_RUN *m_Run;
+			const DWRITE_GLYPH_RUN_DESCRIPTION *m_Description;
+			DirectWrite::FontFace ^m_FontFace;
+
+		internal:
+			GlyphRunView(const DWRITE_GLYPH_RUN *run, const DWRITE_GLYPH_RUN_DESCRIPTION *description, DirectWrite::FontFace ^fontFace);
+
+			property const DWRITE_GLYPH_RUN *NativeRun
+			{
+				const DWRITE_GLYPH_RUN *get() { return m_Run; }
+			}
+
+			property const DWRITE_GLYPH_RUN_DESCRIPTION *NativeDescription
+			{
+				const DWRITE_GLYPH_RUN_DESCRIPTION *get() { return m_Description; }
+			}
+
+		public:
+			property DirectWrite::FontFace^ FontFace
+			{
+				DirectWrite::FontFace^ get();
+			}
+
+			property float FontSize
+			{
+				float get();
+			}
+
+			property int GlyphCount
+			{
+				int get();
+			}
+
+			property bool IsSideways
+			{
+				bool get();
+			}
+
+			property int BidiLevel
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the 16-bit glyph indices of the run.
+			/// </summary>
+			property System::IntPtr GlyphIndicesPointer
+			{
+				System::IntPtr get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the glyph advances of the run, as 32-bit floats.
+			/// </summary>
+			property System::IntPtr GlyphAdvancesPointer
+			{
+				System::IntPtr get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the glyph offsets of the run, or <see cref="System::IntPtr::Zero"/> if the run has none.
+			/// </summary>
+			property System::IntPtr GlyphOffsetsPointer
+			{
+				System::IntPtr get();
+			}
+
+			short GetGlyphIndex(int index);
+			float GetGlyphAdvance(int index);
+			GlyphOffset GetGlyphOffset(int index);
+
+			void CopyGlyphIndices(array<short> ^destination, int destinationIndex);
+			void CopyGlyphAdvances(array<float> ^destination, int destinationIndex);
+
+			/// <summary>
+			/// Gets a value indicating whether the run has a description; runs drawn from a text layout always do.
+			/// </summary>
+			property bool HasDescription
+			{
+				bool get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the characters of the run, which are not null terminated.
+			/// </summary>
+			property System::IntPtr TextPointer
+			{
+				System::IntPtr get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the null terminated locale name of the run.
+			/// </summary>
+			property System::IntPtr LocaleNamePointer
+			{
+				System::IntPtr get();
+			}
+
+			property int StringLength
+			{
+				int get();
+			}
+
+			property int TextPosition
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the cluster map of the run, one 16-bit glyph index per character.
+			/// </summary>
+			property System::IntPtr ClusterMapPointer
+			{
+				System::IntPtr get();
+			}
+
+			short GetClusterMapEntry(int index);
+
+			GlyphRun^ ToGlyphRun();
+			GlyphRunDescription^ ToGlyphRunDescription();
+		};
+	}
+}
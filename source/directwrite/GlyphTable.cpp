@@ -0,0 +1,206 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+#pragma managed(push, off)
+
+#include "GlyphTable.h"
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	namespace
+	{
+		// no glyph has this index, since a face holds at most 65535 glyphs
+		const UINT16 Unknown = 0xffff;
+	}
+
+	GlyphTable::GlyphTable( IDWriteFontFace* face )
+	: m_Face( face ), m_GlyphCount( face->GetGlyphCount() ), m_Lookups( 0 ), m_Misses( 0 )
+	{
+		m_Face->AddRef();
+	}
+
+	GlyphTable::~GlyphTable()
+	{
+		m_Face->Release();
+	}
+
+	HRESULT GlyphTable::GetGlyphIndices( const UINT32* codePoints, UINT32 count, UINT16* indices )
+	{
+		m_MissedCodePoints.clear();
+		m_Lookups += count;
+
+		for( UINT32 i = 0; i < count; i++ )
+		{
+			UINT32 codePoint = codePoints[i];
+			UINT16 index = Unknown;
+			if( codePoint < 0x10000 )
+			{
+				if( !m_Plane0.empty() )
+					index = m_Plane0[codePoint];
+			}
+			else
+			{
+				std::unordered_map<UINT32, UINT16>::const_iterator found = m_Supplementary.find( codePoint );
+				if( found != m_Supplementary.end() )
+					index = found->second;
+			}
+
+			indices[i] = index;
+			if( index == Unknown )
+				m_MissedCodePoints.push_back( codePoint );
+		}
+
+		if( m_MissedCodePoints.empty() )
+			return S_OK;
+
+		UINT32 missed = static_cast<UINT32>( m_MissedCodePoints.size() );
+		m_Misses += missed;
+		m_MissedIndices.resize( missed );
+
+		HRESULT hr = m_Face->GetGlyphIndices( &m_MissedCodePoints[0], missed, &m_MissedIndices[0] );
+		if( FAILED( hr ) )
+			return hr;
+
+		// the dense table is only worth its 128 KB once a face is actually queried
+		if( m_Plane0.empty() )
+			m_Plane0.assign( 0x10000, Unknown );
+
+		for( UINT32 i = 0; i < missed; i++ )
+		{
+			UINT32 codePoint = m_MissedCodePoints[i];
+			if( codePoint < 0x10000 )
+				m_Plane0[codePoint] = m_MissedIndices[i];
+			else
+				m_Supplementary[codePoint] = m_MissedIndices[i];
+		}
+
+		for( UINT32 i = 0, next = 0; i < count; i++ )
+		{
+			if( indices[i] == Unknown )
+				indices[i] = m_MissedIndices[next++];
+		}
+
+		return S_OK;
+	}
+
+	HRESULT GlyphTable::GetGlyphIndices( const WCHAR* text, UINT32 length, UINT16* indices, UINT32& count )
+	{
+		m_Decoded.resize( length > 0 ? length : 1 );
+
+		count = 0;
+		for( UINT32 i = 0; i < length; i++ )
+		{
+			UINT32 unit = text[i];
+			if( unit >= 0xd800 && unit < 0xdc00 && i + 1 < length && text[i + 1] >= 0xdc00 && text[i + 1] < 0xe000 )
+			{
+				unit = 0x10000 + ( ( unit - 0xd800 ) << 10 ) + ( text[i + 1] - 0xdc00 );
+				i++;
+			}
+
+			m_Decoded[count++] = unit;
+		}
+
+		return GetGlyphIndices( &m_Decoded[0], count, indices );
+	}
+
+	HRESULT GlyphTable::FetchMetrics( const UINT16* glyphs, UINT32 count, bool isSideways )
+	{
+		std::vector<DWRITE_GLYPH_METRICS>& metrics = m_Metrics[isSideways];
+		std::vector<bool>& hasMetrics = m_HasMetrics[isSideways];
+		if( metrics.empty() )
+		{
+			metrics.resize( m_GlyphCount );
+			hasMetrics.assign( m_GlyphCount, false );
+		}
+
+		for( UINT32 i = 0; i < count; i++ )
+		{
+			if( glyphs[i] >= m_GlyphCount )
+				return E_INVALIDARG;
+		}
+
+		m_MissedGlyphs.clear();
+		m_Lookups += count;
+		for( UINT32 i = 0; i < count; i++ )
+		{
+			UINT16 glyph = glyphs[i];
+			if( !hasMetrics[glyph] )
+			{
+				// mark it now so that a glyph repeated in one batch is only fetched once
+				hasMetrics[glyph] = true;
+				m_MissedGlyphs.push_back( glyph );
+			}
+		}
+
+		if( m_MissedGlyphs.empty() )
+			return S_OK;
+
+		UINT32 missed = static_cast<UINT32>( m_MissedGlyphs.size() );
+		m_Misses += missed;
+
+		m_MissedMetrics.resize( missed );
+		HRESULT hr = m_Face->GetDesignGlyphMetrics( &m_MissedGlyphs[0], missed, &m_MissedMetrics[0], isSideways ? TRUE : FALSE );
+		if( FAILED( hr ) )
+		{
+			for( UINT32 i = 0; i < missed; i++ )
+				hasMetrics[m_MissedGlyphs[i]] = false;
+
+			return hr;
+		}
+
+		for( UINT32 i = 0; i < missed; i++ )
+			metrics[m_MissedGlyphs[i]] = m_MissedMetrics[i];
+
+		return S_OK;
+	}
+
+	HRESULT GlyphTable::GetDesignGlyphMetrics( const UINT16* glyphs, UINT32 count, DWRITE_GLYPH_METRICS* metrics, bool isSideways )
+	{
+		HRESULT hr = FetchMetrics( glyphs, count, isSideways );
+		if( FAILED( hr ) )
+			return hr;
+
+		const std::vector<DWRITE_GLYPH_METRICS>& table = m_Metrics[isSideways];
+		for( UINT32 i = 0; i < count; i++ )
+			metrics[i] = table[glyphs[i]];
+
+		return S_OK;
+	}
+
+	HRESULT GlyphTable::GetDesignAdvances( const UINT16* glyphs, UINT32 count, INT32* advances, bool isSideways )
+	{
+		HRESULT hr = FetchMetrics( glyphs, count, isSideways );
+		if( FAILED( hr ) )
+			return hr;
+
+		const std::vector<DWRITE_GLYPH_METRICS>& table = m_Metrics[isSideways];
+		for( UINT32 i = 0; i < count; i++ )
+			advances[i] = isSideways ? table[glyphs[i]].advanceHeight : table[glyphs[i]].advanceWidth;
+
+		return S_OK;
+	}
+}
+}
+
+#pragma managed(pop)
@@ -0,0 +1,80 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	// Memoizes the code point to glyph index mapping and the design metrics of one font face. Code points in the
+	// basic multilingual plane live in a dense table, the rest in a hash map; metrics are kept in flat arrays indexed
+	// by glyph. Every batch call resolves what it can from the tables and fetches the rest with a single COM call.
+	// Not thread safe.
+	class GlyphTable
+	{
+	public:
+		explicit GlyphTable( IDWriteFontFace* face );
+		~GlyphTable();
+
+		HRESULT GetGlyphIndices( const UINT32* codePoints, UINT32 count, UINT16* indices );
+
+		// Decodes UTF-16 text, pairing surrogates, and writes one glyph index per code point; count receives the number written.
+		HRESULT GetGlyphIndices( const WCHAR* text, UINT32 length, UINT16* indices, UINT32& count );
+
+		HRESULT GetDesignGlyphMetrics( const UINT16* glyphs, UINT32 count, DWRITE_GLYPH_METRICS* metrics, bool isSideways );
+		HRESULT GetDesignAdvances( const UINT16* glyphs, UINT32 count, INT32* advances, bool isSideways );
+
+		IDWriteFontFace* GetFace() const { return m_Face; }
+		UINT32 GetGlyphCount() const { return m_GlyphCount; }
+		int64_t GetLookups() const { return m_Lookups; }
+		int64_t GetMisses() const { return m_Misses; }
+
+	private:
+		GlyphTable( const GlyphTable& );
+		GlyphTable& operator = ( const GlyphTable& );
+
+		HRESULT FetchMetrics( const UINT16* glyphs, UINT32 count, bool isSideways );
+
+		IDWriteFontFace* m_Face;
+		UINT32 m_GlyphCount;
+
+		std::vector<UINT16> m_Plane0;
+		std::unordered_map<UINT32, UINT16> m_Supplementary;
+
+		std::vector<DWRITE_GLYPH_METRICS> m_Metrics[2];
+		std::vector<bool> m_HasMetrics[2];
+
+		// reused between calls so that lookups which miss do not allocate
+		std::vector<UINT32> m_MissedCodePoints;
+		std::vector<UINT16> m_MissedIndices;
+		std::vector<UINT16> m_MissedGlyphs;
+		std::vector<DWRITE_GLYPH_METRICS> m_MissedMetrics;
+		std::vector<UINT32> m_Decoded;
+
+		int64_t m_Lookups;
+		int64_t m_Misses;
+	};
+}
+}
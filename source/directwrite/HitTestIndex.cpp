@@ -0,0 +1,137 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "DirectWriteException.h"
+#include "HitTestIndex.h"
+#include "TextLayout.h"
+
+using namespace System;
+using namespace System::Runtime::InteropServices;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	HitTestIndex::HitTestIndex(TextLayout ^layout)
+	{
+		if (layout == nullptr)
+			throw gcnew ArgumentNullException("layout");
+
+		// Manual Allocation: released in Destruct
+		m_Table = new HitTestTable(layout->InternalPointer);
+		m_Layout = layout;
+
+		if (RECORD_DW(m_Table->Build()).IsFailure)
+		{
+			Destruct();
+			throw gcnew DirectWriteException(Result::Last);
+		}
+	}
+
+	HitTestIndex::~HitTestIndex()
+	{
+		Destruct();
+		GC::SuppressFinalize(this);
+	}
+
+	HitTestIndex::!HitTestIndex()
+	{
+		Destruct();
+	}
+
+	void HitTestIndex::Destruct()
+	{
+		delete m_Table;
+		m_Table = 0;
+	}
+
+	HitTestTable *HitTestIndex::Table()
+	{
+		if (m_Table == 0)
+			throw gcnew ObjectDisposedException("HitTestIndex");
+
+		return m_Table;
+	}
+
+	Result HitTestIndex::Update(TextRange range)
+	{
+		if (range.StartPosition < 0)
+			throw gcnew ArgumentOutOfRangeException("range");
+
+		return RECORD_DW(Table()->Update(range.StartPosition));
+	}
+
+	Result HitTestIndex::Rebuild()
+	{
+		return RECORD_DW(Table()->Build());
+	}
+
+	HitTestMetrics HitTestIndex::HitTestPoint(float pointX, float pointY, [Out] bool% isTrailingHit, [Out] bool% isInside)
+	{
+		DWRITE_HIT_TEST_METRICS htm;
+		BOOL trailingHit;
+		BOOL inside;
+
+		if (RECORD_DW(Table()->HitTestPoint(pointX, pointY, &trailingHit, &inside, &htm)).IsFailure)
+			return HitTestMetrics();
+
+		isTrailingHit = trailingHit == TRUE;
+		isInside = inside == TRUE;
+		return HitTestMetrics(htm.textPosition, htm.length, htm.left, htm.top, htm.width, htm.height,
+			htm.bidiLevel, htm.isText == TRUE, htm.isTrimmed == TRUE);
+	}
+
+	HitTestMetrics HitTestIndex::HitTestTextPosition(int textPosition, bool isTrailingHit, [Out] float% pointX, [Out] float% pointY)
+	{
+		if (textPosition < 0)
+			throw gcnew ArgumentOutOfRangeException("textPosition");
+
+		DWRITE_HIT_TEST_METRICS htm;
+		FLOAT x;
+		FLOAT y;
+
+		if (RECORD_DW(Table()->HitTestTextPosition(textPosition, isTrailingHit, &x, &y, &htm)).IsFailure)
+			return HitTestMetrics();
+
+		pointX = x;
+		pointY = y;
+		return HitTestMetrics(htm.textPosition, htm.length, htm.left, htm.top, htm.width, htm.height,
+			htm.bidiLevel, htm.isText == TRUE, htm.isTrimmed == TRUE);
+	}
+
+	TextLayout ^HitTestIndex::Layout::get()
+	{
+		return m_Layout;
+	}
+
+	int HitTestIndex::LineCount::get()
+	{
+		return static_cast<int>(Table()->GetLineCount());
+	}
+
+	int HitTestIndex::ClusterCount::get()
+	{
+		return static_cast<int>(Table()->GetClusterCount());
+	}
+}
+}
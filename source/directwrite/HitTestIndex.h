@@ -0,0 +1,90 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "HitTestMetrics.h"
+#include "HitTestTable.h"
+#include "TextRange.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class TextLayout;
+
+		/// <summary>
+		/// Answers hit tests on a text layout in logarithmic time, without calling into DirectWrite or allocating.
+		/// </summary>
+		/// <remarks>
+		/// The index keeps the line and cluster metrics of the layout with prefix sums of the line heights and of the cluster
+		/// widths within each line. Lines containing right-to-left or trimmed text are passed on to the layout. After the
+		/// formatting of a range of the layout changes, call <see cref="Update"/> with that range; after changes that affect
+		/// the whole layout, such as its maximum width, call <see cref="Rebuild"/>. The index is not thread safe.
+		/// </remarks>
+		public ref class HitTestIndex sealed
+		{
+		private:
+			HitTestTable* m_Table;
+			TextLayout^ m_Layout;
+
+			HitTestTable* Table();
+			void Destruct();
+
+		public:
+			HitTestIndex( TextLayout^ layout );
+			~HitTestIndex();
+			!HitTestIndex();
+
+			/// <summary>
+			/// Refreshes the index after the formatting of a range of the layout changed.
+			/// </summary>
+			/// <remarks>
+			/// Lines before the one preceding the range, and the lines at the end of the layout, are kept when their metrics are
+			/// unchanged. Only the lines in between are recomputed; the lines after them are moved to their new positions.
+			/// </remarks>
+			Result Update( TextRange range );
+
+			/// <summary>
+			/// Recomputes the whole index from the layout.
+			/// </summary>
+			Result Rebuild();
+
+			HitTestMetrics HitTestPoint( float pointX, float pointY, [System::Runtime::InteropServices::Out] bool% isTrailingHit, [System::Runtime::InteropServices::Out] bool% isInside );
+			HitTestMetrics HitTestTextPosition( int textPosition, bool isTrailingHit, [System::Runtime::InteropServices::Out] float% pointX, [System::Runtime::InteropServices::Out] float% pointY );
+
+			property TextLayout^ Layout
+			{
+				TextLayout^ get();
+			}
+
+			property int LineCount
+			{
+				int get();
+			}
+
+			property int ClusterCount
+			{
+				int get();
+			}
+		};
+	}
+}
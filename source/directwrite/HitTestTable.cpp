@@ -0,0 +1,389 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+#pragma managed(push, off)
+
+#include <algorithm>
+
+#include "HitTestTable.h"
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	HitTestTable::HitTestTable( IDWriteTextLayout* layout )
+	: m_Layout( layout ), m_TextLength( 0 ), m_Top( 0 )
+	{
+		m_Layout->AddRef();
+	}
+
+	HitTestTable::~HitTestTable()
+	{
+		m_Layout->Release();
+	}
+
+	HRESULT HitTestTable::Build()
+	{
+		HRESULT hr = Fetch();
+		if( FAILED( hr ) )
+			return hr;
+
+		m_Lines.clear();
+		m_LineTops.clear();
+		m_ClusterPositions.clear();
+		m_ClusterOffsets.clear();
+		m_TextLength = 0;
+		m_Clusters.swap( m_ClusterMetrics );
+
+		return Splice( 0, 0, static_cast<UINT32>( m_LineMetrics.size() ) );
+	}
+
+	HRESULT HitTestTable::Update( UINT32 textPosition )
+	{
+		if( m_Lines.empty() )
+			return Build();
+
+		// a change can pull text back into the line before the one it starts in
+		UINT32 line = FindLine( textPosition );
+		UINT32 keep = line > 0 ? line - 1 : 0;
+
+		// DirectWrite only hands out the metrics of the whole layout; they are copied out of it without laying out again
+		HRESULT hr = Fetch();
+		if( FAILED( hr ) )
+			return hr;
+
+		// only lines whose metrics, and whose clusters, are unchanged are kept
+		UINT32 oldLineCount = static_cast<UINT32>( m_Lines.size() );
+		UINT32 newLineCount = static_cast<UINT32>( m_LineMetrics.size() );
+		keep = std::min( keep, newLineCount );
+		UINT32 kept = 0;
+		for( ; kept < keep; kept++ )
+		{
+			const Line& cached = m_Lines[kept];
+			const DWRITE_LINE_METRICS& metrics = m_LineMetrics[kept];
+			UINT32 clusterEnd = cached.FirstCluster + cached.ClusterCount;
+
+			if( metrics.length != cached.Length || metrics.height != cached.Height || metrics.isTrimmed ||
+				clusterEnd > m_ClusterMetrics.size() || ( cached.ClusterCount > 0 &&
+				memcmp( &m_Clusters[cached.FirstCluster], &m_ClusterMetrics[cached.FirstCluster], cached.ClusterCount * sizeof( DWRITE_CLUSTER_METRICS ) ) != 0 ) )
+				break;
+		}
+
+		// the same goes for the lines after the change, matched from the end of the text
+		UINT32 prefixClusters = kept > 0 ? m_Lines[kept - 1].FirstCluster + m_Lines[kept - 1].ClusterCount : 0;
+		UINT32 oldClusterCount = static_cast<UINT32>( m_Clusters.size() );
+		UINT32 newClusterCount = static_cast<UINT32>( m_ClusterMetrics.size() );
+		UINT32 tail = 0;
+		for( ; kept + tail < oldLineCount && kept + tail < newLineCount; tail++ )
+		{
+			const Line& cached = m_Lines[oldLineCount - 1 - tail];
+			const DWRITE_LINE_METRICS& metrics = m_LineMetrics[newLineCount - 1 - tail];
+			UINT32 fromEnd = oldClusterCount - cached.FirstCluster;
+
+			if( metrics.length != cached.Length || metrics.height != cached.Height || metrics.isTrimmed ||
+				fromEnd > newClusterCount - prefixClusters || ( cached.ClusterCount > 0 &&
+				memcmp( &m_Clusters[cached.FirstCluster], &m_ClusterMetrics[newClusterCount - fromEnd], cached.ClusterCount * sizeof( DWRITE_CLUSTER_METRICS ) ) != 0 ) )
+				break;
+		}
+
+		m_Clusters.swap( m_ClusterMetrics );
+		return Splice( kept, oldLineCount - kept - tail, newLineCount - kept - tail );
+	}
+
+	HRESULT HitTestTable::Fetch()
+	{
+		UINT32 count = 0;
+		HRESULT hr = m_Layout->GetLineMetrics( NULL, 0, &count );
+		if( FAILED( hr ) && hr != HRESULT_FROM_WIN32( ERROR_INSUFFICIENT_BUFFER ) )
+			return hr;
+
+		m_LineMetrics.resize( count );
+		if( count > 0 )
+		{
+			hr = m_Layout->GetLineMetrics( &m_LineMetrics[0], count, &count );
+			if( FAILED( hr ) )
+				return hr;
+		}
+
+		count = 0;
+		hr = m_Layout->GetClusterMetrics( NULL, 0, &count );
+		if( FAILED( hr ) && hr != HRESULT_FROM_WIN32( ERROR_INSUFFICIENT_BUFFER ) )
+			return hr;
+
+		m_ClusterMetrics.resize( count );
+		if( count > 0 )
+		{
+			hr = m_Layout->GetClusterMetrics( &m_ClusterMetrics[0], count, &count );
+			if( FAILED( hr ) )
+				return hr;
+		}
+
+		return S_OK;
+	}
+
+	HRESULT HitTestTable::Splice( UINT32 firstLine, UINT32 removedLines, UINT32 addedLines )
+	{
+		UINT32 cluster = 0;
+		UINT32 position = 0;
+		FLOAT top = m_Top;
+		if( firstLine > 0 )
+		{
+			const Line& previous = m_Lines[firstLine - 1];
+			cluster = previous.FirstCluster + previous.ClusterCount;
+			position = previous.TextPosition + previous.Length;
+			top = m_LineTops[firstLine - 1] + previous.Height;
+		}
+
+		// where the lines that follow the replaced ones used to start
+		UINT32 oldEnd = firstLine + removedLines;
+		UINT32 oldClusterEnd = static_cast<UINT32>( m_ClusterPositions.size() );
+		UINT32 oldPositionEnd = m_TextLength;
+		FLOAT oldTopEnd = top;
+		if( oldEnd < m_Lines.size() )
+		{
+			oldClusterEnd = m_Lines[oldEnd].FirstCluster;
+			oldPositionEnd = m_Lines[oldEnd].TextPosition;
+			oldTopEnd = m_LineTops[oldEnd];
+		}
+		else if( oldEnd > 0 )
+		{
+			oldTopEnd = m_LineTops[oldEnd - 1] + m_Lines[oldEnd - 1].Height;
+		}
+
+		UINT32 firstCluster = cluster;
+		std::vector<Line> lines;
+		std::vector<FLOAT> tops;
+		std::vector<UINT32> positions;
+		std::vector<FLOAT> offsets;
+		lines.reserve( addedLines );
+		tops.reserve( addedLines );
+
+		UINT32 clusterCount = static_cast<UINT32>( m_Clusters.size() );
+		for( UINT32 i = firstLine; i < firstLine + addedLines; i++ )
+		{
+			const DWRITE_LINE_METRICS& metrics = m_LineMetrics[i];
+
+			Line line;
+			line.TextPosition = position;
+			line.Length = metrics.length;
+			line.FirstCluster = cluster;
+			line.Height = metrics.height;
+			line.IsSimple = !metrics.isTrimmed;
+
+			UINT32 end = position + metrics.length;
+			FLOAT offset = 0;
+			while( cluster < clusterCount && position < end )
+			{
+				const DWRITE_CLUSTER_METRICS& clusterMetrics = m_Clusters[cluster];
+				if( clusterMetrics.isRightToLeft )
+					line.IsSimple = false;
+
+				positions.push_back( position );
+				offsets.push_back( offset );
+				offset += clusterMetrics.width;
+				position += clusterMetrics.length;
+				cluster++;
+			}
+
+			line.ClusterCount = cluster - line.FirstCluster;
+
+			// the metrics do not report where alignment puts the line, so ask the layout once per new line
+			DWRITE_HIT_TEST_METRICS hit;
+			FLOAT x;
+			FLOAT y;
+			HRESULT hr = m_Layout->HitTestTextPosition( line.TextPosition, FALSE, &x, &y, &hit );
+			if( FAILED( hr ) )
+			{
+				m_Lines.clear();
+				m_LineTops.clear();
+				m_ClusterPositions.clear();
+				m_ClusterOffsets.clear();
+				return hr;
+			}
+
+			if( i == 0 )
+			{
+				m_Top = y;
+				top = y;
+			}
+
+			line.Left = x;
+			line.BidiLevel = hit.bidiLevel;
+
+			lines.push_back( line );
+			tops.push_back( top );
+			top += line.Height;
+		}
+
+		m_Lines.erase( m_Lines.begin() + firstLine, m_Lines.begin() + oldEnd );
+		m_Lines.insert( m_Lines.begin() + firstLine, lines.begin(), lines.end() );
+		m_LineTops.erase( m_LineTops.begin() + firstLine, m_LineTops.begin() + oldEnd );
+		m_LineTops.insert( m_LineTops.begin() + firstLine, tops.begin(), tops.end() );
+		m_ClusterPositions.erase( m_ClusterPositions.begin() + firstCluster, m_ClusterPositions.begin() + oldClusterEnd );
+		m_ClusterPositions.insert( m_ClusterPositions.begin() + firstCluster, positions.begin(), positions.end() );
+		m_ClusterOffsets.erase( m_ClusterOffsets.begin() + firstCluster, m_ClusterOffsets.begin() + oldClusterEnd );
+		m_ClusterOffsets.insert( m_ClusterOffsets.begin() + firstCluster, offsets.begin(), offsets.end() );
+
+		// the lines after the new ones keep their clusters and offsets, and only move; unsigned wraparound makes the deltas signed
+		UINT32 positionDelta = position - oldPositionEnd;
+		UINT32 clusterDelta = cluster - oldClusterEnd;
+		FLOAT topDelta = top - oldTopEnd;
+		for( size_t i = firstLine + addedLines; i < m_Lines.size(); i++ )
+		{
+			m_Lines[i].TextPosition += positionDelta;
+			m_Lines[i].FirstCluster += clusterDelta;
+			m_LineTops[i] += topDelta;
+		}
+
+		for( size_t i = cluster; i < m_ClusterPositions.size(); i++ )
+			m_ClusterPositions[i] += positionDelta;
+
+		m_TextLength += positionDelta;
+		return S_OK;
+	}
+
+	UINT32 HitTestTable::FindLine( UINT32 textPosition ) const
+	{
+		UINT32 low = 0;
+		UINT32 high = static_cast<UINT32>( m_Lines.size() );
+		while( low < high )
+		{
+			UINT32 middle = ( low + high ) / 2;
+			if( textPosition < m_Lines[middle].TextPosition )
+				high = middle;
+			else
+				low = middle + 1;
+		}
+
+		return low > 0 ? low - 1 : 0;
+	}
+
+	void HitTestTable::Fill( UINT32 lineIndex, UINT32 cluster, DWRITE_HIT_TEST_METRICS* metrics ) const
+	{
+		const Line& line = m_Lines[lineIndex];
+		metrics->top = m_LineTops[lineIndex];
+		metrics->height = line.Height;
+		metrics->bidiLevel = line.BidiLevel;
+		metrics->isTrimmed = FALSE;
+
+		if( line.ClusterCount == 0 )
+		{
+			// the empty line after a final newline
+			metrics->textPosition = line.TextPosition;
+			metrics->length = 0;
+			metrics->left = line.Left;
+			metrics->width = 0;
+			metrics->isText = FALSE;
+			return;
+		}
+
+		metrics->textPosition = m_ClusterPositions[cluster];
+		metrics->length = m_Clusters[cluster].length;
+		metrics->left = line.Left + m_ClusterOffsets[cluster];
+		metrics->width = m_Clusters[cluster].width;
+		metrics->isText = TRUE;
+	}
+
+	HRESULT HitTestTable::HitTestPoint( FLOAT pointX, FLOAT pointY, BOOL* isTrailingHit, BOOL* isInside, DWRITE_HIT_TEST_METRICS* metrics )
+	{
+		if( m_Lines.empty() )
+			return m_Layout->HitTestPoint( pointX, pointY, isTrailingHit, isInside, metrics );
+
+		UINT32 lineIndex = static_cast<UINT32>( std::upper_bound( m_LineTops.begin(), m_LineTops.end(), pointY ) - m_LineTops.begin() );
+		lineIndex = lineIndex > 0 ? lineIndex - 1 : 0;
+
+		const Line& line = m_Lines[lineIndex];
+		if( !line.IsSimple )
+			return m_Layout->HitTestPoint( pointX, pointY, isTrailingHit, isInside, metrics );
+
+		bool insideY = pointY >= m_LineTops.front() && pointY < m_LineTops.back() + m_Lines.back().Height;
+		if( line.ClusterCount == 0 )
+		{
+			Fill( lineIndex, 0, metrics );
+			*isTrailingHit = FALSE;
+			*isInside = FALSE;
+			return S_OK;
+		}
+
+		FLOAT x = pointX - line.Left;
+		const FLOAT* offsets = &m_ClusterOffsets[line.FirstCluster];
+		UINT32 cluster = static_cast<UINT32>( std::upper_bound( offsets, offsets + line.ClusterCount, x ) - offsets );
+		cluster = line.FirstCluster + ( cluster > 0 ? cluster - 1 : 0 );
+
+		UINT32 last = line.FirstCluster + line.ClusterCount - 1;
+		FLOAT width = m_ClusterOffsets[last] + m_Clusters[last].width;
+		bool insideX = x >= 0 && x < width;
+
+		Fill( lineIndex, cluster, metrics );
+		if( x >= width )
+			*isTrailingHit = m_Clusters[cluster].isNewline ? FALSE : TRUE;
+		else
+			*isTrailingHit = x >= m_ClusterOffsets[cluster] + m_Clusters[cluster].width * 0.5f ? TRUE : FALSE;
+
+		*isInside = insideX && insideY ? TRUE : FALSE;
+		return S_OK;
+	}
+
+	HRESULT HitTestTable::HitTestTextPosition( UINT32 textPosition, BOOL isTrailingHit, FLOAT* pointX, FLOAT* pointY, DWRITE_HIT_TEST_METRICS* metrics )
+	{
+		if( m_Lines.empty() )
+			return m_Layout->HitTestTextPosition( textPosition, isTrailingHit, pointX, pointY, metrics );
+
+		if( textPosition > m_TextLength )
+			textPosition = m_TextLength;
+
+		UINT32 lineIndex = FindLine( textPosition );
+		const Line& line = m_Lines[lineIndex];
+		if( !line.IsSimple )
+			return m_Layout->HitTestTextPosition( textPosition, isTrailingHit, pointX, pointY, metrics );
+
+		if( line.ClusterCount == 0 )
+		{
+			Fill( lineIndex, 0, metrics );
+			*pointX = metrics->left;
+			*pointY = metrics->top;
+			return S_OK;
+		}
+
+		UINT32 cluster;
+		if( textPosition >= line.TextPosition + line.Length )
+		{
+			// the end of text that does not finish with a newline is the trailing edge of its last cluster
+			cluster = line.FirstCluster + line.ClusterCount - 1;
+			isTrailingHit = TRUE;
+		}
+		else
+		{
+			const UINT32* positions = &m_ClusterPositions[line.FirstCluster];
+			cluster = static_cast<UINT32>( std::upper_bound( positions, positions + line.ClusterCount, textPosition ) - positions );
+			cluster = line.FirstCluster + ( cluster > 0 ? cluster - 1 : 0 );
+		}
+
+		Fill( lineIndex, cluster, metrics );
+		*pointX = metrics->left + ( isTrailingHit ? metrics->width : 0 );
+		*pointY = metrics->top;
+		return S_OK;
+	}
+}
+}
+
+#pragma managed(pop)
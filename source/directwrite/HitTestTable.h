@@ -0,0 +1,90 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include <vector>
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	// Answers hit tests on a text layout from its line and cluster metrics. Line tops are prefix sums of the line
+	// heights and cluster offsets are prefix sums of the cluster widths within each line, so both kinds of query are
+	// a pair of binary searches. Lines that contain right-to-left or trimmed clusters do not lay out their clusters in
+	// logical order, and are handed to the layout instead. Not thread safe.
+	class HitTestTable
+	{
+	public:
+		explicit HitTestTable( IDWriteTextLayout* layout );
+		~HitTestTable();
+
+		HRESULT Build();
+
+		// Refreshes the table after the formatting of the text from textPosition onwards changed. Lines that end before the
+		// line preceding the change, and the lines at the end of the text, keep their cached offsets while their metrics
+		// did not change; only the lines between them are laid out again, and the ones after are moved.
+		HRESULT Update( UINT32 textPosition );
+
+		HRESULT HitTestPoint( FLOAT pointX, FLOAT pointY, BOOL* isTrailingHit, BOOL* isInside, DWRITE_HIT_TEST_METRICS* metrics );
+		HRESULT HitTestTextPosition( UINT32 textPosition, BOOL isTrailingHit, FLOAT* pointX, FLOAT* pointY, DWRITE_HIT_TEST_METRICS* metrics );
+
+		IDWriteTextLayout* GetLayout() const { return m_Layout; }
+		UINT32 GetLineCount() const { return static_cast<UINT32>( m_Lines.size() ); }
+		UINT32 GetClusterCount() const { return static_cast<UINT32>( m_Clusters.size() ); }
+
+	private:
+		struct Line
+		{
+			UINT32 TextPosition;
+			UINT32 Length;
+			UINT32 FirstCluster;
+			UINT32 ClusterCount;
+			FLOAT Left;
+			FLOAT Height;
+			UINT32 BidiLevel;
+			bool IsSimple;
+		};
+
+		HitTestTable( const HitTestTable& );
+		HitTestTable& operator = ( const HitTestTable& );
+
+		HRESULT Fetch();
+		HRESULT Splice( UINT32 firstLine, UINT32 removedLines, UINT32 addedLines );
+		UINT32 FindLine( UINT32 textPosition ) const;
+		void Fill( UINT32 lineIndex, UINT32 cluster, DWRITE_HIT_TEST_METRICS* metrics ) const;
+
+		IDWriteTextLayout* m_Layout;
+		UINT32 m_TextLength;
+		FLOAT m_Top;
+
+		std::vector<Line> m_Lines;
+		std::vector<FLOAT> m_LineTops;
+		std::vector<DWRITE_CLUSTER_METRICS> m_Clusters;
+		std::vector<UINT32> m_ClusterPositions;
+		std::vector<FLOAT> m_ClusterOffsets;
+
+		// metrics read from the layout, compared against the cached lines by Update
+		std::vector<DWRITE_LINE_METRICS> m_LineMetrics;
+		std::vector<DWRITE_CLUSTER_METRICS> m_ClusterMetrics;
+	};
+}
+}
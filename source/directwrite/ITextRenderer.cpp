@@ -41,12 +41,57 @@ namespace DirectWrite
 		return new ITextRendererShim(wrappedInterface);
 	}
 
+	ITextRendererShim *ITextRendererShim::CreateInstance(ITextViewRenderer ^wrappedInterface)
+	{
+		if (wrappedInterface == nullptr)
+			return NULL;
+
+		return new ITextRendererShim(wrappedInterface);
+	}
+
 	ITextRendererShim::ITextRendererShim(ITextRenderer ^wrappedInterface)
 		: m_WrappedInterface(wrappedInterface),
+		m_UsesViews(false),
+		m_LastFontFace(NULL),
 		m_refCount(1)
 	{
 	}
 
+	ITextRendererShim::ITextRendererShim(ITextViewRenderer ^wrappedInterface)
+		: m_ViewInterface(wrappedInterface),
+		m_UsesViews(true),
+		m_LastFontFace(NULL),
+		m_refCount(1)
+	{
+	}
+
+	FontFace ^ITextRendererShim::GetFontFace(IDWriteFontFace *fontFace)
+	{
+		// consecutive runs almost always share a face, so this saves the object table lookup
+		if (fontFace != m_LastFontFace)
+		{
+			fontFace->AddRef();
+			m_LastFontFaceWrapper = FontFace::FromPointer(fontFace);
+			m_LastFontFace = fontFace;
+		}
+
+		return m_LastFontFaceWrapper;
+	}
+
+	String ^ITextRendererShim::GetLocaleName(const WCHAR *localeName)
+	{
+		if (localeName == NULL)
+			return nullptr;
+
+		if (static_cast<String ^>(m_LastLocaleNameString) == nullptr || m_LastLocaleName != localeName)
+		{
+			m_LastLocaleName = localeName;
+			m_LastLocaleNameString = gcnew String(localeName);
+		}
+
+		return m_LastLocaleNameString;
+	}
+
 	HRESULT ITextRendererShim::QueryInterface(const IID &iid, LPVOID *ppv)
 	{
 		if (iid == IID_IDWriteTextRenderer)
@@ -77,7 +122,10 @@ namespace DirectWrite
 	{
 		try
 		{
-			*isDisabled = m_WrappedInterface->IsPixelSnappingDisabled(IntPtr(clientDrawingContext));
+			if (m_UsesViews)
+				*isDisabled = m_ViewInterface->IsPixelSnappingDisabled(IntPtr(clientDrawingContext));
+			else
+				*isDisabled = m_WrappedInterface->IsPixelSnappingDisabled(IntPtr(clientDrawingContext));
 			return S_OK;
 		}
 		catch(SlimDXException^ e)
@@ -94,7 +142,7 @@ namespace DirectWrite
 	{
 		try
 		{
-			Matrix3x2 result = m_WrappedInterface->GetCurrentTransform(IntPtr(clientDrawingContext));
+			Matrix3x2 result = m_UsesViews ? m_ViewInterface->GetCurrentTransform(IntPtr(clientDrawingContext)) : m_WrappedInterface->GetCurrentTransform(IntPtr(clientDrawingContext));
 			memcpy(transform, &result, sizeof(DWRITE_MATRIX));
 			return S_OK;
 		}
@@ -112,7 +160,10 @@ namespace DirectWrite
 	{
 		try
 		{
-			*pixelsPerDip = m_WrappedInterface->GetPixelsPerDip(IntPtr(clientDrawingContext));
+			if (m_UsesViews)
+				*pixelsPerDip = m_ViewInterface->GetPixelsPerDip(IntPtr(clientDrawingContext));
+			else
+				*pixelsPerDip = m_WrappedInterface->GetPixelsPerDip(IntPtr(clientDrawingContext));
 			return S_OK;
 		}
 		catch(SlimDXException^ e)
@@ -130,6 +181,13 @@ namespace DirectWrite
 	{
 		try
 		{
+			if (m_UsesViews)
+			{
+				GlyphRunView view(glyphRun, glyphRunDescription, GetFontFace(glyphRun->fontFace));
+				return m_ViewInterface->DrawGlyphRun(IntPtr(clientDrawingContext), baselineOriginX, baselineOriginY, static_cast<MeasuringMode>(measuringMode),
+					view, IntPtr(clientDrawingEffect)).Code;
+			}
+
 			Result result = m_WrappedInterface->DrawGlyphRun(IntPtr(clientDrawingContext), baselineOriginX, baselineOriginY, static_cast<MeasuringMode>(measuringMode),
 				gcnew GlyphRun(*glyphRun), gcnew GlyphRunDescription(*glyphRunDescription), IntPtr(clientDrawingEffect));
 
@@ -149,6 +207,15 @@ namespace DirectWrite
 	{
 		try
 		{
+			if (m_UsesViews)
+			{
+				if (static_cast<Underline ^>(m_Underline) == nullptr)
+					m_Underline = gcnew Underline(*underline);
+
+				m_Underline->Assign(*underline, GetLocaleName(underline->localeName));
+				return m_ViewInterface->DrawUnderline(IntPtr(clientDrawingContext), baselineOriginX, baselineOriginY, m_Underline, IntPtr(clientDrawingEffect)).Code;
+			}
+
 			Result result = m_WrappedInterface->DrawUnderline(IntPtr(clientDrawingContext), baselineOriginX, baselineOriginY, gcnew Underline(*underline), IntPtr(clientDrawingEffect));
 			return result.Code;
 		}
@@ -166,6 +233,15 @@ namespace DirectWrite
 	{
 		try
 		{
+			if (m_UsesViews)
+			{
+				if (static_cast<Strikethrough ^>(m_Strikethrough) == nullptr)
+					m_Strikethrough = gcnew Strikethrough(*strikethrough);
+
+				m_Strikethrough->Assign(*strikethrough, GetLocaleName(strikethrough->localeName));
+				return m_ViewInterface->DrawStrikethrough(IntPtr(clientDrawingContext), baselineOriginX, baselineOriginY, m_Strikethrough, IntPtr(clientDrawingEffect)).Code;
+			}
+
 			Result result = m_WrappedInterface->DrawStrikethrough(IntPtr(clientDrawingContext), baselineOriginX, baselineOriginY, gcnew Strikethrough(*strikethrough), IntPtr(clientDrawingEffect));
 			return result.Code;
 		}
@@ -183,6 +259,9 @@ namespace DirectWrite
 	{
 		try
 		{
+			if (m_UsesViews)
+				return m_ViewInterface->DrawInlineObject(IntPtr(clientDrawingContext), originX, originY, InlineObject::FromPointer(inlineObject), isSideways != 0, isRightToLeft != 0, IntPtr(clientDrawingEffect)).Code;
+
 			Result result = m_WrappedInterface->DrawInlineObject(IntPtr(clientDrawingContext), originX, originY, InlineObject::FromPointer(inlineObject), isSideways != 0, isRightToLeft != 0, IntPtr(clientDrawingEffect));
 			return result.Code;
 		}
@@ -29,6 +29,7 @@ extern const IID IID_IDWriteTextRenderer;
 #include "Enums.h"
 #include "GlyphRunDW.h"
 #include "GlyphRunDescription.h"
+#include "ITextViewRenderer.h"
 #include "Underline.h"
 #include "Strikethrough.h"
 
@@ -52,6 +53,7 @@ namespace SlimDX
 		{
 		public:
 			static ITextRendererShim *CreateInstance(ITextRenderer ^wrappedInterface);
+			static ITextRendererShim *CreateInstance(ITextViewRenderer ^wrappedInterface);
 
 			STDMETHOD(QueryInterface)(REFIID riid, void **ppvObject);
 			STDMETHOD_(ULONG, AddRef)();
@@ -110,9 +112,23 @@ namespace SlimDX
 
 		private:
 			ITextRendererShim(ITextRenderer ^wrappedInterface);
+			ITextRendererShim(ITextViewRenderer ^wrappedInterface);
+
+			FontFace ^GetFontFace(IDWriteFontFace *fontFace);
+			System::String ^GetLocaleName(const WCHAR *localeName);
 
 			int m_refCount;
 			gcroot<ITextRenderer ^> m_WrappedInterface;
+
+			// the view renderer gets its wrappers from these instead of allocating new ones for every callback
+			gcroot<ITextViewRenderer ^> m_ViewInterface;
+			bool m_UsesViews;
+			IDWriteFontFace *m_LastFontFace;
+			gcroot<FontFace ^> m_LastFontFaceWrapper;
+			std::wstring m_LastLocaleName;
+			gcroot<System::String ^> m_LastLocaleNameString;
+			gcroot<Underline ^> m_Underline;
+			gcroot<Strikethrough ^> m_Strikethrough;
 		};
 	}
 }
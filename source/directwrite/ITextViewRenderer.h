@@ -0,0 +1,54 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "InlineObject.h"
+#include "Enums.h"
+#include "GlyphRunView.h"
+#include "Underline.h"
+#include "Strikethrough.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		/// <summary>
+		/// A text renderer that receives glyph runs as views of the native data instead of managed copies,
+		/// so that drawing a layout does not allocate per run.
+		/// </summary>
+		/// <remarks>
+		/// The <see cref="GlyphRunView"/>, <see cref="Underline"/> and <see cref="Strikethrough"/> arguments are only valid
+		/// for the duration of the call; the underline and strikethrough objects are reused for every call of one draw.
+		/// </remarks>
+		public interface struct ITextViewRenderer
+		{
+			Matrix3x2 GetCurrentTransform(System::IntPtr drawingContext);
+			float GetPixelsPerDip(System::IntPtr drawingContext);
+			bool IsPixelSnappingDisabled(System::IntPtr drawingContext);
+
+			Result DrawGlyphRun(System::IntPtr drawingContext, float baselineOriginX, float baselineOriginY, MeasuringMode measuringMode, GlyphRunView glyphRun, System::IntPtr clientDrawingEffect);
+			Result DrawInlineObject(System::IntPtr drawingContext, float baselineOriginX, float baselineOriginY, InlineObject^ inlineObject, bool isSideways, bool isRightToLeft, System::IntPtr clientDrawingEffect);
+			Result DrawStrikethrough(System::IntPtr drawingContext, float baselineOriginX, float baselineOriginY, Strikethrough^ strikethrough, System::IntPtr clientDrawingEffect);
+			Result DrawUnderline(System::IntPtr drawingContext, float baselineOriginX, float baselineOriginY, Underline^ underline, System::IntPtr clientDrawingEffect);
+		};
+	}
+}
@@ -0,0 +1,139 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+#pragma managed(push, off)
+
+#include "../ParallelFor.h"
+
+#include "LayoutBatchJob.h"
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	LayoutBatchJob::LayoutBatchJob( IDWriteFactory* factory )
+	: m_Factory( factory )
+	{
+		m_Factory->AddRef();
+	}
+
+	LayoutBatchJob::~LayoutBatchJob()
+	{
+		Clear();
+		m_Factory->Release();
+	}
+
+	void LayoutBatchJob::Add( const WCHAR* text, UINT32 length, IDWriteTextFormat* format, FLOAT maxWidth, FLOAT maxHeight )
+	{
+		Request request;
+		request.TextOffset = m_Text.size();
+		request.TextLength = length;
+		request.Format = format;
+		request.MaxWidth = maxWidth;
+		request.MaxHeight = maxHeight;
+
+		m_Text.insert( m_Text.end(), text, text + length );
+		m_Requests.push_back( request );
+		format->AddRef();
+	}
+
+	void LayoutBatchJob::Run( int minimumParallelCount )
+	{
+		// outputs from a previous run still own their layouts
+		for( size_t i = 0; i < m_Outputs.size(); i++ )
+		{
+			if( m_Outputs[i].Layout != NULL )
+				m_Outputs[i].Layout->Release();
+		}
+
+		m_Outputs.clear();
+		m_Outputs.resize( m_Requests.size() );
+		for( size_t i = 0; i < m_Outputs.size(); i++ )
+		{
+			m_Outputs[i].Layout = NULL;
+			m_Outputs[i].Result = S_OK;
+		}
+
+		// CreateTextLayout reads from the buffer without null termination, which keeps empty texts addressable too
+		m_Text.push_back( 0 );
+		ParallelFor( static_cast<int>( m_Requests.size() ), minimumParallelCount, &LayoutBatchJob::Build, this );
+		m_Text.pop_back();
+	}
+
+	void LayoutBatchJob::Build( void* context, int index )
+	{
+		LayoutBatchJob* job = static_cast<LayoutBatchJob*>( context );
+		const Request& request = job->m_Requests[index];
+		Output& output = job->m_Outputs[index];
+
+		IDWriteTextLayout* layout = NULL;
+		HRESULT hr = job->m_Factory->CreateTextLayout( &job->m_Text[request.TextOffset], request.TextLength, request.Format,
+			request.MaxWidth, request.MaxHeight, &layout );
+
+		// layouts are formatted lazily; measuring here makes the worker pay for shaping and line breaking
+		if( SUCCEEDED( hr ) )
+			hr = layout->GetMetrics( &output.Metrics );
+
+		if( SUCCEEDED( hr ) )
+		{
+			UINT32 count = output.Metrics.lineCount;
+			output.Lines.resize( count > 0 ? count : 1 );
+			hr = layout->GetLineMetrics( &output.Lines[0], count, &count );
+			output.Lines.resize( count );
+		}
+
+		if( FAILED( hr ) && layout != NULL )
+		{
+			layout->Release();
+			layout = NULL;
+		}
+
+		output.Layout = layout;
+		output.Result = hr;
+	}
+
+	IDWriteTextLayout* LayoutBatchJob::Detach( UINT32 index )
+	{
+		IDWriteTextLayout* layout = m_Outputs[index].Layout;
+		m_Outputs[index].Layout = NULL;
+		return layout;
+	}
+
+	void LayoutBatchJob::Clear()
+	{
+		for( size_t i = 0; i < m_Outputs.size(); i++ )
+		{
+			if( m_Outputs[i].Layout != NULL )
+				m_Outputs[i].Layout->Release();
+		}
+
+		for( size_t i = 0; i < m_Requests.size(); i++ )
+			m_Requests[i].Format->Release();
+
+		m_Outputs.clear();
+		m_Requests.clear();
+		m_Text.clear();
+	}
+}
+}
+
+#pragma managed(pop)
@@ -0,0 +1,80 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include <vector>
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	// Creates and measures a batch of text layouts, spreading them across the thread pool. The texts are copied into
+	// one buffer when they are added; each layout is built, formatted and measured by a single worker, which writes
+	// only its own output slot, so workers never share mutable state. The factory must be a shared factory, whose
+	// methods are safe to call from several threads; text formats are only read.
+	class LayoutBatchJob
+	{
+	public:
+		struct Output
+		{
+			IDWriteTextLayout* Layout;
+			DWRITE_TEXT_METRICS Metrics;
+			std::vector<DWRITE_LINE_METRICS> Lines;
+			HRESULT Result;
+		};
+
+		explicit LayoutBatchJob( IDWriteFactory* factory );
+		~LayoutBatchJob();
+
+		void Add( const WCHAR* text, UINT32 length, IDWriteTextFormat* format, FLOAT maxWidth, FLOAT maxHeight );
+		void Run( int minimumParallelCount );
+
+		// Hands the reference to a layout over to the caller; the layout is not released by Clear afterwards.
+		IDWriteTextLayout* Detach( UINT32 index );
+		void Clear();
+
+		UINT32 GetCount() const { return static_cast<UINT32>( m_Requests.size() ); }
+		const Output& GetOutput( UINT32 index ) const { return m_Outputs[index]; }
+
+	private:
+		struct Request
+		{
+			size_t TextOffset;
+			UINT32 TextLength;
+			IDWriteTextFormat* Format;
+			FLOAT MaxWidth;
+			FLOAT MaxHeight;
+		};
+
+		LayoutBatchJob( const LayoutBatchJob& );
+		LayoutBatchJob& operator = ( const LayoutBatchJob& );
+
+		// Matches ParallelForBody.
+		static void Build( void* context, int index );
+
+		IDWriteFactory* m_Factory;
+		std::vector<WCHAR> m_Text;
+		std::vector<Request> m_Requests;
+		std::vector<Output> m_Outputs;
+	};
+}
+}
@@ -0,0 +1,281 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "TextLayout.h"
+#include "LayoutCache.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Runtime::CompilerServices;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	LayoutCacheKey::LayoutCacheKey( String^ text, TextFormat^ format, float maxWidth, float maxHeight, array<LayoutFormatRange>^ ranges )
+	{
+		Text = text;
+		Format = format;
+		MaxWidth = maxWidth;
+		MaxHeight = maxHeight;
+		Ranges = ranges;
+
+		int hash = text->GetHashCode();
+		hash = hash * 31 + RuntimeHelpers::GetHashCode( format );
+		hash = hash * 31 + maxWidth.GetHashCode();
+		hash = hash * 31 + maxHeight.GetHashCode();
+		if( ranges != nullptr )
+		{
+			for( int i = 0; i < ranges->Length; i++ )
+				hash = hash * 31 + ranges[i].Range.StartPosition + ( ranges[i].Range.Length << 16 ) + static_cast<int>( ranges[i].FontWeight );
+		}
+
+		Hash = hash;
+	}
+
+	int LayoutCacheKey::GetHashCode()
+	{
+		return Hash;
+	}
+
+	bool LayoutCacheKey::Equals( Object^ obj )
+	{
+		if( obj == nullptr || obj->GetType() != GetType() )
+			return false;
+
+		return Equals( safe_cast<LayoutCacheKey>( obj ) );
+	}
+
+	static bool RangesEqual( array<LayoutFormatRange>^ left, array<LayoutFormatRange>^ right )
+	{
+		int leftCount = left == nullptr ? 0 : left->Length;
+		int rightCount = right == nullptr ? 0 : right->Length;
+		if( leftCount != rightCount )
+			return false;
+
+		for( int i = 0; i < leftCount; i++ )
+		{
+			LayoutFormatRange% a = left[i];
+			LayoutFormatRange% b = right[i];
+			if( a.Range.StartPosition != b.Range.StartPosition || a.Range.Length != b.Range.Length ||
+				a.FontWeight != b.FontWeight || a.FontStyle != b.FontStyle || a.FontStretch != b.FontStretch ||
+				a.FontSize != b.FontSize || a.Underline != b.Underline || a.Strikethrough != b.Strikethrough )
+				return false;
+		}
+
+		return true;
+	}
+
+	bool LayoutCacheKey::Equals( LayoutCacheKey other )
+	{
+		return Hash == other.Hash && Object::ReferenceEquals( Format, other.Format ) && MaxWidth == other.MaxWidth &&
+			MaxHeight == other.MaxHeight && String::Equals( Text, other.Text ) && RangesEqual( Ranges, other.Ranges );
+	}
+
+	LayoutCache::LayoutCache( Factory^ factory, int capacity, Int64 memoryBudget )
+	{
+		if( factory == nullptr )
+			throw gcnew ArgumentNullException( "factory" );
+		if( capacity < 1 )
+			throw gcnew ArgumentOutOfRangeException( "capacity" );
+		if( memoryBudget < 1 )
+			throw gcnew ArgumentOutOfRangeException( "memoryBudget" );
+
+		m_Factory = factory;
+		m_Entries = gcnew Dictionary<LayoutCacheKey, LinkedListNode<Entry>^>();
+		m_Order = gcnew LinkedList<Entry>();
+		m_Capacity = capacity;
+		m_MemoryBudget = memoryBudget;
+	}
+
+	LayoutCache::~LayoutCache()
+	{
+		Clear();
+	}
+
+	CachedLayout^ LayoutCache::GetLayout( String^ text, TextFormat^ format, float maxWidth, float maxHeight )
+	{
+		return GetLayout( text, format, maxWidth, maxHeight, nullptr );
+	}
+
+	CachedLayout^ LayoutCache::GetLayout( String^ text, TextFormat^ format, float maxWidth, float maxHeight, array<LayoutFormatRange>^ ranges )
+	{
+		if( text == nullptr )
+			throw gcnew ArgumentNullException( "text" );
+		if( format == nullptr )
+			throw gcnew ArgumentNullException( "format" );
+
+		LayoutCacheKey key( text, format, maxWidth, maxHeight, ranges );
+
+		LinkedListNode<Entry>^ node;
+		if( m_Entries->TryGetValue( key, node ) )
+		{
+			m_Hits++;
+			if( node != m_Order->First )
+			{
+				m_Order->Remove( node );
+				m_Order->AddFirst( node );
+			}
+
+			return node->Value.Layout;
+		}
+
+		m_Misses++;
+
+		TextLayout^ layout = gcnew TextLayout( m_Factory, text, format, maxWidth, maxHeight );
+		CachedLayout^ result;
+		try
+		{
+			if( ranges != nullptr )
+			{
+				for( int i = 0; i < ranges->Length; i++ )
+				{
+					LayoutFormatRange% range = ranges[i];
+					layout->SetFontWeight( range.FontWeight, range.Range );
+					layout->SetFontStyle( range.FontStyle, range.Range );
+					layout->SetFontStretch( range.FontStretch, range.Range );
+					layout->SetFontSize( range.FontSize, range.Range );
+					layout->SetUnderline( range.Underline, range.Range );
+					layout->SetStrikethrough( range.Strikethrough, range.Range );
+				}
+
+				// the caller may reuse its array for the next lookup
+				key.Ranges = safe_cast<array<LayoutFormatRange>^>( ranges->Clone() );
+			}
+
+			result = gcnew CachedLayout( layout, text->Length );
+		}
+		catch( ... )
+		{
+			delete layout;
+			throw;
+		}
+
+		Entry entry;
+		entry.Key = key;
+		entry.Layout = result;
+		m_Entries->Add( key, m_Order->AddFirst( entry ) );
+		m_MemoryUsage += result->EstimatedSize;
+
+		// the new entry is never evicted, even if it alone is over the budget
+		Evict( m_Capacity, m_MemoryBudget, true );
+		return result;
+	}
+
+	void LayoutCache::Evict( int keepCount, Int64 keepSize, bool keepNewest )
+	{
+		int minimum = keepNewest ? 1 : 0;
+		while( m_Order->Count > minimum && ( m_Order->Count > keepCount || m_MemoryUsage > keepSize ) )
+		{
+			LinkedListNode<Entry>^ node = m_Order->Last;
+			m_Order->RemoveLast();
+			m_Entries->Remove( node->Value.Key );
+			m_MemoryUsage -= node->Value.Layout->EstimatedSize;
+			m_Evictions++;
+		}
+	}
+
+	void LayoutCache::Trim( int count, Int64 memoryUsage )
+	{
+		if( count < 0 )
+			throw gcnew ArgumentOutOfRangeException( "count" );
+		if( memoryUsage < 0 )
+			throw gcnew ArgumentOutOfRangeException( "memoryUsage" );
+
+		Evict( count, memoryUsage, false );
+	}
+
+	void LayoutCache::Clear()
+	{
+		m_Order->Clear();
+		m_Entries->Clear();
+		m_MemoryUsage = 0;
+	}
+
+	void LayoutCache::ResetCounters()
+	{
+		m_Hits = 0;
+		m_Misses = 0;
+		m_Evictions = 0;
+	}
+
+	int LayoutCache::Count::get()
+	{
+		return m_Order->Count;
+	}
+
+	int LayoutCache::Capacity::get()
+	{
+		return m_Capacity;
+	}
+
+	void LayoutCache::Capacity::set( int value )
+	{
+		if( value < 1 )
+			throw gcnew ArgumentOutOfRangeException( "value" );
+
+		m_Capacity = value;
+		Evict( m_Capacity, m_MemoryBudget, true );
+	}
+
+	Int64 LayoutCache::MemoryBudget::get()
+	{
+		return m_MemoryBudget;
+	}
+
+	void LayoutCache::MemoryBudget::set( Int64 value )
+	{
+		if( value < 1 )
+			throw gcnew ArgumentOutOfRangeException( "value" );
+
+		m_MemoryBudget = value;
+		Evict( m_Capacity, m_MemoryBudget, true );
+	}
+
+	Int64 LayoutCache::MemoryUsage::get()
+	{
+		return m_MemoryUsage;
+	}
+
+	Int64 LayoutCache::HitCount::get()
+	{
+		return m_Hits;
+	}
+
+	Int64 LayoutCache::MissCount::get()
+	{
+		return m_Misses;
+	}
+
+	Int64 LayoutCache::EvictionCount::get()
+	{
+		return m_Evictions;
+	}
+
+	double LayoutCache::HitRate::get()
+	{
+		Int64 total = m_Hits + m_Misses;
+		return total == 0 ? 0.0 : static_cast<double>( m_Hits ) / total;
+	}
+}
+}
@@ -0,0 +1,173 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "CachedLayout.h"
+#include "LayoutFormatRange.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class Factory;
+		ref class TextFormat;
+
+		value class LayoutCacheKey : System::IEquatable<LayoutCacheKey>
+		{
+		public:
+			System::String^ Text;
+			TextFormat^ Format;
+			float MaxWidth;
+			float MaxHeight;
+			array<LayoutFormatRange>^ Ranges;
+			int Hash;
+
+			LayoutCacheKey( System::String^ text, TextFormat^ format, float maxWidth, float maxHeight, array<LayoutFormatRange>^ ranges );
+
+			virtual int GetHashCode() override;
+			virtual bool Equals( System::Object^ obj ) override;
+			virtual bool Equals( LayoutCacheKey other );
+		};
+
+		/// <summary>
+		/// Shares text layouts and their metrics between callers that lay out the same text with the same format and constraints.
+		/// </summary>
+		/// <remarks>
+		/// Entries are keyed by the text, the identity of the text format, the maximum width and height, and the formatting
+		/// applied to ranges of the text. The least recently used entries are evicted when either the entry count or the
+		/// estimated memory use exceeds its limit; an evicted layout is disposed once its handle is finalized.
+		/// Text formats must stay alive while they are used in the cache. The cache is not thread safe.
+		/// </remarks>
+		public ref class LayoutCache sealed
+		{
+		private:
+			value class Entry
+			{
+			public:
+				LayoutCacheKey Key;
+				CachedLayout^ Layout;
+			};
+
+			Factory^ m_Factory;
+			System::Collections::Generic::Dictionary<LayoutCacheKey, System::Collections::Generic::LinkedListNode<Entry>^>^ m_Entries;
+			System::Collections::Generic::LinkedList<Entry>^ m_Order;
+			int m_Capacity;
+			System::Int64 m_MemoryBudget;
+			System::Int64 m_MemoryUsage;
+			System::Int64 m_Hits;
+			System::Int64 m_Misses;
+			System::Int64 m_Evictions;
+
+			void Evict( int keepCount, System::Int64 keepSize, bool keepNewest );
+
+		public:
+			/// <summary>
+			/// Initializes a new instance of the <see cref="LayoutCache"/> class.
+			/// </summary>
+			/// <param name="factory">The factory used to create layouts.</param>
+			/// <param name="capacity">The maximum number of layouts kept.</param>
+			/// <param name="memoryBudget">The maximum estimated memory, in bytes, used by the kept layouts.</param>
+			LayoutCache( Factory^ factory, int capacity, System::Int64 memoryBudget );
+
+			/// <summary>
+			/// Evicts every layout in the cache.
+			/// </summary>
+			~LayoutCache();
+
+			/// <summary>
+			/// Gets a layout of the text, creating it if it is not in the cache.
+			/// </summary>
+			/// <returns>The handle of the cache entry; every lookup of the same entry returns the same handle.</returns>
+			CachedLayout^ GetLayout( System::String^ text, TextFormat^ format, float maxWidth, float maxHeight );
+
+			/// <summary>
+			/// Gets a layout of the text with formatting applied to ranges of it, creating it if it is not in the cache.
+			/// </summary>
+			/// <returns>The handle of the cache entry; every lookup of the same entry returns the same handle.</returns>
+			/// <remarks>The ranges are copied when a new entry is created, so the array can be reused by the caller.</remarks>
+			CachedLayout^ GetLayout( System::String^ text, TextFormat^ format, float maxWidth, float maxHeight, array<LayoutFormatRange>^ ranges );
+
+			/// <summary>
+			/// Evicts least recently used layouts until at most the given number and size remain.
+			/// </summary>
+			void Trim( int count, System::Int64 memoryUsage );
+
+			/// <summary>
+			/// Evicts every layout in the cache. The counters are not reset.
+			/// </summary>
+			void Clear();
+
+			/// <summary>
+			/// Resets the hit, miss and eviction counters.
+			/// </summary>
+			void ResetCounters();
+
+			property int Count
+			{
+				int get();
+			}
+
+			property int Capacity
+			{
+				int get();
+				void set( int value );
+			}
+
+			property System::Int64 MemoryBudget
+			{
+				System::Int64 get();
+				void set( System::Int64 value );
+			}
+
+			/// <summary>
+			/// Gets the estimated memory, in bytes, used by the layouts in the cache.
+			/// </summary>
+			property System::Int64 MemoryUsage
+			{
+				System::Int64 get();
+			}
+
+			property System::Int64 HitCount
+			{
+				System::Int64 get();
+			}
+
+			property System::Int64 MissCount
+			{
+				System::Int64 get();
+			}
+
+			property System::Int64 EvictionCount
+			{
+				System::Int64 get();
+			}
+
+			/// <summary>
+			/// Gets the fraction of lookups since the counters were reset that found their layout in the cache.
+			/// </summary>
+			property double HitRate
+			{
+				double get();
+			}
+		};
+	}
+}
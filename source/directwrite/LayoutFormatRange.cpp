@@ -0,0 +1,53 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "TextFormat.h"
+#include "LayoutFormatRange.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	LayoutFormatRange::LayoutFormatRange( TextRange range, SlimDX::DirectWrite::FontWeight fontWeight, SlimDX::DirectWrite::FontStyle fontStyle,
+		SlimDX::DirectWrite::FontStretch fontStretch, float fontSize, bool underline, bool strikethrough )
+	{
+		Range = range;
+		FontWeight = fontWeight;
+		FontStyle = fontStyle;
+		FontStretch = fontStretch;
+		FontSize = fontSize;
+		Underline = underline;
+		Strikethrough = strikethrough;
+	}
+
+	LayoutFormatRange LayoutFormatRange::FromFormat( TextFormat^ format, TextRange range )
+	{
+		if( format == nullptr )
+			throw gcnew ArgumentNullException( "format" );
+
+		return LayoutFormatRange( range, format->FontWeight, format->FontStyle, format->FontStretch, format->FontSize, false, false );
+	}
+}
+}
@@ -0,0 +1,413 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+#pragma managed(push, off)
+
+#include "MappedFontFile.h"
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	HRESULT MappedFile::Open( const WCHAR* path, MappedFile** file )
+	{
+		*file = NULL;
+
+		HANDLE handle = CreateFileW( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+		if( handle == INVALID_HANDLE_VALUE )
+			return HRESULT_FROM_WIN32( GetLastError() );
+
+		LARGE_INTEGER size;
+		FILETIME lastWriteTime;
+		if( !GetFileSizeEx( handle, &size ) || !GetFileTime( handle, NULL, NULL, &lastWriteTime ) )
+		{
+			HRESULT hr = HRESULT_FROM_WIN32( GetLastError() );
+			CloseHandle( handle );
+			return hr;
+		}
+
+		// empty files cannot be mapped, and hold no font anyway
+		if( size.QuadPart == 0 )
+		{
+			CloseHandle( handle );
+			return E_INVALIDARG;
+		}
+
+		// the view keeps the mapping, and the mapping the file, alive after the handles are closed
+		HANDLE mapping = CreateFileMappingW( handle, NULL, PAGE_READONLY, 0, 0, NULL );
+		HRESULT hr = mapping == NULL ? HRESULT_FROM_WIN32( GetLastError() ) : S_OK;
+		CloseHandle( handle );
+		if( FAILED( hr ) )
+			return hr;
+
+		const void* view = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+		hr = view == NULL ? HRESULT_FROM_WIN32( GetLastError() ) : S_OK;
+		CloseHandle( mapping );
+		if( FAILED( hr ) )
+			return hr;
+
+		UINT64 time = ( static_cast<UINT64>( lastWriteTime.dwHighDateTime ) << 32 ) | lastWriteTime.dwLowDateTime;
+		*file = new MappedFile( static_cast<const BYTE*>( view ), static_cast<UINT64>( size.QuadPart ), time );
+		return S_OK;
+	}
+
+	MappedFile::MappedFile( const BYTE* view, UINT64 size, UINT64 lastWriteTime )
+	: m_RefCount( 1 ), m_View( view ), m_Size( size ), m_LastWriteTime( lastWriteTime )
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		UnmapViewOfFile( m_View );
+	}
+
+	void MappedFile::AddRef()
+	{
+		InterlockedIncrement( &m_RefCount );
+	}
+
+	void MappedFile::Release()
+	{
+		if( InterlockedDecrement( &m_RefCount ) == 0 )
+			delete this;
+	}
+
+	MappedFontFileStream::MappedFontFileStream( MappedFile* file, UINT64 offset, UINT64 size )
+	: m_RefCount( 1 ), m_File( file ), m_Data( file->GetData() + offset ), m_Size( size )
+	{
+		m_File->AddRef();
+	}
+
+	MappedFontFileStream::~MappedFontFileStream()
+	{
+		m_File->Release();
+	}
+
+	HRESULT MappedFontFileStream::QueryInterface( REFIID riid, void** ppvObject )
+	{
+		if( ppvObject == NULL )
+			return E_POINTER;
+
+		if( riid == __uuidof( IDWriteFontFileStream ) || riid == __uuidof( IUnknown ) )
+		{
+			AddRef();
+			*ppvObject = this;
+			return S_OK;
+		}
+
+		*ppvObject = NULL;
+		return E_NOINTERFACE;
+	}
+
+	ULONG MappedFontFileStream::AddRef()
+	{
+		return InterlockedIncrement( &m_RefCount );
+	}
+
+	ULONG MappedFontFileStream::Release()
+	{
+		ULONG count = InterlockedDecrement( &m_RefCount );
+		if( count == 0 )
+			delete this;
+
+		return count;
+	}
+
+	HRESULT MappedFontFileStream::ReadFileFragment( void const** fragmentStart, UINT64 fileOffset, UINT64 fragmentSize, void** fragmentContext )
+	{
+		*fragmentContext = NULL;
+		if( fileOffset > m_Size || fragmentSize > m_Size - fileOffset )
+		{
+			*fragmentStart = NULL;
+			return E_INVALIDARG;
+		}
+
+		*fragmentStart = m_Data + fileOffset;
+		return S_OK;
+	}
+
+	void MappedFontFileStream::ReleaseFileFragment( void* )
+	{
+	}
+
+	HRESULT MappedFontFileStream::GetFileSize( UINT64* fileSize )
+	{
+		*fileSize = m_Size;
+		return S_OK;
+	}
+
+	HRESULT MappedFontFileStream::GetLastWriteTime( UINT64* lastWriteTime )
+	{
+		*lastWriteTime = m_File->GetLastWriteTime();
+		return S_OK;
+	}
+
+	MappedFontFileLoader::MappedFontFileLoader()
+	: m_RefCount( 1 )
+	{
+		InitializeSRWLock( &m_Lock );
+	}
+
+	MappedFontFileLoader::~MappedFontFileLoader()
+	{
+		for( size_t i = 0; i < m_Entries.size(); i++ )
+			m_Entries[i].File->Release();
+	}
+
+	HRESULT MappedFontFileLoader::QueryInterface( REFIID riid, void** ppvObject )
+	{
+		if( ppvObject == NULL )
+			return E_POINTER;
+
+		if( riid == __uuidof( IDWriteFontFileLoader ) || riid == __uuidof( IUnknown ) )
+		{
+			AddRef();
+			*ppvObject = this;
+			return S_OK;
+		}
+
+		*ppvObject = NULL;
+		return E_NOINTERFACE;
+	}
+
+	ULONG MappedFontFileLoader::AddRef()
+	{
+		return InterlockedIncrement( &m_RefCount );
+	}
+
+	ULONG MappedFontFileLoader::Release()
+	{
+		ULONG count = InterlockedDecrement( &m_RefCount );
+		if( count == 0 )
+			delete this;
+
+		return count;
+	}
+
+	HRESULT MappedFontFileLoader::CreateStreamFromKey( void const* fontFileReferenceKey, UINT32 fontFileReferenceKeySize, IDWriteFontFileStream** fontFileStream )
+	{
+		if( fontFileStream == NULL )
+			return E_POINTER;
+
+		*fontFileStream = NULL;
+		if( fontFileReferenceKey == NULL || fontFileReferenceKeySize != sizeof( UINT32 ) )
+			return E_INVALIDARG;
+
+		UINT32 key = *static_cast<const UINT32*>( fontFileReferenceKey );
+
+		AcquireSRWLockShared( &m_Lock );
+		HRESULT hr = E_INVALIDARG;
+		if( key < m_Entries.size() )
+		{
+			const Entry& entry = m_Entries[key];
+			*fontFileStream = new MappedFontFileStream( entry.File, entry.Offset, entry.Size );
+			hr = S_OK;
+		}
+		ReleaseSRWLockShared( &m_Lock );
+
+		return hr;
+	}
+
+	HRESULT MappedFontFileLoader::AddFont( MappedFile* file, UINT64 offset, UINT64 size, UINT32* key )
+	{
+		if( offset > file->GetSize() || size > file->GetSize() - offset )
+			return E_INVALIDARG;
+
+		Entry entry;
+		entry.File = file;
+		entry.Offset = offset;
+		entry.Size = size;
+
+		AcquireSRWLockExclusive( &m_Lock );
+		*key = static_cast<UINT32>( m_Entries.size() );
+		m_Entries.push_back( entry );
+		ReleaseSRWLockExclusive( &m_Lock );
+
+		file->AddRef();
+		return S_OK;
+	}
+
+	UINT32 MappedFontFileLoader::GetFontCount()
+	{
+		AcquireSRWLockShared( &m_Lock );
+		UINT32 count = static_cast<UINT32>( m_Entries.size() );
+		ReleaseSRWLockShared( &m_Lock );
+
+		return count;
+	}
+
+	MappedFontCollectionLoader::MappedFontCollectionLoader( MappedFontFileLoader* fileLoader )
+	: m_RefCount( 1 ), m_FileLoader( fileLoader )
+	{
+		m_FileLoader->AddRef();
+		InitializeSRWLock( &m_Lock );
+	}
+
+	MappedFontCollectionLoader::~MappedFontCollectionLoader()
+	{
+		m_FileLoader->Release();
+	}
+
+	HRESULT MappedFontCollectionLoader::QueryInterface( REFIID riid, void** ppvObject )
+	{
+		if( ppvObject == NULL )
+			return E_POINTER;
+
+		if( riid == __uuidof( IDWriteFontCollectionLoader ) || riid == __uuidof( IUnknown ) )
+		{
+			AddRef();
+			*ppvObject = this;
+			return S_OK;
+		}
+
+		*ppvObject = NULL;
+		return E_NOINTERFACE;
+	}
+
+	ULONG MappedFontCollectionLoader::AddRef()
+	{
+		return InterlockedIncrement( &m_RefCount );
+	}
+
+	ULONG MappedFontCollectionLoader::Release()
+	{
+		ULONG count = InterlockedDecrement( &m_RefCount );
+		if( count == 0 )
+			delete this;
+
+		return count;
+	}
+
+	HRESULT MappedFontCollectionLoader::CreateEnumeratorFromKey( IDWriteFactory* factory, void const* collectionKey, UINT32 collectionKeySize,
+		IDWriteFontFileEnumerator** fontFileEnumerator )
+	{
+		if( fontFileEnumerator == NULL )
+			return E_POINTER;
+
+		*fontFileEnumerator = NULL;
+		if( factory == NULL || collectionKey == NULL || collectionKeySize != sizeof( UINT32 ) )
+			return E_INVALIDARG;
+
+		UINT32 key = *static_cast<const UINT32*>( collectionKey );
+
+		AcquireSRWLockShared( &m_Lock );
+		HRESULT hr = E_INVALIDARG;
+		if( key < m_Collections.size() )
+		{
+			*fontFileEnumerator = new MappedFontFileEnumerator( factory, m_FileLoader, m_Collections[key] );
+			hr = S_OK;
+		}
+		ReleaseSRWLockShared( &m_Lock );
+
+		return hr;
+	}
+
+	HRESULT MappedFontCollectionLoader::AddCollection( const UINT32* fonts, UINT32 count, UINT32* key )
+	{
+		UINT32 fontCount = m_FileLoader->GetFontCount();
+		for( UINT32 i = 0; i < count; i++ )
+		{
+			if( fonts[i] >= fontCount )
+				return E_INVALIDARG;
+		}
+
+		AcquireSRWLockExclusive( &m_Lock );
+		*key = static_cast<UINT32>( m_Collections.size() );
+		m_Collections.push_back( std::vector<UINT32>( fonts, fonts + count ) );
+		ReleaseSRWLockExclusive( &m_Lock );
+
+		return S_OK;
+	}
+
+	MappedFontFileEnumerator::MappedFontFileEnumerator( IDWriteFactory* factory, MappedFontFileLoader* fileLoader, const std::vector<UINT32>& fonts )
+	: m_RefCount( 1 ), m_Factory( factory ), m_FileLoader( fileLoader ), m_Fonts( fonts ), m_Next( 0 )
+	{
+		m_Factory->AddRef();
+		m_FileLoader->AddRef();
+	}
+
+	MappedFontFileEnumerator::~MappedFontFileEnumerator()
+	{
+		m_FileLoader->Release();
+		m_Factory->Release();
+	}
+
+	HRESULT MappedFontFileEnumerator::QueryInterface( REFIID riid, void** ppvObject )
+	{
+		if( ppvObject == NULL )
+			return E_POINTER;
+
+		if( riid == __uuidof( IDWriteFontFileEnumerator ) || riid == __uuidof( IUnknown ) )
+		{
+			AddRef();
+			*ppvObject = this;
+			return S_OK;
+		}
+
+		*ppvObject = NULL;
+		return E_NOINTERFACE;
+	}
+
+	ULONG MappedFontFileEnumerator::AddRef()
+	{
+		return InterlockedIncrement( &m_RefCount );
+	}
+
+	ULONG MappedFontFileEnumerator::Release()
+	{
+		ULONG count = InterlockedDecrement( &m_RefCount );
+		if( count == 0 )
+			delete this;
+
+		return count;
+	}
+
+	HRESULT MappedFontFileEnumerator::MoveNext( BOOL* hasCurrentFile )
+	{
+		if( m_Next < m_Fonts.size() )
+		{
+			m_Next++;
+			*hasCurrentFile = TRUE;
+		}
+		else
+		{
+			*hasCurrentFile = FALSE;
+		}
+
+		return S_OK;
+	}
+
+	HRESULT MappedFontFileEnumerator::GetCurrentFontFile( IDWriteFontFile** fontFile )
+	{
+		if( fontFile == NULL )
+			return E_POINTER;
+
+		*fontFile = NULL;
+		if( m_Next == 0 || m_Next > m_Fonts.size() )
+			return E_FAIL;
+
+		return m_Factory->CreateCustomFontFileReference( &m_Fonts[m_Next - 1], sizeof( UINT32 ), m_FileLoader, fontFile );
+	}
+}
+}
+
+#pragma managed(pop)
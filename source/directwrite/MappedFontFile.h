@@ -0,0 +1,157 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include <vector>
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	// A read-only view of a whole file. The view outlives every stream created from it, and its pages come from the
+	// system file cache, so they are shared with every other process mapping the same file.
+	class MappedFile
+	{
+	public:
+		static HRESULT Open( const WCHAR* path, MappedFile** file );
+
+		void AddRef();
+		void Release();
+
+		const BYTE* GetData() const { return m_View; }
+		UINT64 GetSize() const { return m_Size; }
+		UINT64 GetLastWriteTime() const { return m_LastWriteTime; }
+
+	private:
+		MappedFile( const BYTE* view, UINT64 size, UINT64 lastWriteTime );
+		~MappedFile();
+
+		MappedFile( const MappedFile& );
+		MappedFile& operator = ( const MappedFile& );
+
+		LONG m_RefCount;
+		const BYTE* m_View;
+		UINT64 m_Size;
+		UINT64 m_LastWriteTime;
+	};
+
+	// Serves a font that occupies a range of a mapped file. Fragments are pointers into the view; nothing is copied.
+	class MappedFontFileStream : public IDWriteFontFileStream
+	{
+	public:
+		MappedFontFileStream( MappedFile* file, UINT64 offset, UINT64 size );
+
+		STDMETHOD(QueryInterface)( REFIID riid, void** ppvObject );
+		STDMETHOD_(ULONG, AddRef)();
+		STDMETHOD_(ULONG, Release)();
+
+		STDMETHOD(ReadFileFragment)( void const** fragmentStart, UINT64 fileOffset, UINT64 fragmentSize, void** fragmentContext );
+		STDMETHOD_(void, ReleaseFileFragment)( void* fragmentContext );
+		STDMETHOD(GetFileSize)( UINT64* fileSize );
+		STDMETHOD(GetLastWriteTime)( UINT64* lastWriteTime );
+
+	private:
+		~MappedFontFileStream();
+
+		LONG m_RefCount;
+		MappedFile* m_File;
+		const BYTE* m_Data;
+		UINT64 m_Size;
+	};
+
+	// Font file loader whose reference keys are 32-bit indices into a table of ranges of mapped files. The table only
+	// grows; fonts can be added while DirectWrite reads from other threads.
+	class MappedFontFileLoader : public IDWriteFontFileLoader
+	{
+	public:
+		MappedFontFileLoader();
+
+		STDMETHOD(QueryInterface)( REFIID riid, void** ppvObject );
+		STDMETHOD_(ULONG, AddRef)();
+		STDMETHOD_(ULONG, Release)();
+
+		STDMETHOD(CreateStreamFromKey)( void const* fontFileReferenceKey, UINT32 fontFileReferenceKeySize, IDWriteFontFileStream** fontFileStream );
+
+		HRESULT AddFont( MappedFile* file, UINT64 offset, UINT64 size, UINT32* key );
+		UINT32 GetFontCount();
+
+	private:
+		struct Entry
+		{
+			MappedFile* File;
+			UINT64 Offset;
+			UINT64 Size;
+		};
+
+		~MappedFontFileLoader();
+
+		LONG m_RefCount;
+		SRWLOCK m_Lock;
+		std::vector<Entry> m_Entries;
+	};
+
+	// Font collection loader whose keys are 32-bit indices into a table of lists of fonts of a MappedFontFileLoader.
+	class MappedFontCollectionLoader : public IDWriteFontCollectionLoader
+	{
+	public:
+		explicit MappedFontCollectionLoader( MappedFontFileLoader* fileLoader );
+
+		STDMETHOD(QueryInterface)( REFIID riid, void** ppvObject );
+		STDMETHOD_(ULONG, AddRef)();
+		STDMETHOD_(ULONG, Release)();
+
+		STDMETHOD(CreateEnumeratorFromKey)( IDWriteFactory* factory, void const* collectionKey, UINT32 collectionKeySize, IDWriteFontFileEnumerator** fontFileEnumerator );
+
+		HRESULT AddCollection( const UINT32* fonts, UINT32 count, UINT32* key );
+
+	private:
+		~MappedFontCollectionLoader();
+
+		LONG m_RefCount;
+		MappedFontFileLoader* m_FileLoader;
+		SRWLOCK m_Lock;
+		std::vector<std::vector<UINT32> > m_Collections;
+	};
+
+	class MappedFontFileEnumerator : public IDWriteFontFileEnumerator
+	{
+	public:
+		MappedFontFileEnumerator( IDWriteFactory* factory, MappedFontFileLoader* fileLoader, const std::vector<UINT32>& fonts );
+
+		STDMETHOD(QueryInterface)( REFIID riid, void** ppvObject );
+		STDMETHOD_(ULONG, AddRef)();
+		STDMETHOD_(ULONG, Release)();
+
+		STDMETHOD(MoveNext)( BOOL* hasCurrentFile );
+		STDMETHOD(GetCurrentFontFile)( IDWriteFontFile** fontFile );
+
+	private:
+		~MappedFontFileEnumerator();
+
+		LONG m_RefCount;
+		IDWriteFactory* m_Factory;
+		MappedFontFileLoader* m_FileLoader;
+		std::vector<UINT32> m_Fonts;
+		size_t m_Next;
+	};
+}
+}
@@ -0,0 +1,213 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "DirectWriteException.h"
+#include "FactoryDW.h"
+#include "FontCollection.h"
+#include "FontFile.h"
+#include "MappedFontLoader.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	MappedFontLoader::MappedFontLoader(SlimDX::DirectWrite::Factory ^factory)
+	{
+		if (factory == nullptr)
+			throw gcnew ArgumentNullException("factory");
+
+		// Manual Allocation: released in Destruct
+		MappedFontFileLoader *fileLoader = new MappedFontFileLoader();
+		MappedFontCollectionLoader *collectionLoader = new MappedFontCollectionLoader(fileLoader);
+
+		IDWriteFactory *nativeFactory = factory->InternalPointer;
+		HRESULT hr = nativeFactory->RegisterFontFileLoader(fileLoader);
+		if (SUCCEEDED(hr))
+		{
+			hr = nativeFactory->RegisterFontCollectionLoader(collectionLoader);
+			if (FAILED(hr))
+				nativeFactory->UnregisterFontFileLoader(fileLoader);
+		}
+
+		if (RECORD_DW(hr).IsFailure)
+		{
+			collectionLoader->Release();
+			fileLoader->Release();
+			throw gcnew DirectWriteException(Result::Last);
+		}
+
+		nativeFactory->AddRef();
+		m_NativeFactory = nativeFactory;
+		m_FileLoader = fileLoader;
+		m_CollectionLoader = collectionLoader;
+		m_Factory = factory;
+	}
+
+	MappedFontLoader::~MappedFontLoader()
+	{
+		Destruct();
+		GC::SuppressFinalize(this);
+	}
+
+	MappedFontLoader::!MappedFontLoader()
+	{
+		Destruct();
+	}
+
+	void MappedFontLoader::Destruct()
+	{
+		if (m_FileLoader == 0)
+			return;
+
+		m_NativeFactory->UnregisterFontCollectionLoader(m_CollectionLoader);
+		m_NativeFactory->UnregisterFontFileLoader(m_FileLoader);
+
+		m_CollectionLoader->Release();
+		m_FileLoader->Release();
+		m_NativeFactory->Release();
+
+		m_CollectionLoader = 0;
+		m_FileLoader = 0;
+		m_NativeFactory = 0;
+	}
+
+	void MappedFontLoader::CheckDisposed()
+	{
+		if (m_FileLoader == 0)
+			throw gcnew ObjectDisposedException("MappedFontLoader");
+	}
+
+	int MappedFontLoader::AddFile(String ^path)
+	{
+		if (path == nullptr)
+			throw gcnew ArgumentNullException("path");
+
+		CheckDisposed();
+
+		pin_ptr<const wchar_t> pinnedPath = PtrToStringChars(path);
+		MappedFile *file = 0;
+		if (RECORD_DW(MappedFile::Open(pinnedPath, &file)).IsFailure)
+			return -1;
+
+		UINT32 key = 0;
+		HRESULT hr = m_FileLoader->AddFont(file, 0, file->GetSize(), &key);
+		file->Release();
+
+		if (RECORD_DW(hr).IsFailure)
+			return -1;
+
+		return static_cast<int>(key);
+	}
+
+	array<int> ^MappedFontLoader::AddArchive(String ^path, array<Int64> ^offsets, array<Int64> ^sizes)
+	{
+		if (path == nullptr)
+			throw gcnew ArgumentNullException("path");
+		if (offsets == nullptr)
+			throw gcnew ArgumentNullException("offsets");
+		if (sizes == nullptr)
+			throw gcnew ArgumentNullException("sizes");
+		if (sizes->Length != offsets->Length)
+			throw gcnew ArgumentException("There must be one size per offset.", "sizes");
+
+		CheckDisposed();
+
+		pin_ptr<const wchar_t> pinnedPath = PtrToStringChars(path);
+		MappedFile *file = 0;
+		if (RECORD_DW(MappedFile::Open(pinnedPath, &file)).IsFailure)
+			return nullptr;
+
+		// validate the whole index first, so that a bad entry does not leave part of the archive added
+		for (int i = 0; i < offsets->Length; i++)
+		{
+			UINT64 offset = static_cast<UINT64>(offsets[i]);
+			UINT64 size = static_cast<UINT64>(sizes[i]);
+			if (offsets[i] < 0 || sizes[i] < 0 || offset > file->GetSize() || size > file->GetSize() - offset)
+			{
+				file->Release();
+				throw gcnew ArgumentOutOfRangeException("offsets", "The index describes a font outside of the archive.");
+			}
+		}
+
+		array<int> ^keys = gcnew array<int>(offsets->Length);
+		for (int i = 0; i < offsets->Length; i++)
+		{
+			UINT32 key = 0;
+			m_FileLoader->AddFont(file, static_cast<UINT64>(offsets[i]), static_cast<UINT64>(sizes[i]), &key);
+			keys[i] = static_cast<int>(key);
+		}
+
+		file->Release();
+		return keys;
+	}
+
+	FontFile ^MappedFontLoader::CreateFontFileReference(int font)
+	{
+		CheckDisposed();
+		if (font < 0 || font >= static_cast<int>(m_FileLoader->GetFontCount()))
+			throw gcnew ArgumentOutOfRangeException("font");
+
+		UINT32 key = static_cast<UINT32>(font);
+		IDWriteFontFile *file = 0;
+		if (RECORD_DW(m_NativeFactory->CreateCustomFontFileReference(&key, sizeof(key), m_FileLoader, &file)).IsFailure)
+			return nullptr;
+
+		return FontFile::FromPointer(file);
+	}
+
+	FontCollection ^MappedFontLoader::CreateFontCollection(array<int> ^fonts)
+	{
+		if (fonts == nullptr)
+			throw gcnew ArgumentNullException("fonts");
+
+		CheckDisposed();
+
+		UINT32 key = 0;
+		pin_ptr<int> pinnedFonts;
+		if (fonts->Length > 0)
+			pinnedFonts = &fonts[0];
+
+		if (RECORD_DW(m_CollectionLoader->AddCollection(reinterpret_cast<UINT32*>(pinnedFonts), fonts->Length, &key)).IsFailure)
+			return nullptr;
+
+		IDWriteFontCollection *collection = 0;
+		if (RECORD_DW(m_NativeFactory->CreateCustomFontCollection(m_CollectionLoader, &key, sizeof(key), &collection)).IsFailure)
+			return nullptr;
+
+		return FontCollection::FromPointer(collection);
+	}
+
+	SlimDX::DirectWrite::Factory ^MappedFontLoader::Factory::get()
+	{
+		return m_Factory;
+	}
+
+	int MappedFontLoader::FontCount::get()
+	{
+		CheckDisposed();
+		return static_cast<int>(m_FileLoader->GetFontCount());
+	}
+}
+}
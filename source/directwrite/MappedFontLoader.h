@@ -0,0 +1,97 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "MappedFontFile.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class Factory;
+		ref class FontCollection;
+		ref class FontFile;
+
+		/// <summary>
+		/// Loads fonts from memory mapped files, entirely in native code.
+		/// </summary>
+		/// <remarks>
+		/// Unlike loaders implemented through <see cref="IFontFileLoader"/>, DirectWrite reads font data through pointers
+		/// straight into the mapped views, without calling into managed code or copying. Mapped pages come from the system
+		/// file cache and are shared with other processes using the same files. A file can hold a single font, or be an
+		/// archive of fonts described by an index of offsets and sizes. The loader registers itself and a matching font
+		/// collection loader with the factory when it is created, and unregisters both when it is disposed; fonts and
+		/// collections already created keep working after that. Files stay mapped while any font created from them is alive.
+		/// </remarks>
+		public ref class MappedFontLoader sealed
+		{
+		private:
+			IDWriteFactory* m_NativeFactory;
+			MappedFontFileLoader* m_FileLoader;
+			MappedFontCollectionLoader* m_CollectionLoader;
+			SlimDX::DirectWrite::Factory^ m_Factory;
+
+			void Destruct();
+			void CheckDisposed();
+
+		public:
+			MappedFontLoader( SlimDX::DirectWrite::Factory^ factory );
+			~MappedFontLoader();
+			!MappedFontLoader();
+
+			/// <summary>
+			/// Maps a font file.
+			/// </summary>
+			/// <returns>The index of the font within the loader, or -1 if the file could not be mapped.</returns>
+			int AddFile( System::String^ path );
+
+			/// <summary>
+			/// Maps an archive of fonts once and adds each font it contains.
+			/// </summary>
+			/// <param name="path">The path of the archive.</param>
+			/// <param name="offsets">The byte offset of each font within the archive.</param>
+			/// <param name="sizes">The size in bytes of each font.</param>
+			/// <returns>The index of each font within the loader, or <c>null</c> if the archive could not be mapped.</returns>
+			array<int>^ AddArchive( System::String^ path, array<System::Int64>^ offsets, array<System::Int64>^ sizes );
+
+			/// <summary>
+			/// Creates a reference to one of the fonts added to the loader.
+			/// </summary>
+			FontFile^ CreateFontFileReference( int font );
+
+			/// <summary>
+			/// Creates a font collection from fonts added to the loader.
+			/// </summary>
+			FontCollection^ CreateFontCollection( array<int>^ fonts );
+
+			property SlimDX::DirectWrite::Factory^ Factory
+			{
+				SlimDX::DirectWrite::Factory^ get();
+			}
+
+			property int FontCount
+			{
+				int get();
+			}
+		};
+	}
+}
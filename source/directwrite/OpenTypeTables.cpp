@@ -0,0 +1,525 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+#pragma managed(push, off)
+
+#include <algorithm>
+
+#include "OpenTypeTables.h"
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	namespace
+	{
+		// tags read from the font data are big-endian, unlike DWRITE_MAKE_OPENTYPE_TAG
+		const UINT32 KernFeatureTag = 0x6B65726E;
+
+		const UINT16 PairAdjustmentLookup = 2;
+		const UINT16 ExtensionLookup = 9;
+
+		// value record fields; only the horizontal advance of the first glyph is used for kerning
+		const UINT16 PlacementMask = 0x0003;
+		const UINT16 XAdvanceFlag = 0x0004;
+
+		// kern subtable coverage bits
+		const UINT16 KernHorizontal = 0x0001;
+		const UINT16 KernMinimum = 0x0002;
+		const UINT16 KernCrossStream = 0x0004;
+		const UINT16 KernOverride = 0x0008;
+
+		inline int CountBits( UINT16 value )
+		{
+			int count = 0;
+			for( ; value != 0; value &= value - 1 )
+				count++;
+			return count;
+		}
+	}
+
+	OpenTypeTables::OpenTypeTables( IDWriteFontFace* face )
+	: m_Face( face ), m_CharacterMapOffset( 0 ), m_CharacterMapFormat( 0 ), m_SymbolMap( false ), m_MetricsCount( 0 ), m_BearingCount( 0 )
+	{
+		m_Face->AddRef();
+
+		Acquire( DWRITE_MAKE_OPENTYPE_TAG( 'c', 'm', 'a', 'p' ), m_CharacterMap );
+		Acquire( DWRITE_MAKE_OPENTYPE_TAG( 'h', 'h', 'e', 'a' ), m_HorizontalHeader );
+		Acquire( DWRITE_MAKE_OPENTYPE_TAG( 'h', 'm', 't', 'x' ), m_HorizontalMetrics );
+		Acquire( DWRITE_MAKE_OPENTYPE_TAG( 'k', 'e', 'r', 'n' ), m_Kern );
+		Acquire( DWRITE_MAKE_OPENTYPE_TAG( 'G', 'P', 'O', 'S' ), m_Positioning );
+
+		ParseCharacterMap();
+		ParseMetrics();
+		ParseKern();
+		ParsePositioning();
+	}
+
+	OpenTypeTables::~OpenTypeTables()
+	{
+		Table* tables[] = { &m_CharacterMap, &m_HorizontalHeader, &m_HorizontalMetrics, &m_Kern, &m_Positioning };
+		for( int i = 0; i < _countof( tables ); i++ )
+		{
+			if( tables[i]->Context != NULL )
+				m_Face->ReleaseFontTable( tables[i]->Context );
+		}
+
+		m_Face->Release();
+	}
+
+	void OpenTypeTables::Acquire( UINT32 tag, Table& table )
+	{
+		const void* data = NULL;
+		BOOL exists = FALSE;
+		table.Data = NULL;
+		table.Size = 0;
+		table.Context = NULL;
+
+		if( FAILED( m_Face->TryGetFontTable( tag, &data, &table.Size, &table.Context, &exists ) ) || !exists )
+		{
+			// a missing table may still hand back a context to release
+			if( table.Context != NULL )
+				m_Face->ReleaseFontTable( table.Context );
+
+			table.Context = NULL;
+			table.Size = 0;
+			return;
+		}
+
+		table.Data = static_cast<const BYTE*>( data );
+	}
+
+	void OpenTypeTables::ParseCharacterMap()
+	{
+		// prefer full Unicode subtables, then BMP ones, then the Windows symbol encoding
+		int best = 0;
+		UINT16 count = ReadU16( m_CharacterMap, 2 );
+		for( UINT32 i = 0; i < count; i++ )
+		{
+			UINT32 record = 4 + i * 8;
+			UINT16 platform = ReadU16( m_CharacterMap, record );
+			UINT16 encoding = ReadU16( m_CharacterMap, record + 2 );
+			UINT32 offset = ReadU32( m_CharacterMap, record + 4 );
+			UINT16 format = ReadU16( m_CharacterMap, offset );
+
+			int score = 0;
+			if( format == 12 && ( ( platform == 3 && encoding == 10 ) || ( platform == 0 && ( encoding == 4 || encoding == 6 ) ) ) )
+				score = 4;
+			else if( format == 4 && ( ( platform == 3 && encoding == 1 ) || ( platform == 0 && encoding <= 3 ) ) )
+				score = 3;
+			else if( format == 4 && platform == 3 && encoding == 0 )
+				score = 1;
+
+			if( score > best )
+			{
+				best = score;
+				m_CharacterMapOffset = offset;
+				m_CharacterMapFormat = format;
+				m_SymbolMap = score == 1;
+			}
+		}
+	}
+
+	void OpenTypeTables::ParseMetrics()
+	{
+		if( m_HorizontalMetrics.Size == 0 )
+			return;
+
+		m_MetricsCount = std::min<UINT32>( ReadU16( m_HorizontalHeader, 34 ), m_HorizontalMetrics.Size / 4 );
+		m_BearingCount = ( m_HorizontalMetrics.Size - m_MetricsCount * 4 ) / 2;
+	}
+
+	void OpenTypeTables::ParseKern()
+	{
+		// only the Microsoft layout (version 0) is read; Apple's version 1 tables are left to DirectWrite
+		if( m_Kern.Size < 4 || ReadU16( m_Kern, 0 ) != 0 )
+			return;
+
+		UINT16 count = ReadU16( m_Kern, 2 );
+		UINT32 offset = 4;
+		for( UINT32 i = 0; i < count && offset + 6 <= m_Kern.Size; i++ )
+		{
+			UINT16 length = ReadU16( m_Kern, offset + 2 );
+			UINT16 coverage = ReadU16( m_Kern, offset + 4 );
+			if( ( coverage >> 8 ) == 0 && ( coverage & KernHorizontal ) != 0 && ( coverage & ( KernMinimum | KernCrossStream ) ) == 0 )
+				m_KernSubtables.push_back( offset );
+
+			if( length < 6 )
+				break;
+			offset += length;
+		}
+	}
+
+	void OpenTypeTables::ParsePositioning()
+	{
+		if( m_Positioning.Size < 10 || ReadU16( m_Positioning, 0 ) != 1 )
+			return;
+
+		UINT32 featureList = ReadU16( m_Positioning, 6 );
+		UINT32 lookupList = ReadU16( m_Positioning, 8 );
+
+		// lookups are applied in lookup list order, whichever script the 'kern' feature was found under
+		std::vector<UINT16> lookups;
+		UINT16 featureCount = ReadU16( m_Positioning, featureList );
+		for( UINT32 i = 0; i < featureCount; i++ )
+		{
+			UINT32 record = featureList + 2 + i * 6;
+			if( ReadU32( m_Positioning, record ) != KernFeatureTag )
+				continue;
+
+			UINT32 feature = featureList + ReadU16( m_Positioning, record + 4 );
+			UINT16 lookupCount = ReadU16( m_Positioning, feature + 2 );
+			for( UINT32 j = 0; j < lookupCount; j++ )
+				lookups.push_back( ReadU16( m_Positioning, feature + 4 + j * 2 ) );
+		}
+
+		std::sort( lookups.begin(), lookups.end() );
+		lookups.erase( std::unique( lookups.begin(), lookups.end() ), lookups.end() );
+
+		for( size_t i = 0; i < lookups.size(); i++ )
+			AddPairLookup( lookupList, lookups[i] );
+
+		if( !m_PairSubtables.empty() )
+			m_PairLookups.push_back( static_cast<UINT32>( m_PairSubtables.size() ) );
+	}
+
+	void OpenTypeTables::AddPairLookup( UINT32 lookupList, UINT16 lookup )
+	{
+		if( lookup >= ReadU16( m_Positioning, lookupList ) )
+			return;
+
+		UINT32 table = lookupList + ReadU16( m_Positioning, lookupList + 2 + lookup * 2 );
+		UINT16 type = ReadU16( m_Positioning, table );
+		if( type != PairAdjustmentLookup && type != ExtensionLookup )
+			return;
+
+		UINT32 start = static_cast<UINT32>( m_PairSubtables.size() );
+		UINT16 count = ReadU16( m_Positioning, table + 4 );
+		for( UINT32 i = 0; i < count; i++ )
+		{
+			UINT32 subtable = table + ReadU16( m_Positioning, table + 6 + i * 2 );
+			if( type == ExtensionLookup )
+			{
+				if( ReadU16( m_Positioning, subtable + 2 ) != PairAdjustmentLookup )
+					continue;
+
+				UINT64 target = static_cast<UINT64>( subtable ) + ReadU32( m_Positioning, subtable + 4 );
+				if( target >= m_Positioning.Size )
+					continue;
+
+				subtable = static_cast<UINT32>( target );
+			}
+
+			m_PairSubtables.push_back( subtable );
+		}
+
+		if( m_PairSubtables.size() > start )
+			m_PairLookups.push_back( start );
+	}
+
+	// Every read is bounds checked against the table; reads past the end return 0.
+	UINT16 OpenTypeTables::ReadU16( const Table& table, UINT64 offset )
+	{
+		if( offset + 2 > table.Size )
+			return 0;
+
+		const BYTE* data = table.Data + offset;
+		return static_cast<UINT16>( data[0] << 8 | data[1] );
+	}
+
+	UINT32 OpenTypeTables::ReadU32( const Table& table, UINT64 offset )
+	{
+		if( offset + 4 > table.Size )
+			return 0;
+
+		const BYTE* data = table.Data + offset;
+		return static_cast<UINT32>( data[0] ) << 24 | static_cast<UINT32>( data[1] ) << 16 | static_cast<UINT32>( data[2] ) << 8 | data[3];
+	}
+
+	UINT16 OpenTypeTables::GetClass( UINT32 classDefinition, UINT16 glyph ) const
+	{
+		const Table& gpos = m_Positioning;
+		UINT16 format = ReadU16( gpos, classDefinition );
+		if( format == 1 )
+		{
+			UINT16 first = ReadU16( gpos, classDefinition + 2 );
+			if( glyph < first || glyph - first >= ReadU16( gpos, classDefinition + 4 ) )
+				return 0;
+
+			return ReadU16( gpos, classDefinition + 6 + ( glyph - first ) * 2 );
+		}
+
+		if( format != 2 )
+			return 0;
+
+		UINT32 low = 0;
+		UINT32 high = ReadU16( gpos, classDefinition + 2 );
+		while( low < high )
+		{
+			UINT32 middle = low + ( high - low ) / 2;
+			UINT32 range = classDefinition + 4 + middle * 6;
+			if( ReadU16( gpos, range + 2 ) < glyph )
+				low = middle + 1;
+			else if( ReadU16( gpos, range ) > glyph )
+				high = middle;
+			else
+				return ReadU16( gpos, range + 4 );
+		}
+
+		// glyphs not listed are in class 0
+		return 0;
+	}
+
+	UINT16 OpenTypeTables::GetGlyphIndex( UINT32 codePoint ) const
+	{
+		const Table& map = m_CharacterMap;
+		UINT32 table = m_CharacterMapOffset;
+
+		if( m_CharacterMapFormat == 12 )
+		{
+			UINT32 count = std::min<UINT32>( ReadU32( map, table + 12 ), ( map.Size - std::min( map.Size, table + 16 ) ) / 12 );
+			UINT32 low = 0;
+			UINT32 high = count;
+			while( low < high )
+			{
+				UINT32 middle = low + ( high - low ) / 2;
+				UINT32 group = table + 16 + middle * 12;
+				if( codePoint > ReadU32( map, group + 4 ) )
+					low = middle + 1;
+				else if( codePoint < ReadU32( map, group ) )
+					high = middle;
+				else
+					return static_cast<UINT16>( ReadU32( map, group + 8 ) + ( codePoint - ReadU32( map, group ) ) );
+			}
+
+			return 0;
+		}
+
+		if( m_CharacterMapFormat != 4 )
+			return 0;
+
+		// symbol fonts map their characters into the private use area
+		if( m_SymbolMap && codePoint <= 0xFF )
+			codePoint += 0xF000;
+		if( codePoint > 0xFFFF )
+			return 0;
+
+		UINT32 segments = ReadU16( map, table + 6 ) / 2;
+		UINT32 ends = table + 14;
+		UINT32 starts = ends + segments * 2 + 2;
+		UINT32 deltas = starts + segments * 2;
+		UINT32 rangeOffsets = deltas + segments * 2;
+
+		// the first segment whose end is at or after the code point
+		UINT32 low = 0;
+		UINT32 high = segments;
+		while( low < high )
+		{
+			UINT32 middle = low + ( high - low ) / 2;
+			if( ReadU16( map, ends + middle * 2 ) < codePoint )
+				low = middle + 1;
+			else
+				high = middle;
+		}
+
+		if( low == segments )
+			return 0;
+
+		UINT16 start = ReadU16( map, starts + low * 2 );
+		if( codePoint < start )
+			return 0;
+
+		UINT16 delta = ReadU16( map, deltas + low * 2 );
+		UINT32 rangeOffset = ReadU16( map, rangeOffsets + low * 2 );
+		if( rangeOffset == 0 )
+			return static_cast<UINT16>( codePoint + delta );
+
+		// the range offset is relative to its own position in the table
+		UINT16 glyph = ReadU16( map, rangeOffsets + low * 2 + rangeOffset + ( codePoint - start ) * 2 );
+		return glyph == 0 ? 0 : static_cast<UINT16>( glyph + delta );
+	}
+
+	bool OpenTypeTables::GetHorizontalMetrics( UINT16 glyph, UINT16& advance, INT16& leftSideBearing ) const
+	{
+		if( glyph < m_MetricsCount )
+		{
+			advance = ReadU16( m_HorizontalMetrics, glyph * 4 );
+			leftSideBearing = static_cast<INT16>( ReadU16( m_HorizontalMetrics, glyph * 4 + 2 ) );
+			return true;
+		}
+
+		// glyphs after the last full record share its advance
+		if( m_MetricsCount == 0 || glyph - m_MetricsCount >= m_BearingCount )
+			return false;
+
+		advance = ReadU16( m_HorizontalMetrics, ( m_MetricsCount - 1 ) * 4 );
+		leftSideBearing = static_cast<INT16>( ReadU16( m_HorizontalMetrics, m_MetricsCount * 4 + ( glyph - m_MetricsCount ) * 2 ) );
+		return true;
+	}
+
+	INT32 OpenTypeTables::GetKerning( UINT16 left, UINT16 right ) const
+	{
+		INT32 kerning = 0;
+		if( !m_PairSubtables.empty() )
+		{
+			// within a lookup the first subtable that applies wins; the lookups themselves accumulate
+			for( size_t lookup = 0; lookup + 1 < m_PairLookups.size(); lookup++ )
+			{
+				for( UINT32 i = m_PairLookups[lookup]; i < m_PairLookups[lookup + 1]; i++ )
+				{
+					if( GetPairAdjustment( m_PairSubtables[i], left, right, kerning ) )
+						break;
+				}
+			}
+
+			return kerning;
+		}
+
+		UINT32 key = static_cast<UINT32>( left ) << 16 | right;
+		for( size_t i = 0; i < m_KernSubtables.size(); i++ )
+		{
+			UINT32 subtable = m_KernSubtables[i];
+			UINT32 pairs = subtable + 14;
+			UINT32 count = std::min<UINT32>( ReadU16( m_Kern, subtable + 6 ), ( m_Kern.Size - std::min( m_Kern.Size, pairs ) ) / 6 );
+
+			UINT32 low = 0;
+			UINT32 high = count;
+			while( low < high )
+			{
+				UINT32 middle = low + ( high - low ) / 2;
+				UINT32 pair = ReadU32( m_Kern, pairs + middle * 6 );
+				if( pair < key )
+					low = middle + 1;
+				else if( pair > key )
+					high = middle;
+				else
+				{
+					INT16 value = static_cast<INT16>( ReadU16( m_Kern, pairs + middle * 6 + 4 ) );
+					if( ReadU16( m_Kern, subtable + 4 ) & KernOverride )
+						kerning = value;
+					else
+						kerning += value;
+					break;
+				}
+			}
+		}
+
+		return kerning;
+	}
+
+	bool OpenTypeTables::GetPairAdjustment( UINT32 subtable, UINT16 left, UINT16 right, INT32& adjustment ) const
+	{
+		const Table& gpos = m_Positioning;
+		UINT16 format = ReadU16( gpos, subtable );
+		UINT32 coverage = subtable + ReadU16( gpos, subtable + 2 );
+		UINT16 valueFormat1 = ReadU16( gpos, subtable + 4 );
+		UINT16 valueFormat2 = ReadU16( gpos, subtable + 6 );
+		UINT32 size1 = CountBits( valueFormat1 ) * 2;
+		UINT32 size2 = CountBits( valueFormat2 ) * 2;
+		UINT32 advance = CountBits( valueFormat1 & PlacementMask ) * 2;
+
+		// the coverage index of the first glyph
+		INT32 index = -1;
+		UINT16 coverageFormat = ReadU16( gpos, coverage );
+		UINT32 low = 0;
+		UINT32 high = ReadU16( gpos, coverage + 2 );
+		while( low < high && index < 0 )
+		{
+			UINT32 middle = low + ( high - low ) / 2;
+			if( coverageFormat == 1 )
+			{
+				UINT16 glyph = ReadU16( gpos, coverage + 4 + middle * 2 );
+				if( glyph < left )
+					low = middle + 1;
+				else if( glyph > left )
+					high = middle;
+				else
+					index = middle;
+			}
+			else if( coverageFormat == 2 )
+			{
+				UINT32 range = coverage + 4 + middle * 6;
+				if( ReadU16( gpos, range + 2 ) < left )
+					low = middle + 1;
+				else if( ReadU16( gpos, range ) > left )
+					high = middle;
+				else
+					index = ReadU16( gpos, range + 4 ) + left - ReadU16( gpos, range );
+			}
+			else
+				break;
+		}
+
+		if( index < 0 )
+			return false;
+
+		if( format == 1 )
+		{
+			if( static_cast<UINT32>( index ) >= ReadU16( gpos, subtable + 8 ) )
+				return false;
+
+			UINT32 pairSet = subtable + ReadU16( gpos, subtable + 10 + index * 2 );
+			UINT32 recordSize = 2 + size1 + size2;
+			low = 0;
+			high = ReadU16( gpos, pairSet );
+			while( low < high )
+			{
+				UINT32 middle = low + ( high - low ) / 2;
+				UINT32 record = pairSet + 2 + middle * recordSize;
+				UINT16 second = ReadU16( gpos, record );
+				if( second < right )
+					low = middle + 1;
+				else if( second > right )
+					high = middle;
+				else
+				{
+					if( valueFormat1 & XAdvanceFlag )
+						adjustment += static_cast<INT16>( ReadU16( gpos, record + 2 + advance ) );
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		if( format != 2 )
+			return false;
+
+		UINT32 class1 = GetClass( subtable + ReadU16( gpos, subtable + 8 ), left );
+		UINT32 class2 = GetClass( subtable + ReadU16( gpos, subtable + 10 ), right );
+		UINT16 class1Count = ReadU16( gpos, subtable + 12 );
+		UINT16 class2Count = ReadU16( gpos, subtable + 14 );
+		if( class1 >= class1Count || class2 >= class2Count )
+			return false;
+
+		if( valueFormat1 & XAdvanceFlag )
+		{
+			UINT32 record = subtable + 16 + ( class1 * class2Count + class2 ) * ( size1 + size2 );
+			adjustment += static_cast<INT16>( ReadU16( gpos, record + advance ) );
+		}
+
+		return true;
+	}
+}
+}
+
+#pragma managed(pop)
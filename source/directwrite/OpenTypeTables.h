@@ -0,0 +1,99 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include <vector>
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	// Read-only views of the cmap, hhea/hmtx, kern and GPOS tables of one font face. The tables are acquired once
+	// and held until destruction; the header of each is parsed up front so that lookups read the big-endian font data
+	// in place, without copying or allocating. Malformed data yields glyph 0 and zero adjustments rather than failing.
+	// Lookups do not modify the object, so one instance can be shared between threads.
+	class OpenTypeTables
+	{
+	public:
+		explicit OpenTypeTables( IDWriteFontFace* face );
+		~OpenTypeTables();
+
+		UINT16 GetGlyphIndex( UINT32 codePoint ) const;
+
+		// Returns false if the font has no horizontal metrics or the glyph is out of range.
+		bool GetHorizontalMetrics( UINT16 glyph, UINT16& advance, INT16& leftSideBearing ) const;
+
+		// The horizontal advance adjustment of the first glyph of the pair, in design units. GPOS pair adjustments
+		// from the 'kern' feature take precedence over the kern table, as they do in DirectWrite itself.
+		INT32 GetKerning( UINT16 left, UINT16 right ) const;
+
+		IDWriteFontFace* GetFace() const { return m_Face; }
+		bool HasCharacterMap() const { return m_CharacterMapFormat != 0; }
+		bool HasHorizontalMetrics() const { return m_MetricsCount != 0; }
+		bool HasKerning() const { return !m_PairSubtables.empty() || !m_KernSubtables.empty(); }
+
+	private:
+		struct Table
+		{
+			const BYTE* Data;
+			UINT32 Size;
+			void* Context;
+		};
+
+		OpenTypeTables( const OpenTypeTables& );
+		OpenTypeTables& operator = ( const OpenTypeTables& );
+
+		void Acquire( UINT32 tag, Table& table );
+		void ParseCharacterMap();
+		void ParseMetrics();
+		void ParseKern();
+		void ParsePositioning();
+		void AddPairLookup( UINT32 lookupList, UINT16 lookup );
+		bool GetPairAdjustment( UINT32 subtable, UINT16 left, UINT16 right, INT32& adjustment ) const;
+		UINT16 GetClass( UINT32 classDefinition, UINT16 glyph ) const;
+
+		static UINT16 ReadU16( const Table& table, UINT64 offset );
+		static UINT32 ReadU32( const Table& table, UINT64 offset );
+
+		IDWriteFontFace* m_Face;
+		Table m_CharacterMap;
+		Table m_HorizontalHeader;
+		Table m_HorizontalMetrics;
+		Table m_Kern;
+		Table m_Positioning;
+
+		// offset of the chosen cmap subtable within the cmap table, and its format (4 or 12, 0 if none)
+		UINT32 m_CharacterMapOffset;
+		UINT16 m_CharacterMapFormat;
+		bool m_SymbolMap;
+
+		UINT32 m_MetricsCount;
+		UINT32 m_BearingCount;
+
+		// offsets of horizontal format 0 kern subtables, and of pair adjustment subtables within the GPOS table;
+		// the subtables of lookup i are m_PairSubtables[m_PairLookups[i]] to m_PairSubtables[m_PairLookups[i + 1]]
+		std::vector<UINT32> m_KernSubtables;
+		std::vector<UINT32> m_PairSubtables;
+		std::vector<UINT32> m_PairLookups;
+	};
+}
+}
@@ -0,0 +1,172 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "ShapedRun.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	ShapedRun::ShapedRun(const ShapedRunData &data)
+		: m_TextLength(data.TextLength), m_GlyphCount(data.GlyphCount), m_ClusterMap(data.ClusterMap), m_TextProperties(data.TextProperties),
+		  m_GlyphIndices(data.GlyphIndices), m_GlyphProperties(data.GlyphProperties), m_GlyphAdvances(data.GlyphAdvances), m_GlyphOffsets(data.GlyphOffsets)
+	{
+	}
+
+	static void CheckDestination(Array ^destination, int destinationIndex, int count)
+	{
+		if (destination == nullptr)
+			throw gcnew ArgumentNullException("destination");
+		if (destinationIndex < 0 || destinationIndex > destination->Length - count)
+			throw gcnew ArgumentOutOfRangeException("destinationIndex");
+	}
+
+	int ShapedRun::CheckGlyph(int index)
+	{
+		if (index < 0 || index >= m_GlyphCount)
+			throw gcnew ArgumentOutOfRangeException("index");
+
+		return index;
+	}
+
+	int ShapedRun::TextLength::get()
+	{
+		return m_TextLength;
+	}
+
+	int ShapedRun::GlyphCount::get()
+	{
+		return m_GlyphCount;
+	}
+
+	IntPtr ShapedRun::ClusterMapPointer::get()
+	{
+		return IntPtr(const_cast<UINT16*>(m_ClusterMap));
+	}
+
+	IntPtr ShapedRun::TextPropertiesPointer::get()
+	{
+		return IntPtr(const_cast<DWRITE_SHAPING_TEXT_PROPERTIES*>(m_TextProperties));
+	}
+
+	IntPtr ShapedRun::GlyphIndicesPointer::get()
+	{
+		return IntPtr(const_cast<UINT16*>(m_GlyphIndices));
+	}
+
+	IntPtr ShapedRun::GlyphPropertiesPointer::get()
+	{
+		return IntPtr(const_cast<DWRITE_SHAPING_GLYPH_PROPERTIES*>(m_GlyphProperties));
+	}
+
+	IntPtr ShapedRun::GlyphAdvancesPointer::get()
+	{
+		return IntPtr(const_cast<FLOAT*>(m_GlyphAdvances));
+	}
+
+	IntPtr ShapedRun::GlyphOffsetsPointer::get()
+	{
+		return IntPtr(const_cast<DWRITE_GLYPH_OFFSET*>(m_GlyphOffsets));
+	}
+
+	short ShapedRun::GetClusterMapEntry(int index)
+	{
+		if (index < 0 || index >= m_TextLength)
+			throw gcnew ArgumentOutOfRangeException("index");
+
+		return m_ClusterMap[index];
+	}
+
+	short ShapedRun::GetGlyphIndex(int index)
+	{
+		return m_GlyphIndices[CheckGlyph(index)];
+	}
+
+	float ShapedRun::GetGlyphAdvance(int index)
+	{
+		return m_GlyphAdvances[CheckGlyph(index)];
+	}
+
+	GlyphOffset ShapedRun::GetGlyphOffset(int index)
+	{
+		index = CheckGlyph(index);
+
+		GlyphOffset result;
+		result.AdvanceOffset = m_GlyphOffsets[index].advanceOffset;
+		result.AscenderOffset = m_GlyphOffsets[index].ascenderOffset;
+		return result;
+	}
+
+	bool ShapedRun::IsClusterStart(int index)
+	{
+		return m_GlyphProperties[CheckGlyph(index)].isClusterStart != 0;
+	}
+
+	bool ShapedRun::IsDiacritic(int index)
+	{
+		return m_GlyphProperties[CheckGlyph(index)].isDiacritic != 0;
+	}
+
+	void ShapedRun::CopyClusterMap(array<short> ^destination, int destinationIndex)
+	{
+		CheckDestination(destination, destinationIndex, m_TextLength);
+		if (m_TextLength > 0)
+		{
+			pin_ptr<short> pinned = &destination[destinationIndex];
+			memcpy(pinned, m_ClusterMap, sizeof(UINT16) * m_TextLength);
+		}
+	}
+
+	void ShapedRun::CopyGlyphIndices(array<short> ^destination, int destinationIndex)
+	{
+		CheckDestination(destination, destinationIndex, m_GlyphCount);
+		if (m_GlyphCount > 0)
+		{
+			pin_ptr<short> pinned = &destination[destinationIndex];
+			memcpy(pinned, m_GlyphIndices, sizeof(UINT16) * m_GlyphCount);
+		}
+	}
+
+	void ShapedRun::CopyGlyphAdvances(array<float> ^destination, int destinationIndex)
+	{
+		CheckDestination(destination, destinationIndex, m_GlyphCount);
+		if (m_GlyphCount > 0)
+		{
+			pin_ptr<float> pinned = &destination[destinationIndex];
+			memcpy(pinned, m_GlyphAdvances, sizeof(FLOAT) * m_GlyphCount);
+		}
+	}
+
+	void ShapedRun::CopyGlyphOffsets(array<GlyphOffset> ^destination, int destinationIndex)
+	{
+		CheckDestination(destination, destinationIndex, m_GlyphCount);
+		if (m_GlyphCount > 0)
+		{
+			pin_ptr<GlyphOffset> pinned = &destination[destinationIndex];
+			memcpy(pinned, m_GlyphOffsets, sizeof(DWRITE_GLYPH_OFFSET) * m_GlyphCount);
+		}
+	}
+}
+}
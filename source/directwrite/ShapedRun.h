@@ -0,0 +1,136 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "GlyphOffset.h"
+#include "ShapingArena.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		/// <summary>
+		/// A view of a run shaped by a <see cref="ShapingCache"/>.
+		/// </summary>
+		/// <remarks>
+		/// The view points into memory owned by the cache, so it is only valid until the next call to
+		/// <see cref="ShapingCache::Shape"/>, <see cref="ShapingCache::Clear"/> or until the cache is disposed.
+		/// Copy the arrays out to keep them.
+		/// </remarks>
+		public value class ShapedRun
+		{
+		private:
+			int m_TextLength;
+			int m_GlyphCount;
+			const UINT16 *m_ClusterMap;
+			const DWRITE_SHAPING_TEXT_PROPERTIES *m_TextProperties;
+			const UINT16 *m_GlyphIndices;
+			const DWRITE_SHAPING_GLYPH_PROPERTIES *m_GlyphProperties;
+			const FLOAT *m_GlyphAdvances;
+			const DWRITE_GLYPH_OFFSET *m_GlyphOffsets;
+
+			int CheckGlyph(int index);
+
+		internal:
+			ShapedRun(const ShapedRunData &data);
+
+		public:
+			property int TextLength
+			{
+				int get();
+			}
+
+			property int GlyphCount
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the cluster map, one 16-bit glyph index per character.
+			/// </summary>
+			property System::IntPtr ClusterMapPointer
+			{
+				System::IntPtr get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the 16-bit shaping properties of each character.
+			/// </summary>
+			property System::IntPtr TextPropertiesPointer
+			{
+				System::IntPtr get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the 16-bit glyph indices.
+			/// </summary>
+			property System::IntPtr GlyphIndicesPointer
+			{
+				System::IntPtr get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the 16-bit shaping properties of each glyph.
+			/// </summary>
+			property System::IntPtr GlyphPropertiesPointer
+			{
+				System::IntPtr get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the glyph advances, as 32-bit floats.
+			/// </summary>
+			property System::IntPtr GlyphAdvancesPointer
+			{
+				System::IntPtr get();
+			}
+
+			/// <summary>
+			/// Gets a pointer to the glyph offsets, laid out as <see cref="GlyphOffset"/> values.
+			/// </summary>
+			property System::IntPtr GlyphOffsetsPointer
+			{
+				System::IntPtr get();
+			}
+
+			short GetClusterMapEntry(int index);
+			short GetGlyphIndex(int index);
+			float GetGlyphAdvance(int index);
+			GlyphOffset GetGlyphOffset(int index);
+
+			/// <summary>
+			/// Gets a value indicating whether a glyph starts a cluster.
+			/// </summary>
+			bool IsClusterStart(int index);
+
+			/// <summary>
+			/// Gets a value indicating whether a glyph is a diacritic.
+			/// </summary>
+			bool IsDiacritic(int index);
+
+			void CopyClusterMap(array<short> ^destination, int destinationIndex);
+			void CopyGlyphIndices(array<short> ^destination, int destinationIndex);
+			void CopyGlyphAdvances(array<float> ^destination, int destinationIndex);
+			void CopyGlyphOffsets(array<GlyphOffset> ^destination, int destinationIndex);
+		};
+	}
+}
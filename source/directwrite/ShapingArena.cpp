@@ -0,0 +1,356 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+#pragma managed(push, off)
+
+#include "ShapingArena.h"
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	namespace
+	{
+		const size_t Alignment = 8;
+
+		// DirectWrite's recommended initial glyph buffer size; it is doubled until GetGlyphs stops asking for more
+		UINT32 EstimateGlyphCount( UINT32 textLength )
+		{
+			return textLength * 3 / 2 + 16;
+		}
+
+		size_t Align( size_t size )
+		{
+			return ( size + Alignment - 1 ) & ~( Alignment - 1 );
+		}
+
+		UINT64 Combine( UINT64 hash, const void* data, size_t size )
+		{
+			// FNV-1a
+			const BYTE* bytes = static_cast<const BYTE*>( data );
+			for( size_t i = 0; i < size; i++ )
+				hash = ( hash ^ bytes[i] ) * 1099511628211ULL;
+
+			return hash;
+		}
+	}
+
+	// The entry header is followed by its arrays, widest elements first so that each one stays aligned:
+	// features, advances, offsets, text, cluster map, text properties, glyph indices, glyph properties.
+	struct ShapingArena::Entry
+	{
+		UINT64 Hash;
+		IDWriteFontFace* Face;
+		const WCHAR* LocaleName;
+		FLOAT EmSize;
+		DWRITE_SCRIPT_ANALYSIS Script;
+		BOOL IsSideways;
+		BOOL IsRightToLeft;
+		UINT32 TextLength;
+		UINT32 GlyphCount;
+		UINT32 FeatureCount;
+
+		static size_t SizeOf( UINT32 textLength, UINT32 glyphCount, UINT32 featureCount )
+		{
+			return Align( sizeof( Entry ) + featureCount * sizeof( DWRITE_FONT_FEATURE ) +
+				glyphCount * ( sizeof( FLOAT ) + sizeof( DWRITE_GLYPH_OFFSET ) + sizeof( UINT16 ) + sizeof( DWRITE_SHAPING_GLYPH_PROPERTIES ) ) +
+				textLength * ( sizeof( WCHAR ) + sizeof( UINT16 ) + sizeof( DWRITE_SHAPING_TEXT_PROPERTIES ) ) );
+		}
+
+		DWRITE_FONT_FEATURE* Features() { return reinterpret_cast<DWRITE_FONT_FEATURE*>( this + 1 ); }
+		FLOAT* Advances() { return reinterpret_cast<FLOAT*>( Features() + FeatureCount ); }
+		DWRITE_GLYPH_OFFSET* Offsets() { return reinterpret_cast<DWRITE_GLYPH_OFFSET*>( Advances() + GlyphCount ); }
+		WCHAR* Text() { return reinterpret_cast<WCHAR*>( Offsets() + GlyphCount ); }
+		UINT16* ClusterMap() { return reinterpret_cast<UINT16*>( Text() + TextLength ); }
+		DWRITE_SHAPING_TEXT_PROPERTIES* TextProperties() { return reinterpret_cast<DWRITE_SHAPING_TEXT_PROPERTIES*>( ClusterMap() + TextLength ); }
+		UINT16* GlyphIndices() { return reinterpret_cast<UINT16*>( TextProperties() + TextLength ); }
+		DWRITE_SHAPING_GLYPH_PROPERTIES* GlyphProperties() { return reinterpret_cast<DWRITE_SHAPING_GLYPH_PROPERTIES*>( GlyphIndices() + GlyphCount ); }
+	};
+
+	ShapingArena::ShapingArena( IDWriteTextAnalyzer* analyzer, UINT32 chunkSize, UINT32 chunkCount )
+	: m_Analyzer( analyzer ), m_ChunkSize( chunkSize ), m_Chunks( chunkCount ), m_Current( 0 ), m_GlyphCount( 0 ),
+	  m_Hits( 0 ), m_Misses( 0 ), m_Evictions( 0 )
+	{
+		m_Analyzer->AddRef();
+
+		for( size_t i = 0; i < m_Chunks.size(); i++ )
+			m_Chunks[i].Used = 0;
+	}
+
+	ShapingArena::~ShapingArena()
+	{
+		Clear();
+		m_Analyzer->Release();
+	}
+
+	size_t ShapingArena::GetMemoryUsage() const
+	{
+		size_t total = 0;
+		for( size_t i = 0; i < m_Chunks.size(); i++ )
+			total += m_Chunks[i].Memory.size();
+
+		return total;
+	}
+
+	HRESULT ShapingArena::Shape( const ShapingKey& key, ShapedRunData& result )
+	{
+		memset( &result, 0, sizeof( result ) );
+		if( key.TextLength == 0 )
+			return S_OK;
+
+		ShapingKey normalized = key;
+		if( normalized.LocaleName == NULL )
+			normalized.LocaleName = L"";
+		if( normalized.FeatureCount == 0 )
+			normalized.Features = NULL;
+
+		UINT64 hash = Hash( normalized );
+		typedef std::unordered_multimap<UINT64, Entry*>::const_iterator Iterator;
+		std::pair<Iterator, Iterator> range = m_Entries.equal_range( hash );
+		for( Iterator it = range.first; it != range.second; ++it )
+		{
+			if( Matches( it->second, normalized ) )
+			{
+				m_Hits++;
+				Read( it->second, result );
+				return S_OK;
+			}
+		}
+
+		m_Misses++;
+		HRESULT hr = Analyze( normalized );
+		if( FAILED( hr ) )
+			return hr;
+
+		Entry* entry = Store( normalized, hash );
+		if( entry != NULL )
+		{
+			Read( entry, result );
+			return S_OK;
+		}
+
+		// too large for a chunk, hand out the scratch buffers instead
+		result.TextLength = key.TextLength;
+		result.GlyphCount = m_GlyphCount;
+		result.ClusterMap = &m_ClusterMap[0];
+		result.TextProperties = &m_TextProperties[0];
+		result.GlyphIndices = &m_GlyphIndices[0];
+		result.GlyphProperties = &m_GlyphProperties[0];
+		result.GlyphAdvances = &m_GlyphAdvances[0];
+		result.GlyphOffsets = &m_GlyphOffsets[0];
+		return S_OK;
+	}
+
+	void ShapingArena::Clear()
+	{
+		for( size_t i = 0; i < m_Chunks.size(); i++ )
+		{
+			std::vector<BYTE>().swap( m_Chunks[i].Memory );
+			m_Chunks[i].Entries.clear();
+			m_Chunks[i].Used = 0;
+		}
+
+		for( std::unordered_map<IDWriteFontFace*, UINT32>::iterator it = m_Faces.begin(); it != m_Faces.end(); ++it )
+			it->first->Release();
+
+		m_Faces.clear();
+		m_Entries.clear();
+		m_Locales.clear();
+		m_Current = 0;
+	}
+
+	UINT64 ShapingArena::Hash( const ShapingKey& key )
+	{
+		UINT64 hash = 14695981039346656037ULL;
+		hash = Combine( hash, key.Text, key.TextLength * sizeof( WCHAR ) );
+		hash = Combine( hash, &key.Face, sizeof( key.Face ) );
+		hash = Combine( hash, &key.EmSize, sizeof( key.EmSize ) );
+		hash = Combine( hash, &key.Script.script, sizeof( key.Script.script ) );
+		hash = Combine( hash, &key.Script.shapes, sizeof( key.Script.shapes ) );
+		hash = Combine( hash, key.LocaleName, wcslen( key.LocaleName ) * sizeof( WCHAR ) );
+		hash = Combine( hash, key.Features, key.FeatureCount * sizeof( DWRITE_FONT_FEATURE ) );
+
+		BYTE flags = static_cast<BYTE>( ( key.IsSideways ? 1 : 0 ) | ( key.IsRightToLeft ? 2 : 0 ) );
+		return Combine( hash, &flags, sizeof( flags ) );
+	}
+
+	bool ShapingArena::Matches( const Entry* entry, const ShapingKey& key )
+	{
+		Entry* e = const_cast<Entry*>( entry );
+		return e->Face == key.Face && e->EmSize == key.EmSize && e->TextLength == key.TextLength && e->FeatureCount == key.FeatureCount &&
+			e->Script.script == key.Script.script && e->Script.shapes == key.Script.shapes &&
+			!e->IsSideways == !key.IsSideways && !e->IsRightToLeft == !key.IsRightToLeft &&
+			wcscmp( e->LocaleName, key.LocaleName ) == 0 &&
+			memcmp( e->Text(), key.Text, key.TextLength * sizeof( WCHAR ) ) == 0 &&
+			( key.FeatureCount == 0 || memcmp( e->Features(), key.Features, key.FeatureCount * sizeof( DWRITE_FONT_FEATURE ) ) == 0 );
+	}
+
+	void ShapingArena::Read( const Entry* entry, ShapedRunData& result )
+	{
+		Entry* e = const_cast<Entry*>( entry );
+		result.TextLength = e->TextLength;
+		result.GlyphCount = e->GlyphCount;
+		result.ClusterMap = e->ClusterMap();
+		result.TextProperties = e->TextProperties();
+		result.GlyphIndices = e->GlyphIndices();
+		result.GlyphProperties = e->GlyphProperties();
+		result.GlyphAdvances = e->Advances();
+		result.GlyphOffsets = e->Offsets();
+	}
+
+	HRESULT ShapingArena::Analyze( const ShapingKey& key )
+	{
+		DWRITE_TYPOGRAPHIC_FEATURES typographic = { const_cast<DWRITE_FONT_FEATURE*>( key.Features ), key.FeatureCount };
+		const DWRITE_TYPOGRAPHIC_FEATURES* features = &typographic;
+		UINT32 rangeLength = key.TextLength;
+		UINT32 rangeCount = key.FeatureCount > 0 ? 1 : 0;
+
+		m_ClusterMap.resize( key.TextLength );
+		m_TextProperties.resize( key.TextLength );
+
+		UINT32 maxGlyphCount = EstimateGlyphCount( key.TextLength );
+		if( m_GlyphIndices.size() > maxGlyphCount )
+			maxGlyphCount = static_cast<UINT32>( m_GlyphIndices.size() );
+
+		HRESULT hr;
+		for( ;; )
+		{
+			m_GlyphIndices.resize( maxGlyphCount );
+			m_GlyphProperties.resize( maxGlyphCount );
+
+			hr = m_Analyzer->GetGlyphs( key.Text, key.TextLength, key.Face, key.IsSideways, key.IsRightToLeft, &key.Script, key.LocaleName, NULL,
+				rangeCount > 0 ? &features : NULL, rangeCount > 0 ? &rangeLength : NULL, rangeCount, maxGlyphCount,
+				&m_ClusterMap[0], &m_TextProperties[0], &m_GlyphIndices[0], &m_GlyphProperties[0], &m_GlyphCount );
+
+			if( hr != HRESULT_FROM_WIN32( ERROR_INSUFFICIENT_BUFFER ) )
+				break;
+
+			maxGlyphCount *= 2;
+		}
+
+		if( FAILED( hr ) )
+			return hr;
+
+		// keep at least one element so that the scratch buffers can always be addressed
+		m_GlyphAdvances.resize( m_GlyphCount > 0 ? m_GlyphCount : 1 );
+		m_GlyphOffsets.resize( m_GlyphCount > 0 ? m_GlyphCount : 1 );
+
+		return m_Analyzer->GetGlyphPlacements( key.Text, &m_ClusterMap[0], &m_TextProperties[0], key.TextLength, &m_GlyphIndices[0], &m_GlyphProperties[0],
+			m_GlyphCount, key.Face, key.EmSize, key.IsSideways, key.IsRightToLeft, &key.Script, key.LocaleName,
+			rangeCount > 0 ? &features : NULL, rangeCount > 0 ? &rangeLength : NULL, rangeCount, &m_GlyphAdvances[0], &m_GlyphOffsets[0] );
+	}
+
+	ShapingArena::Entry* ShapingArena::Store( const ShapingKey& key, UINT64 hash )
+	{
+		size_t size = Entry::SizeOf( key.TextLength, m_GlyphCount, key.FeatureCount );
+		if( size > m_ChunkSize || m_Chunks.empty() )
+			return NULL;
+
+		Entry* entry = reinterpret_cast<Entry*>( Allocate( size ) );
+		entry->Hash = hash;
+		entry->Face = key.Face;
+		entry->LocaleName = Intern( key.LocaleName );
+		entry->EmSize = key.EmSize;
+		entry->Script = key.Script;
+		entry->IsSideways = key.IsSideways;
+		entry->IsRightToLeft = key.IsRightToLeft;
+		entry->TextLength = key.TextLength;
+		entry->GlyphCount = m_GlyphCount;
+		entry->FeatureCount = key.FeatureCount;
+
+		if( key.FeatureCount > 0 )
+			memcpy( entry->Features(), key.Features, key.FeatureCount * sizeof( DWRITE_FONT_FEATURE ) );
+		memcpy( entry->Text(), key.Text, key.TextLength * sizeof( WCHAR ) );
+		memcpy( entry->ClusterMap(), &m_ClusterMap[0], key.TextLength * sizeof( UINT16 ) );
+		memcpy( entry->TextProperties(), &m_TextProperties[0], key.TextLength * sizeof( DWRITE_SHAPING_TEXT_PROPERTIES ) );
+		if( m_GlyphCount > 0 )
+		{
+			memcpy( entry->GlyphIndices(), &m_GlyphIndices[0], m_GlyphCount * sizeof( UINT16 ) );
+			memcpy( entry->GlyphProperties(), &m_GlyphProperties[0], m_GlyphCount * sizeof( DWRITE_SHAPING_GLYPH_PROPERTIES ) );
+			memcpy( entry->Advances(), &m_GlyphAdvances[0], m_GlyphCount * sizeof( FLOAT ) );
+			memcpy( entry->Offsets(), &m_GlyphOffsets[0], m_GlyphCount * sizeof( DWRITE_GLYPH_OFFSET ) );
+		}
+
+		UINT32& references = m_Faces[key.Face];
+		if( references++ == 0 )
+			key.Face->AddRef();
+
+		m_Chunks[m_Current].Entries.push_back( entry );
+		m_Entries.insert( std::make_pair( hash, entry ) );
+		return entry;
+	}
+
+	BYTE* ShapingArena::Allocate( size_t size )
+	{
+		if( m_Chunks[m_Current].Used + size > m_ChunkSize )
+		{
+			m_Current = ( m_Current + 1 ) % m_Chunks.size();
+			Recycle( m_Chunks[m_Current] );
+		}
+
+		Chunk& chunk = m_Chunks[m_Current];
+		if( chunk.Memory.empty() )
+			chunk.Memory.resize( m_ChunkSize );
+
+		BYTE* memory = &chunk.Memory[chunk.Used];
+		chunk.Used += size;
+		return memory;
+	}
+
+	void ShapingArena::Recycle( Chunk& chunk )
+	{
+		for( size_t i = 0; i < chunk.Entries.size(); i++ )
+		{
+			Entry* entry = chunk.Entries[i];
+
+			typedef std::unordered_multimap<UINT64, Entry*>::iterator Iterator;
+			std::pair<Iterator, Iterator> range = m_Entries.equal_range( entry->Hash );
+			for( Iterator it = range.first; it != range.second; ++it )
+			{
+				if( it->second == entry )
+				{
+					m_Entries.erase( it );
+					break;
+				}
+			}
+
+			std::unordered_map<IDWriteFontFace*, UINT32>::iterator face = m_Faces.find( entry->Face );
+			if( --face->second == 0 )
+			{
+				face->first->Release();
+				m_Faces.erase( face );
+			}
+		}
+
+		m_Evictions += chunk.Entries.size();
+		chunk.Entries.clear();
+		chunk.Used = 0;
+	}
+
+	const WCHAR* ShapingArena::Intern( const WCHAR* localeName )
+	{
+		return m_Locales.insert( std::wstring( localeName ) ).first->c_str();
+	}
+}
+}
+
+#pragma managed(pop)
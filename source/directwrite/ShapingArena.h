@@ -0,0 +1,129 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	// Everything that determines the output of IDWriteTextAnalyzer::GetGlyphs and GetGlyphPlacements for one run.
+	// The features, if any, apply to the whole run; number substitution is not supported.
+	struct ShapingKey
+	{
+		const WCHAR* Text;
+		UINT32 TextLength;
+		IDWriteFontFace* Face;
+		FLOAT EmSize;
+		BOOL IsSideways;
+		BOOL IsRightToLeft;
+		DWRITE_SCRIPT_ANALYSIS Script;
+		const WCHAR* LocaleName;
+		const DWRITE_FONT_FEATURE* Features;
+		UINT32 FeatureCount;
+	};
+
+	// A shaped run; the arrays point into the arena and stay valid until the next call to Shape or Clear.
+	struct ShapedRunData
+	{
+		UINT32 TextLength;
+		UINT32 GlyphCount;
+		const UINT16* ClusterMap;
+		const DWRITE_SHAPING_TEXT_PROPERTIES* TextProperties;
+		const UINT16* GlyphIndices;
+		const DWRITE_SHAPING_GLYPH_PROPERTIES* GlyphProperties;
+		const FLOAT* GlyphAdvances;
+		const DWRITE_GLYPH_OFFSET* GlyphOffsets;
+	};
+
+	// Caches the results of shaping text runs. Each entry stores its key and all of its output arrays in one block
+	// carved out of a fixed number of equally sized chunks; when the chunks are full the oldest one is emptied and
+	// reused, evicting every entry in it. Runs larger than a chunk are shaped into scratch buffers and not cached.
+	// Not thread safe.
+	class ShapingArena
+	{
+	public:
+		ShapingArena( IDWriteTextAnalyzer* analyzer, UINT32 chunkSize, UINT32 chunkCount );
+		~ShapingArena();
+
+		HRESULT Shape( const ShapingKey& key, ShapedRunData& result );
+		void Clear();
+
+		UINT32 GetChunkSize() const { return m_ChunkSize; }
+		UINT32 GetChunkCount() const { return static_cast<UINT32>( m_Chunks.size() ); }
+		UINT32 GetCount() const { return static_cast<UINT32>( m_Entries.size() ); }
+		size_t GetMemoryUsage() const;
+		int64_t GetHits() const { return m_Hits; }
+		int64_t GetMisses() const { return m_Misses; }
+		int64_t GetEvictions() const { return m_Evictions; }
+
+	private:
+		struct Entry;
+
+		struct Chunk
+		{
+			std::vector<BYTE> Memory;
+			size_t Used;
+			std::vector<Entry*> Entries;
+		};
+
+		ShapingArena( const ShapingArena& );
+		ShapingArena& operator = ( const ShapingArena& );
+
+		static UINT64 Hash( const ShapingKey& key );
+		static bool Matches( const Entry* entry, const ShapingKey& key );
+		static void Read( const Entry* entry, ShapedRunData& result );
+
+		HRESULT Analyze( const ShapingKey& key );
+		Entry* Store( const ShapingKey& key, UINT64 hash );
+		BYTE* Allocate( size_t size );
+		void Recycle( Chunk& chunk );
+		const WCHAR* Intern( const WCHAR* localeName );
+
+		IDWriteTextAnalyzer* m_Analyzer;
+		UINT32 m_ChunkSize;
+		std::vector<Chunk> m_Chunks;
+		UINT32 m_Current;
+
+		std::unordered_multimap<UINT64, Entry*> m_Entries;
+		std::unordered_map<IDWriteFontFace*, UINT32> m_Faces;
+		std::unordered_set<std::wstring> m_Locales;
+
+		// output of the analyzer, reused between misses
+		std::vector<UINT16> m_ClusterMap;
+		std::vector<DWRITE_SHAPING_TEXT_PROPERTIES> m_TextProperties;
+		std::vector<UINT16> m_GlyphIndices;
+		std::vector<DWRITE_SHAPING_GLYPH_PROPERTIES> m_GlyphProperties;
+		std::vector<FLOAT> m_GlyphAdvances;
+		std::vector<DWRITE_GLYPH_OFFSET> m_GlyphOffsets;
+		UINT32 m_GlyphCount;
+
+		int64_t m_Hits;
+		int64_t m_Misses;
+		int64_t m_Evictions;
+	};
+}
+}
@@ -0,0 +1,174 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "DirectWriteException.h"
+#include "FontFace.h"
+#include "ShapingCache.h"
+#include "TextAnalyzer.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	ShapingCache::ShapingCache(TextAnalyzer ^analyzer)
+	{
+		if (analyzer == nullptr)
+			throw gcnew ArgumentNullException("analyzer");
+
+		// Manual Allocation: released in Destruct
+		m_Arena = new ShapingArena(analyzer->InternalPointer, 64 * 1024, 16);
+		m_Analyzer = analyzer;
+		m_Pressure = 64 * 1024 * 16;
+		GC::AddMemoryPressure(m_Pressure);
+	}
+
+	ShapingCache::ShapingCache(TextAnalyzer ^analyzer, int chunkSize, int chunkCount)
+	{
+		if (analyzer == nullptr)
+			throw gcnew ArgumentNullException("analyzer");
+		if (chunkSize <= 0)
+			throw gcnew ArgumentOutOfRangeException("chunkSize");
+		if (chunkCount <= 0)
+			throw gcnew ArgumentOutOfRangeException("chunkCount");
+
+		// Manual Allocation: released in Destruct
+		m_Arena = new ShapingArena(analyzer->InternalPointer, chunkSize, chunkCount);
+		m_Analyzer = analyzer;
+		m_Pressure = static_cast<Int64>(chunkSize) * chunkCount;
+		GC::AddMemoryPressure(m_Pressure);
+	}
+
+	ShapingCache::~ShapingCache()
+	{
+		Destruct();
+		GC::SuppressFinalize(this);
+	}
+
+	ShapingCache::!ShapingCache()
+	{
+		Destruct();
+	}
+
+	void ShapingCache::Destruct()
+	{
+		if (m_Arena == 0)
+			return;
+
+		delete m_Arena;
+		m_Arena = 0;
+		GC::RemoveMemoryPressure(m_Pressure);
+	}
+
+	ShapingArena *ShapingCache::Arena()
+	{
+		if (m_Arena == 0)
+			throw gcnew ObjectDisposedException("ShapingCache");
+
+		return m_Arena;
+	}
+
+	ShapedRun ShapingCache::Shape(String ^text, int textIndex, int length, FontFace ^fontFace, float fontSize, bool isSideways, bool isRightToLeft,
+		ScriptAnalysis script, String ^localeName)
+	{
+		return Shape(text, textIndex, length, fontFace, fontSize, isSideways, isRightToLeft, script, localeName, nullptr);
+	}
+
+	ShapedRun ShapingCache::Shape(String ^text, int textIndex, int length, FontFace ^fontFace, float fontSize, bool isSideways, bool isRightToLeft,
+		ScriptAnalysis script, String ^localeName, array<FontFeature> ^features)
+	{
+		if (text == nullptr)
+			throw gcnew ArgumentNullException("text");
+		if (fontFace == nullptr)
+			throw gcnew ArgumentNullException("fontFace");
+		if (textIndex < 0 || length < 0 || textIndex > text->Length - length)
+			throw gcnew ArgumentOutOfRangeException("textIndex");
+
+		ShapingArena *arena = Arena();
+
+		pin_ptr<const wchar_t> pinnedText = PtrToStringChars(text);
+		pin_ptr<const wchar_t> pinnedLocale;
+		if (localeName != nullptr)
+			pinnedLocale = PtrToStringChars(localeName);
+
+		pin_ptr<FontFeature> pinnedFeatures;
+		if (features != nullptr && features->Length > 0)
+			pinnedFeatures = &features[0];
+
+		ShapingKey key;
+		key.Text = pinnedText + textIndex;
+		key.TextLength = length;
+		key.Face = fontFace->InternalPointer;
+		key.EmSize = fontSize;
+		key.IsSideways = isSideways;
+		key.IsRightToLeft = isRightToLeft;
+		key.Script.script = static_cast<UINT16>(script.Script);
+		key.Script.shapes = static_cast<DWRITE_SCRIPT_SHAPES>(script.Shapes);
+		key.LocaleName = pinnedLocale;
+		key.Features = reinterpret_cast<const DWRITE_FONT_FEATURE*>(pinnedFeatures);
+		key.FeatureCount = features == nullptr ? 0 : features->Length;
+
+		ShapedRunData data;
+		if (RECORD_DW(arena->Shape(key, data)).IsFailure)
+			return ShapedRun();
+
+		return ShapedRun(data);
+	}
+
+	void ShapingCache::Clear()
+	{
+		Arena()->Clear();
+	}
+
+	TextAnalyzer ^ShapingCache::Analyzer::get()
+	{
+		return m_Analyzer;
+	}
+
+	int ShapingCache::Count::get()
+	{
+		return static_cast<int>(Arena()->GetCount());
+	}
+
+	Int64 ShapingCache::MemoryUsage::get()
+	{
+		return static_cast<Int64>(Arena()->GetMemoryUsage());
+	}
+
+	Int64 ShapingCache::HitCount::get()
+	{
+		return Arena()->GetHits();
+	}
+
+	Int64 ShapingCache::MissCount::get()
+	{
+		return Arena()->GetMisses();
+	}
+
+	Int64 ShapingCache::EvictionCount::get()
+	{
+		return Arena()->GetEvictions();
+	}
+}
+}
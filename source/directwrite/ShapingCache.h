@@ -0,0 +1,128 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "FontFeature.h"
+#include "ScriptAnalysis.h"
+#include "ShapedRun.h"
+#include "ShapingArena.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class FontFace;
+		ref class TextAnalyzer;
+
+		/// <summary>
+		/// Caches the glyphs and glyph placements produced by shaping runs of text, so that runs shaped again skip the text analyzer.
+		/// </summary>
+		/// <remarks>
+		/// Entries are keyed by the text, the font face, the font size, the script, the reading direction, the locale and the
+		/// features applied to the run. Each entry keeps its key and results in one block of a pooled arena made of equally
+		/// sized chunks; when every chunk is full the oldest one is emptied, evicting all of its entries at once. Runs that do
+		/// not fit in a chunk are shaped without being cached. Number substitution is not supported. The cache is not thread safe.
+		/// </remarks>
+		public ref class ShapingCache sealed
+		{
+		private:
+			ShapingArena* m_Arena;
+			TextAnalyzer^ m_Analyzer;
+			System::Int64 m_Pressure;
+
+			ShapingArena* Arena();
+			void Destruct();
+
+		public:
+			/// <summary>
+			/// Initializes a new instance of the <see cref="ShapingCache"/> class with sixteen chunks of 64 KB.
+			/// </summary>
+			ShapingCache( TextAnalyzer^ analyzer );
+
+			/// <summary>
+			/// Initializes a new instance of the <see cref="ShapingCache"/> class.
+			/// </summary>
+			/// <param name="analyzer">The text analyzer used to shape runs that are not in the cache.</param>
+			/// <param name="chunkSize">The size, in bytes, of each chunk of the arena.</param>
+			/// <param name="chunkCount">The number of chunks in the arena.</param>
+			ShapingCache( TextAnalyzer^ analyzer, int chunkSize, int chunkCount );
+
+			~ShapingCache();
+			!ShapingCache();
+
+			/// <summary>
+			/// Shapes a run of text, returning the cached result if the run was shaped before.
+			/// </summary>
+			/// <returns>A view of the shaped run, valid until the next call to Shape or Clear.</returns>
+			ShapedRun Shape( System::String^ text, int textIndex, int length, FontFace^ fontFace, float fontSize, bool isSideways, bool isRightToLeft,
+				ScriptAnalysis script, System::String^ localeName );
+
+			/// <summary>
+			/// Shapes a run of text with typographic features applied to the whole run, returning the cached result if the run was shaped before.
+			/// </summary>
+			/// <returns>A view of the shaped run, valid until the next call to Shape or Clear.</returns>
+			ShapedRun Shape( System::String^ text, int textIndex, int length, FontFace^ fontFace, float fontSize, bool isSideways, bool isRightToLeft,
+				ScriptAnalysis script, System::String^ localeName, array<FontFeature>^ features );
+
+			/// <summary>
+			/// Removes every entry from the cache and releases the arena. The counters are not reset.
+			/// </summary>
+			void Clear();
+
+			property TextAnalyzer^ Analyzer
+			{
+				TextAnalyzer^ get();
+			}
+
+			property int Count
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the memory, in bytes, currently allocated by the chunks of the arena.
+			/// </summary>
+			property System::Int64 MemoryUsage
+			{
+				System::Int64 get();
+			}
+
+			property System::Int64 HitCount
+			{
+				System::Int64 get();
+			}
+
+			property System::Int64 MissCount
+			{
+				System::Int64 get();
+			}
+
+			/// <summary>
+			/// Gets the number of entries evicted when their chunk was reused.
+			/// </summary>
+			property System::Int64 EvictionCount
+			{
+				System::Int64 get();
+			}
+		};
+	}
+}
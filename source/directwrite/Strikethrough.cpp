@@ -30,13 +30,18 @@ namespace SlimDX
 namespace DirectWrite
 {
 	Strikethrough::Strikethrough(const DWRITE_STRIKETHROUGH &strikethrough)
+	{
+		Assign(strikethrough, gcnew String(strikethrough.localeName));
+	}
+
+	void Strikethrough::Assign(const DWRITE_STRIKETHROUGH &strikethrough, String ^localeName)
 	{
 		Width = strikethrough.width;
 		Thickness = strikethrough.thickness;
 		Offset = strikethrough.offset;
 		ReadingDirection = static_cast<DirectWrite::ReadingDirection>(strikethrough.readingDirection);
 		FlowDirection = static_cast<DirectWrite::FlowDirection>(strikethrough.flowDirection);
-		LocaleName = gcnew String(strikethrough.localeName);
+		LocaleName = localeName;
 		MeasuringMode = static_cast<DirectWrite::MeasuringMode>(strikethrough.measuringMode);
 	}
 }
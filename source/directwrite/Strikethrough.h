@@ -31,6 +31,7 @@ namespace SlimDX
 		{
 		internal:
 			Strikethrough(const DWRITE_STRIKETHROUGH &strikethrough);
+			void Assign(const DWRITE_STRIKETHROUGH &strikethrough, System::String ^localeName);
 
 		public:
 			property float Width;
@@ -78,6 +78,16 @@ namespace DirectWrite
 		return RECORD_DW(hr);
 	}
 
+	Result TextLayout::Draw(IntPtr clientDrawingContext, ITextViewRenderer ^renderer, float originX, float originY)
+	{
+		ITextRendererShim *shim = ITextRendererShim::CreateInstance(renderer);
+
+		HRESULT hr = InternalPointer->Draw(static_cast<void *>(clientDrawingContext), shim, originX, originY);
+		shim->Release();
+
+		return RECORD_DW(hr);
+	}
+
 	HitTestMetrics TextLayout::HitTestPoint( float pointX, float pointY, [Out] bool% isTrailingHit, [Out] bool% isInside )
 	{
 		DWRITE_HIT_TEST_METRICS htm;
@@ -41,6 +41,7 @@ namespace SlimDX
 		value class TextMetrics;
 		ref class InlineObject;
 		interface struct ITextRenderer;
+		interface struct ITextViewRenderer;
 		interface struct IClientDrawingEffect;
 
 		public ref class TextLayout : public TextFormat
@@ -55,6 +56,7 @@ namespace SlimDX
 
 			float DetermineMinWidth();
 			Result Draw(IntPtr clientDrawingContext, ITextRenderer ^renderer, float originX, float originY);
+			Result Draw(IntPtr clientDrawingContext, ITextViewRenderer ^renderer, float originX, float originY);
 			HitTestMetrics HitTestPoint( float pointX, float pointY, [Out] bool% isTrailingHit, [Out] bool% isInside );
 			HitTestMetrics HitTestTextPosition( int textPosition, bool isTrailingHit, [Out] float% pointX, [Out] float% pointY );
 			array< HitTestMetrics >^ HitTestTextRange( int textPosition, int textLength, float originX, float originY );
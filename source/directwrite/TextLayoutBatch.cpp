@@ -0,0 +1,181 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#include "stdafx.h"
+
+#include "DirectWriteException.h"
+#include "FactoryDW.h"
+#include "TextFormat.h"
+#include "TextLayout.h"
+#include "TextLayoutBatch.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace DirectWrite
+{
+	TextLayoutBatch::TextLayoutBatch(SlimDX::DirectWrite::Factory ^factory)
+	{
+		if (factory == nullptr)
+			throw gcnew ArgumentNullException("factory");
+
+		// Manual Allocation: released in Destruct
+		m_Job = new LayoutBatchJob(factory->InternalPointer);
+		m_Factory = factory;
+		m_MinimumParallelCount = 4;
+	}
+
+	TextLayoutBatch::~TextLayoutBatch()
+	{
+		Destruct();
+		GC::SuppressFinalize(this);
+	}
+
+	TextLayoutBatch::!TextLayoutBatch()
+	{
+		Destruct();
+	}
+
+	void TextLayoutBatch::Destruct()
+	{
+		delete m_Job;
+		m_Job = 0;
+	}
+
+	LayoutBatchJob *TextLayoutBatch::Job()
+	{
+		if (m_Job == 0)
+			throw gcnew ObjectDisposedException("TextLayoutBatch");
+
+		return m_Job;
+	}
+
+	int TextLayoutBatch::Add(String ^text, TextFormat ^format, float maxWidth, float maxHeight)
+	{
+		if (text == nullptr)
+			throw gcnew ArgumentNullException("text");
+
+		return Add(text, 0, text->Length, format, maxWidth, maxHeight);
+	}
+
+	int TextLayoutBatch::Add(String ^text, int textIndex, int length, TextFormat ^format, float maxWidth, float maxHeight)
+	{
+		if (text == nullptr)
+			throw gcnew ArgumentNullException("text");
+		if (format == nullptr)
+			throw gcnew ArgumentNullException("format");
+		if (textIndex < 0 || length < 0 || textIndex > text->Length - length)
+			throw gcnew ArgumentOutOfRangeException("textIndex");
+
+		LayoutBatchJob *job = Job();
+
+		pin_ptr<const wchar_t> pinnedText = PtrToStringChars(text);
+		job->Add(pinnedText + textIndex, length, format->InternalPointer, maxWidth, maxHeight);
+		return static_cast<int>(job->GetCount()) - 1;
+	}
+
+	array<TextLayoutResult> ^TextLayoutBatch::Execute()
+	{
+		LayoutBatchJob *job = Job();
+		job->Run(m_MinimumParallelCount);
+
+		// wrapping touches the object table, so it happens here on the calling thread rather than on the workers
+		UINT32 count = job->GetCount();
+		array<TextLayoutResult> ^results = gcnew array<TextLayoutResult>(count);
+		HRESULT failure = S_OK;
+
+		for (UINT32 i = 0; i < count; i++)
+		{
+			const LayoutBatchJob::Output &output = job->GetOutput(i);
+			if (FAILED(output.Result))
+			{
+				if (SUCCEEDED(failure))
+					failure = output.Result;
+
+				results[i] = TextLayoutResult(nullptr, TextMetrics(), gcnew array<LineMetrics>(0), Result(output.Result));
+				continue;
+			}
+
+			const DWRITE_TEXT_METRICS &metrics = output.Metrics;
+			TextMetrics textMetrics(metrics.left, metrics.top, metrics.width, metrics.widthIncludingTrailingWhitespace, metrics.height,
+				metrics.layoutWidth, metrics.layoutHeight, metrics.maxBidiReorderingDepth, metrics.lineCount);
+
+			array<LineMetrics> ^lines = gcnew array<LineMetrics>(static_cast<int>(output.Lines.size()));
+			for (int j = 0; j < lines->Length; j++)
+			{
+				const DWRITE_LINE_METRICS &line = output.Lines[j];
+				lines[j] = LineMetrics(line.length, line.trailingWhitespaceLength, line.newlineLength, line.height, line.baseline, line.isTrimmed != 0);
+			}
+
+			results[i] = TextLayoutResult(TextLayout::FromPointer(job->Detach(i)), textMetrics, lines, Result(output.Result));
+		}
+
+		job->Clear();
+
+		// failures are also reported per result; if recording one throws, the caller never sees the successful layouts
+		if (FAILED(failure))
+		{
+			try
+			{
+				RECORD_DW(failure);
+			}
+			catch (...)
+			{
+				for (int i = 0; i < results->Length; i++)
+					delete results[i].Layout;
+
+				throw;
+			}
+		}
+
+		return results;
+	}
+
+	void TextLayoutBatch::Clear()
+	{
+		Job()->Clear();
+	}
+
+	SlimDX::DirectWrite::Factory ^TextLayoutBatch::Factory::get()
+	{
+		return m_Factory;
+	}
+
+	int TextLayoutBatch::Count::get()
+	{
+		return static_cast<int>(Job()->GetCount());
+	}
+
+	int TextLayoutBatch::MinimumParallelCount::get()
+	{
+		return m_MinimumParallelCount;
+	}
+
+	void TextLayoutBatch::MinimumParallelCount::set(int value)
+	{
+		if (value < 1)
+			throw gcnew ArgumentOutOfRangeException("value");
+
+		m_MinimumParallelCount = value;
+	}
+}
+}
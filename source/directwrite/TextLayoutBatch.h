@@ -0,0 +1,106 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "LayoutBatchJob.h"
+#include "TextLayoutResult.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class Factory;
+		ref class TextFormat;
+
+		/// <summary>
+		/// Builds and measures many independent text layouts at once, spreading the work across the thread pool.
+		/// </summary>
+		/// <remarks>
+		/// Requests are queued with <see cref="Add"/> and built by <see cref="Execute"/>, which returns once every layout
+		/// has been formatted. The text of each request is copied when it is added, so the strings may change afterwards;
+		/// the text formats must not be modified until <see cref="Execute"/> returns. The factory must have been created
+		/// with <see cref="FactoryType::Shared"/>, since isolated factories are not safe to use from several threads.
+		/// The batch itself is not thread safe.
+		/// </remarks>
+		public ref class TextLayoutBatch sealed
+		{
+		private:
+			LayoutBatchJob* m_Job;
+			SlimDX::DirectWrite::Factory^ m_Factory;
+			int m_MinimumParallelCount;
+
+			LayoutBatchJob* Job();
+			void Destruct();
+
+		public:
+			TextLayoutBatch( SlimDX::DirectWrite::Factory^ factory );
+			~TextLayoutBatch();
+			!TextLayoutBatch();
+
+			/// <summary>
+			/// Queues a layout of the text.
+			/// </summary>
+			/// <returns>The index of the layout in the array returned by <see cref="Execute"/>.</returns>
+			int Add( System::String^ text, TextFormat^ format, float maxWidth, float maxHeight );
+
+			/// <summary>
+			/// Queues a layout of part of the text.
+			/// </summary>
+			/// <returns>The index of the layout in the array returned by <see cref="Execute"/>.</returns>
+			int Add( System::String^ text, int textIndex, int length, TextFormat^ format, float maxWidth, float maxHeight );
+
+			/// <summary>
+			/// Builds and measures every queued layout, then empties the queue.
+			/// </summary>
+			/// <returns>One result per queued layout, in the order they were added.</returns>
+			/// <remarks>If any layout failed and the failure is thrown, the layouts that were built are disposed first.</remarks>
+			array<TextLayoutResult>^ Execute();
+
+			/// <summary>
+			/// Removes every queued layout without building it.
+			/// </summary>
+			void Clear();
+
+			property SlimDX::DirectWrite::Factory^ Factory
+			{
+				SlimDX::DirectWrite::Factory^ get();
+			}
+
+			/// <summary>
+			/// Gets the number of queued layouts.
+			/// </summary>
+			property int Count
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets or sets the number of queued layouts below which <see cref="Execute"/> builds them on the calling thread.
+			/// </summary>
+			property int MinimumParallelCount
+			{
+				int get();
+				void set( int value );
+			}
+		};
+	}
+}
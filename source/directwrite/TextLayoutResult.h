@@ -0,0 +1,80 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "../Result.h"
+
+#include "LineMetrics.h"
+#include "TextMetrics.h"
+
+namespace SlimDX
+{
+	namespace DirectWrite
+	{
+		ref class TextLayout;
+
+		/// <summary>
+		/// A text layout built by a <see cref="TextLayoutBatch"/>, together with the metrics measured when it was built.
+		/// </summary>
+		/// <remarks>
+		/// The layout belongs to the caller, who is responsible for disposing it.
+		/// </remarks>
+		public value class TextLayoutResult
+		{
+		private:
+			TextLayout^ m_Layout;
+			TextMetrics m_Metrics;
+			array<SlimDX::DirectWrite::LineMetrics>^ m_LineMetrics;
+			SlimDX::Result m_Result;
+
+		internal:
+			TextLayoutResult( TextLayout^ layout, TextMetrics metrics, array<SlimDX::DirectWrite::LineMetrics>^ lineMetrics, SlimDX::Result result );
+
+		public:
+			/// <summary>
+			/// Gets the layout, or <c>null</c> if it could not be built.
+			/// </summary>
+			property TextLayout^ Layout
+			{
+				TextLayout^ get();
+			}
+
+			property TextMetrics Metrics
+			{
+				TextMetrics get();
+			}
+
+			property array<SlimDX::DirectWrite::LineMetrics>^ LineMetrics
+			{
+				array<SlimDX::DirectWrite::LineMetrics>^ get();
+			}
+
+			/// <summary>
+			/// Gets the result of building and measuring the layout.
+			/// </summary>
+			property SlimDX::Result Result
+			{
+				SlimDX::Result get();
+			}
+		};
+	}
+}
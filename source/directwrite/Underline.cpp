@@ -30,6 +30,11 @@ namespace SlimDX
 namespace DirectWrite
 {
 	Underline::Underline(const DWRITE_UNDERLINE &underline)
+	{
+		Assign(underline, gcnew String(underline.localeName));
+	}
+
+	void Underline::Assign(const DWRITE_UNDERLINE &underline, String ^localeName)
 	{
 		Width = underline.width;
 		Thickness = underline.thickness;
@@ -37,7 +42,7 @@ namespace DirectWrite
 		RunHeight = underline.runHeight;
 		ReadingDirection = static_cast<DirectWrite::ReadingDirection>(underline.readingDirection);
 		FlowDirection = static_cast<DirectWrite::FlowDirection>(underline.flowDirection);
-		LocaleName = gcnew String(underline.localeName);
+		LocaleName = localeName;
 		MeasuringMode = static_cast<DirectWrite::MeasuringMode>(underline.measuringMode);
 	}
 }
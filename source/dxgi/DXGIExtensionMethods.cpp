@@ -32,7 +32,13 @@ namespace DXGI
 {
 	int DXGIExtensions::SizeInBytes(Format format)
 	{
-		return Utilities::SizeOfFormatElement(static_cast<DXGI_FORMAT>(format)) / 8;
+		// rounded up, so that R1_UNORM, the only format with less than a byte per element, reports 1 rather than 0
+		return (Utilities::SizeOfFormatElement(static_cast<DXGI_FORMAT>(format)) + 7) / 8;
+	}
+
+	FormatDescription DXGIExtensions::GetDescription(Format format)
+	{
+		return FormatDescription(format);
 	}
 }
 }
\ No newline at end of file
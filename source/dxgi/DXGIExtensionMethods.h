@@ -21,6 +21,8 @@
 */
 #pragma once
 
+#include "FormatDescription.h"
+
 namespace SlimDX
 {
 	namespace DXGI
@@ -32,8 +34,15 @@ namespace SlimDX
 			DXGIExtensions() { }
 
 		public:
+			/// <summary>
+			/// Gets the size of one element of a format in bytes, rounded up to a whole byte; block compressed formats report the size of a 4x4 block.
+			/// </summary>
+			/// <remarks><see cref="Format::R1_UNorm"/> has one bit per element and reports 1.</remarks>
 			[System::Runtime::CompilerServices::ExtensionAttribute]
 			static int SizeInBytes(Format format);
+
+			[System::Runtime::CompilerServices::ExtensionAttribute]
+			static FormatDescription GetDescription(Format format);
 		};
 	}
 }
\ No newline at end of file
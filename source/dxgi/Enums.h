@@ -187,6 +187,19 @@ namespace SlimDX
 			/// <summary>Not Supported below DirectX 11.</summary>
 			BC7_UNorm_SRGB = DXGI_FORMAT_BC7_UNORM_SRGB
 		};
+
+		public enum class FormatComponentType : System::Int32
+		{
+			Unknown,
+			Typeless,
+			UNorm,
+			UNormSrgb,
+			SNorm,
+			UInt,
+			SInt,
+			Float,
+			Mixed
+		};
 		
 		[System::Flags]
 		public enum class MapFlags : System::Int32
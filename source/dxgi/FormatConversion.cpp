@@ -0,0 +1,627 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#pragma managed(push, off)
+
+#include <emmintrin.h>
+
+#include "FormatTable.h"
+#include "FormatConversion.h"
+#include "PixelCodec.h"
+
+namespace SlimDX
+{
+namespace DXGI
+{
+namespace FormatConversion
+{
+namespace
+{
+	// sRGB code to linear intensity.
+	const float SrgbToLinear[256] =
+	{
+		0.0f, 0.000303526991f, 0.000607053982f, 0.000910580973f, 0.00121410796f, 0.00151763496f, 0.00182116195f, 0.00212468882f,
+		0.00242821593f, 0.0027317428f, 0.00303526991f, 0.00334653584f, 0.00367650739f, 0.00402471703f, 0.00439144205f, 0.00477695325f,
+		0.00518151652f, 0.00560539169f, 0.00604883302f, 0.00651209056f, 0.00699541019f, 0.00749903219f, 0.00802319311f, 0.00856812578f,
+		0.00913405884f, 0.00972121768f, 0.010329823f, 0.0109600937f, 0.0116122449f, 0.012286488f, 0.0129830325f, 0.0137020834f,
+		0.0144438436f, 0.0152085144f, 0.0159962941f, 0.0168073755f, 0.0176419541f, 0.01850022f, 0.0193823613f, 0.0202885624f,
+		0.0212190095f, 0.0221738853f, 0.0231533665f, 0.0241576321f, 0.0251868591f, 0.0262412224f, 0.0273208916f, 0.02842604f,
+		0.0295568351f, 0.0307134446f, 0.0318960324f, 0.0331047662f, 0.0343398079f, 0.0356013142f, 0.0368894488f, 0.0382043719f,
+		0.0395462364f, 0.0409151986f, 0.0423114114f, 0.043735031f, 0.045186203f, 0.0466650873f, 0.0481718257f, 0.0497065671f,
+		0.0512694567f, 0.0528606474f, 0.054480277f, 0.0561284907f, 0.0578054301f, 0.0595112368f, 0.0612460524f, 0.0630100146f,
+		0.064803265f, 0.0666259378f, 0.0684781671f, 0.0703600943f, 0.0722718537f, 0.0742135718f, 0.0761853829f, 0.078187421f,
+		0.0802198201f, 0.0822827071f, 0.0843762085f, 0.0865004584f, 0.0886555836f, 0.0908417106f, 0.0930589661f, 0.0953074694f,
+		0.097587347f, 0.0998987257f, 0.102241732f, 0.104616486f, 0.107023105f, 0.10946171f, 0.111932427f, 0.114435375f,
+		0.116970666f, 0.119538426f, 0.122138776f, 0.124771819f, 0.127437681f, 0.130136475f, 0.13286832f, 0.135633335f,
+		0.138431609f, 0.141263291f, 0.144128472f, 0.147027269f, 0.149959788f, 0.152926147f, 0.155926466f, 0.158960834f,
+		0.162029371f, 0.165132195f, 0.168269396f, 0.171441108f, 0.174647406f, 0.177888423f, 0.18116425f, 0.18447499f,
+		0.187820777f, 0.191201687f, 0.194617838f, 0.198069319f, 0.20155625f, 0.205078736f, 0.208636865f, 0.212230757f,
+		0.215860501f, 0.219526201f, 0.223227963f, 0.226965874f, 0.230740055f, 0.23455058f, 0.238397568f, 0.242281124f,
+		0.246201321f, 0.25015828f, 0.254152089f, 0.258182853f, 0.262250662f, 0.266355604f, 0.270497799f, 0.274677306f,
+		0.278894275f, 0.283148736f, 0.287440836f, 0.291770637f, 0.296138257f, 0.300543785f, 0.304987311f, 0.309468925f,
+		0.313988715f, 0.318546772f, 0.323143214f, 0.327778101f, 0.332451522f, 0.337163627f, 0.341914415f, 0.346704066f,
+		0.351532608f, 0.356400132f, 0.361306787f, 0.366252601f, 0.371237695f, 0.376262128f, 0.38132602f, 0.386429429f,
+		0.391572475f, 0.396755219f, 0.401977777f, 0.407240212f, 0.412542611f, 0.417885065f, 0.423267663f, 0.428690493f,
+		0.434153646f, 0.439657182f, 0.445201188f, 0.450785786f, 0.456411034f, 0.462076992f, 0.467783809f, 0.473531485f,
+		0.479320168f, 0.48514995f, 0.491020858f, 0.496932983f, 0.502886474f, 0.50888133f, 0.514917672f, 0.520995557f,
+		0.527115107f, 0.533276379f, 0.539479494f, 0.545724452f, 0.55201143f, 0.558340371f, 0.564711511f, 0.571124852f,
+		0.577580452f, 0.584078431f, 0.590618849f, 0.597201765f, 0.603827357f, 0.610495567f, 0.617206573f, 0.623960376f,
+		0.630757153f, 0.637596846f, 0.644479692f, 0.651405632f, 0.658374846f, 0.665387273f, 0.672443151f, 0.679542482f,
+		0.686685324f, 0.693871737f, 0.701101899f, 0.708375752f, 0.715693474f, 0.723055124f, 0.730460763f, 0.73791039f,
+		0.745404184f, 0.752942204f, 0.760524511f, 0.768151164f, 0.775822222f, 0.783537805f, 0.791297913f, 0.799102724f,
+		0.806952238f, 0.814846575f, 0.822785735f, 0.830769897f, 0.838799f, 0.846873224f, 0.854992628f, 0.863157213f,
+		0.871367097f, 0.8796224f, 0.887923121f, 0.896269381f, 0.904661179f, 0.913098633f, 0.921581864f, 0.930110872f,
+		0.938685715f, 0.947306514f, 0.955973327f, 0.964686275f, 0.973445296f, 0.982250571f, 0.991102099f, 1.0f
+	};
+
+	// Linear intensities at which the nearest sRGB code steps from i to i + 1.
+	const float SrgbThresholds[255] =
+	{
+		0.000151763496f, 0.000455290487f, 0.000758817478f, 0.00106234441f, 0.0013658714f, 0.00166939839f, 0.00197292538f, 0.00227645249f,
+		0.00257997937f, 0.00288350624f, 0.00318830088f, 0.00350925932f, 0.00384831498f, 0.00420574797f, 0.00458183279f, 0.00497683743f,
+		0.00539102405f, 0.00582465064f, 0.00627796957f, 0.00675122766f, 0.00724466844f, 0.00775853032f, 0.00829304848f, 0.00884845294f,
+		0.00942497049f, 0.0100228256f, 0.010642237f, 0.011283421f, 0.0119465925f, 0.0126319602f, 0.0133397318f, 0.0140701123f,
+		0.0148233026f, 0.0155995032f, 0.0163989104f, 0.0172217153f, 0.0180681143f, 0.0189382937f, 0.0198324434f, 0.0207507443f,
+		0.0216933824f, 0.0226605386f, 0.0236523896f, 0.0246691145f, 0.0257108882f, 0.0267778821f, 0.0278702695f, 0.0289882198f,
+		0.0301319025f, 0.0313014798f, 0.0324971229f, 0.0337189883f, 0.0349672437f, 0.0362420455f, 0.0375435539f, 0.0388719253f,
+		0.04022732f, 0.041609887f, 0.0430197865f, 0.0444571637f, 0.0459221713f, 0.0474149622f, 0.0489356853f, 0.0504844859f,
+		0.0520615056f, 0.0536668971f, 0.055300802f, 0.0569633618f, 0.0586547181f, 0.0603750125f, 0.0621243827f, 0.0639029741f,
+		0.0657109171f, 0.0675483495f, 0.0694154128f, 0.0713122338f, 0.0732389539f, 0.0751957074f, 0.0771826133f, 0.0791998208f,
+		0.0812474415f, 0.0833256245f, 0.085434489f, 0.0875741541f, 0.089744769f, 0.091946438f, 0.0941793025f, 0.0964434743f,
+		0.098739095f, 0.101066269f, 0.10342513f, 0.105815805f, 0.108238399f, 0.110693045f, 0.113179862f, 0.115698971f,
+		0.118250482f, 0.120834522f, 0.123451203f, 0.126100644f, 0.128782958f, 0.131498262f, 0.134246677f, 0.137028307f,
+		0.13984327f, 0.142691687f, 0.145573661f, 0.148489311f, 0.151438728f, 0.15442206f, 0.157439381f, 0.160490826f,
+		0.163576499f, 0.166696489f, 0.169850931f, 0.173039913f, 0.176263571f, 0.179521978f, 0.182815254f, 0.186143503f,
+		0.189506829f, 0.192905352f, 0.196339145f, 0.199808344f, 0.203313038f, 0.206853345f, 0.210429341f, 0.214041144f,
+		0.217688844f, 0.22137256f, 0.225092396f, 0.228848428f, 0.232640758f, 0.236469507f, 0.240334779f, 0.244236633f,
+		0.248175204f, 0.252150565f, 0.256162852f, 0.260212123f, 0.264298469f, 0.268422037f, 0.272582889f, 0.276781112f,
+		0.281016797f, 0.285290092f, 0.289601028f, 0.293949723f, 0.298336297f, 0.30276081f, 0.30722335f, 0.311724037f,
+		0.31626296f, 0.32084018f, 0.325455844f, 0.330109984f, 0.334802747f, 0.339534163f, 0.344304383f, 0.349113464f,
+		0.353961498f, 0.358848572f, 0.363774776f, 0.368740231f, 0.373744965f, 0.378789127f, 0.383872777f, 0.388996005f,
+		0.3941589f, 0.399361521f, 0.404604018f, 0.40988642f, 0.415208817f, 0.420571357f, 0.425974041f, 0.431417018f,
+		0.436900347f, 0.442424119f, 0.447988421f, 0.453593314f, 0.459238917f, 0.464925289f, 0.470652521f, 0.476420701f,
+		0.482229918f, 0.488080233f, 0.493971765f, 0.499904543f, 0.505878687f, 0.511894286f, 0.517951429f, 0.524050117f,
+		0.530190527f, 0.536372721f, 0.542596757f, 0.548862696f, 0.555170655f, 0.561520696f, 0.567912877f, 0.574347317f,
+		0.580824137f, 0.587343335f, 0.593904972f, 0.600509226f, 0.607156098f, 0.613845706f, 0.62057811f, 0.62735337f,
+		0.634171605f, 0.641032875f, 0.647937238f, 0.654884815f, 0.661875665f, 0.668909788f, 0.675987363f, 0.683108449f,
+		0.690273106f, 0.697481334f, 0.704733372f, 0.712029159f, 0.719368815f, 0.72675246f, 0.734180033f, 0.741651773f,
+		0.749167681f, 0.756727815f, 0.764332294f, 0.77198112f, 0.779674411f, 0.787412286f, 0.795194745f, 0.803021908f,
+		0.810893834f, 0.818810523f, 0.826772213f, 0.834778786f, 0.842830479f, 0.850927293f, 0.859069228f, 0.867256522f,
+		0.875489056f, 0.883767068f, 0.892090559f, 0.900459588f, 0.908874214f, 0.917334557f, 0.925840616f, 0.934392571f,
+		0.942990363f, 0.951634169f, 0.960324049f, 0.969060004f, 0.977842152f, 0.986670554f, 0.995545268f
+	};
+
+	// Pixels are converted through the float codecs in chunks of this size.
+	const size_t ChunkSize = 64;
+
+	inline __m128 Saturate( __m128 value )
+	{
+		// max returns its second operand for NaN, so NaN saturates to zero
+		return _mm_min_ps( _mm_max_ps( value, _mm_setzero_ps() ), _mm_set1_ps( 1.0f ) );
+	}
+
+	// Scales saturated values to integers, rounding halves up.
+	inline __m128i ToUNorm( __m128 value, float scale )
+	{
+		return _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( Saturate( value ), _mm_set1_ps( scale ) ), _mm_set1_ps( 0.5f ) ) );
+	}
+
+	inline __m128 SwapRedBlue( __m128 pixel )
+	{
+		return _mm_shuffle_ps( pixel, pixel, _MM_SHUFFLE( 3, 0, 1, 2 ) );
+	}
+
+	inline __m128 SetAlphaOne( __m128 pixel )
+	{
+		const __m128 mask = _mm_castsi128_ps( _mm_setr_epi32( -1, -1, -1, 0 ) );
+		return _mm_or_ps( _mm_and_ps( pixel, mask ), _mm_setr_ps( 0, 0, 0, 1.0f ) );
+	}
+
+	// Expands halves in the low 16 bits of each lane to floats, including denormals, infinities and NaNs.
+	inline __m128 HalfToFloat( __m128i half )
+	{
+		const __m128i expMantissa = _mm_and_si128( half, _mm_set1_epi32( 0x7fff ) );
+		const __m128i sign = _mm_slli_epi32( _mm_xor_si128( half, expMantissa ), 16 );
+
+		// rebias the exponent by multiplication, which also normalizes denormals
+		const __m128 scaled = _mm_mul_ps( _mm_castsi128_ps( _mm_slli_epi32( expMantissa, 13 ) ), _mm_castsi128_ps( _mm_set1_epi32( ( 254 - 15 ) << 23 ) ) );
+		const __m128i infNan = _mm_and_si128( _mm_cmpgt_epi32( expMantissa, _mm_set1_epi32( 0x7bff ) ), _mm_set1_epi32( 255 << 23 ) );
+		return _mm_or_ps( scaled, _mm_castsi128_ps( _mm_or_si128( sign, infNan ) ) );
+	}
+
+	// Rounds floats to the nearest half, ties to even, leaving the result sign extended in each lane.
+	inline __m128i FloatToHalf( __m128 value )
+	{
+		const __m128i maximum = _mm_set1_epi32( ( 127 + 16 ) << 23 );
+		const __m128i minimumNormal = _mm_set1_epi32( ( 127 - 14 ) << 23 );
+		const __m128i subnormalMagic = _mm_set1_epi32( ( ( 127 - 15 ) + ( 23 - 10 ) + 1 ) << 23 );
+		const __m128i normalBias = _mm_set1_epi32( 0xfff - ( ( 127 - 15 ) << 23 ) );
+
+		const __m128 sign = _mm_and_ps( value, _mm_castsi128_ps( _mm_set1_epi32( 0x80000000 ) ) );
+		const __m128 absolute = _mm_xor_ps( value, sign );
+		const __m128i bits = _mm_castps_si128( absolute );
+
+		const __m128i isNan = _mm_castps_si128( _mm_cmpunord_ps( absolute, absolute ) );
+		const __m128i isRegular = _mm_cmpgt_epi32( maximum, bits );
+		const __m128i isSubnormal = _mm_cmpgt_epi32( minimumNormal, bits );
+		const __m128i infNan = _mm_or_si128( _mm_and_si128( isNan, _mm_set1_epi32( 0x200 ) ), _mm_set1_epi32( 0x7c00 ) );
+
+		// subnormal results: let the float adder align and round the mantissa
+		const __m128i subnormal = _mm_sub_epi32( _mm_castps_si128( _mm_add_ps( absolute, _mm_castsi128_ps( subnormalMagic ) ) ), subnormalMagic );
+
+		// normal results: rebias, then round to nearest even on the thirteen dropped bits
+		const __m128i odd = _mm_srai_epi32( _mm_slli_epi32( bits, 31 - 13 ), 31 );
+		const __m128i normal = _mm_srli_epi32( _mm_sub_epi32( _mm_add_epi32( bits, normalBias ), odd ), 13 );
+
+		const __m128i finite = _mm_or_si128( _mm_and_si128( isSubnormal, subnormal ), _mm_andnot_si128( isSubnormal, normal ) );
+		const __m128i result = _mm_or_si128( _mm_and_si128( isRegular, finite ), _mm_andnot_si128( isRegular, infNan ) );
+		return _mm_or_si128( result, _mm_srai_epi32( _mm_castps_si128( sign ), 16 ) );
+	}
+
+	inline uint8_t LinearToSrgb( float value )
+	{
+		// branch-free binary search over the code boundaries; NaN compares false and becomes zero
+		size_t code = 0;
+		for( size_t step = 128; step > 0; step >>= 1 )
+			code += ( value >= SrgbThresholds[code + step - 1] ) ? step : 0;
+
+		return static_cast<uint8_t>( code );
+	}
+
+	//
+	// Unpacking
+	//
+
+	inline __m128 UnpackRGBA8Pixel( uint32_t pixel )
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i value = _mm_unpacklo_epi16( _mm_unpacklo_epi8( _mm_cvtsi32_si128( static_cast<int>( pixel ) ), zero ), zero );
+		return _mm_mul_ps( _mm_cvtepi32_ps( value ), _mm_set1_ps( 1.0f / 255.0f ) );
+	}
+
+	void UnpackRGBA8( const uint8_t* source, __m128* pixels, size_t count )
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 scale = _mm_set1_ps( 1.0f / 255.0f );
+
+		size_t pixel = 0;
+		for( ; pixel + 4 <= count; pixel += 4, source += 16 )
+		{
+			const __m128i packed = _mm_loadu_si128( reinterpret_cast<const __m128i*>( source ) );
+			const __m128i low = _mm_unpacklo_epi8( packed, zero );
+			const __m128i high = _mm_unpackhi_epi8( packed, zero );
+			pixels[pixel + 0] = _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( low, zero ) ), scale );
+			pixels[pixel + 1] = _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( low, zero ) ), scale );
+			pixels[pixel + 2] = _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( high, zero ) ), scale );
+			pixels[pixel + 3] = _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( high, zero ) ), scale );
+		}
+
+		for( ; pixel < count; ++pixel, source += 4 )
+		{
+			uint32_t value;
+			memcpy( &value, source, sizeof( value ) );
+			pixels[pixel] = UnpackRGBA8Pixel( value );
+		}
+	}
+
+	void UnpackBGRA8( const uint8_t* source, __m128* pixels, size_t count )
+	{
+		UnpackRGBA8( source, pixels, count );
+		for( size_t pixel = 0; pixel < count; ++pixel )
+			pixels[pixel] = SwapRedBlue( pixels[pixel] );
+	}
+
+	void UnpackBGRX8( const uint8_t* source, __m128* pixels, size_t count )
+	{
+		UnpackRGBA8( source, pixels, count );
+		for( size_t pixel = 0; pixel < count; ++pixel )
+			pixels[pixel] = SetAlphaOne( SwapRedBlue( pixels[pixel] ) );
+	}
+
+	void UnpackRGBA8Srgb( const uint8_t* source, __m128* pixels, size_t count )
+	{
+		for( size_t pixel = 0; pixel < count; ++pixel, source += 4 )
+			pixels[pixel] = _mm_setr_ps( SrgbToLinear[source[0]], SrgbToLinear[source[1]], SrgbToLinear[source[2]], source[3] * ( 1.0f / 255.0f ) );
+	}
+
+	void UnpackBGRA8Srgb( const uint8_t* source, __m128* pixels, size_t count )
+	{
+		for( size_t pixel = 0; pixel < count; ++pixel, source += 4 )
+			pixels[pixel] = _mm_setr_ps( SrgbToLinear[source[2]], SrgbToLinear[source[1]], SrgbToLinear[source[0]], source[3] * ( 1.0f / 255.0f ) );
+	}
+
+	void UnpackBGRX8Srgb( const uint8_t* source, __m128* pixels, size_t count )
+	{
+		for( size_t pixel = 0; pixel < count; ++pixel, source += 4 )
+			pixels[pixel] = _mm_setr_ps( SrgbToLinear[source[2]], SrgbToLinear[source[1]], SrgbToLinear[source[0]], 1.0f );
+	}
+
+	void UnpackRGBA32F( const uint8_t* source, __m128* pixels, size_t count )
+	{
+		for( size_t pixel = 0; pixel < count; ++pixel, source += 16 )
+			pixels[pixel] = _mm_loadu_ps( reinterpret_cast<const float*>( source ) );
+	}
+
+	void UnpackRGBA16F( const uint8_t* source, __m128* pixels, size_t count )
+	{
+		const __m128i zero = _mm_setzero_si128();
+
+		size_t pixel = 0;
+		for( ; pixel + 2 <= count; pixel += 2, source += 16 )
+		{
+			const __m128i packed = _mm_loadu_si128( reinterpret_cast<const __m128i*>( source ) );
+			pixels[pixel + 0] = HalfToFloat( _mm_unpacklo_epi16( packed, zero ) );
+			pixels[pixel + 1] = HalfToFloat( _mm_unpackhi_epi16( packed, zero ) );
+		}
+
+		if( pixel < count )
+			pixels[pixel] = HalfToFloat( _mm_unpacklo_epi16( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( source ) ), zero ) );
+	}
+
+	void UnpackRGBA16( const uint8_t* source, __m128* pixels, size_t count )
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 scale = _mm_set1_ps( 1.0f / 65535.0f );
+
+		size_t pixel = 0;
+		for( ; pixel + 2 <= count; pixel += 2, source += 16 )
+		{
+			const __m128i packed = _mm_loadu_si128( reinterpret_cast<const __m128i*>( source ) );
+			pixels[pixel + 0] = _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( packed, zero ) ), scale );
+			pixels[pixel + 1] = _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( packed, zero ) ), scale );
+		}
+
+		if( pixel < count )
+			pixels[pixel] = _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( source ) ), zero ) ), scale );
+	}
+
+	// Four pixels are split into channel vectors, converted together, and transposed back into pixels.
+	void UnpackRGB10A2( const uint8_t* source, __m128* pixels, size_t count )
+	{
+		const __m128i mask = _mm_set1_epi32( 0x3ff );
+		const __m128 colorScale = _mm_set1_ps( 1.0f / 1023.0f );
+		const __m128 alphaScale = _mm_set1_ps( 1.0f / 3.0f );
+
+		for( size_t pixel = 0; pixel < count; pixel += 4, source += 16 )
+		{
+			__m128i packed;
+			if( pixel + 4 <= count )
+			{
+				packed = _mm_loadu_si128( reinterpret_cast<const __m128i*>( source ) );
+			}
+			else
+			{
+				uint32_t tail[4] = { 0 };
+				memcpy( tail, source, ( count - pixel ) * 4 );
+				packed = _mm_loadu_si128( reinterpret_cast<const __m128i*>( tail ) );
+			}
+
+			__m128 r = _mm_mul_ps( _mm_cvtepi32_ps( _mm_and_si128( packed, mask ) ), colorScale );
+			__m128 g = _mm_mul_ps( _mm_cvtepi32_ps( _mm_and_si128( _mm_srli_epi32( packed, 10 ), mask ) ), colorScale );
+			__m128 b = _mm_mul_ps( _mm_cvtepi32_ps( _mm_and_si128( _mm_srli_epi32( packed, 20 ), mask ) ), colorScale );
+			__m128 a = _mm_mul_ps( _mm_cvtepi32_ps( _mm_srli_epi32( packed, 30 ) ), alphaScale );
+			_MM_TRANSPOSE4_PS( r, g, b, a );
+
+			const __m128 converted[4] = { r, g, b, a };
+			for( size_t lane = 0; lane < 4 && pixel + lane < count; ++lane )
+				pixels[pixel + lane] = converted[lane];
+		}
+	}
+
+	//
+	// Packing
+	//
+
+	void PackRGBA8( const __m128* pixels, uint8_t* destination, size_t count )
+	{
+		size_t pixel = 0;
+		for( ; pixel + 4 <= count; pixel += 4, destination += 16 )
+		{
+			const __m128i low = _mm_packs_epi32( ToUNorm( pixels[pixel + 0], 255.0f ), ToUNorm( pixels[pixel + 1], 255.0f ) );
+			const __m128i high = _mm_packs_epi32( ToUNorm( pixels[pixel + 2], 255.0f ), ToUNorm( pixels[pixel + 3], 255.0f ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( destination ), _mm_packus_epi16( low, high ) );
+		}
+
+		for( ; pixel < count; ++pixel, destination += 4 )
+		{
+			const __m128i value = _mm_packs_epi32( ToUNorm( pixels[pixel], 255.0f ), _mm_setzero_si128() );
+			const int packed = _mm_cvtsi128_si32( _mm_packus_epi16( value, value ) );
+			memcpy( destination, &packed, sizeof( packed ) );
+		}
+	}
+
+	void PackBGRA8( const __m128* pixels, uint8_t* destination, size_t count )
+	{
+		__declspec(align(16)) __m128 swapped[ChunkSize];
+		for( size_t pixel = 0; pixel < count; ++pixel )
+			swapped[pixel] = SwapRedBlue( pixels[pixel] );
+
+		PackRGBA8( swapped, destination, count );
+	}
+
+	void PackBGRX8( const __m128* pixels, uint8_t* destination, size_t count )
+	{
+		__declspec(align(16)) __m128 swapped[ChunkSize];
+		for( size_t pixel = 0; pixel < count; ++pixel )
+			swapped[pixel] = SetAlphaOne( SwapRedBlue( pixels[pixel] ) );
+
+		PackRGBA8( swapped, destination, count );
+	}
+
+	void PackSrgb8( const __m128* pixels, uint8_t* destination, size_t count, size_t red, size_t blue, bool opaque )
+	{
+		for( size_t pixel = 0; pixel < count; ++pixel, destination += 4 )
+		{
+			__declspec(align(16)) float value[4];
+			_mm_store_ps( value, pixels[pixel] );
+
+			const int alpha = _mm_cvtsi128_si32( ToUNorm( _mm_set_ss( value[3] ), 255.0f ) );
+			destination[red] = LinearToSrgb( value[0] );
+			destination[1] = LinearToSrgb( value[1] );
+			destination[blue] = LinearToSrgb( value[2] );
+			destination[3] = opaque ? 255 : static_cast<uint8_t>( alpha );
+		}
+	}
+
+	void PackRGBA8Srgb( const __m128* pixels, uint8_t* destination, size_t count )
+	{
+		PackSrgb8( pixels, destination, count, 0, 2, false );
+	}
+
+	void PackBGRA8Srgb( const __m128* pixels, uint8_t* destination, size_t count )
+	{
+		PackSrgb8( pixels, destination, count, 2, 0, false );
+	}
+
+	void PackBGRX8Srgb( const __m128* pixels, uint8_t* destination, size_t count )
+	{
+		PackSrgb8( pixels, destination, count, 2, 0, true );
+	}
+
+	void PackRGBA32F( const __m128* pixels, uint8_t* destination, size_t count )
+	{
+		for( size_t pixel = 0; pixel < count; ++pixel, destination += 16 )
+			_mm_storeu_ps( reinterpret_cast<float*>( destination ), pixels[pixel] );
+	}
+
+	// Narrows sign extended 16-bit values in 32-bit lanes; the halves already fit, so saturation never applies.
+	void PackRGBA16F( const __m128* pixels, uint8_t* destination, size_t count )
+	{
+		size_t pixel = 0;
+		for( ; pixel + 2 <= count; pixel += 2, destination += 16 )
+		{
+			const __m128i packed = _mm_packs_epi32( FloatToHalf( pixels[pixel] ), FloatToHalf( pixels[pixel + 1] ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( destination ), packed );
+		}
+
+		if( pixel < count )
+			_mm_storel_epi64( reinterpret_cast<__m128i*>( destination ), _mm_packs_epi32( FloatToHalf( pixels[pixel] ), _mm_setzero_si128() ) );
+	}
+
+	// SSE2 has no unsigned 32 to 16-bit pack, so values are biased into the signed range and back.
+	inline __m128i PackUNorm16( __m128 first, __m128 second )
+	{
+		const __m128i bias = _mm_set1_epi32( 32768 );
+		const __m128i packed = _mm_packs_epi32( _mm_sub_epi32( ToUNorm( first, 65535.0f ), bias ), _mm_sub_epi32( ToUNorm( second, 65535.0f ), bias ) );
+		return _mm_xor_si128( packed, _mm_set1_epi16( static_cast<short>( 0x8000 ) ) );
+	}
+
+	void PackRGBA16( const __m128* pixels, uint8_t* destination, size_t count )
+	{
+		size_t pixel = 0;
+		for( ; pixel + 2 <= count; pixel += 2, destination += 16 )
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( destination ), PackUNorm16( pixels[pixel], pixels[pixel + 1] ) );
+
+		if( pixel < count )
+			_mm_storel_epi64( reinterpret_cast<__m128i*>( destination ), PackUNorm16( pixels[pixel], pixels[pixel] ) );
+	}
+
+	void PackRGB10A2( const __m128* pixels, uint8_t* destination, size_t count )
+	{
+		for( size_t pixel = 0; pixel < count; pixel += 4, destination += 16 )
+		{
+			const size_t lanes = std::min<size_t>( 4, count - pixel );
+			__m128 r = pixels[pixel];
+			__m128 g = lanes > 1 ? pixels[pixel + 1] : r;
+			__m128 b = lanes > 2 ? pixels[pixel + 2] : r;
+			__m128 a = lanes > 3 ? pixels[pixel + 3] : r;
+			_MM_TRANSPOSE4_PS( r, g, b, a );
+
+			__m128i packed = ToUNorm( r, 1023.0f );
+			packed = _mm_or_si128( packed, _mm_slli_epi32( ToUNorm( g, 1023.0f ), 10 ) );
+			packed = _mm_or_si128( packed, _mm_slli_epi32( ToUNorm( b, 1023.0f ), 20 ) );
+			packed = _mm_or_si128( packed, _mm_slli_epi32( ToUNorm( a, 3.0f ), 30 ) );
+
+			if( lanes == 4 )
+			{
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( destination ), packed );
+			}
+			else
+			{
+				uint32_t tail[4];
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( tail ), packed );
+				memcpy( destination, tail, lanes * 4 );
+			}
+		}
+	}
+
+	const PixelCodec PixelCodecs[] =
+	{
+		{ DXGI_FORMAT_R8G8B8A8_UNORM, UnpackRGBA8, PackRGBA8 },
+		{ DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, UnpackRGBA8Srgb, PackRGBA8Srgb },
+		{ DXGI_FORMAT_B8G8R8A8_UNORM, UnpackBGRA8, PackBGRA8 },
+		{ DXGI_FORMAT_B8G8R8A8_UNORM_SRGB, UnpackBGRA8Srgb, PackBGRA8Srgb },
+		{ DXGI_FORMAT_B8G8R8X8_UNORM, UnpackBGRX8, PackBGRX8 },
+		{ DXGI_FORMAT_B8G8R8X8_UNORM_SRGB, UnpackBGRX8Srgb, PackBGRX8Srgb },
+		{ DXGI_FORMAT_R32G32B32A32_FLOAT, UnpackRGBA32F, PackRGBA32F },
+		{ DXGI_FORMAT_R16G16B16A16_FLOAT, UnpackRGBA16F, PackRGBA16F },
+		{ DXGI_FORMAT_R16G16B16A16_UNORM, UnpackRGBA16, PackRGBA16 },
+		{ DXGI_FORMAT_R10G10B10A2_UNORM, UnpackRGB10A2, PackRGB10A2 }
+	};
+
+	//
+	// Direct paths that skip the float round trip
+	//
+
+	// Copies 8-bit four channel pixels, optionally swapping bytes 0 and 2 and forcing alpha to opaque.
+	// Covers RGBA8 to and from BGRA8/BGRX8, and BGRA8 to and from BGRX8.
+	void SwizzleRow( const uint8_t* source, uint8_t* destination, size_t count, bool swap, bool opaque )
+	{
+		const __m128i redBlue = _mm_set1_epi32( swap ? 0x00ff00ff : 0 );
+		const __m128i kept = _mm_set1_epi32( ( swap ? 0x0000ff00 : 0x00ffffff ) | ( opaque ? 0 : 0xff000000 ) );
+		const __m128i alpha = _mm_set1_epi32( opaque ? 0xff000000 : 0 );
+
+		size_t pixel = 0;
+		for( ; pixel + 4 <= count; pixel += 4, source += 16, destination += 16 )
+		{
+			const __m128i value = _mm_loadu_si128( reinterpret_cast<const __m128i*>( source ) );
+			const __m128i rb = _mm_and_si128( value, redBlue );
+			const __m128i swapped = _mm_or_si128( _mm_slli_epi32( rb, 16 ), _mm_srli_epi32( rb, 16 ) );
+			const __m128i result = _mm_or_si128( _mm_or_si128( swapped, _mm_and_si128( value, kept ) ), alpha );
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( destination ), result );
+		}
+
+		for( ; pixel < count; ++pixel, source += 4, destination += 4 )
+		{
+			const uint8_t red = source[swap ? 2 : 0];
+			const uint8_t blue = source[swap ? 0 : 2];
+			destination[0] = red;
+			destination[1] = source[1];
+			destination[2] = blue;
+			destination[3] = opaque ? 255 : source[3];
+		}
+	}
+
+	bool IsRGBA8( DXGI_FORMAT format )
+	{
+		return format == DXGI_FORMAT_R8G8B8A8_UNORM || format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	}
+
+	bool IsBGR8( DXGI_FORMAT format )
+	{
+		return format == DXGI_FORMAT_B8G8R8A8_UNORM || format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB ||
+			format == DXGI_FORMAT_B8G8R8X8_UNORM || format == DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
+	}
+
+	bool IsOpaqueBGR8( DXGI_FORMAT format )
+	{
+		return format == DXGI_FORMAT_B8G8R8X8_UNORM || format == DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
+	}
+
+	// Formats whose pixels each occupy a whole number of bytes; excludes block compressed and packed formats.
+	bool IsAddressable( const FormatDescriptor& descriptor )
+	{
+		return descriptor.BitsPerElement >= 8 && descriptor.BlockSize == 0 &&
+			descriptor.Format != DXGI_FORMAT_R8G8_B8G8_UNORM && descriptor.Format != DXGI_FORMAT_G8R8_G8B8_UNORM;
+	}
+
+	enum ConversionKind
+	{
+		ConversionKind_None,
+		ConversionKind_Copy,
+		ConversionKind_Swizzle,
+		ConversionKind_Float
+	};
+
+	ConversionKind GetConversionKind( DXGI_FORMAT source, DXGI_FORMAT destination )
+	{
+		const FormatDescriptor* from = GetFormatDescriptor( source );
+		const FormatDescriptor* to = GetFormatDescriptor( destination );
+		if( from == NULL || to == NULL || !IsAddressable( *from ) || !IsAddressable( *to ) )
+			return ConversionKind_None;
+
+		// identical layouts, or a cast within a typeless family, are plain copies
+		if( source == destination || ( from->TypelessFormat == to->TypelessFormat && ( from->Type == FormatType_Typeless || to->Type == FormatType_Typeless ) ) )
+			return ConversionKind_Copy;
+
+		// 8-bit formats in the same colour space only differ in channel order
+		const bool sameSpace = ( from->Type == FormatType_UNormSrgb ) == ( to->Type == FormatType_UNormSrgb );
+		if( sameSpace && ( ( IsRGBA8( source ) && IsBGR8( destination ) ) || ( IsBGR8( source ) && IsRGBA8( destination ) ) ||
+			( IsBGR8( source ) && IsBGR8( destination ) ) ) )
+			return ConversionKind_Swizzle;
+
+		if( FindCodec( source ) != NULL && FindCodec( destination ) != NULL )
+			return ConversionKind_Float;
+
+		return ConversionKind_None;
+	}
+}
+
+	const PixelCodec* FindCodec( DXGI_FORMAT format )
+	{
+		for( size_t index = 0; index < _countof( PixelCodecs ); ++index )
+		{
+			if( PixelCodecs[index].Format == format )
+				return &PixelCodecs[index];
+		}
+
+		return NULL;
+	}
+
+	bool CanConvert( DXGI_FORMAT source, DXGI_FORMAT destination )
+	{
+		return GetConversionKind( source, destination ) != ConversionKind_None;
+	}
+
+	void ConvertRow( void* context, int row )
+	{
+		const ConvertJob& job = *static_cast<const ConvertJob*>( context );
+		const size_t slice = static_cast<size_t>( row ) / job.Height;
+		const size_t y = static_cast<size_t>( row ) % job.Height;
+		const uint8_t* source = job.Source + slice * job.SourceSlicePitch + y * job.SourceRowPitch;
+		uint8_t* destination = job.Destination + slice * job.DestinationSlicePitch + y * job.DestinationRowPitch;
+
+		switch( GetConversionKind( job.SourceFormat, job.DestinationFormat ) )
+		{
+		case ConversionKind_Copy:
+			memcpy( destination, source, job.Width * ( GetFormatDescriptor( job.SourceFormat )->BitsPerElement / 8 ) );
+			break;
+
+		case ConversionKind_Swizzle:
+			SwizzleRow( source, destination, job.Width, IsRGBA8( job.SourceFormat ) != IsRGBA8( job.DestinationFormat ),
+				IsOpaqueBGR8( job.SourceFormat ) || IsOpaqueBGR8( job.DestinationFormat ) );
+			break;
+
+		case ConversionKind_Float:
+			{
+				const PixelCodec* from = FindCodec( job.SourceFormat );
+				const PixelCodec* to = FindCodec( job.DestinationFormat );
+				const size_t sourceStride = GetFormatDescriptor( job.SourceFormat )->BitsPerElement / 8;
+				const size_t destinationStride = GetFormatDescriptor( job.DestinationFormat )->BitsPerElement / 8;
+
+				__declspec(align(16)) __m128 pixels[ChunkSize];
+				for( size_t x = 0; x < job.Width; x += ChunkSize )
+				{
+					const size_t count = std::min( ChunkSize, job.Width - x );
+					from->Unpack( source + x * sourceStride, pixels, count );
+					to->Pack( pixels, destination + x * destinationStride, count );
+				}
+			}
+			break;
+		}
+	}
+}
+}
+}
+
+#pragma managed(pop)
@@ -0,0 +1,52 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+namespace DXGI
+{
+	// Native row converters used by FormatConverter. Compiled as unmanaged code so they can use SSE2.
+	namespace FormatConversion
+	{
+		struct ConvertJob
+		{
+			DXGI_FORMAT SourceFormat;
+			DXGI_FORMAT DestinationFormat;
+			size_t Width;
+			size_t Height;
+			const uint8_t* Source;
+			size_t SourceRowPitch;
+			size_t SourceSlicePitch;
+			uint8_t* Destination;
+			size_t DestinationRowPitch;
+			size_t DestinationSlicePitch;
+		};
+
+		// Returns true if ConvertRow can translate between the formats.
+		bool CanConvert( DXGI_FORMAT source, DXGI_FORMAT destination );
+
+		// Converts one row of the job; rows past Height continue into the following slices. Matches ParallelForBody.
+		void ConvertRow( void* job, int row );
+	}
+}
+}
@@ -0,0 +1,108 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "../DataBox.h"
+#include "../DataRectangle.h"
+#include "../DataStream.h"
+#include "../ParallelFor.h"
+
+#include "FormatTable.h"
+#include "FormatConversion.h"
+#include "FormatConverter.h"
+
+using namespace System;
+
+namespace SlimDX
+{
+namespace DXGI
+{
+	bool FormatConverter::CanConvert( Format sourceFormat, Format destinationFormat )
+	{
+		return FormatConversion::CanConvert( static_cast<DXGI_FORMAT>( sourceFormat ), static_cast<DXGI_FORMAT>( destinationFormat ) );
+	}
+
+	void FormatConverter::Convert( DataStream^ source, Format sourceFormat, int sourceRowPitch, int sourceSlicePitch,
+		DataStream^ destination, Format destinationFormat, int destinationRowPitch, int destinationSlicePitch, int width, int height, int depth )
+	{
+		if( !CanConvert( sourceFormat, destinationFormat ) )
+			throw gcnew ArgumentException( String::Format( "Cannot convert from {0} to {1}.", sourceFormat, destinationFormat ), "destinationFormat" );
+		if( width < 1 )
+			throw gcnew ArgumentOutOfRangeException( "width" );
+		if( height < 1 )
+			throw gcnew ArgumentOutOfRangeException( "height" );
+		if( depth < 1 )
+			throw gcnew ArgumentOutOfRangeException( "depth" );
+
+		// the rows are handed out by index, and the index is an int
+		Int64 rowCount = static_cast<Int64>( height ) * depth;
+		if( rowCount > Int32::MaxValue )
+			throw gcnew ArgumentOutOfRangeException( "depth", "The region has too many rows." );
+
+		Int64 sourceRow = static_cast<Int64>( width ) * ( GetFormatDescriptor( static_cast<DXGI_FORMAT>( sourceFormat ) )->BitsPerElement / 8 );
+		Int64 destinationRow = static_cast<Int64>( width ) * ( GetFormatDescriptor( static_cast<DXGI_FORMAT>( destinationFormat ) )->BitsPerElement / 8 );
+		if( sourceRowPitch < sourceRow || ( depth > 1 && sourceSlicePitch < ( height - 1 ) * static_cast<Int64>( sourceRowPitch ) + sourceRow ) )
+			throw gcnew ArgumentException( "The source pitch is too small for the region.", "source" );
+		if( destinationRowPitch < destinationRow || ( depth > 1 && destinationSlicePitch < ( height - 1 ) * static_cast<Int64>( destinationRowPitch ) + destinationRow ) )
+			throw gcnew ArgumentException( "The destination pitch is too small for the region.", "destination" );
+		if( ( depth - 1 ) * static_cast<Int64>( sourceSlicePitch ) + ( height - 1 ) * static_cast<Int64>( sourceRowPitch ) + sourceRow > source->RemainingLength )
+			throw gcnew ArgumentException( "The source does not contain enough data for the region.", "source" );
+		if( ( depth - 1 ) * static_cast<Int64>( destinationSlicePitch ) + ( height - 1 ) * static_cast<Int64>( destinationRowPitch ) + destinationRow > destination->RemainingLength )
+			throw gcnew ArgumentException( "The destination is too small for the region.", "destination" );
+
+		FormatConversion::ConvertJob job;
+		job.SourceFormat = static_cast<DXGI_FORMAT>( sourceFormat );
+		job.DestinationFormat = static_cast<DXGI_FORMAT>( destinationFormat );
+		job.Width = width;
+		job.Height = height;
+		job.Source = reinterpret_cast<const uint8_t*>( source->PositionPointer );
+		job.SourceRowPitch = sourceRowPitch;
+		job.SourceSlicePitch = sourceSlicePitch;
+		job.Destination = reinterpret_cast<uint8_t*>( destination->PositionPointer );
+		job.DestinationRowPitch = destinationRowPitch;
+		job.DestinationSlicePitch = destinationSlicePitch;
+
+		// a row is cheap, so only large surfaces are worth handing to the thread pool
+		ParallelFor( static_cast<int>( rowCount ), 64, &FormatConversion::ConvertRow, &job );
+	}
+
+	void FormatConverter::Convert( DataRectangle^ source, Format sourceFormat, DataRectangle^ destination, Format destinationFormat, int width, int height )
+	{
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+		if( destination == nullptr )
+			throw gcnew ArgumentNullException( "destination" );
+
+		Convert( source->Data, sourceFormat, source->Pitch, 0, destination->Data, destinationFormat, destination->Pitch, 0, width, height, 1 );
+	}
+
+	void FormatConverter::Convert( DataBox^ source, Format sourceFormat, DataBox^ destination, Format destinationFormat, int width, int height, int depth )
+	{
+		if( source == nullptr )
+			throw gcnew ArgumentNullException( "source" );
+		if( destination == nullptr )
+			throw gcnew ArgumentNullException( "destination" );
+
+		Convert( source->Data, sourceFormat, source->RowPitch, source->SlicePitch, destination->Data, destinationFormat, destination->RowPitch, destination->SlicePitch, width, height, depth );
+	}
+}
+}
@@ -0,0 +1,86 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "Enums.h"
+
+namespace SlimDX
+{
+	ref class DataBox;
+	ref class DataRectangle;
+	ref class DataStream;
+
+	namespace DXGI
+	{
+		/// <summary>
+		/// Converts pixel data between formats on the CPU, such as when fixing up readback or upload data.
+		/// </summary>
+		/// <remarks>
+		/// Conversions between R8G8B8A8, B8G8R8A8 and B8G8R8X8 in the same colour space swap channels directly.
+		/// Other conversions go through 32-bit floats, which covers the UNorm and sRGB variants of those formats,
+		/// R32G32B32A32_Float, R16G16B16A16_Float, R16G16B16A16_UNorm and R10G10B10A2_UNorm. Converting to or from
+		/// an sRGB format applies the sRGB transfer function. Formats that only differ in type within a typeless
+		/// family are copied unchanged. Rows are processed in parallel on the thread pool.
+		/// </remarks>
+		/// <unmanaged>None</unmanaged>
+		public ref class FormatConverter sealed
+		{
+		private:
+			FormatConverter() { }
+
+			static void Convert( DataStream^ source, Format sourceFormat, int sourceRowPitch, int sourceSlicePitch,
+				DataStream^ destination, Format destinationFormat, int destinationRowPitch, int destinationSlicePitch, int width, int height, int depth );
+
+		public:
+			/// <summary>
+			/// Determines whether pixel data can be converted between two formats.
+			/// </summary>
+			/// <param name="sourceFormat">The format of the source data.</param>
+			/// <param name="destinationFormat">The format of the destination data.</param>
+			/// <returns><c>true</c> if <see cref="Convert"/> supports the conversion; otherwise, <c>false</c>.</returns>
+			static bool CanConvert( Format sourceFormat, Format destinationFormat );
+
+			/// <summary>
+			/// Converts a two dimensional region of pixels between formats.
+			/// </summary>
+			/// <param name="source">The source pixels, starting at the current position of its stream.</param>
+			/// <param name="sourceFormat">The format of the source pixels.</param>
+			/// <param name="destination">Receives the converted pixels, starting at the current position of its stream.</param>
+			/// <param name="destinationFormat">The format to convert to.</param>
+			/// <param name="width">The width of the region, in pixels.</param>
+			/// <param name="height">The height of the region, in pixels.</param>
+			static void Convert( DataRectangle^ source, Format sourceFormat, DataRectangle^ destination, Format destinationFormat, int width, int height );
+
+			/// <summary>
+			/// Converts a three dimensional region of pixels between formats.
+			/// </summary>
+			/// <param name="source">The source pixels, starting at the current position of its stream.</param>
+			/// <param name="sourceFormat">The format of the source pixels.</param>
+			/// <param name="destination">Receives the converted pixels, starting at the current position of its stream.</param>
+			/// <param name="destinationFormat">The format to convert to.</param>
+			/// <param name="width">The width of the region, in pixels.</param>
+			/// <param name="height">The height of the region, in pixels.</param>
+			/// <param name="depth">The depth of the region, in slices.</param>
+			static void Convert( DataBox^ source, Format sourceFormat, DataBox^ destination, Format destinationFormat, int width, int height, int depth );
+		};
+	}
+}
@@ -0,0 +1,147 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <dxgi.h>
+
+#include "FormatTable.h"
+#include "FormatDescription.h"
+
+using namespace System;
+using namespace System::Globalization;
+
+namespace SlimDX
+{
+namespace DXGI
+{
+	FormatDescription::FormatDescription( DXGI::Format format )
+	{
+		const FormatDescriptor* descriptor = GetFormatDescriptor( static_cast<DXGI_FORMAT>( format ) );
+		if( descriptor == NULL )
+			throw gcnew ArgumentException( "The format is not a known format.", "format" );
+
+		m_Format = format;
+		m_BitsPerElement = descriptor->BitsPerElement;
+		m_ChannelCount = descriptor->ChannelCount;
+		m_BlockSize = descriptor->BlockSize;
+		m_ComponentType = static_cast<FormatComponentType>( descriptor->Type );
+		m_TypelessFormat = static_cast<DXGI::Format>( descriptor->TypelessFormat );
+		m_SrgbPair = static_cast<DXGI::Format>( descriptor->SrgbPair );
+	}
+
+	DXGI::Format FormatDescription::Format::get()
+	{
+		return m_Format;
+	}
+
+	int FormatDescription::BitsPerElement::get()
+	{
+		return m_BitsPerElement;
+	}
+
+	int FormatDescription::ChannelCount::get()
+	{
+		return m_ChannelCount;
+	}
+
+	int FormatDescription::BlockSize::get()
+	{
+		return m_BlockSize;
+	}
+
+	bool FormatDescription::IsCompressed::get()
+	{
+		return m_BlockSize != 0;
+	}
+
+	bool FormatDescription::IsSrgb::get()
+	{
+		return m_ComponentType == FormatComponentType::UNormSrgb;
+	}
+
+	bool FormatDescription::IsTypeless::get()
+	{
+		return m_ComponentType == FormatComponentType::Typeless;
+	}
+
+	FormatComponentType FormatDescription::ComponentType::get()
+	{
+		return m_ComponentType;
+	}
+
+	DXGI::Format FormatDescription::TypelessFormat::get()
+	{
+		return m_TypelessFormat;
+	}
+
+	DXGI::Format FormatDescription::SrgbFormat::get()
+	{
+		return IsSrgb ? m_Format : m_SrgbPair;
+	}
+
+	DXGI::Format FormatDescription::LinearFormat::get()
+	{
+		return IsSrgb ? m_SrgbPair : m_Format;
+	}
+
+	String^ FormatDescription::ToString()
+	{
+		return String::Format( CultureInfo::CurrentCulture, "{0}: {1} bits, {2} channels, {3}", m_Format, m_BitsPerElement, m_ChannelCount, m_ComponentType );
+	}
+
+	bool FormatDescription::operator == ( FormatDescription left, FormatDescription right )
+	{
+		return FormatDescription::Equals( left, right );
+	}
+
+	bool FormatDescription::operator != ( FormatDescription left, FormatDescription right )
+	{
+		return !FormatDescription::Equals( left, right );
+	}
+
+	int FormatDescription::GetHashCode()
+	{
+		return m_Format.GetHashCode();
+	}
+
+	bool FormatDescription::Equals( Object^ value )
+	{
+		if( value == nullptr )
+			return false;
+
+		if( value->GetType() != GetType() )
+			return false;
+
+		return Equals( safe_cast<FormatDescription>( value ) );
+	}
+
+	bool FormatDescription::Equals( FormatDescription value )
+	{
+		return m_Format == value.m_Format;
+	}
+
+	bool FormatDescription::Equals( FormatDescription% value1, FormatDescription% value2 )
+	{
+		return value1.m_Format == value2.m_Format;
+	}
+}
+}
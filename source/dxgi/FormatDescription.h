@@ -0,0 +1,193 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+#include "Enums.h"
+
+namespace SlimDX
+{
+	namespace DXGI
+	{
+		/// <summary>
+		/// Describes the memory layout and interpretation of a <see cref="Format"/>.
+		/// </summary>
+		/// <unmanaged>None</unmanaged>
+		public value class FormatDescription : System::IEquatable<FormatDescription>
+		{
+			Format m_Format;
+			int m_BitsPerElement;
+			int m_ChannelCount;
+			int m_BlockSize;
+			FormatComponentType m_ComponentType;
+			Format m_TypelessFormat;
+			Format m_SrgbPair;
+
+		public:
+			/// <summary>
+			/// Initializes a new instance of the <see cref="FormatDescription"/> structure.
+			/// </summary>
+			/// <param name="format">The format to describe.</param>
+			/// <exception cref="System::ArgumentException"><paramref name="format"/> is not a known format.</exception>
+			FormatDescription( Format format );
+
+			/// <summary>
+			/// Gets the described format.
+			/// </summary>
+			property DXGI::Format Format
+			{
+				DXGI::Format get();
+			}
+
+			/// <summary>
+			/// Gets the number of bits in one element: a pixel, or a 4x4 block for block compressed formats.
+			/// </summary>
+			property int BitsPerElement
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the number of channels in the format.
+			/// </summary>
+			property int ChannelCount
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets the size of a 4x4 block in bytes, or zero if the format is not block compressed.
+			/// </summary>
+			property int BlockSize
+			{
+				int get();
+			}
+
+			/// <summary>
+			/// Gets a value indicating whether the format is block compressed.
+			/// </summary>
+			property bool IsCompressed
+			{
+				bool get();
+			}
+
+			/// <summary>
+			/// Gets a value indicating whether the format stores colours in the sRGB colour space.
+			/// </summary>
+			property bool IsSrgb
+			{
+				bool get();
+			}
+
+			/// <summary>
+			/// Gets a value indicating whether the format is typeless.
+			/// </summary>
+			property bool IsTypeless
+			{
+				bool get();
+			}
+
+			/// <summary>
+			/// Gets how the channels of the format are interpreted.
+			/// </summary>
+			property FormatComponentType ComponentType
+			{
+				FormatComponentType get();
+			}
+
+			/// <summary>
+			/// Gets the typeless format of the family that the format can be cast within.
+			/// </summary>
+			property DXGI::Format TypelessFormat
+			{
+				DXGI::Format get();
+			}
+
+			/// <summary>
+			/// Gets the sRGB counterpart of the format, the format itself if it is already sRGB,
+			/// or <see cref="DXGI::Format::Unknown"/> if there is none.
+			/// </summary>
+			property DXGI::Format SrgbFormat
+			{
+				DXGI::Format get();
+			}
+
+			/// <summary>
+			/// Gets the non-sRGB counterpart of an sRGB format, or the format itself otherwise.
+			/// </summary>
+			property DXGI::Format LinearFormat
+			{
+				DXGI::Format get();
+			}
+
+			/// <summary>
+			/// Converts the value of the object to its equivalent string representation.
+			/// </summary>
+			/// <returns>The string representation of the value of this instance.</returns>
+			virtual System::String^ ToString() override;
+
+			/// <summary>
+			/// Tests for equality between two objects.
+			/// </summary>
+			/// <param name="left">The first value to compare.</param>
+			/// <param name="right">The second value to compare.</param>
+			/// <returns><c>true</c> if <paramref name="left"/> has the same value as <paramref name="right"/>; otherwise, <c>false</c>.</returns>
+			static bool operator == ( FormatDescription left, FormatDescription right );
+
+			/// <summary>
+			/// Tests for inequality between two objects.
+			/// </summary>
+			/// <param name="left">The first value to compare.</param>
+			/// <param name="right">The second value to compare.</param>
+			/// <returns><c>true</c> if <paramref name="left"/> has a different value than <paramref name="right"/>; otherwise, <c>false</c>.</returns>
+			static bool operator != ( FormatDescription left, FormatDescription right );
+
+			/// <summary>
+			/// Returns the hash code for this instance.
+			/// </summary>
+			/// <returns>A 32-bit signed integer hash code.</returns>
+			virtual int GetHashCode() override;
+
+			/// <summary>
+			/// Returns a value that indicates whether the current instance is equal to a specified object. 
+			/// </summary>
+			/// <param name="obj">Object to make the comparison with.</param>
+			/// <returns><c>true</c> if the current instance is equal to the specified object; <c>false</c> otherwise.</returns>
+			virtual bool Equals( System::Object^ obj ) override;
+
+			/// <summary>
+			/// Returns a value that indicates whether the current instance is equal to the specified object. 
+			/// </summary>
+			/// <param name="other">Object to make the comparison with.</param>
+			/// <returns><c>true</c> if the current instance is equal to the specified object; <c>false</c> otherwise.</returns>
+			virtual bool Equals( FormatDescription other );
+
+			/// <summary>
+			/// Determines whether the specified object instances are considered equal. 
+			/// </summary>
+			/// <param name="value1">The first value to compare.</param>
+			/// <param name="value2">The second value to compare.</param>
+			/// <returns><c>true</c> if <paramref name="value1"/> is the same instance as <paramref name="value2"/> or 
+			/// if both are <c>null</c> references or if <c>value1.Equals(value2)</c> returns <c>true</c>; otherwise, <c>false</c>.</returns>
+			static bool Equals( FormatDescription% value1, FormatDescription% value2 );
+		};
+	}
+}
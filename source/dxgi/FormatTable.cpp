@@ -0,0 +1,173 @@
+#include "stdafx.h"
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#pragma managed(push, off)
+
+#include "FormatTable.h"
+
+namespace SlimDX
+{
+namespace DXGI
+{
+	// Indexed by DXGI_FORMAT value; every entry repeats its format so the ordering can be checked on lookup.
+	const FormatDescriptor FormatDescriptors[] =
+	{
+		{ DXGI_FORMAT_UNKNOWN,                      0, 0,  0, FormatType_Unknown,  DXGI_FORMAT_UNKNOWN,               DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32B32A32_TYPELESS,      128, 4,  0, FormatType_Typeless, DXGI_FORMAT_R32G32B32A32_TYPELESS, DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32B32A32_FLOAT,         128, 4,  0, FormatType_Float,    DXGI_FORMAT_R32G32B32A32_TYPELESS, DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32B32A32_UINT,          128, 4,  0, FormatType_UInt,     DXGI_FORMAT_R32G32B32A32_TYPELESS, DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32B32A32_SINT,          128, 4,  0, FormatType_SInt,     DXGI_FORMAT_R32G32B32A32_TYPELESS, DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32B32_TYPELESS,          96, 3,  0, FormatType_Typeless, DXGI_FORMAT_R32G32B32_TYPELESS,    DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32B32_FLOAT,             96, 3,  0, FormatType_Float,    DXGI_FORMAT_R32G32B32_TYPELESS,    DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32B32_UINT,              96, 3,  0, FormatType_UInt,     DXGI_FORMAT_R32G32B32_TYPELESS,    DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32B32_SINT,              96, 3,  0, FormatType_SInt,     DXGI_FORMAT_R32G32B32_TYPELESS,    DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16B16A16_TYPELESS,       64, 4,  0, FormatType_Typeless, DXGI_FORMAT_R16G16B16A16_TYPELESS, DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16B16A16_FLOAT,          64, 4,  0, FormatType_Float,    DXGI_FORMAT_R16G16B16A16_TYPELESS, DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16B16A16_UNORM,          64, 4,  0, FormatType_UNorm,    DXGI_FORMAT_R16G16B16A16_TYPELESS, DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16B16A16_UINT,           64, 4,  0, FormatType_UInt,     DXGI_FORMAT_R16G16B16A16_TYPELESS, DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16B16A16_SNORM,          64, 4,  0, FormatType_SNorm,    DXGI_FORMAT_R16G16B16A16_TYPELESS, DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16B16A16_SINT,           64, 4,  0, FormatType_SInt,     DXGI_FORMAT_R16G16B16A16_TYPELESS, DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32_TYPELESS,             64, 2,  0, FormatType_Typeless, DXGI_FORMAT_R32G32_TYPELESS,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32_FLOAT,                64, 2,  0, FormatType_Float,    DXGI_FORMAT_R32G32_TYPELESS,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32_UINT,                 64, 2,  0, FormatType_UInt,     DXGI_FORMAT_R32G32_TYPELESS,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G32_SINT,                 64, 2,  0, FormatType_SInt,     DXGI_FORMAT_R32G32_TYPELESS,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32G8X24_TYPELESS,           64, 2,  0, FormatType_Typeless, DXGI_FORMAT_R32G8X24_TYPELESS,     DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_D32_FLOAT_S8X24_UINT,        64, 2,  0, FormatType_Mixed,    DXGI_FORMAT_R32G8X24_TYPELESS,     DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS,    64, 2,  0, FormatType_Mixed,    DXGI_FORMAT_R32G8X24_TYPELESS,     DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_X32_TYPELESS_G8X24_UINT,     64, 2,  0, FormatType_Mixed,    DXGI_FORMAT_R32G8X24_TYPELESS,     DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R10G10B10A2_TYPELESS,        32, 4,  0, FormatType_Typeless, DXGI_FORMAT_R10G10B10A2_TYPELESS,  DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R10G10B10A2_UNORM,           32, 4,  0, FormatType_UNorm,    DXGI_FORMAT_R10G10B10A2_TYPELESS,  DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R10G10B10A2_UINT,            32, 4,  0, FormatType_UInt,     DXGI_FORMAT_R10G10B10A2_TYPELESS,  DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R11G11B10_FLOAT,             32, 3,  0, FormatType_Float,    DXGI_FORMAT_R11G11B10_FLOAT,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8G8B8A8_TYPELESS,           32, 4,  0, FormatType_Typeless, DXGI_FORMAT_R8G8B8A8_TYPELESS,     DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8G8B8A8_UNORM,              32, 4,  0, FormatType_UNorm,    DXGI_FORMAT_R8G8B8A8_TYPELESS,     DXGI_FORMAT_R8G8B8A8_UNORM_SRGB },
+		{ DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,         32, 4,  0, FormatType_UNormSrgb, DXGI_FORMAT_R8G8B8A8_TYPELESS,     DXGI_FORMAT_R8G8B8A8_UNORM },
+		{ DXGI_FORMAT_R8G8B8A8_UINT,               32, 4,  0, FormatType_UInt,     DXGI_FORMAT_R8G8B8A8_TYPELESS,     DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8G8B8A8_SNORM,              32, 4,  0, FormatType_SNorm,    DXGI_FORMAT_R8G8B8A8_TYPELESS,     DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8G8B8A8_SINT,               32, 4,  0, FormatType_SInt,     DXGI_FORMAT_R8G8B8A8_TYPELESS,     DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16_TYPELESS,             32, 2,  0, FormatType_Typeless, DXGI_FORMAT_R16G16_TYPELESS,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16_FLOAT,                32, 2,  0, FormatType_Float,    DXGI_FORMAT_R16G16_TYPELESS,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16_UNORM,                32, 2,  0, FormatType_UNorm,    DXGI_FORMAT_R16G16_TYPELESS,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16_UINT,                 32, 2,  0, FormatType_UInt,     DXGI_FORMAT_R16G16_TYPELESS,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16_SNORM,                32, 2,  0, FormatType_SNorm,    DXGI_FORMAT_R16G16_TYPELESS,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16G16_SINT,                 32, 2,  0, FormatType_SInt,     DXGI_FORMAT_R16G16_TYPELESS,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32_TYPELESS,                32, 1,  0, FormatType_Typeless, DXGI_FORMAT_R32_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_D32_FLOAT,                   32, 1,  0, FormatType_Float,    DXGI_FORMAT_R32_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32_FLOAT,                   32, 1,  0, FormatType_Float,    DXGI_FORMAT_R32_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32_UINT,                    32, 1,  0, FormatType_UInt,     DXGI_FORMAT_R32_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R32_SINT,                    32, 1,  0, FormatType_SInt,     DXGI_FORMAT_R32_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R24G8_TYPELESS,              32, 2,  0, FormatType_Typeless, DXGI_FORMAT_R24G8_TYPELESS,        DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_D24_UNORM_S8_UINT,           32, 2,  0, FormatType_Mixed,    DXGI_FORMAT_R24G8_TYPELESS,        DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R24_UNORM_X8_TYPELESS,       32, 2,  0, FormatType_Mixed,    DXGI_FORMAT_R24G8_TYPELESS,        DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_X24_TYPELESS_G8_UINT,        32, 2,  0, FormatType_Mixed,    DXGI_FORMAT_R24G8_TYPELESS,        DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8G8_TYPELESS,               16, 2,  0, FormatType_Typeless, DXGI_FORMAT_R8G8_TYPELESS,         DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8G8_UNORM,                  16, 2,  0, FormatType_UNorm,    DXGI_FORMAT_R8G8_TYPELESS,         DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8G8_UINT,                   16, 2,  0, FormatType_UInt,     DXGI_FORMAT_R8G8_TYPELESS,         DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8G8_SNORM,                  16, 2,  0, FormatType_SNorm,    DXGI_FORMAT_R8G8_TYPELESS,         DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8G8_SINT,                   16, 2,  0, FormatType_SInt,     DXGI_FORMAT_R8G8_TYPELESS,         DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16_TYPELESS,                16, 1,  0, FormatType_Typeless, DXGI_FORMAT_R16_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16_FLOAT,                   16, 1,  0, FormatType_Float,    DXGI_FORMAT_R16_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_D16_UNORM,                   16, 1,  0, FormatType_UNorm,    DXGI_FORMAT_R16_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16_UNORM,                   16, 1,  0, FormatType_UNorm,    DXGI_FORMAT_R16_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16_UINT,                    16, 1,  0, FormatType_UInt,     DXGI_FORMAT_R16_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16_SNORM,                   16, 1,  0, FormatType_SNorm,    DXGI_FORMAT_R16_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R16_SINT,                    16, 1,  0, FormatType_SInt,     DXGI_FORMAT_R16_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8_TYPELESS,                  8, 1,  0, FormatType_Typeless, DXGI_FORMAT_R8_TYPELESS,           DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8_UNORM,                     8, 1,  0, FormatType_UNorm,    DXGI_FORMAT_R8_TYPELESS,           DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8_UINT,                      8, 1,  0, FormatType_UInt,     DXGI_FORMAT_R8_TYPELESS,           DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8_SNORM,                     8, 1,  0, FormatType_SNorm,    DXGI_FORMAT_R8_TYPELESS,           DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8_SINT,                      8, 1,  0, FormatType_SInt,     DXGI_FORMAT_R8_TYPELESS,           DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_A8_UNORM,                     8, 1,  0, FormatType_UNorm,    DXGI_FORMAT_A8_UNORM,              DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R1_UNORM,                     1, 1,  0, FormatType_UNorm,    DXGI_FORMAT_R1_UNORM,              DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R9G9B9E5_SHAREDEXP,          32, 3,  0, FormatType_Float,    DXGI_FORMAT_R9G9B9E5_SHAREDEXP,    DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_R8G8_B8G8_UNORM,             32, 4,  0, FormatType_UNorm,    DXGI_FORMAT_R8G8_B8G8_UNORM,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_G8R8_G8B8_UNORM,             32, 4,  0, FormatType_UNorm,    DXGI_FORMAT_G8R8_G8B8_UNORM,       DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC1_TYPELESS,                64, 4,  8, FormatType_Typeless, DXGI_FORMAT_BC1_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC1_UNORM,                   64, 4,  8, FormatType_UNorm,    DXGI_FORMAT_BC1_TYPELESS,          DXGI_FORMAT_BC1_UNORM_SRGB },
+		{ DXGI_FORMAT_BC1_UNORM_SRGB,              64, 4,  8, FormatType_UNormSrgb, DXGI_FORMAT_BC1_TYPELESS,          DXGI_FORMAT_BC1_UNORM },
+		{ DXGI_FORMAT_BC2_TYPELESS,               128, 4, 16, FormatType_Typeless, DXGI_FORMAT_BC2_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC2_UNORM,                  128, 4, 16, FormatType_UNorm,    DXGI_FORMAT_BC2_TYPELESS,          DXGI_FORMAT_BC2_UNORM_SRGB },
+		{ DXGI_FORMAT_BC2_UNORM_SRGB,             128, 4, 16, FormatType_UNormSrgb, DXGI_FORMAT_BC2_TYPELESS,          DXGI_FORMAT_BC2_UNORM },
+		{ DXGI_FORMAT_BC3_TYPELESS,               128, 4, 16, FormatType_Typeless, DXGI_FORMAT_BC3_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC3_UNORM,                  128, 4, 16, FormatType_UNorm,    DXGI_FORMAT_BC3_TYPELESS,          DXGI_FORMAT_BC3_UNORM_SRGB },
+		{ DXGI_FORMAT_BC3_UNORM_SRGB,             128, 4, 16, FormatType_UNormSrgb, DXGI_FORMAT_BC3_TYPELESS,          DXGI_FORMAT_BC3_UNORM },
+		{ DXGI_FORMAT_BC4_TYPELESS,                64, 1,  8, FormatType_Typeless, DXGI_FORMAT_BC4_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC4_UNORM,                   64, 1,  8, FormatType_UNorm,    DXGI_FORMAT_BC4_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC4_SNORM,                   64, 1,  8, FormatType_SNorm,    DXGI_FORMAT_BC4_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC5_TYPELESS,               128, 2, 16, FormatType_Typeless, DXGI_FORMAT_BC5_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC5_UNORM,                  128, 2, 16, FormatType_UNorm,    DXGI_FORMAT_BC5_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC5_SNORM,                  128, 2, 16, FormatType_SNorm,    DXGI_FORMAT_BC5_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_B5G6R5_UNORM,                16, 3,  0, FormatType_UNorm,    DXGI_FORMAT_B5G6R5_UNORM,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_B5G5R5A1_UNORM,              16, 4,  0, FormatType_UNorm,    DXGI_FORMAT_B5G5R5A1_UNORM,        DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_B8G8R8A8_UNORM,              32, 4,  0, FormatType_UNorm,    DXGI_FORMAT_B8G8R8A8_TYPELESS,     DXGI_FORMAT_B8G8R8A8_UNORM_SRGB },
+		{ DXGI_FORMAT_B8G8R8X8_UNORM,              32, 4,  0, FormatType_UNorm,    DXGI_FORMAT_B8G8R8X8_TYPELESS,     DXGI_FORMAT_B8G8R8X8_UNORM_SRGB },
+		{ DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM,  32, 4,  0, FormatType_Mixed,    DXGI_FORMAT_R10G10B10A2_TYPELESS,  DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_B8G8R8A8_TYPELESS,           32, 4,  0, FormatType_Typeless, DXGI_FORMAT_B8G8R8A8_TYPELESS,     DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_B8G8R8A8_UNORM_SRGB,         32, 4,  0, FormatType_UNormSrgb, DXGI_FORMAT_B8G8R8A8_TYPELESS,     DXGI_FORMAT_B8G8R8A8_UNORM },
+		{ DXGI_FORMAT_B8G8R8X8_TYPELESS,           32, 4,  0, FormatType_Typeless, DXGI_FORMAT_B8G8R8X8_TYPELESS,     DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_B8G8R8X8_UNORM_SRGB,         32, 4,  0, FormatType_UNormSrgb, DXGI_FORMAT_B8G8R8X8_TYPELESS,     DXGI_FORMAT_B8G8R8X8_UNORM },
+		{ DXGI_FORMAT_BC6H_TYPELESS,              128, 3, 16, FormatType_Typeless, DXGI_FORMAT_BC6H_TYPELESS,         DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC6H_UF16,                  128, 3, 16, FormatType_Float,    DXGI_FORMAT_BC6H_TYPELESS,         DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC6H_SF16,                  128, 3, 16, FormatType_Float,    DXGI_FORMAT_BC6H_TYPELESS,         DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC7_TYPELESS,               128, 4, 16, FormatType_Typeless, DXGI_FORMAT_BC7_TYPELESS,          DXGI_FORMAT_UNKNOWN },
+		{ DXGI_FORMAT_BC7_UNORM,                  128, 4, 16, FormatType_UNorm,    DXGI_FORMAT_BC7_TYPELESS,          DXGI_FORMAT_BC7_UNORM_SRGB },
+		{ DXGI_FORMAT_BC7_UNORM_SRGB,             128, 4, 16, FormatType_UNormSrgb, DXGI_FORMAT_BC7_TYPELESS,          DXGI_FORMAT_BC7_UNORM }
+	};
+
+	const FormatDescriptor* GetFormatDescriptor( DXGI_FORMAT format )
+	{
+		const size_t index = static_cast<size_t>( format );
+		if( index >= _countof( FormatDescriptors ) || FormatDescriptors[index].Format != format )
+			return NULL;
+
+		return &FormatDescriptors[index];
+	}
+
+	bool GetSurfacePitch( DXGI_FORMAT format, uint32_t width, uint32_t height, uint32_t& rowPitch, uint32_t& rowCount )
+	{
+		const FormatDescriptor* descriptor = GetFormatDescriptor( format );
+		if( descriptor == NULL || descriptor->BitsPerElement == 0 )
+			return false;
+
+		if( descriptor->BlockSize != 0 )
+		{
+			rowPitch = std::max( 1u, ( width + 3 ) / 4 ) * descriptor->BlockSize;
+			rowCount = std::max( 1u, ( height + 3 ) / 4 );
+		}
+		else if( format == DXGI_FORMAT_R8G8_B8G8_UNORM || format == DXGI_FORMAT_G8R8_G8B8_UNORM )
+		{
+			rowPitch = ( ( width + 1 ) / 2 ) * 4;
+			rowCount = height;
+		}
+		else
+		{
+			rowPitch = ( width * descriptor->BitsPerElement + 7 ) / 8;
+			rowCount = height;
+		}
+
+		return true;
+	}
+}
+}
+
+#pragma managed(pop)
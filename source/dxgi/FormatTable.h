@@ -0,0 +1,60 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+namespace SlimDX
+{
+namespace DXGI
+{
+	// Mirrors FormatComponentType.
+	enum FormatType
+	{
+		FormatType_Unknown,
+		FormatType_Typeless,
+		FormatType_UNorm,
+		FormatType_UNormSrgb,
+		FormatType_SNorm,
+		FormatType_UInt,
+		FormatType_SInt,
+		FormatType_Float,
+		FormatType_Mixed
+	};
+
+	struct FormatDescriptor
+	{
+		DXGI_FORMAT Format;
+		uint8_t BitsPerElement;		// per pixel, or per 4x4 block for block compressed formats
+		uint8_t ChannelCount;
+		uint8_t BlockSize;			// bytes per 4x4 block, or 0 if the format is not block compressed
+		FormatType Type;
+		DXGI_FORMAT TypelessFormat;	// the family the format can be cast within
+		DXGI_FORMAT SrgbPair;		// the counterpart in the opposite colour space, if there is one
+	};
+
+	// Returns the descriptor of a format, or NULL if the format is not described.
+	const FormatDescriptor* GetFormatDescriptor( DXGI_FORMAT format );
+
+	// Computes the tightly packed pitch and number of rows (of blocks, for block compressed formats) of one image.
+	// Returns false if the format has no defined size.
+	bool GetSurfacePitch( DXGI_FORMAT format, uint32_t width, uint32_t height, uint32_t& rowPitch, uint32_t& rowCount );
+}
+}
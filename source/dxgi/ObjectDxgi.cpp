@@ -20,12 +20,12 @@
 * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 * THE SOFTWARE.
 */
+#include "../ComObjectFactory.h"
+
 #include "DXGIException.h"
 #include "ObjectDxgi.h"
 
 using namespace System;
-using namespace System::Reflection;
-using namespace System::Globalization;
 
 namespace SlimDX
 {
@@ -35,7 +35,7 @@ namespace DXGI
 	T DXGIObject::GetParent()
 	{
 		IUnknown* unknown = 0;
-		GUID guid = Utilities::GetNativeGuidForType(T::typeid);
+		GUID guid = Utilities::ConvertManagedGuid(ComObjectFactory<T>::NativeInterface);
 		RECORD_DXGI(InternalPointer->GetParent(guid, reinterpret_cast<void**>(&unknown)));
 		if(Result::Last.IsFailure)
 			return T();
@@ -46,16 +46,7 @@ namespace DXGI
 			return safe_cast<T>(ObjectTable::Find(IntPtr(unknown)));
 		}
 
-		BindingFlags flags = BindingFlags::Static | BindingFlags::InvokeMethod | BindingFlags::NonPublic;
-		array<System::Object^>^ args = gcnew array<System::Object^>( 2 );
-		args[ 0 ] = IntPtr( unknown );
-		args[ 1 ] = this;
-
-		// Trying to invoke "FromPointer" directly will choose the IntPtr overload since it's more
-		// cumbersome to pass a native pointer as an argument here. The IntPtr overload is intended
-		// to be the user-pointer overload, however, which isn't what we want; thus the thunk.
-		T result = safe_cast<T>( T::typeid->InvokeMember( "FromPointerReflectionThunk", flags, nullptr, nullptr, args, CultureInfo::InvariantCulture ) );
-		return result;
+		return ComObjectFactory<T>::FromPointer(unknown, this);
 	}
 
 	System::String^ DXGIObject::DebugName::get()
@@ -0,0 +1,48 @@
+/*
+* Copyright (c) 2007-2014 SlimDX Group
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+#pragma once
+
+// Only include from code compiled with #pragma managed(off); the codecs work on SSE vectors.
+#include <xmmintrin.h>
+
+namespace SlimDX
+{
+namespace DXGI
+{
+	namespace FormatConversion
+	{
+		// Pixels pass between unpacking and packing as one R, G, B, A float vector each.
+		typedef void (*UnpackRow)( const uint8_t* source, __m128* pixels, size_t count );
+		typedef void (*PackRow)( const __m128* pixels, uint8_t* destination, size_t count );
+
+		struct PixelCodec
+		{
+			DXGI_FORMAT Format;
+			UnpackRow Unpack;
+			PackRow Pack;
+		};
+
+		// Returns the float codec for a format, or NULL if there is none. sRGB codecs unpack to and pack from linear values.
+		const PixelCodec* FindCodec( DXGI_FORMAT format );
+	}
+}
+}
@@ -21,21 +21,28 @@
 */
 #pragma once
 
-#define stackalloc(type, length) stack_array<type>::from_stack_ptr(reinterpret_cast<type*>(_malloca(sizeof(type) * length)), length)
+#include <new>
+#include <type_traits>
+
+#include "ScratchArena.h"
+
+// Scratch arrays come from the calling thread's scratch arena (see ScratchArena.h) rather than the stack, so large counts
+// no longer fall back to the heap. Only trivial types may be stackalloc'd; the memory is not initialized.
+#define stackalloc(type, length) stack_array<type>::from_scratch(length)
 
 template<typename T>
 struct stack_array_ref
 {
-	explicit stack_array_ref(T *right, size_t length, bool on_stack)
+	explicit stack_array_ref(T *right, size_t length, bool in_scratch)
 		:	ptr(right),
 			len(length),
-			on_stack(on_stack)
+			in_scratch(in_scratch)
 	{
 	}
 
 	T *ptr;
 	size_t len;
-	bool on_stack;
+	bool in_scratch;
 };
 
 template<typename T>
@@ -44,61 +51,81 @@ class stack_array
 private:
 	T* ptr;
 	size_t len;
-	bool on_stack;
+	bool in_scratch;
 
 	explicit stack_array(T* memory, size_t length) throw()
 		:	len(length),
 			ptr(memory),
-			on_stack(true)
+			in_scratch(true)
+	{
+	}
+
+	static T* allocate_scratch(size_t length)
+	{
+		// the arena falls back to the heap, which can fail
+		T* memory = static_cast<T*>(SlimDX::ScratchAllocate(sizeof(T) * length));
+		if (memory == NULL)
+			throw std::bad_alloc();
+
+		return memory;
+	}
+
+	void release()
 	{
+		if (in_scratch)
+			SlimDX::ScratchFree(ptr, sizeof(T) * len);
+		else
+			delete[] ptr;
 	}
 
 public:
-	explicit stack_array(size_t length = 0) throw()
+	explicit stack_array(size_t length = 0)
 		:	len(length),
-			ptr(new T[length]),
-			on_stack(false)
+			ptr(NULL),
+			in_scratch(std::is_trivial<T>::value && length > 0)
 	{
+		if (in_scratch)
+			ptr = allocate_scratch(length);
+		else
+			ptr = new T[length];
 	}
 
 	stack_array(stack_array<T>& right) throw()
 		:	ptr(right.ptr),
 			len(right.len),
-			on_stack(right.on_stack)
+			in_scratch(right.in_scratch)
 	{
 		right.ptr = NULL;
 		right.len = 0;
-		right.on_stack = false;
+		right.in_scratch = false;
 	}
 
 	stack_array(stack_array_ref<T> right) throw()
 	{
 		ptr = right.ptr;
 		len = right.len;
-		on_stack = right.on_stack;
+		in_scratch = right.in_scratch;
 
 		right.ptr = NULL;
 	}
 
 	~stack_array()
 	{
-		if (on_stack)
-			_freea(ptr);
-		else
-			delete[] ptr;
+		release();
 	}
 
-	static stack_array<T> from_stack_ptr(T* memory, size_t length)
+	static stack_array<T> from_scratch(size_t length)
 	{
-		return stack_array<T>(memory, length);
+		static_assert(std::is_trivial<T>::value, "stackalloc only supports trivial types");
+		return stack_array<T>(allocate_scratch(length), length);
 	}
 
 	operator stack_array_ref<T>() throw()
 	{
-		stack_array_ref<T> ans(ptr, len, on_stack);
+		stack_array_ref<T> ans(ptr, len, in_scratch);
 		ptr = NULL;
 		len = 0;
-		on_stack = false;
+		in_scratch = false;
 
 		return ans;
 	}
@@ -106,20 +133,15 @@ public:
 	stack_array<T>& operator = (stack_array<T>& right) throw()
 	{
 		if (right.ptr != ptr)
-		{
-			if (on_stack)
-				_freea(ptr);
-			else
-				delete[] ptr;
-		}
+			release();
 
 		ptr = right.ptr;
 		len = right.len;
-		on_stack = right.on_stack;
+		in_scratch = right.in_scratch;
 
 		right.ptr = NULL;
 		right.len = 0;
-		right.on_stack = false;
+		right.in_scratch = false;
 
 		return *this;
 	}
@@ -127,16 +149,11 @@ public:
 	stack_array<T>& operator = (stack_array_ref<T> right) throw()
 	{
 		if (right.ptr != ptr)
-		{
-			if (on_stack)
-				_freea(ptr);
-			else
-				delete[] ptr;
-		}
+			release();
 
 		ptr = right.ptr;
 		len = right.len;
-		on_stack = right.on_stack;
+		in_scratch = right.in_scratch;
 
 		return *this;
 	}